@@ -295,6 +295,11 @@ where options are:
 
     NON REPRODUCIBLE OPTION, DON'T USE THIS OPTION IN PRODUCTION
 
+  --idle-fast-forward
+    when the CPU waits for interrupts, advance mcycle straight to the next timer interrupt.
+    the choice is recorded in the machine config, so hashes remain reproducible.
+    this has no effect in unreproducible mode, where time advances normally when the CPU is idle.
+
   --sync-init-date
     set the guest date to match the host date on initialization.
     this option is recommended when using TLS connections or when sharing
@@ -447,9 +452,17 @@ where options are:
   --periodic-hashes=<number-period>[,<number-start>]
     prints root hash every <number-period> cycles.
     if <number-start> is given, the periodic hashing will start at that mcycle.
+    the machine keeps running while each root hash is computed in the background.
     this option implies --initial-hash and --final-hash.
     (default: none)
 
+  --profile[=<number-period>]
+    count executed instructions and sample the guest pc every <number-period>
+    cycles, then print the most executed instructions, the most frequent pairs
+    of consecutive instructions, and the most sampled guest pcs when done.
+    frequent pairs are the candidates for instruction fusion.
+    (default: 1000000)
+
   --log-uarch-step
     advance one micro step and print access log.
 
@@ -566,6 +579,7 @@ local flash_user = {}
 local flash_start = {}
 local flash_length = {}
 local unreproducible = false
+local idle_fast_forward = false
 local virtio = {}
 local virtio_net_user_config = false
 local virtio_volume_count = 0
@@ -606,6 +620,7 @@ local initial_proof = {}
 local final_proof = {}
 local periodic_hashes_period = math.maxinteger
 local periodic_hashes_start = 0
+local profile_pc_sample_period
 local dump_memory_ranges = false
 local max_mcycle = math.maxinteger
 local max_uarch_cycle = 0
@@ -919,6 +934,14 @@ local options = {
             return true
         end,
     },
+    {
+        "^%-%-idle%-fast%-forward$",
+        function(all)
+            if not all then return false end
+            idle_fast_forward = true
+            return true
+        end,
+    },
     {
         "^%-%-sync%-init-date$",
         handle_sync_init_date,
@@ -1347,6 +1370,22 @@ local options = {
             return true
         end,
     },
+    {
+        "^%-%-profile$",
+        function(all)
+            if not all then return false end
+            profile_pc_sample_period = 1000000
+            return true
+        end,
+    },
+    {
+        "^(%-%-profile%=(.*))$",
+        function(all, v)
+            if not v then return false end
+            profile_pc_sample_period = assert(util.parse_number(v), "invalid period " .. all)
+            return true
+        end,
+    },
     {
         "^%-%-store%-config(%=?)(%g*)$",
         function(o, v)
@@ -1512,6 +1551,34 @@ local function print_root_hash(machine, print)
     (print or stderr)("%u: %s\n", machine:read_mcycle(), util.hexhash(machine:get_root_hash()))
 end
 
+local function print_periodic_root_hashes(machine)
+    for _, h in ipairs(machine:get_periodic_root_hashes()) do stderr("%u: %s\n", h.mcycle, util.hexhash(h.hash)) end
+end
+
+local function print_profile(machine)
+    local profile = machine:get_profile()
+    local total = 0
+    for _, c in ipairs(profile.insn_counts) do total = total + c.count end
+    stderr("\nInstruction profile (%u instructions):\n", total)
+    for i = 1, math.min(#profile.insn_counts, 20) do
+        local c = profile.insn_counts[i]
+        if c.count == 0 then break end
+        stderr("  %-12s %14u %6.2f%%\n", c.insn, c.count, 100 * c.count / total)
+    end
+    stderr("\nInstruction pair profile:\n")
+    for i = 1, math.min(#profile.insn_pair_counts, 20) do
+        local c = profile.insn_pair_counts[i]
+        stderr("  %-12s %-12s %14u %6.2f%%\n", c.insn, c.next_insn, c.count, 100 * c.count / total)
+    end
+    local samples = 0
+    for _, s in ipairs(profile.pc_samples) do samples = samples + s.count end
+    stderr("\nGuest pc profile (%u samples):\n", samples)
+    for i = 1, math.min(#profile.pc_samples, 20) do
+        local s = profile.pc_samples[i]
+        stderr("  0x%016x %10u %6.2f%%\n", s.pc, s.count, 100 * s.count / samples)
+    end
+end
+
 local function store_memory_range(r, indent, output)
     local function comment_default(u, v) output(u == v and " -- default\n" or "\n") end
     output("{\n")
@@ -1753,6 +1820,9 @@ if remote_address then
     end
 end
 
+-- periodic hashes are computed by the machine itself, unless we attach to a remote machine created by someone else
+local native_periodic_hashes = periodic_hashes_period ~= math.maxinteger and not (remote and not remote_create)
+
 local runtime = {
     concurrency = {
         update_merkle_tree = concurrency_update_merkle_tree,
@@ -1760,6 +1830,14 @@ local runtime = {
     htif = {
         no_console_putchar = htif_no_console_putchar,
     },
+    periodic_hashes = native_periodic_hashes and {
+        period = periodic_hashes_period,
+        start = periodic_hashes_start,
+    } or nil,
+    profile = profile_pc_sample_period and {
+        enabled = true,
+        pc_sample_period = profile_pc_sample_period,
+    } or nil,
     skip_root_hash_check = skip_root_hash_check,
     skip_version_check = skip_version_check,
 }
@@ -1782,6 +1860,9 @@ else
             marchid = -1,
             mvendorid = -1,
             iunrep = unreproducible and 1 or 0,
+            iflags = idle_fast_forward
+                    and (cartesi.machine.get_default_config().processor.iflags | cartesi.IFLAGS_I_MASK)
+                or nil,
         },
         dtb = {
             image_filename = dtb_image_filename,
@@ -1977,12 +2058,22 @@ local function save_rollup_hashes(machine, range, filename)
     local hash_len = 32
     local f = assert(io.open(filename, "wb"))
     local zeros = string.rep("\0", hash_len)
+    -- read hashes in batches, so each batch costs a single call
+    local batch_len = 64
     local offset = 0
     while offset < range.length do
-        local hash = machine:read_memory(range.start + offset, 32)
-        if hash == zeros then break end
-        assert(f:write(hash))
-        offset = offset + hash_len
+        local ranges = {}
+        while #ranges < batch_len and offset < range.length do
+            ranges[#ranges + 1] = { address = range.start + offset, length = hash_len }
+            offset = offset + hash_len
+        end
+        for _, hash in ipairs(machine:read_memory_ranges(ranges)) do
+            if hash == zeros then
+                f:close()
+                return
+            end
+            assert(f:write(hash))
+        end
     end
     f:close()
 end
@@ -2011,16 +2102,16 @@ end
 
 local function load_rollup_input_and_metadata(machine, config, advance)
     local values = { e = advance.epoch_index, i = advance.next_input_index }
-    machine:replace_memory_range(config.input_metadata) -- clear
+    machine:clear_memory_range(config.input_metadata.start, config.input_metadata.length)
     load_memory_range(machine, config.input_metadata, instantiate_filename(advance.input_metadata, values))
-    machine:replace_memory_range(config.rx_buffer) -- clear
+    machine:clear_memory_range(config.rx_buffer.start, config.rx_buffer.length)
     load_memory_range(machine, config.rx_buffer, instantiate_filename(advance.input, values))
-    machine:replace_memory_range(config.voucher_hashes) -- clear
-    machine:replace_memory_range(config.notice_hashes) -- clear
+    machine:clear_memory_range(config.voucher_hashes.start, config.voucher_hashes.length)
+    machine:clear_memory_range(config.notice_hashes.start, config.notice_hashes.length)
 end
 
 local function load_rollup_query(machine, config, inspect)
-    machine:replace_memory_range(config.rx_buffer) -- clear
+    machine:clear_memory_range(config.rx_buffer.start, config.rx_buffer.length)
     load_memory_range(machine, config.rx_buffer, inspect.query) -- load query payload
 end
 
@@ -2133,7 +2224,9 @@ end
 dump_value_proofs(machine, initial_proof, config)
 local exit_code = 0
 local next_hash_mcycle
-if periodic_hashes_start ~= 0 then
+if native_periodic_hashes then
+    next_hash_mcycle = math.maxinteger
+elseif periodic_hashes_start ~= 0 then
     next_hash_mcycle = periodic_hashes_start
 else
     next_hash_mcycle = periodic_hashes_period
@@ -2157,6 +2250,7 @@ while math.ult(cycles, max_mcycle) do
     else
         machine:run(next_mcycle)
     end
+    if native_periodic_hashes then print_periodic_root_hashes(machine) end
     cycles = machine:read_mcycle()
     -- deal with halt
     if machine:read_iflags_H() then
@@ -2272,6 +2366,7 @@ if log_uarch_reset then
     util.dump_log(machine:log_uarch_reset({ proofs = true, annotations = true }), io.stderr)
 end
 if dump_memory_ranges then dump_pmas(machine) end
+if profile_pc_sample_period then print_profile(machine) end
 if final_hash then
     assert(config.processor.iunrep == 0, "hashes are meaningless in unreproducible mode")
     print_root_hash(machine, stderr_unsilenceable)
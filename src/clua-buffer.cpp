@@ -0,0 +1,239 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "clua-buffer.h"
+
+#include <cstring>
+#include <new>
+
+#include "clua.h"
+#include "keccak-256-hasher.h"
+
+namespace cartesi {
+
+clua_buffer *clua_tobuffer(lua_State *L, int idx, int ctxidx) {
+    if (lua_type(L, idx) != LUA_TUSERDATA || !clua_is<clua_buffer>(L, idx, ctxidx)) {
+        return nullptr;
+    }
+    return &clua_to<clua_buffer>(L, idx);
+}
+
+const unsigned char *clua_check_bytes(lua_State *L, int idx, size_t *length, int ctxidx) {
+    if (auto *b = clua_tobuffer(L, idx, ctxidx); b != nullptr) {
+        *length = b->length;
+        return b->data;
+    }
+    if (lua_type(L, idx) != LUA_TSTRING) {
+        luaL_argerror(L, idx, "expected string or buffer");
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const unsigned char *>(lua_tolstring(L, idx, length));
+}
+
+/// \brief Normalizes a string.sub style start position into a buffer, like posrelatI in lstrlib.c
+/// \param pos 1-based position, where negative values count back from the end of the buffer
+/// \param length Length of buffer
+/// \returns Position of at least 1, which may be past the end of the buffer
+static lua_Integer buffer_start_position(lua_Integer pos, size_t length) {
+    const auto len = static_cast<lua_Integer>(length);
+    if (pos > 0) {
+        return pos;
+    }
+    if (pos == 0 || pos < -len) {
+        return 1;
+    }
+    return len + pos + 1;
+}
+
+/// \brief Normalizes a string.sub style end position into a buffer, like getendpos in lstrlib.c
+/// \param pos 1-based position, where negative values count back from the end of the buffer
+/// \param length Length of buffer
+/// \returns Position clamped to 0 .. length
+static lua_Integer buffer_end_position(lua_Integer pos, size_t length) {
+    const auto len = static_cast<lua_Integer>(length);
+    if (pos > len) {
+        return len;
+    }
+    if (pos >= 0) {
+        return pos;
+    }
+    if (pos < -len) {
+        return 0;
+    }
+    return len + pos + 1;
+}
+
+/// \brief Obtains the range [i, j] of a buffer from optional arguments, following string.sub conventions
+/// \param L Lua state.
+/// \param b Buffer
+/// \param idx Stack index of first argument
+/// \param offset Receives the offset of the first byte in range, or 0 if the range is empty
+/// \returns Length of range in bytes
+static size_t check_buffer_range(lua_State *L, const clua_buffer &b, int idx, size_t *offset) {
+    const lua_Integer i = buffer_start_position(luaL_optinteger(L, idx, 1), b.length);
+    const lua_Integer j = buffer_end_position(luaL_optinteger(L, idx + 1, -1), b.length);
+    if (i > j) {
+        *offset = 0;
+        return 0;
+    }
+    *offset = static_cast<size_t>(i - 1);
+    return static_cast<size_t>(j - i + 1);
+}
+
+/// \brief Pushes a new buffer that owns length zeroed bytes
+static clua_buffer &push_new_buffer(lua_State *L, size_t length, int ctxidx = lua_upvalueindex(1)) {
+    clua_buffer b{};
+    bool allocated = true;
+    try {
+        b.storage = std::shared_ptr<unsigned char[]>(new unsigned char[length]{});
+    } catch (std::bad_alloc &) {
+        allocated = false;
+    }
+    // Raise the error only after leaving the handler, so the exception object is destroyed
+    if (!allocated) {
+        luaL_error(L, "failed to allocate memory for buffer");
+    }
+    b.data = b.storage.get();
+    b.length = length;
+    return clua_push_to(L, std::move(b), ctxidx);
+}
+
+/// \brief This is the cartesi.new_buffer() function implementation.
+/// \param L Lua state.
+static int cartesi_mod_new_buffer(lua_State *L) {
+    if (lua_type(L, 1) == LUA_TSTRING) {
+        size_t length = 0;
+        const char *s = lua_tolstring(L, 1, &length);
+        auto &b = push_new_buffer(L, length);
+        memcpy(b.data, s, length);
+        return 1;
+    }
+    const lua_Integer length = luaL_checkinteger(L, 1);
+    luaL_argcheck(L, length >= 0, 1, "invalid length");
+    push_new_buffer(L, static_cast<size_t>(length));
+    return 1;
+}
+
+/// \brief This is the buffer:sub() method implementation.
+/// \param L Lua state.
+/// \details Returns a slice that shares the storage of the buffer.
+static int buffer_obj_index_sub(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    size_t offset = 0;
+    const size_t length = check_buffer_range(L, b, 2, &offset);
+    clua_buffer slice{b.storage, b.data + offset, length};
+    clua_push(L, std::move(slice));
+    return 1;
+}
+
+/// \brief This is the buffer:tostring() method implementation.
+/// \param L Lua state.
+static int buffer_obj_index_tostring(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    size_t offset = 0;
+    const size_t length = check_buffer_range(L, b, 2, &offset);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    lua_pushlstring(L, reinterpret_cast<const char *>(b.data + offset), length);
+    return 1;
+}
+
+/// \brief This is the buffer:set() method implementation.
+/// \param L Lua state.
+/// \details Copies a string or buffer into the buffer, starting at a given position.
+static int buffer_obj_index_set(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    const lua_Integer pos = luaL_checkinteger(L, 2);
+    size_t length = 0;
+    const unsigned char *data = clua_check_bytes(L, 3, &length);
+    luaL_argcheck(L, pos >= 1 && static_cast<size_t>(pos - 1) <= b.length, 2, "position out of bounds");
+    luaL_argcheck(L, length <= b.length - static_cast<size_t>(pos - 1), 3, "data does not fit in buffer");
+    // Source and destination may be slices of the same storage
+    memmove(b.data + pos - 1, data, length);
+    lua_settop(L, 1);
+    return 1;
+}
+
+/// \brief This is the buffer:byte() method implementation.
+/// \param L Lua state.
+static int buffer_obj_index_byte(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    const lua_Integer pos = luaL_optinteger(L, 2, 1);
+    luaL_argcheck(L, pos >= 1 && static_cast<size_t>(pos) <= b.length, 2, "position out of bounds");
+    lua_pushinteger(L, b.data[pos - 1]);
+    return 1;
+}
+
+/// \brief This is the buffer:keccak() method implementation.
+/// \param L Lua state.
+static int buffer_obj_index_keccak(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    size_t offset = 0;
+    const size_t length = check_buffer_range(L, b, 2, &offset);
+    keccak_256_hasher h;
+    keccak_256_hasher::hash_type hash;
+    h.begin();
+    h.add_data(b.data + offset, length);
+    h.end(hash);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    lua_pushlstring(L, reinterpret_cast<const char *>(hash.data()), hash.size());
+    return 1;
+}
+
+/// \brief This is the buffer __len metamethod implementation.
+/// \param L Lua state.
+static int buffer_obj_len(lua_State *L) {
+    auto &b = clua_check<clua_buffer>(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(b.length));
+    return 1;
+}
+
+/// \brief Contents of the buffer object metatable __index table.
+static const auto buffer_obj_index = cartesi::clua_make_luaL_Reg_array({
+    {"sub", buffer_obj_index_sub},
+    {"tostring", buffer_obj_index_tostring},
+    {"set", buffer_obj_index_set},
+    {"byte", buffer_obj_index_byte},
+    {"keccak", buffer_obj_index_keccak},
+});
+
+/// \brief Contents of the buffer object metatable.
+static const auto buffer_obj_meta = cartesi::clua_make_luaL_Reg_array({
+    {"__len", buffer_obj_len},
+});
+
+/// \brief Buffer functions exported to the module table.
+static const auto buffer_mod = cartesi::clua_make_luaL_Reg_array({
+    {"new_buffer", cartesi_mod_new_buffer},
+});
+
+int clua_buffer_init(lua_State *L, int ctxidx) {
+    if (!clua_typeexists<clua_buffer>(L, ctxidx)) {
+        clua_createtype<clua_buffer>(L, "cartesi buffer", ctxidx);
+        clua_setmethods<clua_buffer>(L, buffer_obj_index.data(), 0, ctxidx);
+        clua_setmetamethods<clua_buffer>(L, buffer_obj_meta.data(), 0, ctxidx);
+    }
+    return 1;
+}
+
+int clua_buffer_export(lua_State *L, int ctxidx) {
+    ctxidx = lua_absindex(L, ctxidx);
+    clua_buffer_init(L, ctxidx);            // cartesi
+    lua_pushvalue(L, ctxidx);               // cartesi cluactx
+    luaL_setfuncs(L, buffer_mod.data(), 1); // cartesi
+    return 0;
+}
+
+} // namespace cartesi
@@ -0,0 +1,67 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef CLUA_BUFFER_H
+#define CLUA_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+
+extern "C" {
+#include <lua.h>
+}
+
+/// \file
+/// \brief Byte buffer Lua interface
+
+namespace cartesi {
+
+/// \brief Byte buffer exposed to Lua
+/// \details Machine memory can be read into and written from buffers without going through Lua strings.
+/// Slices share the storage of the buffer they were taken from, so taking one copies no bytes.
+struct clua_buffer final {
+    std::shared_ptr<unsigned char[]> storage; ///< Storage shared by a buffer and all its slices
+    unsigned char *data{};                    ///< First byte of the buffer within storage
+    size_t length{};                          ///< Length of the buffer in bytes
+};
+
+/// \brief Returns the buffer at a given stack index, or nullptr if the value is not a buffer
+/// \param L Lua state
+/// \param idx Index (or pseudo-index) of value in stack
+/// \param ctxidx Index (or pseudo-index) of clua context
+clua_buffer *clua_tobuffer(lua_State *L, int idx, int ctxidx = lua_upvalueindex(1));
+
+/// \brief Returns the bytes of a string or buffer at a given stack index
+/// \param L Lua state
+/// \param idx Index (or pseudo-index) of value in stack
+/// \param length Receives the number of bytes
+/// \param ctxidx Index (or pseudo-index) of clua context
+/// \returns Pointer to bytes, valid while the value remains in the stack
+const unsigned char *clua_check_bytes(lua_State *L, int idx, size_t *length, int ctxidx = lua_upvalueindex(1));
+
+/// \brief Initialize the buffer Lua type
+/// \param L Lua state
+/// \param ctxidx Index of Clua context
+int clua_buffer_init(lua_State *L, int ctxidx);
+
+/// \brief Exports symbols to table on top of Lua stack
+/// \param L Lua state
+/// \param ctxidx Index of Clua context
+int clua_buffer_export(lua_State *L, int ctxidx);
+
+} // namespace cartesi
+
+#endif
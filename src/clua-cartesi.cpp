@@ -136,6 +136,7 @@ CM_API int luaopen_cartesi(lua_State *L) {
     clua_setintegerfield(L, MVENDORID_INIT, "MVENDORID", -1);
     clua_setintegerfield(L, MARCHID_INIT, "MARCHID", -1);
     clua_setintegerfield(L, MIMPID_INIT, "MIMPID", -1);
+    clua_setintegerfield(L, IFLAGS_I_MASK, "IFLAGS_I_MASK", -1);
     clua_setintegerfield(L, CM_VERSION_MAJOR, "VERSION_MAJOR", -1);
     clua_setintegerfield(L, CM_VERSION_MINOR, "VERSION_MINOR", -1);
     clua_setintegerfield(L, CM_VERSION_PATCH, "VERSION_PATCH", -1);
@@ -17,7 +17,9 @@
 #include "clua-i-virtual-machine.h"
 
 #include <cinttypes>
+#include <vector>
 
+#include "clua-buffer.h"
 #include "clua-machine-util.h"
 #include "clua.h"
 
@@ -34,17 +36,38 @@ namespace cartesi {
 /// \brief This is the machine:get_proof() method implementation.
 /// \param L Lua state.
 static int machine_obj_index_get_proof(lua_State *L) {
-    lua_settop(L, 3);
+    lua_settop(L, 4);
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     const uint64_t address = luaL_checkinteger(L, 2);
     auto log2_size = luaL_checkinteger(L, 3);
+    const bool lazy = lua_toboolean(L, 4);
     auto &managed_proof = clua_push_to(L, clua_managed_cm_ptr<cm_merkle_tree_proof>(nullptr));
     TRY_EXECUTE(cm_get_proof(m.get(), address, log2_size, &managed_proof.get(), err_msg));
+    if (lazy) {
+        clua_push_lazy_cm_proof(L, managed_proof.release());
+        return 1;
+    }
     clua_push_cm_proof(L, managed_proof.get());
     managed_proof.reset();
     return 1;
 }
 
+/// \brief This is the machine:get_multi_proof() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_get_multi_proof(lua_State *L) {
+    lua_settop(L, 2);
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    auto &managed_targets = clua_push_to(L,
+        clua_managed_cm_ptr<cm_merkle_tree_multi_proof_target_array>(
+            clua_check_cm_merkle_tree_multi_proof_target_array(L, 2)));
+    auto &managed_proof = clua_push_to(L, clua_managed_cm_ptr<cm_merkle_tree_multi_proof>(nullptr));
+    TRY_EXECUTE(cm_get_multi_proof(m.get(), managed_targets.get(), &managed_proof.get(), err_msg));
+    managed_targets.reset();
+    clua_push_cm_multi_proof(L, managed_proof.get());
+    managed_proof.reset();
+    return 1;
+}
+
 static int machine_obj_index_get_initial_config(lua_State *L) {
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     auto &managed_config = clua_push_to(L, clua_managed_cm_ptr<const cm_machine_config>(nullptr));
@@ -274,6 +297,11 @@ static int machine_obj_index_read_memory(lua_State *L) {
     lua_settop(L, 3);
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     const uint64_t address = luaL_checkinteger(L, 2);
+    // Reading into a buffer fills it in place and returns it
+    if (auto *b = clua_tobuffer(L, 3); b != nullptr) {
+        TRY_EXECUTE(cm_read_memory(m.get(), address, b->data, b->length, err_msg));
+        return 1;
+    }
     const size_t length = luaL_checkinteger(L, 3);
     unsigned char *data{};
     try {
@@ -295,6 +323,11 @@ static int machine_obj_index_read_virtual_memory(lua_State *L) {
     lua_settop(L, 3);
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     const uint64_t address = luaL_checkinteger(L, 2);
+    // Reading into a buffer fills it in place and returns it
+    if (auto *b = clua_tobuffer(L, 3); b != nullptr) {
+        TRY_EXECUTE(cm_read_virtual_memory(m.get(), address, b->data, b->length, err_msg));
+        return 1;
+    }
     const size_t length = luaL_checkinteger(L, 3);
     unsigned char *data{};
     try {
@@ -368,12 +401,85 @@ static int machine_obj_index_get_memory_ranges(lua_State *L) {
     return 1;
 }
 
+/// \brief This is the machine:get_periodic_root_hashes() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_get_periodic_root_hashes(lua_State *L) {
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    auto &managed_hashes = clua_push_to(L, clua_managed_cm_ptr<cm_periodic_root_hash_array>(nullptr));
+    TRY_EXECUTE(cm_get_periodic_root_hashes(m.get(), &managed_hashes.get(), err_msg));
+    clua_push_cm_periodic_root_hash_array(L, managed_hashes.get());
+    managed_hashes.reset();
+    return 1;
+}
+
+/// \brief This is the machine:get_profile() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_get_profile(lua_State *L) {
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    auto &managed_profile = clua_push_to(L, clua_managed_cm_ptr<cm_machine_profile>(nullptr));
+    TRY_EXECUTE(cm_get_profile(m.get(), &managed_profile.get(), err_msg));
+    clua_push_cm_machine_profile(L, managed_profile.get());
+    managed_profile.reset();
+    return 1;
+}
+
+/// \brief This is the machine:advance_rollup() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_advance_rollup(lua_State *L) {
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    const uint64_t mcycle_end = luaL_optinteger(L, 3, UINT64_MAX);
+    // Inputs point straight into the Lua strings, which stay referenced by the table at index 2
+    std::vector<cm_rollup_input> inputs(luaL_len(L, 2));
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        lua_geti(L, 2, static_cast<lua_Integer>(i + 1));
+        if (!lua_istable(L, -1)) {
+            luaL_error(L, "input [%d] not a table", static_cast<int>(i + 1));
+        }
+        auto &input = inputs[i];
+        lua_getfield(L, -1, "metadata");
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        input.metadata = reinterpret_cast<const uint8_t *>(luaL_checklstring(L, -1, &input.metadata_length));
+        lua_getfield(L, -2, "payload");
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        input.payload = reinterpret_cast<const uint8_t *>(luaL_checklstring(L, -1, &input.payload_length));
+        lua_pop(L, 3);
+    }
+    const cm_rollup_input_array input_array{inputs.data(), inputs.size()};
+    auto &managed_results = clua_push_to(L, clua_managed_cm_ptr<cm_rollup_input_result_array>(nullptr));
+    TRY_EXECUTE(cm_advance_rollup(m.get(), &input_array, mcycle_end, &managed_results.get(), err_msg));
+    clua_push_cm_rollup_input_result_array(L, managed_results.get());
+    managed_results.reset();
+    return 1;
+}
+
+/// \brief This is the machine:inspect_rollup() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_inspect_rollup(lua_State *L) {
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    size_t length{0};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto *query = reinterpret_cast<const unsigned char *>(luaL_checklstring(L, 2, &length));
+    const uint64_t mcycle_end = luaL_optinteger(L, 3, UINT64_MAX);
+    auto &managed_result = clua_push_to(L, clua_managed_cm_ptr<cm_rollup_input_result>(nullptr));
+    TRY_EXECUTE(cm_inspect_rollup(m.get(), query, length, mcycle_end, &managed_result.get(), err_msg));
+    clua_push_cm_rollup_input_result(L, managed_result.get());
+    managed_result.reset();
+    return 1;
+}
+
 /// \brief This is the machine:reset_uarch() method implementation.
 /// \param L Lua state.
 static int machine_obj_index_log_uarch_reset(lua_State *L) {
+    lua_settop(L, 3);
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    const bool lazy = lua_toboolean(L, 3);
     auto &managed_log = clua_push_to(L, clua_managed_cm_ptr<cm_access_log>(nullptr));
     TRY_EXECUTE(cm_log_uarch_reset(m.get(), clua_check_cm_log_type(L, 2), true, &managed_log.get(), err_msg));
+    if (lazy) {
+        clua_push_lazy_cm_access_log(L, managed_log.release());
+        return 1;
+    }
     clua_push_cm_access_log(L, managed_log.get());
     managed_log.reset();
     return 1;
@@ -393,9 +499,15 @@ static int machine_obj_index_run_uarch(lua_State *L) {
 /// \brief This is the machine:log_uarch_step() method implementation.
 /// \param L Lua state.
 static int machine_obj_index_log_uarch_step(lua_State *L) {
+    lua_settop(L, 3);
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    const bool lazy = lua_toboolean(L, 3);
     auto &managed_log = clua_push_to(L, clua_managed_cm_ptr<cm_access_log>(nullptr));
     TRY_EXECUTE(cm_log_uarch_step(m.get(), clua_check_cm_log_type(L, 2), true, &managed_log.get(), err_msg));
+    if (lazy) {
+        clua_push_lazy_cm_access_log(L, managed_log.release());
+        return 1;
+    }
     clua_push_cm_access_log(L, managed_log.get());
     managed_log.reset();
     return 1;
@@ -479,8 +591,7 @@ static int machine_obj_index_write_memory(lua_State *L) {
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     size_t length{0};
     const uint64_t address = luaL_checkinteger(L, 2);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    const auto *data = reinterpret_cast<const unsigned char *>(luaL_checklstring(L, 3, &length));
+    const auto *data = clua_check_bytes(L, 3, &length);
     TRY_EXECUTE(cm_write_memory(m.get(), address, data, length, err_msg));
     lua_pushboolean(L, true);
     return 1;
@@ -492,13 +603,144 @@ static int machine_obj_index_write_virtual_memory(lua_State *L) {
     auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
     size_t length{0};
     const uint64_t address = luaL_checkinteger(L, 2);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    const auto *data = reinterpret_cast<const unsigned char *>(luaL_checklstring(L, 3, &length));
+    const auto *data = clua_check_bytes(L, 3, &length);
     TRY_EXECUTE(cm_write_virtual_memory(m.get(), address, data, length, err_msg));
     lua_pushboolean(L, true);
     return 1;
 }
 
+/// \brief Returns the number of entries in a table of memory ranges.
+/// \param L Lua state.
+/// \param tabidx Table stack index.
+/// \param entry_size Bytes of scratch storage needed per entry.
+static size_t check_ranges_count(lua_State *L, int tabidx, size_t entry_size) {
+    const lua_Integer count = luaL_len(L, tabidx);
+    if (count < 0 || static_cast<uint64_t>(count) > SIZE_MAX / entry_size) {
+        luaL_error(L, "too many ranges");
+    }
+    return static_cast<size_t>(count);
+}
+
+/// \brief Reads the list of memory ranges in the table at index 2.
+/// \param L Lua state.
+/// \param read_ranges C API function that reads the ranges.
+/// \details Each entry is either {address = ..., length = ...}, read into a new string,
+/// or {address = ..., buffer = ...}, read into the buffer in place.
+static int read_memory_ranges(lua_State *L,
+    int (*read_ranges)(const cm_machine *, const cm_memory_range_read *, size_t, char **)) {
+    lua_settop(L, 2);
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    // Scratch storage is Lua userdata, because luaL_error would skip the destructors of C++ containers
+    const size_t count = check_ranges_count(L, 2, sizeof(cm_memory_range_read) + 1);
+    auto *ranges = static_cast<cm_memory_range_read *>(lua_newuserdata(L, count * sizeof(cm_memory_range_read)));
+    auto *into_buffer = static_cast<unsigned char *>(lua_newuserdata(L, count));
+    // Ranges read into strings share a single allocation
+    uint64_t total_length = 0;
+    for (size_t i = 0; i < count; ++i) {
+        lua_geti(L, 2, static_cast<lua_Integer>(i + 1));
+        if (!lua_istable(L, -1)) {
+            luaL_error(L, "range [%d] not a table", static_cast<int>(i + 1));
+        }
+        auto &range = ranges[i];
+        lua_getfield(L, -1, "address");
+        range.address = luaL_checkinteger(L, -1);
+        lua_getfield(L, -2, "buffer");
+        if (auto *b = clua_tobuffer(L, -1); b != nullptr) {
+            range.data = b->data;
+            range.length = b->length;
+            into_buffer[i] = 1;
+        } else {
+            into_buffer[i] = 0;
+            lua_getfield(L, -3, "length");
+            range.length = luaL_checkinteger(L, -1);
+            lua_pop(L, 1);
+            if (range.length > SIZE_MAX - total_length) {
+                luaL_error(L, "ranges too long");
+            }
+            total_length += range.length;
+        }
+        lua_pop(L, 3);
+    }
+    auto *data = static_cast<unsigned char *>(lua_newuserdata(L, total_length));
+    uint64_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (into_buffer[i] == 0) {
+            ranges[i].data = data + offset;
+            offset += ranges[i].length;
+        }
+    }
+    TRY_EXECUTE(read_ranges(m.get(), ranges, count, err_msg));
+    lua_createtable(L, static_cast<int>(count), 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (into_buffer[i] != 0) {
+            lua_geti(L, 2, static_cast<lua_Integer>(i + 1));
+            lua_getfield(L, -1, "buffer");
+            lua_remove(L, -2);
+        } else {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            lua_pushlstring(L, reinterpret_cast<const char *>(ranges[i].data), ranges[i].length);
+        }
+        lua_seti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    return 1;
+}
+
+/// \brief Writes the list of memory ranges in the table at index 2.
+/// \param L Lua state.
+/// \param write_ranges C API function that writes the ranges.
+/// \details Each entry is {address = ..., data = ...}, where data is a string or a buffer.
+static int write_memory_ranges(lua_State *L,
+    int (*write_ranges)(cm_machine *, const cm_memory_range_write *, size_t, char **)) {
+    lua_settop(L, 2);
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    // Ranges point straight into the Lua strings and buffers, which stay referenced by the table at index 2
+    const size_t count = check_ranges_count(L, 2, sizeof(cm_memory_range_write));
+    auto *ranges = static_cast<cm_memory_range_write *>(lua_newuserdata(L, count * sizeof(cm_memory_range_write)));
+    for (size_t i = 0; i < count; ++i) {
+        lua_geti(L, 2, static_cast<lua_Integer>(i + 1));
+        if (!lua_istable(L, -1)) {
+            luaL_error(L, "range [%d] not a table", static_cast<int>(i + 1));
+        }
+        auto &range = ranges[i];
+        lua_getfield(L, -1, "address");
+        range.address = luaL_checkinteger(L, -1);
+        lua_getfield(L, -2, "data");
+        size_t length{0};
+        range.data = clua_check_bytes(L, -1, &length);
+        range.length = length;
+        lua_pop(L, 3);
+    }
+    TRY_EXECUTE(write_ranges(m.get(), ranges, count, err_msg));
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+/// \brief This is the machine:read_memory_ranges() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_read_memory_ranges(lua_State *L) {
+    return read_memory_ranges(L, cm_read_memory_ranges);
+}
+
+/// \brief This is the machine:write_memory_ranges() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_write_memory_ranges(lua_State *L) {
+    return write_memory_ranges(L, cm_write_memory_ranges);
+}
+
+/// \brief This is the machine:read_virtual_memory_ranges() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_read_virtual_memory_ranges(lua_State *L) {
+    return read_memory_ranges(L, cm_read_virtual_memory_ranges);
+}
+
+/// \brief This is the machine:write_virtual_memory_ranges() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_write_virtual_memory_ranges(lua_State *L) {
+    return write_memory_ranges(L, cm_write_virtual_memory_ranges);
+}
+
 /// \brief Replaces a memory range.
 /// \param L Lua state.
 static int machine_obj_index_replace_memory_range(lua_State *L) {
@@ -518,6 +760,14 @@ static int machine_obj_index_replace_memory_range(lua_State *L) {
     return 0;
 }
 
+/// \brief This is the machine:clear_memory_range() method implementation.
+/// \param L Lua state.
+static int machine_obj_index_clear_memory_range(lua_State *L) {
+    auto &m = clua_check<clua_managed_cm_ptr<cm_machine>>(L, 1);
+    TRY_EXECUTE(cm_clear_memory_range(m.get(), luaL_checkinteger(L, 2), luaL_checkinteger(L, 3), err_msg));
+    return 0;
+}
+
 /// \brief This is the machine:destroy() method implementation.
 /// \param L Lua state.
 static int machine_obj_index_destroy(lua_State *L) {
@@ -545,6 +795,7 @@ static int machine_obj_index_rollback(lua_State *L) {
 /// \brief Contents of the machine object metatable __index table.
 static const auto machine_obj_index = cartesi::clua_make_luaL_Reg_array({
     {"get_proof", machine_obj_index_get_proof},
+    {"get_multi_proof", machine_obj_index_get_multi_proof},
     {"get_initial_config", machine_obj_index_get_initial_config},
     {"get_root_hash", machine_obj_index_get_root_hash},
     {"read_clint_mtimecmp", machine_obj_index_read_clint_mtimecmp},
@@ -581,6 +832,8 @@ static const auto machine_obj_index = cartesi::clua_make_luaL_Reg_array({
     {"read_medeleg", machine_obj_index_read_medeleg},
     {"read_memory", machine_obj_index_read_memory},
     {"read_virtual_memory", machine_obj_index_read_virtual_memory},
+    {"read_memory_ranges", machine_obj_index_read_memory_ranges},
+    {"read_virtual_memory_ranges", machine_obj_index_read_virtual_memory_ranges},
     {"read_mepc", machine_obj_index_read_mepc},
     {"read_mideleg", machine_obj_index_read_mideleg},
     {"read_mie", machine_obj_index_read_mie},
@@ -635,6 +888,8 @@ static const auto machine_obj_index = cartesi::clua_make_luaL_Reg_array({
     {"write_medeleg", machine_obj_index_write_medeleg},
     {"write_memory", machine_obj_index_write_memory},
     {"write_virtual_memory", machine_obj_index_write_virtual_memory},
+    {"write_memory_ranges", machine_obj_index_write_memory_ranges},
+    {"write_virtual_memory_ranges", machine_obj_index_write_virtual_memory_ranges},
     {"write_mepc", machine_obj_index_write_mepc},
     {"write_mideleg", machine_obj_index_write_mideleg},
     {"write_mie", machine_obj_index_write_mie},
@@ -658,12 +913,17 @@ static const auto machine_obj_index = cartesi::clua_make_luaL_Reg_array({
     {"write_x", machine_obj_index_write_x},
     {"write_f", machine_obj_index_write_f},
     {"replace_memory_range", machine_obj_index_replace_memory_range},
+    {"clear_memory_range", machine_obj_index_clear_memory_range},
     {"destroy", machine_obj_index_destroy},
     {"snapshot", machine_obj_index_snapshot},
     {"rollback", machine_obj_index_rollback},
     {"read_uarch_halt_flag", machine_obj_index_read_uarch_halt_flag},
     {"set_uarch_halt_flag", machine_obj_index_set_uarch_halt_flag},
     {"get_memory_ranges", machine_obj_index_get_memory_ranges},
+    {"get_periodic_root_hashes", machine_obj_index_get_periodic_root_hashes},
+    {"get_profile", machine_obj_index_get_profile},
+    {"advance_rollup", machine_obj_index_advance_rollup},
+    {"inspect_rollup", machine_obj_index_inspect_rollup},
     {"reset_uarch", machine_obj_index_reset_uarch},
     {"log_uarch_reset", machine_obj_index_log_uarch_reset},
 });
@@ -678,6 +938,8 @@ static int machine_obj_close(lua_State *L) {
 }
 
 int clua_i_virtual_machine_init(lua_State *L, int ctxidx) {
+    clua_buffer_init(L, ctxidx);
+    clua_machine_util_init(L, ctxidx);
     if (!clua_typeexists<clua_managed_cm_ptr<cm_machine>>(L, ctxidx)) {
         clua_createtype<clua_managed_cm_ptr<cm_machine>>(L, "cartesi machine object", ctxidx);
         clua_setmethods<clua_managed_cm_ptr<cm_machine>>(L, machine_obj_index.data(), 0, ctxidx);
@@ -692,6 +954,7 @@ int clua_i_virtual_machine_init(lua_State *L, int ctxidx) {
 
 int clua_i_virtual_machine_export(lua_State *L, int ctxidx) {
     clua_i_virtual_machine_init(L, ctxidx); // cartesi
+    clua_buffer_export(L, ctxidx);          // cartesi
     return 0;
 }
 
@@ -129,6 +129,27 @@ static int jsonrpc_machine_class_verify_uarch_reset_state_transition(lua_State *
     return 1;
 }
 
+/// \brief This is the machine.verify_uarch_state_transitions()
+/// static method implementation.
+static int jsonrpc_machine_class_verify_uarch_state_transitions(lua_State *L) {
+    const int stubidx = lua_upvalueindex(1);
+    const int ctxidx = lua_upvalueindex(2);
+    lua_settop(L, 3);
+    auto &managed_jsonrpc_mg_mgr = clua_check<clua_managed_cm_ptr<cm_jsonrpc_mg_mgr>>(L, stubidx, ctxidx);
+    auto &managed_transitions = clua_push_to(L,
+        clua_managed_cm_ptr<cm_uarch_state_transition_array>(clua_check_cm_uarch_state_transition_array(L, 1, ctxidx)),
+        ctxidx);
+    auto &managed_runtime_config = clua_push_to(L,
+        clua_managed_cm_ptr<cm_machine_runtime_config>(clua_opt_cm_machine_runtime_config(L, 2, {}, ctxidx)), ctxidx);
+    TRY_EXECUTE(cm_jsonrpc_verify_uarch_state_transitions(managed_jsonrpc_mg_mgr.get(), managed_transitions.get(),
+        managed_runtime_config.get(), true, err_msg));
+    managed_transitions.reset();
+    managed_runtime_config.reset();
+    lua_pop(L, 2);
+    lua_pushnumber(L, 1); // result
+    return 1;
+}
+
 /// \brief This is the machine.get_x_address() method implementation.
 static int jsonrpc_machine_class_get_x_address(lua_State *L) {
     auto &managed_jsonrpc_mg_mgr =
@@ -178,6 +199,7 @@ static const auto jsonrpc_machine_static_methods = cartesi::clua_make_luaL_Reg_a
     {"verify_uarch_step_state_transition", jsonrpc_machine_class_verify_uarch_step_state_transition},
     {"verify_uarch_reset_log", jsonrpc_machine_class_verify_uarch_reset_log},
     {"verify_uarch_reset_state_transition", jsonrpc_machine_class_verify_uarch_reset_state_transition},
+    {"verify_uarch_state_transitions", jsonrpc_machine_class_verify_uarch_state_transitions},
     {"get_x_address", jsonrpc_machine_class_get_x_address},
     {"get_f_address", jsonrpc_machine_class_get_f_address},
     {"get_uarch_x_address", jsonrpc_machine_class_get_uarch_x_address},
@@ -17,6 +17,8 @@
 #include "clua-machine-util.h"
 
 #include <cstring>
+#include <memory>
+#include <new>
 #include <unordered_map>
 
 #include "clua.h"
@@ -77,6 +79,22 @@ void cm_delete(cm_merkle_tree_proof *ptr) {
     cm_delete_merkle_tree_proof(ptr);
 }
 
+/// \brief Deleter for C api merkle tree multi-proof
+template <>
+void cm_delete(cm_merkle_tree_multi_proof *ptr) {
+    cm_delete_merkle_tree_multi_proof(ptr);
+}
+
+/// \brief Deleter for C api merkle tree multi-proof target array
+template <>
+void cm_delete(cm_merkle_tree_multi_proof_target_array *ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    delete[] ptr->entry;
+    delete ptr;
+}
+
 /// \brief Deleter for C api memory range config
 template <>
 void cm_delete(cm_memory_range_config *ptr) {
@@ -89,6 +107,44 @@ void cm_delete(cm_memory_range_descr_array *ptr) {
     cm_delete_memory_range_descr_array(ptr);
 }
 
+/// \brief Deleter for C api periodic root hash array
+template <>
+void cm_delete(cm_periodic_root_hash_array *ptr) {
+    cm_delete_periodic_root_hash_array(ptr);
+}
+
+/// \brief Deleter for C api machine profile
+template <>
+void cm_delete(cm_machine_profile *ptr) {
+    cm_delete_machine_profile(ptr);
+}
+
+/// \brief Deleter for C api rollup input result
+template <>
+void cm_delete(cm_rollup_input_result *ptr) {
+    cm_delete_rollup_input_result(ptr);
+}
+
+/// \brief Deleter for C api rollup input result array
+template <>
+void cm_delete(cm_rollup_input_result_array *ptr) {
+    cm_delete_rollup_input_result_array(ptr);
+}
+
+/// \brief Deleter for C api uarch state transition array
+template <>
+void cm_delete(cm_uarch_state_transition_array *ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < ptr->count; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        cm_delete_access_log(const_cast<cm_access_log *>(ptr->entry[i].log));
+    }
+    delete[] ptr->entry;
+    delete ptr;
+}
+
 static char *copy_lua_str(lua_State *L, int idx) {
     const char *lua_str = lua_tostring(L, idx);
     auto size = strlen(lua_str) + 1;
@@ -326,6 +382,24 @@ static CM_BRACKET_TYPE check_cm_bracket_type_field(lua_State *L, int tabidx, con
     }
 }
 
+/// \brief Returns an CM_UARCH_STATE_TRANSITION_TYPE table field indexed by string in a table.
+/// \param L Lua state
+/// \param tabidx Table stack index
+/// \param field Field index
+/// \returns Corresponding CM_UARCH_STATE_TRANSITION_TYPE
+static CM_UARCH_STATE_TRANSITION_TYPE check_cm_uarch_state_transition_type_field(lua_State *L, int tabidx,
+    const char *field) {
+    auto name = check_string_field(L, tabidx, field);
+    if (name == "step") {
+        return CM_UARCH_STATE_TRANSITION_STEP;
+    } else if (name == "reset") {
+        return CM_UARCH_STATE_TRANSITION_RESET;
+    } else {
+        luaL_error(L, "invalid %s (expected uarch state transition type)", field);
+        return CM_UARCH_STATE_TRANSITION_STEP; // never reached
+    }
+}
+
 /// \brief Loads a cm_bracket_note from Lua
 /// \param L Lua state
 /// \param tabidx Bracket_note stack index
@@ -363,8 +437,29 @@ static void check_sibling_cm_hashes(lua_State *L, int idx, size_t log2_target_si
     }
 }
 
+/// \brief Access log whose fields are converted to Lua only when first indexed
+struct clua_lazy_access_log final {
+    std::shared_ptr<const cm_access_log> log; ///< Access log, shared with the lazy accesses array
+};
+
+/// \brief Accesses of a lazy access log, each converted to Lua only when first indexed
+struct clua_lazy_access_array final {
+    std::shared_ptr<const cm_access_log> log; ///< Access log the accesses belong to
+};
+
+/// \brief Proof whose fields are converted to Lua only when first indexed
+struct clua_lazy_proof final {
+    std::shared_ptr<const cm_merkle_tree_proof> proof; ///< Proof
+};
+
 cm_merkle_tree_proof *clua_check_cm_merkle_tree_proof(lua_State *L, int tabidx, int ctxidx) {
     tabidx = lua_absindex(L, tabidx);
+    ctxidx = lua_absindex(L, ctxidx);
+    if (lua_type(L, tabidx) == LUA_TUSERDATA && clua_is<clua_lazy_proof>(L, tabidx, ctxidx)) {
+        // Lazy proofs are materialized in place, so the rest of the conversion sees a table
+        clua_push_cm_proof(L, clua_to<clua_lazy_proof>(L, tabidx).proof.get());
+        lua_replace(L, tabidx);
+    }
     luaL_checktype(L, tabidx, LUA_TTABLE);
     auto &managed = clua_push_to(L, clua_managed_cm_ptr<cm_merkle_tree_proof>(new cm_merkle_tree_proof{}), ctxidx);
     cm_merkle_tree_proof *proof = managed.get();
@@ -384,6 +479,30 @@ cm_merkle_tree_proof *clua_check_cm_merkle_tree_proof(lua_State *L, int tabidx,
     return proof;
 }
 
+cm_merkle_tree_multi_proof_target_array *clua_check_cm_merkle_tree_multi_proof_target_array(lua_State *L,
+    int tabidx, int ctxidx) {
+    tabidx = lua_absindex(L, tabidx);
+    luaL_checktype(L, tabidx, LUA_TTABLE);
+    auto &managed = clua_push_to(L,
+        clua_managed_cm_ptr<cm_merkle_tree_multi_proof_target_array>(new cm_merkle_tree_multi_proof_target_array{}),
+        ctxidx);
+    cm_merkle_tree_multi_proof_target_array *targets = managed.get();
+    targets->count = luaL_len(L, tabidx);
+    targets->entry = new cm_merkle_tree_multi_proof_target[targets->count]{};
+    for (size_t i = 1; i <= targets->count; i++) {
+        lua_geti(L, tabidx, static_cast<lua_Integer>(i));
+        if (!lua_istable(L, -1)) {
+            luaL_error(L, "target [%d] not a table", i);
+        }
+        targets->entry[i - 1].address = check_uint_field(L, -1, "address");
+        targets->entry[i - 1].log2_size = static_cast<int>(check_uint_field(L, -1, "log2_size"));
+        lua_pop(L, 1);
+    }
+    managed.release();
+    lua_pop(L, 1); // cleanup managed targets from stack
+    return targets;
+}
+
 /// \brief Returns an access data field indexed by string in a table
 /// \param L Lua state
 /// \param tabidx Table stack index
@@ -461,6 +580,11 @@ static void check_cm_access(lua_State *L, int tabidx, bool proofs, cm_access *a,
 cm_access_log *clua_check_cm_access_log(lua_State *L, int tabidx, int ctxidx) {
     tabidx = lua_absindex(L, tabidx);
     ctxidx = lua_absindex(L, ctxidx);
+    if (lua_type(L, tabidx) == LUA_TUSERDATA && clua_is<clua_lazy_access_log>(L, tabidx, ctxidx)) {
+        // Lazy logs are materialized in place, so the rest of the conversion sees a table
+        clua_push_cm_access_log(L, clua_to<clua_lazy_access_log>(L, tabidx).log.get());
+        lua_replace(L, tabidx);
+    }
     luaL_checktype(L, tabidx, LUA_TTABLE);
     auto &managed = clua_push_to(L, clua_managed_cm_ptr<cm_access_log>(new cm_access_log{}), ctxidx);
     cm_access_log *log = managed.get();
@@ -512,6 +636,39 @@ cm_access_log *clua_check_cm_access_log(lua_State *L, int tabidx, int ctxidx) {
     return log;
 }
 
+cm_uarch_state_transition_array *clua_check_cm_uarch_state_transition_array(lua_State *L, int tabidx,
+    int ctxidx) {
+    tabidx = lua_absindex(L, tabidx);
+    ctxidx = lua_absindex(L, ctxidx);
+    luaL_checktype(L, tabidx, LUA_TTABLE);
+    auto &managed = clua_push_to(L,
+        clua_managed_cm_ptr<cm_uarch_state_transition_array>(new cm_uarch_state_transition_array{}), ctxidx);
+    cm_uarch_state_transition_array *transitions = managed.get();
+    transitions->count = luaL_len(L, tabidx);
+    auto *entry = new cm_uarch_state_transition[transitions->count]{};
+    transitions->entry = entry;
+    for (size_t i = 1; i <= transitions->count; i++) {
+        lua_geti(L, tabidx, static_cast<lua_Integer>(i));
+        if (!lua_istable(L, -1)) {
+            luaL_error(L, "transition [%d] not a table", i);
+        }
+        auto &t = entry[i - 1];
+        t.type = check_cm_uarch_state_transition_type_field(L, -1, "type");
+        lua_getfield(L, -1, "root_hash_before");
+        clua_check_cm_hash(L, -1, &t.root_hash_before);
+        lua_pop(L, 1);
+        lua_getfield(L, -1, "root_hash_after");
+        clua_check_cm_hash(L, -1, &t.root_hash_after);
+        lua_pop(L, 1);
+        check_table_field(L, -1, "log");
+        t.log = clua_check_cm_access_log(L, -1, ctxidx);
+        lua_pop(L, 2);
+    }
+    managed.release();
+    lua_pop(L, 1); // cleanup managed transitions from stack
+    return transitions;
+}
+
 void clua_check_cm_hash(lua_State *L, int idx, cm_hash *c_hash) {
     if (lua_isstring(L, idx)) {
         size_t len = 0;
@@ -632,65 +789,83 @@ static const char *cm_bracket_type_name(CM_BRACKET_TYPE type) {
     return nullptr;
 }
 
+/// \brief Pushes an access of a cm_access_log to the Lua stack
+/// \param L Lua state.
+/// \param log Access log the access belongs to.
+/// \param a Access to be pushed.
+static void push_cm_access(lua_State *L, const cm_access_log *log, const cm_access *a) {
+    lua_newtable(L); // wordaccess
+    clua_setstringfield(L, cm_access_type_name(a->type), "type", -1);
+    clua_setintegerfield(L, a->address, "address", -1);
+    clua_setintegerfield(L, a->log2_size, "log2_size", -1);
+    clua_push_cm_hash(L, &a->read_hash);
+    lua_setfield(L, -2, "read_hash"); // read_hash
+    if (a->read_data != nullptr) {
+        push_raw_data(L, a->read_data, a->read_data_size);
+        lua_setfield(L, -2, "read");
+    }
+    if (a->type == CM_ACCESS_WRITE) {
+        clua_push_cm_hash(L, &a->written_hash);
+        lua_setfield(L, -2, "written_hash");
+        if (a->written_data != nullptr) {
+            push_raw_data(L, a->written_data, a->written_data_size);
+            lua_setfield(L, -2, "written");
+        }
+    }
+    if (log->log_type.proofs && a->sibling_hashes != nullptr) {
+        lua_newtable(L);
+        for (size_t log2_size = a->log2_size; log2_size < CM_TREE_LOG2_ROOT_SIZE; log2_size++) {
+            clua_push_cm_hash(L, &a->sibling_hashes->entry[log2_size - a->log2_size]);
+            lua_rawseti(L, -2, static_cast<lua_Integer>(log2_size - a->log2_size) + 1);
+        }
+        lua_setfield(L, -2, "sibling_hashes");
+    }
+}
+
+/// \brief Pushes the bracket notes of a cm_access_log to the Lua stack
+/// \param L Lua state.
+/// \param log Access log whose brackets are to be pushed.
+static void push_cm_bracket_notes(lua_State *L, const cm_access_log *log) {
+    lua_newtable(L); // brackets
+    for (size_t i = 0; i < log->brackets.count; ++i) {
+        const cm_bracket_note *b = &log->brackets.entry[i];
+        lua_newtable(L); // brackets bracket
+        clua_setstringfield(L, cm_bracket_type_name(b->type), "type", -1);
+        clua_setintegerfield(L, b->where + 1, "where", -1); // convert from 0- to 1-based index
+        clua_setstringfield(L, b->text, "text", -1);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
+    }
+}
+
+/// \brief Pushes the notes of a cm_access_log to the Lua stack
+/// \param L Lua state.
+/// \param log Access log whose notes are to be pushed.
+static void push_cm_notes(lua_State *L, const cm_access_log *log) {
+    lua_newtable(L); // notes
+    for (size_t i = 0; i < log->notes.count; ++i) {
+        lua_pushstring(L, log->notes.entry[i]);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
+    }
+}
+
 void clua_push_cm_access_log(lua_State *L, const cm_access_log *log) {
     lua_newtable(L); // log
-    lua_newtable(L); // log type
     push_cm_access_log_type(L, &log->log_type);
     lua_setfield(L, -2, "log_type"); // log
 
     // Add all accesses
     lua_newtable(L); // log accesses
     for (size_t i = 0; i < log->accesses.count; ++i) {
-        const cm_access *a = &log->accesses.entry[i];
-        lua_newtable(L); // log accesses wordaccess
-        clua_setstringfield(L, cm_access_type_name(a->type), "type", -1);
-        clua_setintegerfield(L, a->address, "address", -1);
-        clua_setintegerfield(L, a->log2_size, "log2_size", -1);
-        clua_push_cm_hash(L, &a->read_hash);
-        lua_setfield(L, -2, "read_hash"); // read_hash
-        if (a->read_data != nullptr) {
-            push_raw_data(L, a->read_data, a->read_data_size);
-            lua_setfield(L, -2, "read");
-        }
-        if (a->type == CM_ACCESS_WRITE) {
-            clua_push_cm_hash(L, &a->written_hash);
-            lua_setfield(L, -2, "written_hash");
-            if (a->written_data != nullptr) {
-                push_raw_data(L, a->written_data, a->written_data_size);
-                lua_setfield(L, -2, "written");
-            }
-        }
-        if (log->log_type.proofs && a->sibling_hashes != nullptr) {
-            lua_newtable(L);
-            for (size_t log2_size = a->log2_size; log2_size < CM_TREE_LOG2_ROOT_SIZE; log2_size++) {
-                clua_push_cm_hash(L, &a->sibling_hashes->entry[log2_size - a->log2_size]);
-                lua_rawseti(L, -2, static_cast<lua_Integer>(log2_size - a->log2_size) + 1);
-            }
-            lua_setfield(L, -2, "sibling_hashes");
-        }
+        push_cm_access(L, log, &log->accesses.entry[i]); // log accesses wordaccess
         lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
     }
     lua_setfield(L, -2, "accesses"); // log
     // Add all brackets
     if (log->log_type.annotations) {
-        lua_newtable(L); // log brackets
-        for (size_t i = 0; i < log->brackets.count; ++i) {
-            const cm_bracket_note *b = &log->brackets.entry[i];
-            lua_newtable(L); // log brackets bracket
-            clua_setstringfield(L, cm_bracket_type_name(b->type), "type", -1);
-            clua_setintegerfield(L, b->where + 1, "where", -1); // convert from 0- to 1-based index
-            clua_setstringfield(L, b->text, "text", -1);
-            lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
-        }
+        push_cm_bracket_notes(L, log);   // log brackets
         lua_setfield(L, -2, "brackets"); // log
-
-        lua_newtable(L); // log notes
-        for (size_t i = 0; i < log->notes.count; ++i) {
-            const char *note = log->notes.entry[i];
-            lua_pushstring(L, note);
-            lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
-        }
-        lua_setfield(L, -2, "notes"); // log
+        push_cm_notes(L, log);           // log notes
+        lua_setfield(L, -2, "notes");    // log
     }
 }
 
@@ -708,13 +883,20 @@ void clua_push_cm_semantic_version(lua_State *L, const cm_semantic_version *v) {
     clua_setstringfield(L, v->build, "build", -1);             // version
 }
 
-void clua_push_cm_proof(lua_State *L, const cm_merkle_tree_proof *proof) {
-    lua_newtable(L); // proof
-    lua_newtable(L); // proof siblings
+/// \brief Pushes the sibling hashes of a cm_merkle_tree_proof to the Lua stack
+/// \param L Lua state.
+/// \param proof Proof whose sibling hashes are to be pushed.
+static void push_cm_proof_sibling_hashes(lua_State *L, const cm_merkle_tree_proof *proof) {
+    lua_newtable(L); // siblings
     for (size_t log2_size = proof->log2_target_size; log2_size < proof->log2_root_size; ++log2_size) {
         clua_push_cm_hash(L, &proof->sibling_hashes.entry[proof->log2_root_size - 1 - log2_size]);
         lua_rawseti(L, -2, static_cast<lua_Integer>(proof->log2_root_size - log2_size));
     }
+}
+
+void clua_push_cm_proof(lua_State *L, const cm_merkle_tree_proof *proof) {
+    lua_newtable(L);                                                          // proof
+    push_cm_proof_sibling_hashes(L, proof);                                   // proof siblings
     lua_setfield(L, -2, "sibling_hashes");                                    // proof
     clua_setintegerfield(L, proof->target_address, "target_address", -1);     // proof
     clua_setintegerfield(L, proof->log2_target_size, "log2_target_size", -1); // proof
@@ -725,6 +907,30 @@ void clua_push_cm_proof(lua_State *L, const cm_merkle_tree_proof *proof) {
     lua_setfield(L, -2, "target_hash"); // proof
 }
 
+void clua_push_cm_multi_proof(lua_State *L, const cm_merkle_tree_multi_proof *proof) {
+    lua_newtable(L); // proof
+    lua_newtable(L); // proof targets
+    for (size_t i = 0; i < proof->targets.count; ++i) {
+        const auto &target = proof->targets.entry[i];
+        lua_newtable(L);                                            // proof targets target
+        clua_setintegerfield(L, target.address, "address", -1);     // proof targets target
+        clua_setintegerfield(L, target.log2_size, "log2_size", -1); // proof targets target
+        clua_push_cm_hash(L, &target.hash);
+        lua_setfield(L, -2, "hash");                          // proof targets target
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1); // proof targets
+    }
+    lua_setfield(L, -2, "targets"); // proof
+    lua_newtable(L);                // proof siblings
+    for (size_t i = 0; i < proof->sibling_hashes.count; ++i) {
+        clua_push_cm_hash(L, &proof->sibling_hashes.entry[i]);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i) + 1);
+    }
+    lua_setfield(L, -2, "sibling_hashes");                                // proof
+    clua_setintegerfield(L, proof->log2_root_size, "log2_root_size", -1); // proof
+    clua_push_cm_hash(L, &proof->root_hash);
+    lua_setfield(L, -2, "root_hash"); // proof
+}
+
 void clua_push_cm_memory_range_descr_array(lua_State *L, const cm_memory_range_descr_array *mrds) {
     lua_newtable(L); // array
     for (int i = 0; i < static_cast<int>(mrds->count); ++i) {
@@ -737,6 +943,116 @@ void clua_push_cm_memory_range_descr_array(lua_State *L, const cm_memory_range_d
     }
 }
 
+void clua_push_cm_periodic_root_hash_array(lua_State *L, const cm_periodic_root_hash_array *hashes) {
+    lua_newtable(L); // array
+    for (int i = 0; i < static_cast<int>(hashes->count); ++i) {
+        const auto &h = hashes->entry[i];
+        lua_newtable(L);                                 // array entry
+        clua_setintegerfield(L, h.mcycle, "mcycle", -1); // array entry
+        clua_push_cm_hash(L, &h.hash);                   // array entry hash
+        lua_setfield(L, -2, "hash");                     // array entry
+        lua_rawseti(L, -2, i + 1);                       // array
+    }
+}
+
+void clua_push_cm_machine_profile(lua_State *L, const cm_machine_profile *profile) {
+    lua_newtable(L); // profile
+    lua_newtable(L); // profile insn_counts
+    for (int i = 0; i < static_cast<int>(profile->insn_counts.count); ++i) {
+        const auto &c = profile->insn_counts.entry[i];
+        lua_newtable(L);                               // profile insn_counts entry
+        clua_setstringfield(L, c.insn, "insn", -1);    // profile insn_counts entry
+        clua_setintegerfield(L, c.count, "count", -1); // profile insn_counts entry
+        lua_rawseti(L, -2, i + 1);                     // profile insn_counts
+    }
+    lua_setfield(L, -2, "insn_counts"); // profile
+    lua_newtable(L);                    // profile insn_pair_counts
+    for (int i = 0; i < static_cast<int>(profile->insn_pair_counts.count); ++i) {
+        const auto &c = profile->insn_pair_counts.entry[i];
+        lua_newtable(L);                                      // profile insn_pair_counts entry
+        clua_setstringfield(L, c.insn, "insn", -1);           // profile insn_pair_counts entry
+        clua_setstringfield(L, c.next_insn, "next_insn", -1); // profile insn_pair_counts entry
+        clua_setintegerfield(L, c.count, "count", -1);        // profile insn_pair_counts entry
+        lua_rawseti(L, -2, i + 1);                            // profile insn_pair_counts
+    }
+    lua_setfield(L, -2, "insn_pair_counts"); // profile
+    lua_newtable(L);                         // profile pc_samples
+    for (int i = 0; i < static_cast<int>(profile->pc_samples.count); ++i) {
+        const auto &s = profile->pc_samples.entry[i];
+        lua_newtable(L);                               // profile pc_samples entry
+        clua_setintegerfield(L, s.pc, "pc", -1);       // profile pc_samples entry
+        clua_setintegerfield(L, s.count, "count", -1); // profile pc_samples entry
+        lua_rawseti(L, -2, i + 1);                     // profile pc_samples
+    }
+    lua_setfield(L, -2, "pc_samples"); // profile
+}
+
+static const char *rollup_input_status_name(CM_ROLLUP_INPUT_STATUS status) {
+    switch (status) {
+        case CM_ROLLUP_INPUT_ACCEPTED:
+            return "accepted";
+        case CM_ROLLUP_INPUT_REJECTED:
+            return "rejected";
+        case CM_ROLLUP_INPUT_EXCEPTION:
+            return "exception";
+        case CM_ROLLUP_INPUT_HALTED:
+            return "halted";
+        case CM_ROLLUP_INPUT_REACHED_TARGET_MCYCLE:
+            return "reached_target_mcycle";
+    }
+    return "unknown"; // LCOV_EXCL_LINE
+}
+
+static void push_cm_rollup_output_array(lua_State *L, const cm_rollup_output_array *outputs) {
+    lua_newtable(L); // outputs
+    for (int i = 0; i < static_cast<int>(outputs->count); ++i) {
+        const auto &o = outputs->entry[i];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        lua_pushlstring(L, reinterpret_cast<const char *>(o.data), o.length); // outputs output
+        lua_rawseti(L, -2, i + 1);                                            // outputs
+    }
+}
+
+static void push_cm_hash_array(lua_State *L, const cm_hash_array *hashes) {
+    lua_newtable(L); // hashes
+    for (int i = 0; i < static_cast<int>(hashes->count); ++i) {
+        clua_push_cm_hash(L, &hashes->entry[i]); // hashes hash
+        lua_rawseti(L, -2, i + 1);               // hashes
+    }
+}
+
+void clua_push_cm_rollup_input_result(lua_State *L, const cm_rollup_input_result *result) {
+    lua_newtable(L);                                                                // result
+    clua_setstringfield(L, rollup_input_status_name(result->status), "status", -1); // result
+    push_cm_rollup_output_array(L, &result->vouchers);                              // result vouchers
+    lua_setfield(L, -2, "vouchers");                                                // result
+    push_cm_rollup_output_array(L, &result->notices);                               // result notices
+    lua_setfield(L, -2, "notices");                                                 // result
+    push_cm_rollup_output_array(L, &result->reports);                               // result reports
+    lua_setfield(L, -2, "reports");                                                 // result
+    if (result->status == CM_ROLLUP_INPUT_EXCEPTION) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        lua_pushlstring(L, reinterpret_cast<const char *>(result->exception.data), result->exception.length);
+        lua_setfield(L, -2, "exception"); // result
+    }
+    push_cm_hash_array(L, &result->voucher_hashes); // result voucher_hashes
+    lua_setfield(L, -2, "voucher_hashes");          // result
+    push_cm_hash_array(L, &result->notice_hashes);  // result notice_hashes
+    lua_setfield(L, -2, "notice_hashes");           // result
+    if (result->status == CM_ROLLUP_INPUT_ACCEPTED || result->status == CM_ROLLUP_INPUT_REJECTED) {
+        clua_push_cm_hash(L, &result->root_hash); // result root_hash
+        lua_setfield(L, -2, "root_hash");         // result
+    }
+}
+
+void clua_push_cm_rollup_input_result_array(lua_State *L, const cm_rollup_input_result_array *results) {
+    lua_newtable(L); // results
+    for (int i = 0; i < static_cast<int>(results->count); ++i) {
+        clua_push_cm_rollup_input_result(L, &results->entry[i]); // results result
+        lua_rawseti(L, -2, i + 1);                               // results
+    }
+}
+
 cm_access_log_type clua_check_cm_log_type(lua_State *L, int tabidx) {
     luaL_checktype(L, tabidx, LUA_TTABLE);
     return cm_access_log_type{
@@ -1054,6 +1370,7 @@ void clua_push_cm_machine_config(lua_State *L, const cm_machine_config *c) {
 static void push_cm_concurrency_runtime_config(lua_State *L, const cm_concurrency_runtime_config *c) {
     lua_newtable(L);
     clua_setintegerfield(L, c->update_merkle_tree, "update_merkle_tree", -1);
+    clua_setintegerfield(L, c->verify_uarch_state_transitions, "verify_uarch_state_transitions", -1);
 }
 
 void clua_push_cm_machine_runtime_config(lua_State *L, const cm_machine_runtime_config *r) {
@@ -1467,6 +1784,7 @@ static void check_cm_concurrency_runtime_config(lua_State *L, int tabidx, cm_con
         return;
     }
     c->update_merkle_tree = opt_uint_field(L, -1, "update_merkle_tree");
+    c->verify_uarch_state_transitions = opt_uint_field(L, -1, "verify_uarch_state_transitions");
     lua_pop(L, 1);
 }
 
@@ -1482,6 +1800,32 @@ static void check_cm_htif_runtime_config(lua_State *L, int tabidx, cm_htif_runti
     lua_pop(L, 1);
 }
 
+/// \brief Loads C api periodic hashes runtime config from Lua
+/// \param L Lua state
+/// \param tabidx Runtime config stack index
+/// \param c C api periodic hashes runtime config structure to receive results
+static void check_cm_periodic_hashes_runtime_config(lua_State *L, int tabidx, cm_periodic_hashes_runtime_config *c) {
+    if (!opt_table_field(L, tabidx, "periodic_hashes")) {
+        return;
+    }
+    c->period = opt_uint_field(L, -1, "period");
+    c->start = opt_uint_field(L, -1, "start");
+    lua_pop(L, 1);
+}
+
+/// \brief Loads C api profile runtime config from Lua
+/// \param L Lua state
+/// \param tabidx Runtime config stack index
+/// \param c C api profile runtime config structure to receive results
+static void check_cm_profile_runtime_config(lua_State *L, int tabidx, cm_profile_runtime_config *c) {
+    if (!opt_table_field(L, tabidx, "profile")) {
+        return;
+    }
+    c->enabled = opt_boolean_field(L, -1, "enabled");
+    c->pc_sample_period = opt_uint_field(L, -1, "pc_sample_period");
+    lua_pop(L, 1);
+}
+
 cm_machine_runtime_config *clua_check_cm_machine_runtime_config(lua_State *L, int tabidx, int ctxidx) {
     luaL_checktype(L, tabidx, LUA_TTABLE);
     auto &managed =
@@ -1489,6 +1833,8 @@ cm_machine_runtime_config *clua_check_cm_machine_runtime_config(lua_State *L, in
     cm_machine_runtime_config *config = managed.get();
     check_cm_concurrency_runtime_config(L, tabidx, &config->concurrency);
     check_cm_htif_runtime_config(L, tabidx, &config->htif);
+    check_cm_periodic_hashes_runtime_config(L, tabidx, &config->periodic_hashes);
+    check_cm_profile_runtime_config(L, tabidx, &config->profile);
     config->skip_root_hash_check = opt_boolean_field(L, tabidx, "skip_root_hash_check");
     config->skip_version_check = opt_boolean_field(L, tabidx, "skip_version_check");
     config->soft_yield = opt_boolean_field(L, tabidx, "soft_yield");
@@ -1510,4 +1856,176 @@ cm_machine_runtime_config *clua_opt_cm_machine_runtime_config(lua_State *L, int
     }
 }
 
+/// \brief Pushes a lazy object, with an empty table in its user value to cache converted fields
+/// \tparam T Lazy object type
+/// \param L Lua state.
+/// \param value Lazy object
+/// \param ctxidx Index (or pseudo-index) of clua context
+template <typename T>
+static void push_lazy(lua_State *L, T &&value, int ctxidx) {
+    clua_push(L, std::forward<T>(value), ctxidx); // lazy
+    lua_newtable(L);                              // lazy cache
+    lua_setiuservalue(L, -2, 1);                  // lazy
+}
+
+/// \brief Pushes the cached field of the lazy object at index 1 for the key at index 2
+/// \param L Lua state.
+/// \returns True if the field was cached and pushed, false if nothing was pushed
+static bool push_lazy_cached_field(lua_State *L) {
+    lua_getiuservalue(L, 1, 1); // cache
+    lua_pushvalue(L, 2);        // cache key
+    if (lua_rawget(L, -2) != LUA_TNIL) {
+        lua_remove(L, -2); // value
+        return true;
+    }
+    lua_pop(L, 2);
+    return false;
+}
+
+/// \brief Caches the value on top of stack as the field of the lazy object at index 1 for the key at index 2
+/// \param L Lua state.
+/// \details The value is left on top of stack.
+static void set_lazy_cached_field(lua_State *L) {
+    lua_getiuservalue(L, 1, 1); // value cache
+    lua_pushvalue(L, 2);        // value cache key
+    lua_pushvalue(L, -3);       // value cache key value
+    lua_rawset(L, -3);          // value cache
+    lua_pop(L, 1);              // value
+}
+
+/// \brief This is the lazy access log __index metamethod implementation.
+/// \param L Lua state.
+static int lazy_access_log_index(lua_State *L) {
+    auto &lazy = clua_check<clua_lazy_access_log>(L, 1);
+    if (push_lazy_cached_field(L)) {
+        return 1;
+    }
+    const cm_access_log *log = lazy.log.get();
+    const char *key = lua_type(L, 2) == LUA_TSTRING ? lua_tostring(L, 2) : "";
+    if (strcmp(key, "log_type") == 0) {
+        push_cm_access_log_type(L, &log->log_type);
+    } else if (strcmp(key, "accesses") == 0) {
+        push_lazy(L, clua_lazy_access_array{lazy.log}, lua_upvalueindex(1));
+    } else if (strcmp(key, "brackets") == 0 && log->log_type.annotations) {
+        push_cm_bracket_notes(L, log);
+    } else if (strcmp(key, "notes") == 0 && log->log_type.annotations) {
+        push_cm_notes(L, log);
+    } else {
+        lua_pushnil(L);
+        return 1;
+    }
+    set_lazy_cached_field(L);
+    return 1;
+}
+
+/// \brief This is the lazy access array __index metamethod implementation.
+/// \param L Lua state.
+static int lazy_access_array_index(lua_State *L) {
+    auto &lazy = clua_check<clua_lazy_access_array>(L, 1);
+    if (push_lazy_cached_field(L)) {
+        return 1;
+    }
+    const cm_access_log *log = lazy.log.get();
+    const lua_Integer i = lua_isinteger(L, 2) ? lua_tointeger(L, 2) : 0;
+    if (i < 1 || static_cast<size_t>(i) > log->accesses.count) {
+        lua_pushnil(L);
+        return 1;
+    }
+    push_cm_access(L, log, &log->accesses.entry[i - 1]);
+    set_lazy_cached_field(L);
+    return 1;
+}
+
+/// \brief This is the lazy access array __len metamethod implementation.
+/// \param L Lua state.
+static int lazy_access_array_len(lua_State *L) {
+    auto &lazy = clua_check<clua_lazy_access_array>(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(lazy.log->accesses.count));
+    return 1;
+}
+
+/// \brief This is the lazy proof __index metamethod implementation.
+/// \param L Lua state.
+static int lazy_proof_index(lua_State *L) {
+    auto &lazy = clua_check<clua_lazy_proof>(L, 1);
+    const cm_merkle_tree_proof *proof = lazy.proof.get();
+    const char *key = lua_type(L, 2) == LUA_TSTRING ? lua_tostring(L, 2) : "";
+    if (strcmp(key, "target_address") == 0) {
+        lua_pushinteger(L, static_cast<lua_Integer>(proof->target_address));
+    } else if (strcmp(key, "log2_target_size") == 0) {
+        lua_pushinteger(L, static_cast<lua_Integer>(proof->log2_target_size));
+    } else if (strcmp(key, "log2_root_size") == 0) {
+        lua_pushinteger(L, static_cast<lua_Integer>(proof->log2_root_size));
+    } else if (strcmp(key, "root_hash") == 0) {
+        clua_push_cm_hash(L, &proof->root_hash);
+    } else if (strcmp(key, "target_hash") == 0) {
+        clua_push_cm_hash(L, &proof->target_hash);
+    } else if (strcmp(key, "sibling_hashes") == 0) {
+        if (!push_lazy_cached_field(L)) {
+            push_cm_proof_sibling_hashes(L, proof);
+            set_lazy_cached_field(L);
+        }
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+void clua_push_lazy_cm_access_log(lua_State *L, cm_access_log *log, int ctxidx) {
+    ctxidx = lua_absindex(L, ctxidx);
+    std::shared_ptr<const cm_access_log> shared_log;
+    bool allocated = true;
+    try {
+        shared_log.reset(log, cm_delete_access_log);
+    } catch (std::bad_alloc &) {
+        allocated = false;
+    }
+    // Raise the error only after leaving the handler, so the exception object is destroyed
+    if (!allocated) {
+        luaL_error(L, "failed to allocate memory for access log");
+    }
+    push_lazy(L, clua_lazy_access_log{std::move(shared_log)}, ctxidx);
+}
+
+void clua_push_lazy_cm_proof(lua_State *L, cm_merkle_tree_proof *proof, int ctxidx) {
+    ctxidx = lua_absindex(L, ctxidx);
+    std::shared_ptr<const cm_merkle_tree_proof> shared_proof;
+    bool allocated = true;
+    try {
+        shared_proof.reset(proof, cm_delete_merkle_tree_proof);
+    } catch (std::bad_alloc &) {
+        allocated = false;
+    }
+    if (!allocated) {
+        luaL_error(L, "failed to allocate memory for proof");
+    }
+    push_lazy(L, clua_lazy_proof{std::move(shared_proof)}, ctxidx);
+}
+
+int clua_machine_util_init(lua_State *L, int ctxidx) {
+    if (!clua_typeexists<clua_lazy_access_log>(L, ctxidx)) {
+        clua_createtype<clua_lazy_access_log>(L, "cartesi access log", ctxidx);
+        static const auto lazy_access_log_meta = cartesi::clua_make_luaL_Reg_array({
+            {"__index", lazy_access_log_index},
+        });
+        clua_setmetamethods<clua_lazy_access_log>(L, lazy_access_log_meta.data(), 0, ctxidx);
+    }
+    if (!clua_typeexists<clua_lazy_access_array>(L, ctxidx)) {
+        clua_createtype<clua_lazy_access_array>(L, "cartesi access array", ctxidx);
+        static const auto lazy_access_array_meta = cartesi::clua_make_luaL_Reg_array({
+            {"__index", lazy_access_array_index},
+            {"__len", lazy_access_array_len},
+        });
+        clua_setmetamethods<clua_lazy_access_array>(L, lazy_access_array_meta.data(), 0, ctxidx);
+    }
+    if (!clua_typeexists<clua_lazy_proof>(L, ctxidx)) {
+        clua_createtype<clua_lazy_proof>(L, "cartesi proof", ctxidx);
+        static const auto lazy_proof_meta = cartesi::clua_make_luaL_Reg_array({
+            {"__index", lazy_proof_index},
+        });
+        clua_setmetamethods<clua_lazy_proof>(L, lazy_proof_meta.data(), 0, ctxidx);
+    }
+    return 1;
+}
+
 } // namespace cartesi
@@ -89,6 +89,14 @@ void cm_delete(cm_access_log *ptr);
 template <>
 void cm_delete(cm_merkle_tree_proof *p);
 
+/// \brief Deleter for C api merkle tree multi-proof
+template <>
+void cm_delete(cm_merkle_tree_multi_proof *p);
+
+/// \brief Deleter for C api merkle tree multi-proof target array
+template <>
+void cm_delete(cm_merkle_tree_multi_proof_target_array *p);
+
 /// \brief Deleter for C api flash drive config
 template <>
 void cm_delete(cm_memory_range_config *p);
@@ -101,6 +109,26 @@ void cm_delete(const cm_semantic_version *p);
 template <>
 void cm_delete(cm_memory_range_descr_array *p);
 
+/// \brief Deleter for C api periodic root hash array
+template <>
+void cm_delete(cm_periodic_root_hash_array *p);
+
+/// \brief Deleter for C api machine profile
+template <>
+void cm_delete(cm_machine_profile *p);
+
+/// \brief Deleter for C api rollup input result
+template <>
+void cm_delete(cm_rollup_input_result *p);
+
+/// \brief Deleter for C api rollup input result array
+template <>
+void cm_delete(cm_rollup_input_result_array *p);
+
+/// \brief Deleter for C api uarch state transition array
+template <>
+void cm_delete(cm_uarch_state_transition_array *p);
+
 // clua_managed_cm_ptr is a smart pointer,
 // however we don't use all its functionally, therefore we exclude it from code coverage.
 // LCOV_EXCL_START
@@ -165,6 +193,11 @@ private:
 /// \param proof Proof to be pushed
 void clua_push_cm_proof(lua_State *L, const cm_merkle_tree_proof *proof);
 
+/// \brief Pushes a C api multi-proof to the Lua stack
+/// \param L Lua state
+/// \param proof Multi-proof to be pushed
+void clua_push_cm_multi_proof(lua_State *L, const cm_merkle_tree_multi_proof *proof);
+
 /// \brief Pushes a cm_semantic_version to the Lua stack
 /// \param L Lua state
 /// \param v C api semantic version to be pushed
@@ -185,6 +218,26 @@ void clua_push_cm_machine_config(lua_State *L, const cm_machine_config *c);
 /// \param mrds Memory range description array to be pushed
 void clua_push_cm_memory_range_descr_array(lua_State *L, const cm_memory_range_descr_array *mrds);
 
+/// \brief Pushes a C api cm_periodic_root_hash_array to the Lua stack
+/// \param L Lua state
+/// \param hashes Periodic root hash array to be pushed
+void clua_push_cm_periodic_root_hash_array(lua_State *L, const cm_periodic_root_hash_array *hashes);
+
+/// \brief Pushes a C api cm_machine_profile to the Lua stack
+/// \param L Lua state
+/// \param profile Machine profile to be pushed
+void clua_push_cm_machine_profile(lua_State *L, const cm_machine_profile *profile);
+
+/// \brief Pushes a C api cm_rollup_input_result to the Lua stack
+/// \param L Lua state
+/// \param result Rollup input result to be pushed
+void clua_push_cm_rollup_input_result(lua_State *L, const cm_rollup_input_result *result);
+
+/// \brief Pushes a C api cm_rollup_input_result_array to the Lua stack
+/// \param L Lua state
+/// \param results Rollup input result array to be pushed
+void clua_push_cm_rollup_input_result_array(lua_State *L, const cm_rollup_input_result_array *results);
+
 #if 0 // NOLINT
 /// \brief Pushes a cm_machine_runtime_config to the Lua stack
 /// \param L Lua state
@@ -203,6 +256,25 @@ CM_PROC_CSR clua_check_cm_proc_csr(lua_State *L, int idx);
 /// \param log Access log to be pushed
 void clua_push_cm_access_log(lua_State *L, const cm_access_log *log);
 
+/// \brief Pushes an access log whose fields are converted to Lua only when first indexed
+/// \param L Lua state
+/// \param log Access log to be pushed. The pushed object takes ownership of it.
+/// \param ctxidx Index (or pseudo-index) of clua context
+/// \details Accesses are also converted one at a time, as they are indexed.
+/// The object is accepted anywhere an access log table is.
+void clua_push_lazy_cm_access_log(lua_State *L, cm_access_log *log, int ctxidx = lua_upvalueindex(1));
+
+/// \brief Pushes a proof whose sibling hashes are converted to Lua only when first indexed
+/// \param L Lua state
+/// \param proof Proof to be pushed. The pushed object takes ownership of it.
+/// \param ctxidx Index (or pseudo-index) of clua context
+void clua_push_lazy_cm_proof(lua_State *L, cm_merkle_tree_proof *proof, int ctxidx = lua_upvalueindex(1));
+
+/// \brief Initialize the Lua types of lazily converted objects
+/// \param L Lua state
+/// \param ctxidx Index of Clua context
+int clua_machine_util_init(lua_State *L, int ctxidx);
+
 /// \brief Loads an cm_access_log_type from Lua
 /// \param L Lua state
 /// \param tabidx Access log stack index
@@ -217,9 +289,18 @@ void clua_check_cm_hash(lua_State *L, int idx, cm_hash *c_hash);
 
 /// \brief Loads a cm_merkle_tree_proof from Lua
 /// \param L Lua state
-/// \param tabidx Proof stack index
+/// \param tabidx Proof stack index, either a table or a lazy proof, which is replaced by its table
+/// \param ctxidx Index of clua context
 /// \returns The allocated proof object
-cm_merkle_tree_proof *clua_check_cm_merkle_tree_proof(lua_State *L, int tabidx);
+cm_merkle_tree_proof *clua_check_cm_merkle_tree_proof(lua_State *L, int tabidx, int ctxidx = lua_upvalueindex(1));
+
+/// \brief Loads a cm_merkle_tree_multi_proof_target_array from Lua
+/// \param L Lua state
+/// \param tabidx Targets stack index
+/// \param ctxidx Index of clua context
+/// \returns The allocated target array. Must be deleted by the user with cm_delete
+cm_merkle_tree_multi_proof_target_array *clua_check_cm_merkle_tree_multi_proof_target_array(lua_State *L,
+    int tabidx, int ctxidx = lua_upvalueindex(1));
 
 /// \brief Loads an cm_access_log from Lua.
 /// \param L Lua state
@@ -228,6 +309,14 @@ cm_merkle_tree_proof *clua_check_cm_merkle_tree_proof(lua_State *L, int tabidx);
 /// \returns The access log. Must be delete by the user with cm_delete_access_log
 cm_access_log *clua_check_cm_access_log(lua_State *L, int tabidx, int ctxidx = lua_upvalueindex(1));
 
+/// \brief Loads a cm_uarch_state_transition_array from Lua.
+/// \param L Lua state
+/// \param tabidx Transitions stack index.
+/// \param ctxidx Index of clua context
+/// \returns The allocated transition array. Must be deleted by the user with cm_delete
+cm_uarch_state_transition_array *clua_check_cm_uarch_state_transition_array(lua_State *L, int tabidx,
+    int ctxidx = lua_upvalueindex(1));
+
 /// \brief Loads a cm_machine_config object from a Lua table
 /// \param L Lua state
 /// \param tabidx Index of table in Lua stack
@@ -93,6 +93,21 @@ static int machine_class_index_verify_uarch_reset_state_transition(lua_State *L)
     return 1;
 }
 
+/// \brief This is the machine.verify_uarch_state_transitions() method implementation.
+static int machine_class_index_verify_uarch_state_transitions(lua_State *L) {
+    lua_settop(L, 2);
+    auto &managed_transitions = clua_push_to(L,
+        clua_managed_cm_ptr<cm_uarch_state_transition_array>(clua_check_cm_uarch_state_transition_array(L, 1)));
+    auto &managed_runtime_config =
+        clua_push_to(L, clua_managed_cm_ptr<cm_machine_runtime_config>(clua_check_cm_machine_runtime_config(L, 2)));
+    TRY_EXECUTE(cm_verify_uarch_state_transitions(managed_transitions.get(), managed_runtime_config.get(), true,
+        err_msg));
+    lua_pushnumber(L, 1);
+    managed_transitions.reset();
+    managed_runtime_config.reset();
+    return 1;
+}
+
 /// \brief This is the machine.get_x_address() method implementation.
 static int machine_class_index_get_x_address(lua_State *L) {
     const int i = static_cast<int>(luaL_checkinteger(L, 1));
@@ -136,6 +151,7 @@ static const auto machine_class_index = cartesi::clua_make_luaL_Reg_array({
     {"verify_uarch_step_state_transition", machine_class_index_verify_uarch_step_state_transition},
     {"verify_uarch_reset_log", machine_class_index_verify_uarch_reset_log},
     {"verify_uarch_reset_state_transition", machine_class_index_verify_uarch_reset_state_transition},
+    {"verify_uarch_state_transitions", machine_class_index_verify_uarch_state_transitions},
     {"get_x_address", machine_class_index_get_x_address},
     {"get_uarch_x_address", machine_class_index_get_uarch_x_address},
     {"get_f_address", machine_class_index_get_f_address},
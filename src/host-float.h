@@ -0,0 +1,274 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef HOST_FLOAT_H
+#define HOST_FLOAT_H
+
+/// \file
+/// \brief Host FPU fast path for floating-point operations.
+/// \details Arithmetic operations run on the host FPU only when the result is provably bit-identical to the one
+/// computed by soft-float. That is the case when the rounding mode is round to nearest even, all operands are zero
+/// or normal, and the result is a normal number above the underflow threshold. Under these conditions, inexact is
+/// the only exception flag the operation can raise, and it is read back from the host status flags when it is not
+/// already set in fflags. Everything else falls back to soft-float.
+/// The fast path assumes the host FPU runs in its default round to nearest mode, which the emulator never changes.
+/// It is disabled in the microarchitecture, which has no FPU, on hosts that evaluate with excess precision, and when
+/// NO_HOST_FPU is defined.
+
+#include <cstdint>
+
+#include "compiler-defines.h"
+#include "riscv-constants.h"
+#include "soft-float.h"
+
+#if !defined(MICROARCHITECTURE) && !defined(NO_HOST_FPU)
+#include <cfloat>
+// Excess precision, as in the x87, would round results twice
+#if FLT_EVAL_METHOD == 0
+#define HOST_FLOAT_ENABLED 1
+#endif
+#endif
+
+#ifdef HOST_FLOAT_ENABLED
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#if defined(__x86_64__)
+#include <xmmintrin.h>
+#else
+#include <cfenv>
+#endif
+#endif
+
+namespace cartesi {
+
+#ifdef HOST_FLOAT_ENABLED
+
+#if defined(__x86_64__)
+// Accessing MXCSR directly is much cheaper than going through <cfenv>, which also touches the x87 environment
+
+/// \brief Clears the host inexact status flag.
+static inline void host_float_clear_inexact() {
+    _mm_setcsr(_mm_getcsr() & ~_MM_EXCEPT_INEXACT);
+}
+
+/// \brief Tests the host inexact status flag.
+static inline bool host_float_test_inexact() {
+    return (_mm_getcsr() & _MM_EXCEPT_INEXACT) != 0;
+}
+#else
+/// \brief Clears the host inexact status flag.
+static inline void host_float_clear_inexact() {
+    std::feclearexcept(FE_INEXACT);
+}
+
+/// \brief Tests the host inexact status flag.
+static inline bool host_float_test_inexact() {
+    return std::fetestexcept(FE_INEXACT) != 0;
+}
+#endif
+
+/// \brief Floating-point operations that use the host FPU whenever the result matches soft-float.
+/// \tparam SFLOAT Soft-float interface used as fallback.
+/// \tparam F Host floating-point type with the same binary representation.
+template <typename SFLOAT, typename F>
+struct i_hfloat {
+    using F_UINT = typename SFLOAT::F_UINT;
+
+    static_assert(sizeof(F) == sizeof(F_UINT), "host float size mismatch");
+    static_assert(std::numeric_limits<F>::is_iec559, "host float is not IEEE 754");
+    static_assert(std::numeric_limits<F>::digits == SFLOAT::MANT_SIZE + 1, "host float mantissa mismatch");
+
+    /// \brief Returns the biased exponent of a float.
+    static inline F_UINT get_exp(F_UINT a) {
+        return (a >> SFLOAT::MANT_SIZE) & SFLOAT::EXP_MASK;
+    }
+
+    /// \brief Checks if a float is zero or normal, i.e., neither subnormal, infinity, nor NaN.
+    static inline bool is_zero_or_normal(F_UINT a) {
+        const F_UINT exp = get_exp(a);
+        return exp != SFLOAT::EXP_MASK && (exp != 0 || (a & ~SFLOAT::SIGN_MASK) == 0);
+    }
+
+    /// \brief Checks if a result can be taken from the host.
+    /// \details Results in the lowest binade are rejected too, so tininess detection never comes into play.
+    static inline bool is_host_result(F_UINT r) {
+        const F_UINT exp = get_exp(r);
+        return exp > 1 && exp != SFLOAT::EXP_MASK;
+    }
+
+    static inline F to_host(F_UINT a) {
+        F f{};
+        memcpy(&f, &a, sizeof(f));
+        return f;
+    }
+
+    static inline F_UINT from_host(F f) {
+        F_UINT a{};
+        memcpy(&a, &f, sizeof(a));
+        return a;
+    }
+
+    /// \brief Executes an operation on the host FPU.
+    /// \param op Operation, receiving an array with the host operands.
+    /// \param args Operands.
+    /// \param pfflags Pointer to accumulated exception flags, updated only on success.
+    /// \param pr Receives the result on success.
+    /// \returns True if the result matches soft-float, false if soft-float must be used instead.
+    template <size_t N, typename OP>
+    static FORCE_INLINE bool host_execute(const OP &op, const std::array<F_UINT, N> &args, uint32_t *pfflags,
+        F_UINT *pr) {
+        for (const F_UINT a : args) {
+            if (!is_zero_or_normal(a)) {
+                return false;
+            }
+        }
+        F_UINT r = 0;
+        bool inexact = false;
+        if ((*pfflags & FFLAGS_NX_MASK) != 0) {
+            // The inexact flag is sticky and already set, so there is no need to query the host
+            std::array<F, N> hargs{};
+            for (size_t i = 0; i < N; ++i) {
+                hargs[i] = to_host(args[i]);
+            }
+            r = from_host(op(hargs));
+        } else {
+            // Volatile accesses keep the compiler from moving the operation across the status flag accesses
+            std::array<volatile F, N> hargs{};
+            for (size_t i = 0; i < N; ++i) {
+                hargs[i] = to_host(args[i]);
+            }
+            host_float_clear_inexact();
+            const volatile F hr = op(hargs);
+            inexact = host_float_test_inexact();
+            r = from_host(hr);
+        }
+        if (!is_host_result(r)) {
+            return false;
+        }
+        if (inexact) {
+            *pfflags |= FFLAGS_NX_MASK;
+        }
+        *pr = r;
+        return true;
+    }
+
+    static bool host_add(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags, F_UINT *pr) {
+        return rm == FRM_RNE && host_execute([](const auto &v) -> F { return v[0] + v[1]; },
+                                    std::array<F_UINT, 2>{a, b}, pfflags, pr);
+    }
+
+    static bool host_mul(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags, F_UINT *pr) {
+        return rm == FRM_RNE && host_execute([](const auto &v) -> F { return v[0] * v[1]; },
+                                    std::array<F_UINT, 2>{a, b}, pfflags, pr);
+    }
+
+    static bool host_div(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags, F_UINT *pr) {
+        return rm == FRM_RNE && host_execute([](const auto &v) -> F { return v[0] / v[1]; },
+                                    std::array<F_UINT, 2>{a, b}, pfflags, pr);
+    }
+
+    static bool host_sqrt(F_UINT a, FRM_modes rm, uint32_t *pfflags, F_UINT *pr) {
+        return rm == FRM_RNE &&
+            host_execute([](const auto &v) -> F { return std::sqrt(static_cast<F>(v[0])); }, std::array<F_UINT, 1>{a},
+                pfflags, pr);
+    }
+
+    /// \brief Returns true if the host has a fused multiply-add instruction.
+    /// \details Otherwise, fma() in the C library is emulated in software and is no faster than soft-float.
+    static constexpr bool has_host_fma() {
+#if defined(FP_FAST_FMA) && defined(FP_FAST_FMAF)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static bool host_fma(F_UINT a, F_UINT b, F_UINT c, FRM_modes rm, uint32_t *pfflags, F_UINT *pr) {
+        if constexpr (has_host_fma()) {
+            return rm == FRM_RNE &&
+                host_execute(
+                    [](const auto &v) -> F {
+                        return std::fma(static_cast<F>(v[0]), static_cast<F>(v[1]), static_cast<F>(v[2]));
+                    },
+                    std::array<F_UINT, 3>{a, b, c}, pfflags, pr);
+        } else {
+            (void) a;
+            (void) b;
+            (void) c;
+            (void) rm;
+            (void) pfflags;
+            (void) pr;
+            return false;
+        }
+    }
+
+    static F_UINT add(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags) {
+        F_UINT r = 0;
+        if (likely(host_add(a, b, rm, pfflags, &r))) {
+            return r;
+        }
+        return SFLOAT::add(a, b, rm, pfflags);
+    }
+
+    static F_UINT mul(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags) {
+        F_UINT r = 0;
+        if (likely(host_mul(a, b, rm, pfflags, &r))) {
+            return r;
+        }
+        return SFLOAT::mul(a, b, rm, pfflags);
+    }
+
+    static F_UINT div(F_UINT a, F_UINT b, FRM_modes rm, uint32_t *pfflags) {
+        F_UINT r = 0;
+        if (likely(host_div(a, b, rm, pfflags, &r))) {
+            return r;
+        }
+        return SFLOAT::div(a, b, rm, pfflags);
+    }
+
+    static F_UINT sqrt(F_UINT a, FRM_modes rm, uint32_t *pfflags) {
+        F_UINT r = 0;
+        if (likely(host_sqrt(a, rm, pfflags, &r))) {
+            return r;
+        }
+        return SFLOAT::sqrt(a, rm, pfflags);
+    }
+
+    static F_UINT fma(F_UINT a, F_UINT b, F_UINT c, FRM_modes rm, uint32_t *pfflags) {
+        F_UINT r = 0;
+        if (likely(host_fma(a, b, c, rm, pfflags, &r))) {
+            return r;
+        }
+        return SFLOAT::fma(a, b, c, rm, pfflags);
+    }
+};
+
+using i_hfloat32 = i_hfloat<i_sfloat32, float>;
+using i_hfloat64 = i_hfloat<i_sfloat64, double>;
+
+#else
+
+// Without a host FPU, all operations go straight to soft-float
+using i_hfloat32 = i_sfloat32;
+using i_hfloat64 = i_sfloat64;
+
+#endif // HOST_FLOAT_ENABLED
+
+} // namespace cartesi
+
+#endif
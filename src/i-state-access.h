@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "insn-id.h"
 #include "meta.h"
 #include "shadow-tlb.h"
 
@@ -510,6 +511,13 @@ public:
         return derived().do_read_iflags_X();
     }
 
+    /// \brief Reads the iflags_I flag.
+    /// \returns The flag value.
+    /// \details This is Cartesi-specific.
+    bool read_iflags_I(void) {
+        return derived().do_read_iflags_I();
+    }
+
     /// \brief Reads the current privilege mode from iflags_PRV.
     /// \details This is Cartesi-specific.
     /// \returns Current privilege mode.
@@ -789,6 +797,23 @@ public:
         return derived().do_get_soft_yield();
     }
 
+    /// \brief Counts an execution of an instruction, if profiling is enabled at runtime
+    /// \param id Instruction identifier.
+    void count_insn(insn_id id) {
+        return derived().do_count_insn(id);
+    }
+
+    /// \brief Returns the number of cycles between guest pc samples taken for profiling (0 if disabled)
+    uint64_t get_pc_sample_period() {
+        return derived().do_get_pc_sample_period();
+    }
+
+    /// \brief Records a guest pc sample for profiling
+    /// \param pc Address of the next instruction to be executed.
+    void sample_pc(uint64_t pc) {
+        return derived().do_sample_pc(pc);
+    }
+
 #ifdef DUMP_COUNTERS
     auto &get_statistics() {
         return derived().do_get_statistics();
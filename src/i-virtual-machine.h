@@ -56,6 +56,12 @@ public:
         return do_run(mcycle_end);
     }
 
+    /// \brief Runs the machine until mcycle reaches mcycle_end, checking it against a reference machine advanced
+    /// with the microarchitecture every period cycles.
+    interpreter_break_reason run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end, uint64_t period) {
+        return do_run_lockstep(reference, mcycle_end, period);
+    }
+
     /// \brief Serialize entire state to directory
     void store(const std::string &dir) {
         do_store(dir);
@@ -71,6 +77,12 @@ public:
         return do_get_proof(address, log2_size);
     }
 
+    /// \brief Obtains a multi-proof for several nodes in the Merkle tree.
+    machine_merkle_tree::multi_proof_type get_multi_proof(
+        const machine_merkle_tree::multi_proof_type::targets_type &targets) const {
+        return do_get_multi_proof(targets);
+    }
+
     /// \brief Obtains the root hash of the Merkle tree.
     void get_root_hash(hash_type &hash) const {
         do_get_root_hash(hash);
@@ -111,6 +123,26 @@ public:
         do_write_virtual_memory(address, data, length);
     }
 
+    /// \brief Reads a list of chunks of data from the machine memory.
+    void read_memory_ranges(const memory_range_reads &ranges) const {
+        do_read_memory_ranges(ranges);
+    }
+
+    /// \brief Writes a list of chunks of data to the machine memory.
+    void write_memory_ranges(const memory_range_writes &ranges) {
+        do_write_memory_ranges(ranges);
+    }
+
+    /// \brief Reads a list of chunks of data from the machine virtual memory.
+    void read_virtual_memory_ranges(const memory_range_reads &ranges) const {
+        do_read_virtual_memory_ranges(ranges);
+    }
+
+    /// \brief Writes a list of chunks of data to the machine virtual memory.
+    void write_virtual_memory_ranges(const memory_range_writes &ranges) {
+        do_write_virtual_memory_ranges(ranges);
+    }
+
     /// \brief Reads the value of a general-purpose register.
     uint64_t read_x(int i) const {
         return do_read_x(i);
@@ -136,6 +168,11 @@ public:
         do_replace_memory_range(new_range);
     }
 
+    /// \brief Fills a memory range with zeros.
+    void clear_memory_range(uint64_t start, uint64_t length) {
+        do_clear_memory_range(start, length);
+    }
+
     /// \brief Read the value of a word in the machine state.
     uint64_t read_word(uint64_t address) const {
         return do_read_word(address);
@@ -675,11 +712,35 @@ public:
         return do_get_memory_ranges();
     }
 
+    /// \brief Returns the root hashes computed by run() at period boundaries since the previous call
+    periodic_root_hashes get_periodic_root_hashes(void) {
+        return do_get_periodic_root_hashes();
+    }
+
+    /// \brief Returns the profile collected by run() so far
+    machine_profile get_profile(void) const {
+        return do_get_profile();
+    }
+
+    /// \brief Advances the rollup state through a batch of inputs
+    rollup_input_results advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) {
+        return do_advance_rollup(inputs, mcycle_end);
+    }
+
+    /// \brief Inspects the rollup state with a query
+    rollup_input_result inspect_rollup(const unsigned char *query, uint64_t length, uint64_t mcycle_end) {
+        return do_inspect_rollup(query, length, mcycle_end);
+    }
+
 private:
     virtual interpreter_break_reason do_run(uint64_t mcycle_end) = 0;
+    virtual interpreter_break_reason do_run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end,
+        uint64_t period) = 0;
     virtual void do_store(const std::string &dir) = 0;
     virtual access_log do_log_uarch_step(const access_log::type &log_type, bool one_based = false) = 0;
     virtual machine_merkle_tree::proof_type do_get_proof(uint64_t address, int log2_size) const = 0;
+    virtual machine_merkle_tree::multi_proof_type do_get_multi_proof(
+        const machine_merkle_tree::multi_proof_type::targets_type &targets) const = 0;
     virtual void do_get_root_hash(hash_type &hash) const = 0;
     virtual bool do_verify_merkle_tree(void) const = 0;
     virtual uint64_t do_read_csr(csr r) const = 0;
@@ -688,6 +749,10 @@ private:
     virtual void do_write_memory(uint64_t address, const unsigned char *data, size_t length) = 0;
     virtual void do_read_virtual_memory(uint64_t address, unsigned char *data, uint64_t length) const = 0;
     virtual void do_write_virtual_memory(uint64_t address, const unsigned char *data, size_t length) = 0;
+    virtual void do_read_memory_ranges(const memory_range_reads &ranges) const = 0;
+    virtual void do_write_memory_ranges(const memory_range_writes &ranges) = 0;
+    virtual void do_read_virtual_memory_ranges(const memory_range_reads &ranges) const = 0;
+    virtual void do_write_virtual_memory_ranges(const memory_range_writes &ranges) = 0;
     virtual uint64_t do_read_x(int i) const = 0;
     virtual void do_write_x(int i, uint64_t val) = 0;
     virtual uint64_t do_read_f(int i) const = 0;
@@ -780,6 +845,7 @@ private:
     virtual uint64_t do_read_plic_girqsrvd(void) const = 0;
     virtual void do_write_plic_girqsrvd(uint64_t val) = 0;
     virtual void do_replace_memory_range(const memory_range_config &new_range) = 0;
+    virtual void do_clear_memory_range(uint64_t start, uint64_t length) = 0;
     virtual uint64_t do_read_word(uint64_t address) const = 0;
     virtual bool do_verify_dirty_page_maps(void) const = 0;
     virtual machine_config do_get_initial_config(void) const = 0;
@@ -798,6 +864,11 @@ private:
     virtual access_log do_log_uarch_reset(const access_log::type &log_type, bool one_based = false) = 0;
     virtual uarch_interpreter_break_reason do_run_uarch(uint64_t uarch_cycle_end) = 0;
     virtual machine_memory_range_descrs do_get_memory_ranges(void) const = 0;
+    virtual periodic_root_hashes do_get_periodic_root_hashes(void) = 0;
+    virtual machine_profile do_get_profile(void) const = 0;
+    virtual rollup_input_results do_advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) = 0;
+    virtual rollup_input_result do_inspect_rollup(const unsigned char *query, uint64_t length,
+        uint64_t mcycle_end) = 0;
 };
 
 } // namespace cartesi
@@ -0,0 +1,263 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef INSN_ID_H
+#define INSN_ID_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// \file
+/// \brief Identifiers of the instructions executed by the interpreter.
+
+namespace cartesi {
+
+/// \brief Instruction identifiers, in the order their implementations appear in the interpreter
+enum class insn_id : uint16_t {
+    LR_W,
+    SC_W,
+    AMOSWAP_W,
+    AMOADD_W,
+    AMOXOR_W,
+    AMOAND_W,
+    AMOOR_W,
+    AMOMIN_W,
+    AMOMAX_W,
+    AMOMINU_W,
+    AMOMAXU_W,
+    LR_D,
+    SC_D,
+    AMOSWAP_D,
+    AMOADD_D,
+    AMOXOR_D,
+    AMOAND_D,
+    AMOOR_D,
+    AMOMIN_D,
+    AMOMAX_D,
+    AMOMINU_D,
+    AMOMAXU_D,
+    ADDW,
+    SUBW,
+    SLLW,
+    SRLW,
+    SRAW,
+    MULW,
+    DIVW,
+    DIVUW,
+    REMW,
+    REMUW,
+    CSRRW,
+    CSRRWI,
+    CSRRS,
+    CSRRC,
+    CSRRSI,
+    CSRRCI,
+    ECALL,
+    EBREAK,
+    SRET,
+    MRET,
+    WFI,
+    FENCE,
+    FENCE_I,
+    ADD,
+    SUB,
+    SLL,
+    SLT,
+    SLTU,
+    XOR,
+    SRL,
+    SRA,
+    OR,
+    AND,
+    MUL,
+    MULH,
+    MULHSU,
+    MULHU,
+    DIV,
+    DIVU,
+    REM,
+    REMU,
+    SRLI,
+    SRAI,
+    ADDI,
+    SLTI,
+    SLTIU,
+    XORI,
+    ORI,
+    ANDI,
+    SLLI,
+    ADDIW,
+    SLLIW,
+    SRLIW,
+    SRAIW,
+    SB,
+    SH,
+    SW,
+    SD,
+    LB,
+    LH,
+    LW,
+    LD,
+    LBU,
+    LHU,
+    LWU,
+    BEQ,
+    BNE,
+    BLT,
+    BGE,
+    BLTU,
+    BGEU,
+    LUI,
+    AUIPC,
+    JAL,
+    JALR,
+    SFENCE_VMA,
+    FSW,
+    FSD,
+    FLW,
+    FLD,
+    FMADD_S,
+    FMADD_D,
+    FMSUB_S,
+    FMSUB_D,
+    FNMADD_S,
+    FNMADD_D,
+    FNMSUB_S,
+    FNMSUB_D,
+    FADD_S,
+    FADD_D,
+    FSUB_S,
+    FSUB_D,
+    FMUL_S,
+    FMUL_D,
+    FDIV_S,
+    FDIV_D,
+    FSGNJ_S,
+    FSGNJN_S,
+    FSGNJX_S,
+    FSGNJ_D,
+    FSGNJN_D,
+    FSGNJX_D,
+    FMIN_S,
+    FMAX_S,
+    FMIN_D,
+    FMAX_D,
+    FCVT_S_D,
+    FCVT_D_S,
+    FSQRT_S,
+    FSQRT_D,
+    FLE_S,
+    FLT_S,
+    FEQ_S,
+    FLE_D,
+    FLT_D,
+    FEQ_D,
+    FCVT_W_S,
+    FCVT_WU_S,
+    FCVT_L_S,
+    FCVT_LU_S,
+    FCVT_W_D,
+    FCVT_WU_D,
+    FCVT_L_D,
+    FCVT_LU_D,
+    FCVT_S_W,
+    FCVT_S_WU,
+    FCVT_S_L,
+    FCVT_S_LU,
+    FCVT_D_W,
+    FCVT_D_WU,
+    FCVT_D_L,
+    FCVT_D_LU,
+    FMV_W_X,
+    FMV_D_X,
+    FCLASS_S,
+    FMV_X_W,
+    FCLASS_D,
+    FMV_X_D,
+    C_ADDI4SPN,
+    C_FLD,
+    C_LW,
+    C_LD,
+    C_FSD,
+    C_SW,
+    C_SD,
+    C_NOP,
+    C_ADDI,
+    C_ADDIW,
+    C_LI,
+    C_ADDI16SP,
+    C_LUI,
+    C_SRLI,
+    C_SRAI,
+    C_ANDI,
+    C_SUB,
+    C_XOR,
+    C_OR,
+    C_AND,
+    C_SUBW,
+    C_ADDW,
+    C_J,
+    C_BEQZ,
+    C_BNEZ,
+    C_SLLI,
+    C_FLDSP,
+    C_LWSP,
+    C_LDSP,
+    C_JR,
+    C_MV,
+    C_EBREAK,
+    C_JALR,
+    C_ADD,
+    C_FSDSP,
+    C_SWSP,
+    C_SDSP,
+};
+
+/// \brief Number of instruction identifiers
+constexpr size_t INSN_ID_COUNT = static_cast<size_t>(insn_id::C_SDSP) + 1;
+
+/// \brief Returns the mnemonic of an instruction
+/// \param id Instruction identifier.
+/// \returns Pointer to null-terminated mnemonic.
+static inline const char *insn_id_name(insn_id id) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+    static constexpr const char *names[] = {
+        "lr.w", "sc.w", "amoswap.w", "amoadd.w", "amoxor.w", "amoand.w", "amoor.w", "amomin.w", "amomax.w", "amominu.w",
+        "amomaxu.w", "lr.d", "sc.d", "amoswap.d", "amoadd.d", "amoxor.d", "amoand.d", "amoor.d", "amomin.d", "amomax.d",
+        "amominu.d", "amomaxu.d", "addw", "subw", "sllw", "srlw", "sraw", "mulw", "divw", "divuw", "remw", "remuw",
+        "csrrw", "csrrwi", "csrrs", "csrrc", "csrrsi", "csrrci", "ecall", "ebreak", "sret", "mret", "wfi", "fence",
+        "fence.i", "add", "sub", "sll", "slt", "sltu", "xor", "srl", "sra", "or", "and", "mul", "mulh", "mulhsu",
+        "mulhu", "div", "divu", "rem", "remu", "srli", "srai", "addi", "slti", "sltiu", "xori", "ori", "andi", "slli",
+        "addiw", "slliw", "srliw", "sraiw", "sb", "sh", "sw", "sd", "lb", "lh", "lw", "ld", "lbu", "lhu", "lwu", "beq",
+        "bne", "blt", "bge", "bltu", "bgeu", "lui", "auipc", "jal", "jalr", "sfence.vma", "fsw", "fsd", "flw", "fld",
+        "fmadd.s", "fmadd.d", "fmsub.s", "fmsub.d", "fnmadd.s", "fnmadd.d", "fnmsub.s", "fnmsub.d", "fadd.s", "fadd.d",
+        "fsub.s", "fsub.d", "fmul.s", "fmul.d", "fdiv.s", "fdiv.d", "fsgnj.s", "fsgnjn.s", "fsgnjx.s", "fsgnj.d",
+        "fsgnjn.d", "fsgnjx.d", "fmin.s", "fmax.s", "fmin.d", "fmax.d", "fcvt.s.d", "fcvt.d.s", "fsqrt.s", "fsqrt.d",
+        "fle.s", "flt.s", "feq.s", "fle.d", "flt.d", "feq.d", "fcvt.w.s", "fcvt.wu.s", "fcvt.l.s", "fcvt.lu.s",
+        "fcvt.w.d", "fcvt.wu.d", "fcvt.l.d", "fcvt.lu.d", "fcvt.s.w", "fcvt.s.wu", "fcvt.s.l", "fcvt.s.lu", "fcvt.d.w",
+        "fcvt.d.wu", "fcvt.d.l", "fcvt.d.lu", "fmv.w.x", "fmv.d.x", "fclass.s", "fmv.x.w", "fclass.d", "fmv.x.d",
+        "c.addi4spn", "c.fld", "c.lw", "c.ld", "c.fsd", "c.sw", "c.sd", "c.nop", "c.addi", "c.addiw", "c.li",
+        "c.addi16sp", "c.lui", "c.srli", "c.srai", "c.andi", "c.sub", "c.xor", "c.or", "c.and", "c.subw", "c.addw",
+        "c.j", "c.beqz", "c.bnez", "c.slli", "c.fldsp", "c.lwsp", "c.ldsp", "c.jr", "c.mv", "c.ebreak", "c.jalr",
+        "c.add", "c.fsdsp", "c.swsp", "c.sdsp",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == INSN_ID_COUNT, "instruction names out of sync");
+    return names[static_cast<size_t>(id)];
+}
+
+} // namespace cartesi
+
+#endif
@@ -23,6 +23,7 @@
 #else
 #include "state-access.h"
 #endif
+#include "insn-id.h"
 #include "machine-statistics.h"
 
 /// \file
@@ -96,6 +97,7 @@
 #include "meta.h"
 #include "riscv-constants.h"
 #include "rtc.h"
+#include "host-float.h"
 #include "soft-float.h"
 #include "strict-aliasing.h"
 #include "translate-virtual-address.h"
@@ -521,6 +523,20 @@ static inline uint64_t raise_interrupt_if_any(STATE_ACCESS &a, uint64_t pc) {
     return pc;
 }
 
+/// \brief Returns the status of an instruction that changed the CSRs controlling which interrupts are taken
+/// \param a Machine state accessor object.
+/// \returns execute_status::success_and_serve_interrupts when an interrupt is now ready to be raised,
+///  so the inner interpreter loop breaks to serve it, otherwise execute_status::success.
+/// \details When no interrupt is ready, none can become ready until mip, mie, mideleg or mstatus change again,
+///  so there is nothing for the outer loop to do. Guests toggle these often while masking interrupts.
+template <typename STATE_ACCESS>
+static inline execute_status serve_interrupts_if_pending(STATE_ACCESS &a) {
+    if (unlikely(get_pending_irq_mask(a) != 0)) {
+        return execute_status::success_and_serve_interrupts;
+    }
+    return execute_status::success;
+}
+
 /// \brief At every tick, set interrupt as pending if the timer is expired
 /// \param a Machine state accessor object.
 /// \param mcycle Machine current cycle.
@@ -947,10 +963,9 @@ static FORCE_INLINE execute_status write_virtual_memory(STATE_ACCESS &a, uint64_
 }
 
 template <typename STATE_ACCESS>
-static void dump_insn(STATE_ACCESS &a, uint64_t pc, uint32_t insn, const char *name) {
-#ifdef DUMP_HIST
-    a.get_naked_state().insn_hist[name]++;
-#endif
+static FORCE_INLINE void dump_insn(STATE_ACCESS &a, uint64_t pc, uint32_t insn, insn_id id) {
+    // Does nothing unless profiling is enabled
+    a.count_insn(id);
 #ifdef DUMP_REGS
     dump_regs(a.get_naked_state());
 #endif
@@ -967,12 +982,10 @@ static void dump_insn(STATE_ACCESS &a, uint64_t pc, uint32_t insn, const char *n
         fprintf(stderr, "p    %08" PRIx64, ppc);
     }
     fprintf(stderr, ":   %08" PRIx32 "   ", insn);
-    fprintf(stderr, "%s\n", name);
+    fprintf(stderr, "%s\n", insn_id_name(id));
 #else
-    (void) a;
     (void) pc;
     (void) insn;
-    (void) name;
 #endif
 }
 
@@ -1101,14 +1114,14 @@ static FORCE_INLINE execute_status execute_LR_W(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & 0b00000001111100000000000000000000) != 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "lr.w");
+    dump_insn(a, pc, insn, insn_id::LR_W);
     return execute_LR<int32_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the SC.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SC_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sc.w");
+    dump_insn(a, pc, insn, insn_id::SC_W);
     return execute_SC<int32_t>(a, pc, mcycle, insn);
 }
 
@@ -1139,7 +1152,7 @@ static FORCE_INLINE execute_status execute_AMO(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the AMOSWAP.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOSWAP_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoswap.w");
+    dump_insn(a, pc, insn, insn_id::AMOSWAP_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         (void) valm;
         return valr;
@@ -1149,7 +1162,7 @@ static FORCE_INLINE execute_status execute_AMOSWAP_W(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the AMOADD.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOADD_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoadd.w");
+    dump_insn(a, pc, insn, insn_id::AMOADD_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         int32_t val = 0;
         __builtin_add_overflow(valm, valr, &val);
@@ -1159,28 +1172,28 @@ static FORCE_INLINE execute_status execute_AMOADD_W(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOXOR_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoxor.w");
+    dump_insn(a, pc, insn, insn_id::AMOXOR_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t { return valm ^ valr; });
 }
 
 /// \brief Implementation of the AMOAND.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOAND_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoand.w");
+    dump_insn(a, pc, insn, insn_id::AMOAND_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t { return valm & valr; });
 }
 
 /// \brief Implementation of the AMOOR.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOOR_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoor.w");
+    dump_insn(a, pc, insn, insn_id::AMOOR_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t { return valm | valr; });
 }
 
 /// \brief Implementation of the AMOMIN.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMIN_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomin.w");
+    dump_insn(a, pc, insn, insn_id::AMOMIN_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         if (valm < valr) {
             return valm;
@@ -1193,7 +1206,7 @@ static FORCE_INLINE execute_status execute_AMOMIN_W(STATE_ACCESS &a, uint64_t &p
 /// \brief Implementation of the AMOMAX.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMAX_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomax.w");
+    dump_insn(a, pc, insn, insn_id::AMOMAX_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         if (valm > valr) {
             return valm;
@@ -1206,7 +1219,7 @@ static FORCE_INLINE execute_status execute_AMOMAX_W(STATE_ACCESS &a, uint64_t &p
 /// \brief Implementation of the AMOMINU.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMINU_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amominu.w");
+    dump_insn(a, pc, insn, insn_id::AMOMINU_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         if (static_cast<uint32_t>(valm) < static_cast<uint32_t>(valr)) {
             return valm;
@@ -1219,7 +1232,7 @@ static FORCE_INLINE execute_status execute_AMOMINU_W(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the AMOMAXU.W instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMAXU_W(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomaxu.w");
+    dump_insn(a, pc, insn, insn_id::AMOMAXU_W);
     return execute_AMO<int32_t>(a, pc, mcycle, insn, [](int32_t valm, int32_t valr) -> int32_t {
         if (static_cast<uint32_t>(valm) > static_cast<uint32_t>(valr)) {
             return valm;
@@ -1235,21 +1248,21 @@ static FORCE_INLINE execute_status execute_LR_D(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & 0b00000001111100000000000000000000) != 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "lr.d");
+    dump_insn(a, pc, insn, insn_id::LR_D);
     return execute_LR<uint64_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the SC.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SC_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sc.d");
+    dump_insn(a, pc, insn, insn_id::SC_D);
     return execute_SC<uint64_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the AMOSWAP.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOSWAP_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoswap.d");
+    dump_insn(a, pc, insn, insn_id::AMOSWAP_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t {
         (void) valm;
         return valr;
@@ -1259,7 +1272,7 @@ static FORCE_INLINE execute_status execute_AMOSWAP_D(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the AMOADD.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOADD_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoadd.d");
+    dump_insn(a, pc, insn, insn_id::AMOADD_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t {
         int64_t val = 0;
         __builtin_add_overflow(valm, valr, &val);
@@ -1269,28 +1282,28 @@ static FORCE_INLINE execute_status execute_AMOADD_D(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOXOR_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoxor.d");
+    dump_insn(a, pc, insn, insn_id::AMOXOR_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t { return valm ^ valr; });
 }
 
 /// \brief Implementation of the AMOAND.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOAND_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoand.d");
+    dump_insn(a, pc, insn, insn_id::AMOAND_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t { return valm & valr; });
 }
 
 /// \brief Implementation of the AMOOR.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOOR_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amoor.d");
+    dump_insn(a, pc, insn, insn_id::AMOOR_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t { return valm | valr; });
 }
 
 /// \brief Implementation of the AMOMIN.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMIN_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomin.d");
+    dump_insn(a, pc, insn, insn_id::AMOMIN_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t {
         if (valm < valr) {
             return valm;
@@ -1303,7 +1316,7 @@ static FORCE_INLINE execute_status execute_AMOMIN_D(STATE_ACCESS &a, uint64_t &p
 /// \brief Implementation of the AMOMAX.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMAX_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomax.d");
+    dump_insn(a, pc, insn, insn_id::AMOMAX_D);
     return execute_AMO<int64_t>(a, pc, mcycle, insn, [](int64_t valm, int64_t valr) -> int64_t {
         if (valm > valr) {
             return valm;
@@ -1316,7 +1329,7 @@ static FORCE_INLINE execute_status execute_AMOMAX_D(STATE_ACCESS &a, uint64_t &p
 /// \brief Implementation of the AMOMINU.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMINU_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amominu.d");
+    dump_insn(a, pc, insn, insn_id::AMOMINU_D);
     return execute_AMO<uint64_t>(a, pc, mcycle, insn, [](uint64_t valm, uint64_t valr) -> uint64_t {
         if (valm < valr) {
             return valm;
@@ -1329,7 +1342,7 @@ static FORCE_INLINE execute_status execute_AMOMINU_D(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the AMOMAXU.D instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AMOMAXU_D(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "amomaxu.d");
+    dump_insn(a, pc, insn, insn_id::AMOMAXU_D);
     return execute_AMO<uint64_t>(a, pc, mcycle, insn, [](uint64_t valm, uint64_t valr) -> uint64_t {
         if (valm > valr) {
             return valm;
@@ -1342,7 +1355,7 @@ static FORCE_INLINE execute_status execute_AMOMAXU_D(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the ADDW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ADDW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "addw");
+    dump_insn(a, pc, insn, insn_id::ADDW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         // Discard upper 32 bits
         auto rs1w = static_cast<int32_t>(rs1);
@@ -1356,7 +1369,7 @@ static FORCE_INLINE execute_status execute_ADDW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SUBW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SUBW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "subw");
+    dump_insn(a, pc, insn, insn_id::SUBW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         // Convert 64-bit to 32-bit
         auto rs1w = static_cast<int32_t>(rs1);
@@ -1373,7 +1386,7 @@ static FORCE_INLINE execute_status execute_SLLW(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & 0b11111110000000000111000001111111) != 0b00000000000000000001000000111011)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "sllw");
+    dump_insn(a, pc, insn, insn_id::SLLW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         const int32_t rs1w = static_cast<int32_t>(static_cast<uint32_t>(rs1) << (rs2 & 31));
         return static_cast<uint64_t>(rs1w);
@@ -1383,7 +1396,7 @@ static FORCE_INLINE execute_status execute_SLLW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SRLW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRLW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "srlw");
+    dump_insn(a, pc, insn, insn_id::SRLW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<int32_t>(static_cast<uint32_t>(rs1) >> (rs2 & 31));
         return static_cast<uint64_t>(rs1w);
@@ -1393,7 +1406,7 @@ static FORCE_INLINE execute_status execute_SRLW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SRAW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRAW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sraw");
+    dump_insn(a, pc, insn, insn_id::SRAW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         const int32_t rs1w = static_cast<int32_t>(rs1) >> (rs2 & 31);
         return static_cast<uint64_t>(rs1w);
@@ -1403,7 +1416,7 @@ static FORCE_INLINE execute_status execute_SRAW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the MULW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MULW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mulw");
+    dump_insn(a, pc, insn, insn_id::MULW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<int32_t>(rs1);
         auto rs2w = static_cast<int32_t>(rs2);
@@ -1419,7 +1432,7 @@ static FORCE_INLINE execute_status execute_DIVW(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & 0b11111110000000000111000001111111) != 0b00000010000000000100000000111011)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "divw");
+    dump_insn(a, pc, insn, insn_id::DIVW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<int32_t>(rs1);
         auto rs2w = static_cast<int32_t>(rs2);
@@ -1436,7 +1449,7 @@ static FORCE_INLINE execute_status execute_DIVW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the DIVUW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_DIVUW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "divuw");
+    dump_insn(a, pc, insn, insn_id::DIVUW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<uint32_t>(rs1);
         auto rs2w = static_cast<uint32_t>(rs2);
@@ -1454,7 +1467,7 @@ static FORCE_INLINE execute_status execute_REMW(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & 0b11111110000000000111000001111111) != 0b00000010000000000110000000111011)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "remw");
+    dump_insn(a, pc, insn, insn_id::REMW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<int32_t>(rs1);
         auto rs2w = static_cast<int32_t>(rs2);
@@ -1477,7 +1490,7 @@ static FORCE_INLINE execute_status execute_REMUW(STATE_ACCESS &a, uint64_t &pc,
     (void) a;
     (void) pc;
     (void) insn;
-    dump_insn(a, pc, insn, "remuw");
+    dump_insn(a, pc, insn, insn_id::REMUW);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto rs1w = static_cast<uint32_t>(rs1);
         auto rs2w = static_cast<uint32_t>(rs2);
@@ -1913,7 +1926,7 @@ static execute_status write_csr_sie(STATE_ACCESS &a, uint64_t val) {
     const uint64_t mask = a.read_mideleg();
     mie = (mie & ~mask) | (val & mask);
     a.write_mie(mie);
-    return execute_status::success_and_serve_interrupts;
+    return serve_interrupts_if_pending(a);
 }
 
 template <typename STATE_ACCESS>
@@ -1958,7 +1971,7 @@ static execute_status write_csr_sip(STATE_ACCESS &a, uint64_t val) {
     uint64_t mip = a.read_mip();
     mip = (mip & ~mask) | (val & mask);
     a.write_mip(mip);
-    return execute_status::success_and_serve_interrupts;
+    return serve_interrupts_if_pending(a);
 }
 
 template <typename STATE_ACCESS>
@@ -2078,10 +2091,16 @@ static execute_status write_csr_mstatus(STATE_ACCESS &a, uint64_t val) {
     }
 
     // When changing an interrupt enabled bit, we may have to service any pending interrupt
-    if ((mod & (MSTATUS_SIE_MASK | MSTATUS_MIE_MASK)) != 0) {
+    if ((mod & (MSTATUS_SIE_MASK | MSTATUS_MIE_MASK)) != 0 &&
+        serve_interrupts_if_pending(a) == execute_status::success_and_serve_interrupts) {
         return execute_status::success_and_serve_interrupts;
     }
 
+    // When enabling or disabling the floating-point state, the interpreter loop may have to switch variants
+    if ((mod & MSTATUS_FS_MASK) != 0) {
+        return execute_status::success_and_flush_fetch;
+    }
+
     return execute_status::success;
 }
 
@@ -2110,7 +2129,7 @@ static execute_status write_csr_mideleg(STATE_ACCESS &a, uint64_t val) {
     uint64_t mideleg = a.read_mideleg();
     mideleg = (mideleg & ~mask) | (val & mask);
     a.write_mideleg(mideleg);
-    return execute_status::success_and_serve_interrupts;
+    return serve_interrupts_if_pending(a);
 }
 
 template <typename STATE_ACCESS>
@@ -2119,7 +2138,7 @@ static execute_status write_csr_mie(STATE_ACCESS &a, uint64_t val) {
     uint64_t mie = a.read_mie();
     mie = (mie & ~mask) | (val & mask);
     a.write_mie(mie);
-    return execute_status::success_and_serve_interrupts;
+    return serve_interrupts_if_pending(a);
 }
 
 template <typename STATE_ACCESS>
@@ -2186,7 +2205,7 @@ static execute_status write_csr_mip(STATE_ACCESS &a, uint64_t val) {
     auto mip = a.read_mip();
     mip = (mip & ~mask) | (val & mask);
     a.write_mip(mip);
-    return execute_status::success_and_serve_interrupts;
+    return serve_interrupts_if_pending(a);
 }
 
 template <typename STATE_ACCESS>
@@ -2420,7 +2439,7 @@ static FORCE_INLINE execute_status execute_csr_RW(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the CSRRW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrw");
+    dump_insn(a, pc, insn, insn_id::CSRRW);
     return execute_csr_RW(a, pc, mcycle, insn,
         [](STATE_ACCESS &a, uint32_t insn) -> uint64_t { return a.read_x(insn_get_rs1(insn)); });
 }
@@ -2428,7 +2447,7 @@ static FORCE_INLINE execute_status execute_CSRRW(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the CSRRWI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRWI(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrwi");
+    dump_insn(a, pc, insn, insn_id::CSRRWI);
     return execute_csr_RW(a, pc, mcycle, insn,
         [](STATE_ACCESS &, uint32_t insn) -> uint64_t { return static_cast<uint64_t>(insn_get_rs1(insn)); });
 }
@@ -2470,14 +2489,14 @@ static FORCE_INLINE execute_status execute_csr_SC(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the CSRRS instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRS(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrs");
+    dump_insn(a, pc, insn, insn_id::CSRRS);
     return execute_csr_SC(a, pc, mcycle, insn, [](uint64_t csr, uint64_t rs1) -> uint64_t { return csr | rs1; });
 }
 
 /// \brief Implementation of the CSRRC instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRC(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrc");
+    dump_insn(a, pc, insn, insn_id::CSRRC);
     return execute_csr_SC(a, pc, mcycle, insn, [](uint64_t csr, uint64_t rs1) -> uint64_t { return csr & ~rs1; });
 }
 
@@ -2515,21 +2534,21 @@ static FORCE_INLINE execute_status execute_csr_SCI(STATE_ACCESS &a, uint64_t &pc
 /// \brief Implementation of the CSRRSI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRSI(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrsi");
+    dump_insn(a, pc, insn, insn_id::CSRRSI);
     return execute_csr_SCI(a, pc, mcycle, insn, [](uint64_t csr, uint32_t rs1) -> uint64_t { return csr | rs1; });
 }
 
 /// \brief Implementation of the CSRRCI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_CSRRCI(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "csrrci");
+    dump_insn(a, pc, insn, insn_id::CSRRCI);
     return execute_csr_SCI(a, pc, mcycle, insn, [](uint64_t csr, uint32_t rs1) -> uint64_t { return csr & ~rs1; });
 }
 
 /// \brief Implementation of the ECALL instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ECALL(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "ecall");
+    dump_insn(a, pc, insn, insn_id::ECALL);
     auto priv = a.read_iflags_PRV();
     pc = raise_exception(a, pc, MCAUSE_ECALL_BASE + priv, 0);
     return execute_status::failure;
@@ -2539,7 +2558,7 @@ static FORCE_INLINE execute_status execute_ECALL(STATE_ACCESS &a, uint64_t &pc,
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_EBREAK(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
     (void) a;
-    dump_insn(a, pc, insn, "ebreak");
+    dump_insn(a, pc, insn, insn_id::EBREAK);
     pc = raise_exception(a, pc, MCAUSE_BREAKPOINT, pc);
     return execute_status::failure;
 }
@@ -2547,7 +2566,7 @@ static FORCE_INLINE execute_status execute_EBREAK(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the SRET instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRET(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sret");
+    dump_insn(a, pc, insn, insn_id::SRET);
     auto priv = a.read_iflags_PRV();
     uint64_t mstatus = a.read_mstatus();
     if (unlikely(priv < PRV_S || (priv == PRV_S && (mstatus & MSTATUS_TSR_MASK)))) {
@@ -2577,7 +2596,7 @@ static FORCE_INLINE execute_status execute_SRET(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the MRET instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MRET(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mret");
+    dump_insn(a, pc, insn, insn_id::MRET);
     auto priv = a.read_iflags_PRV();
     if (unlikely(priv < PRV_M)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -2608,8 +2627,9 @@ static FORCE_INLINE execute_status execute_MRET(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the WFI instruction.
 /// \details This function is outlined to minimize host CPU code cache pressure.
 template <typename STATE_ACCESS>
-static FORCE_INLINE execute_status execute_WFI(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "wfi");
+static FORCE_INLINE execute_status execute_WFI(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle, uint64_t mcycle_end,
+    uint32_t insn) {
+    dump_insn(a, pc, insn, insn_id::WFI);
     // Check privileges and do nothing else
     auto priv = a.read_iflags_PRV();
     const uint64_t mstatus = a.read_mstatus();
@@ -2621,6 +2641,25 @@ static FORCE_INLINE execute_status execute_WFI(STATE_ACCESS &a, uint64_t &pc, ui
     const uint64_t mcycle_max = rtc_time_to_cycle(a.read_clint_mtimecmp());
     execute_status status = execute_status::success;
     if (mcycle_max > mcycle) {
+        // With idle fast-forward in reproducible mode, the timer is the only interrupt that can wake the hart,
+        // so when no interrupt is locally enabled and pending, the hart stalls at the WFI until then.
+        // Stalling leaves pc at the WFI, so each idle mcycle produces the same state as executing the WFI
+        // once more, which is exactly what happens when the interpreter advances a single mcycle at a time
+        // (e.g. in the microarchitecture). All idle mcycles up to mcycle_end are skipped at once.
+        if (a.read_iflags_I() && !a.read_iunrep() && (a.read_mip() & a.read_mie()) == 0) {
+            // The WFI retires in the last mcycle before the timer interrupt becomes pending, so the
+            // interrupt is taken with mepc pointing to the instruction that follows it
+            const bool wakes_up = mcycle_end >= mcycle_max;
+            // The interpreter loop increments mcycle once more after we return
+            const uint64_t mcycle_idle_end = std::min(mcycle_max, mcycle_end) - 1;
+            // Idle mcycles retire no instructions
+            a.write_icycleinstret(a.read_icycleinstret() + (mcycle_idle_end - mcycle) + (wakes_up ? 0 : 1));
+            mcycle = mcycle_idle_end;
+            if (wakes_up) {
+                return advance_to_next_insn(a, pc);
+            }
+            return execute_status::success;
+        }
         // Poll for external interrupts (e.g console or network),
         // this may advance mcycle only when interactive mode is enabled
         const auto [next_mcycle, interrupted] = a.poll_external_interrupts(mcycle, mcycle_max);
@@ -2637,7 +2676,7 @@ template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FENCE(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
     (void) insn;
     INC_COUNTER(a.get_statistics(), fence);
-    dump_insn(a, pc, insn, "fence");
+    dump_insn(a, pc, insn, insn_id::FENCE);
     // Really do nothing
     return advance_to_next_insn(a, pc);
 }
@@ -2647,7 +2686,7 @@ template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FENCE_I(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
     (void) insn;
     INC_COUNTER(a.get_statistics(), fence_i);
-    dump_insn(a, pc, insn, "fence.i");
+    dump_insn(a, pc, insn, insn_id::FENCE_I);
     // Really do nothing
     return advance_to_next_insn(a, pc);
 }
@@ -2670,7 +2709,7 @@ static FORCE_INLINE execute_status execute_arithmetic(STATE_ACCESS &a, uint64_t
 /// \brief Implementation of the ADD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ADD(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "add");
+    dump_insn(a, pc, insn, insn_id::ADD);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         uint64_t val = 0;
         __builtin_add_overflow(rs1, rs2, &val);
@@ -2681,7 +2720,7 @@ static FORCE_INLINE execute_status execute_ADD(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the SUB instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SUB(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sub");
+    dump_insn(a, pc, insn, insn_id::SUB);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         uint64_t val = 0;
         __builtin_sub_overflow(rs1, rs2, &val);
@@ -2692,7 +2731,7 @@ static FORCE_INLINE execute_status execute_SUB(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the SLL instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SLL(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sll");
+    dump_insn(a, pc, insn, insn_id::SLL);
     return execute_arithmetic(a, pc, insn,
         [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 << (rs2 & (XLEN - 1)); });
 }
@@ -2700,7 +2739,7 @@ static FORCE_INLINE execute_status execute_SLL(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the SLT instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SLT(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "slt");
+    dump_insn(a, pc, insn, insn_id::SLT);
     return execute_arithmetic(a, pc, insn,
         [](uint64_t rs1, uint64_t rs2) -> uint64_t { return static_cast<int64_t>(rs1) < static_cast<int64_t>(rs2); });
 }
@@ -2708,21 +2747,21 @@ static FORCE_INLINE execute_status execute_SLT(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the SLTU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SLTU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sltu");
+    dump_insn(a, pc, insn, insn_id::SLTU);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 < rs2; });
 }
 
 /// \brief Implementation of the XOR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_XOR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "xor");
+    dump_insn(a, pc, insn, insn_id::XOR);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 ^ rs2; });
 }
 
 /// \brief Implementation of the SRL instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRL(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "srl");
+    dump_insn(a, pc, insn, insn_id::SRL);
     return execute_arithmetic(a, pc, insn,
         [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 >> (rs2 & (XLEN - 1)); });
 }
@@ -2730,7 +2769,7 @@ static FORCE_INLINE execute_status execute_SRL(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the SRA instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRA(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sra");
+    dump_insn(a, pc, insn, insn_id::SRA);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         return static_cast<uint64_t>(static_cast<int64_t>(rs1) >> (rs2 & (XLEN - 1)));
     });
@@ -2739,21 +2778,21 @@ static FORCE_INLINE execute_status execute_SRA(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the OR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_OR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "or");
+    dump_insn(a, pc, insn, insn_id::OR);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 | rs2; });
 }
 
 /// \brief Implementation of the AND instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AND(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "and");
+    dump_insn(a, pc, insn, insn_id::AND);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t { return rs1 & rs2; });
 }
 
 /// \brief Implementation of the MUL instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MUL(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mul");
+    dump_insn(a, pc, insn, insn_id::MUL);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto srs1 = static_cast<int64_t>(rs1);
         auto srs2 = static_cast<int64_t>(rs2);
@@ -2766,7 +2805,7 @@ static FORCE_INLINE execute_status execute_MUL(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the MULH instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MULH(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mulh");
+    dump_insn(a, pc, insn, insn_id::MULH);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto srs1 = static_cast<int64_t>(rs1);
         auto srs2 = static_cast<int64_t>(rs2);
@@ -2778,7 +2817,7 @@ static FORCE_INLINE execute_status execute_MULH(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the MULHSU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MULHSU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mulhsu");
+    dump_insn(a, pc, insn, insn_id::MULHSU);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto srs1 = static_cast<int64_t>(rs1);
         return static_cast<uint64_t>(
@@ -2789,7 +2828,7 @@ static FORCE_INLINE execute_status execute_MULHSU(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the MULHU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_MULHU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "mulhu");
+    dump_insn(a, pc, insn, insn_id::MULHU);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         return static_cast<uint64_t>((static_cast<uint128_t>(rs1) * static_cast<uint128_t>(rs2)) >> 64);
     });
@@ -2798,7 +2837,7 @@ static FORCE_INLINE execute_status execute_MULHU(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the DIV instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_DIV(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "div");
+    dump_insn(a, pc, insn, insn_id::DIV);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto srs1 = static_cast<int64_t>(rs1);
         auto srs2 = static_cast<int64_t>(rs2);
@@ -2815,7 +2854,7 @@ static FORCE_INLINE execute_status execute_DIV(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the DIVU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_DIVU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "divu");
+    dump_insn(a, pc, insn, insn_id::DIVU);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         if (unlikely(rs2 == 0)) {
             return static_cast<uint64_t>(-1);
@@ -2828,7 +2867,7 @@ static FORCE_INLINE execute_status execute_DIVU(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the REM instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_REM(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "rem");
+    dump_insn(a, pc, insn, insn_id::REM);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         auto srs1 = static_cast<int64_t>(rs1);
         auto srs2 = static_cast<int64_t>(rs2);
@@ -2845,7 +2884,7 @@ static FORCE_INLINE execute_status execute_REM(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the REMU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_REMU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "remu");
+    dump_insn(a, pc, insn, insn_id::REMU);
     return execute_arithmetic(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> uint64_t {
         if (unlikely(rs2 == 0)) {
             return rs1;
@@ -2871,7 +2910,7 @@ static FORCE_INLINE execute_status execute_arithmetic_immediate(STATE_ACCESS &a,
 /// \brief Implementation of the SRLI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRLI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "srli");
+    dump_insn(a, pc, insn, insn_id::SRLI);
     return execute_arithmetic_immediate(a, pc, insn,
         [](uint64_t rs1, int32_t imm) -> uint64_t { return rs1 >> (imm & (XLEN - 1)); });
 }
@@ -2879,7 +2918,7 @@ static FORCE_INLINE execute_status execute_SRLI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SRAI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRAI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "srai");
+    dump_insn(a, pc, insn, insn_id::SRAI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         return static_cast<uint64_t>(static_cast<int64_t>(rs1) >> (imm & (XLEN - 1)));
     });
@@ -2888,7 +2927,7 @@ static FORCE_INLINE execute_status execute_SRAI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the ADDI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ADDI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "addi");
+    dump_insn(a, pc, insn, insn_id::ADDI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         int64_t val = 0;
         __builtin_add_overflow(static_cast<int64_t>(rs1), static_cast<int64_t>(imm), &val);
@@ -2899,7 +2938,7 @@ static FORCE_INLINE execute_status execute_ADDI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SLTI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SLTI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "slti");
+    dump_insn(a, pc, insn, insn_id::SLTI);
     return execute_arithmetic_immediate(a, pc, insn,
         [](uint64_t rs1, int32_t imm) -> uint64_t { return static_cast<int64_t>(rs1) < static_cast<int64_t>(imm); });
 }
@@ -2907,7 +2946,7 @@ static FORCE_INLINE execute_status execute_SLTI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the SLTIU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SLTIU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sltiu");
+    dump_insn(a, pc, insn, insn_id::SLTIU);
     return execute_arithmetic_immediate(a, pc, insn,
         [](uint64_t rs1, int32_t imm) -> uint64_t { return rs1 < static_cast<uint64_t>(imm); });
 }
@@ -2915,21 +2954,21 @@ static FORCE_INLINE execute_status execute_SLTIU(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the XORI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_XORI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "xori");
+    dump_insn(a, pc, insn, insn_id::XORI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t { return rs1 ^ imm; });
 }
 
 /// \brief Implementation of the ORI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ORI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "ori");
+    dump_insn(a, pc, insn, insn_id::ORI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t { return rs1 | imm; });
 }
 
 /// \brief Implementation of the ANDI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ANDI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "andi");
+    dump_insn(a, pc, insn, insn_id::ANDI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t { return rs1 & imm; });
 }
 
@@ -2939,7 +2978,7 @@ static FORCE_INLINE execute_status execute_SLLI(STATE_ACCESS &a, uint64_t &pc, u
     if (unlikely((insn & (0b111111 << 26)) != 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "slli");
+    dump_insn(a, pc, insn, insn_id::SLLI);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         // No need to mask lower 6 bits in imm because of the if condition a above
         // We do it anyway here to prevent problems if this code is moved
@@ -2950,7 +2989,7 @@ static FORCE_INLINE execute_status execute_SLLI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the ADDIW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_ADDIW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "addiw");
+    dump_insn(a, pc, insn, insn_id::ADDIW);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         int32_t val = 0;
         __builtin_add_overflow(static_cast<int32_t>(rs1), imm, &val);
@@ -2964,7 +3003,7 @@ static FORCE_INLINE execute_status execute_SLLIW(STATE_ACCESS &a, uint64_t &pc,
     if (unlikely(insn_get_funct7(insn) != 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "slliw");
+    dump_insn(a, pc, insn, insn_id::SLLIW);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         // No need to mask lower 5 bits in imm because of the if condition a above
         // We do it anyway here to prevent problems if this code is moved
@@ -2976,7 +3015,7 @@ static FORCE_INLINE execute_status execute_SLLIW(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the SRLIW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRLIW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "srliw");
+    dump_insn(a, pc, insn, insn_id::SRLIW);
     return execute_arithmetic_immediate(a, pc, insn, [](uint64_t rs1, int32_t imm) -> uint64_t {
         // No need to mask lower 5 bits in imm because of funct7 test in caller
         // We do it anyway here to prevent problems if this code is moved
@@ -2988,7 +3027,7 @@ static FORCE_INLINE execute_status execute_SRLIW(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the SRAIW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SRAIW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "sraiw");
+    dump_insn(a, pc, insn, insn_id::SRAIW);
     // When rd=0 the instruction is a HINT, and we consider it as a soft yield when rs1 == 31
     if (unlikely(insn_get_rd(insn) == 0 && insn_get_rs1(insn) == 31 && a.get_soft_yield())) {
         // Force the main interpreter loop to break
@@ -3015,28 +3054,28 @@ static FORCE_INLINE execute_status execute_S(STATE_ACCESS &a, uint64_t &pc, uint
 /// \brief Implementation of the SB instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SB(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sb");
+    dump_insn(a, pc, insn, insn_id::SB);
     return execute_S<uint8_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the SH instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SH(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sh");
+    dump_insn(a, pc, insn, insn_id::SH);
     return execute_S<uint16_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the SW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sw");
+    dump_insn(a, pc, insn, insn_id::SW);
     return execute_S<uint32_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the SD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_SD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "sd");
+    dump_insn(a, pc, insn, insn_id::SD);
     return execute_S<uint64_t>(a, pc, mcycle, insn);
 }
 
@@ -3065,49 +3104,49 @@ static FORCE_INLINE execute_status execute_L(STATE_ACCESS &a, uint64_t &pc, uint
 /// \brief Implementation of the LB instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LB(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lb");
+    dump_insn(a, pc, insn, insn_id::LB);
     return execute_L<int8_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LH instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LH(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lh");
+    dump_insn(a, pc, insn, insn_id::LH);
     return execute_L<int16_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lw");
+    dump_insn(a, pc, insn, insn_id::LW);
     return execute_L<int32_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "ld");
+    dump_insn(a, pc, insn, insn_id::LD);
     return execute_L<int64_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LBU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LBU(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lbu");
+    dump_insn(a, pc, insn, insn_id::LBU);
     return execute_L<uint8_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LHU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LHU(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lhu");
+    dump_insn(a, pc, insn, insn_id::LHU);
     return execute_L<uint16_t>(a, pc, mcycle, insn);
 }
 
 /// \brief Implementation of the LWU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LWU(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "lwu");
+    dump_insn(a, pc, insn, insn_id::LWU);
     return execute_L<uint32_t>(a, pc, mcycle, insn);
 }
 
@@ -3125,21 +3164,21 @@ static FORCE_INLINE execute_status execute_branch(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the BEQ instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BEQ(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "beq");
+    dump_insn(a, pc, insn, insn_id::BEQ);
     return execute_branch(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> bool { return rs1 == rs2; });
 }
 
 /// \brief Implementation of the BNE instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BNE(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "bne");
+    dump_insn(a, pc, insn, insn_id::BNE);
     return execute_branch(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> bool { return rs1 != rs2; });
 }
 
 /// \brief Implementation of the BLT instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BLT(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "blt");
+    dump_insn(a, pc, insn, insn_id::BLT);
     return execute_branch(a, pc, insn,
         [](uint64_t rs1, uint64_t rs2) -> bool { return static_cast<int64_t>(rs1) < static_cast<int64_t>(rs2); });
 }
@@ -3147,7 +3186,7 @@ static FORCE_INLINE execute_status execute_BLT(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the BGE instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BGE(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "bge");
+    dump_insn(a, pc, insn, insn_id::BGE);
     return execute_branch(a, pc, insn,
         [](uint64_t rs1, uint64_t rs2) -> bool { return static_cast<int64_t>(rs1) >= static_cast<int64_t>(rs2); });
 }
@@ -3155,21 +3194,21 @@ static FORCE_INLINE execute_status execute_BGE(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the BLTU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BLTU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "bltu");
+    dump_insn(a, pc, insn, insn_id::BLTU);
     return execute_branch(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> bool { return rs1 < rs2; });
 }
 
 /// \brief Implementation of the BGEU instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_BGEU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "bgeu");
+    dump_insn(a, pc, insn, insn_id::BGEU);
     return execute_branch(a, pc, insn, [](uint64_t rs1, uint64_t rs2) -> bool { return rs1 >= rs2; });
 }
 
 /// \brief Implementation of the LUI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_LUI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "lui");
+    dump_insn(a, pc, insn, insn_id::LUI);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return advance_to_next_insn(a, pc);
@@ -3181,7 +3220,7 @@ static FORCE_INLINE execute_status execute_LUI(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the AUIPC instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_AUIPC(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "auipc");
+    dump_insn(a, pc, insn, insn_id::AUIPC);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return advance_to_next_insn(a, pc);
@@ -3193,7 +3232,7 @@ static FORCE_INLINE execute_status execute_AUIPC(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the JAL instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_JAL(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "jal");
+    dump_insn(a, pc, insn, insn_id::JAL);
     const uint64_t new_pc = pc + insn_J_get_imm(insn);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
@@ -3206,7 +3245,7 @@ static FORCE_INLINE execute_status execute_JAL(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the JALR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_JALR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "jalr");
+    dump_insn(a, pc, insn, insn_id::JALR);
     const uint64_t val = pc + 4;
     const uint64_t new_pc =
         static_cast<int64_t>(a.read_x(insn_get_rs1(insn)) + insn_I_get_imm(insn)) & ~static_cast<uint64_t>(1);
@@ -3227,7 +3266,7 @@ static FORCE_INLINE execute_status execute_SFENCE_VMA(STATE_ACCESS &a, uint64_t
         return raise_illegal_insn_exception(a, pc, insn);
     }
     INC_COUNTER(a.get_statistics(), fence_vma);
-    dump_insn(a, pc, insn, "sfence.vma");
+    dump_insn(a, pc, insn, insn_id::SFENCE_VMA);
     auto priv = a.read_iflags_PRV();
     const uint64_t mstatus = a.read_mstatus();
 
@@ -3482,7 +3521,8 @@ static FORCE_INLINE execute_status execute_SRLW_DIVUW_SRAW(STATE_ACCESS &a, uint
 }
 
 template <typename STATE_ACCESS>
-static FORCE_INLINE execute_status execute_privileged(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle, uint32_t insn) {
+static FORCE_INLINE execute_status execute_privileged(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle,
+    uint64_t mcycle_end, uint32_t insn) {
     switch (static_cast<insn_privileged>(insn)) {
         case insn_privileged::ECALL:
             return execute_ECALL(a, pc, insn);
@@ -3493,7 +3533,7 @@ static FORCE_INLINE execute_status execute_privileged(STATE_ACCESS &a, uint64_t
         case insn_privileged::MRET:
             return execute_MRET(a, pc, insn);
         case insn_privileged::WFI:
-            return execute_WFI(a, pc, mcycle, insn);
+            return execute_WFI(a, pc, mcycle, mcycle_end, insn);
         default:
             return execute_SFENCE_VMA(a, pc, insn);
     }
@@ -3623,13 +3663,13 @@ static FORCE_INLINE execute_status execute_FS(STATE_ACCESS &a, uint64_t &pc, uin
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsw");
+    dump_insn(a, pc, insn, insn_id::FSW);
     return execute_FS<uint32_t>(a, pc, mcycle, insn);
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsd");
+    dump_insn(a, pc, insn, insn_id::FSD);
     return execute_FS<uint64_t>(a, pc, mcycle, insn);
 }
 
@@ -3651,31 +3691,31 @@ static FORCE_INLINE execute_status execute_FL(STATE_ACCESS &a, uint64_t &pc, uin
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "flw");
+    dump_insn(a, pc, insn, insn_id::FLW);
     return execute_FL<uint32_t>(a, pc, mcycle, insn);
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "fld");
+    dump_insn(a, pc, insn, insn_id::FLD);
     return execute_FL<uint64_t>(a, pc, mcycle, insn);
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMADD_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmadd.s");
+    dump_insn(a, pc, insn, insn_id::FMADD_S);
     return execute_float_ternary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t s3, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::fma(s1, s2, s3, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::fma(s1, s2, s3, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMADD_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmadd.d");
+    dump_insn(a, pc, insn, insn_id::FMADD_D);
     return execute_float_ternary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint64_t s3, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::fma(s1, s2, s3, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::fma(s1, s2, s3, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
@@ -3693,19 +3733,19 @@ static FORCE_INLINE execute_status execute_FMADD(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMSUB_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmsub.s");
+    dump_insn(a, pc, insn, insn_id::FMSUB_S);
     return execute_float_ternary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t s3, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::fma(s1, s2, s3 ^ i_sfloat32::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::fma(s1, s2, s3 ^ i_sfloat32::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMSUB_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmsub.d");
+    dump_insn(a, pc, insn, insn_id::FMSUB_D);
     return execute_float_ternary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint64_t s3, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::fma(s1, s2, s3 ^ i_sfloat64::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::fma(s1, s2, s3 ^ i_sfloat64::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
@@ -3723,20 +3763,20 @@ static FORCE_INLINE execute_status execute_FMSUB(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FNMADD_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fnmadd.s");
+    dump_insn(a, pc, insn, insn_id::FNMADD_S);
     return execute_float_ternary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t s3, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::fma(s1 ^ i_sfloat32::SIGN_MASK, s2, s3 ^ i_sfloat32::SIGN_MASK,
+            return i_hfloat32::fma(s1 ^ i_sfloat32::SIGN_MASK, s2, s3 ^ i_sfloat32::SIGN_MASK,
                 static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FNMADD_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fnmadd.d");
+    dump_insn(a, pc, insn, insn_id::FNMADD_D);
     return execute_float_ternary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint64_t s3, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::fma(s1 ^ i_sfloat64::SIGN_MASK, s2, s3 ^ i_sfloat64::SIGN_MASK,
+            return i_hfloat64::fma(s1 ^ i_sfloat64::SIGN_MASK, s2, s3 ^ i_sfloat64::SIGN_MASK,
                 static_cast<FRM_modes>(rm), fflags);
         });
 }
@@ -3755,19 +3795,19 @@ static FORCE_INLINE execute_status execute_FNMADD(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FNMSUB_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fnmsub.s");
+    dump_insn(a, pc, insn, insn_id::FNMSUB_S);
     return execute_float_ternary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t s3, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::fma(s1 ^ i_sfloat32::SIGN_MASK, s2, s3, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::fma(s1 ^ i_sfloat32::SIGN_MASK, s2, s3, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FNMSUB_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fnmsub.d");
+    dump_insn(a, pc, insn, insn_id::FNMSUB_D);
     return execute_float_ternary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint64_t s3, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::fma(s1 ^ i_sfloat64::SIGN_MASK, s2, s3, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::fma(s1 ^ i_sfloat64::SIGN_MASK, s2, s3, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
@@ -3785,73 +3825,73 @@ static FORCE_INLINE execute_status execute_FNMSUB(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FADD_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fadd.s");
+    dump_insn(a, pc, insn, insn_id::FADD_S);
     return execute_float_binary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::add(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::add(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FADD_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fadd.d");
+    dump_insn(a, pc, insn, insn_id::FADD_D);
     return execute_float_binary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::add(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::add(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSUB_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsub.s");
+    dump_insn(a, pc, insn, insn_id::FSUB_S);
     return execute_float_binary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::add(s1, s2 ^ i_sfloat32::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::add(s1, s2 ^ i_sfloat32::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSUB_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsub.d");
+    dump_insn(a, pc, insn, insn_id::FSUB_D);
     return execute_float_binary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::add(s1, s2 ^ i_sfloat64::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::add(s1, s2 ^ i_sfloat64::SIGN_MASK, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMUL_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmul.s");
+    dump_insn(a, pc, insn, insn_id::FMUL_S);
     return execute_float_binary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::mul(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::mul(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMUL_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmul.d");
+    dump_insn(a, pc, insn, insn_id::FMUL_D);
     return execute_float_binary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::mul(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::mul(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FDIV_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fdiv.s");
+    dump_insn(a, pc, insn, insn_id::FDIV_S);
     return execute_float_binary_op_rm<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t rm, uint32_t *fflags) -> uint32_t {
-            return i_sfloat32::div(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat32::div(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FDIV_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fdiv.d");
+    dump_insn(a, pc, insn, insn_id::FDIV_D);
     return execute_float_binary_op_rm<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t rm, uint32_t *fflags) -> uint64_t {
-            return i_sfloat64::div(s1, s2, static_cast<FRM_modes>(rm), fflags);
+            return i_hfloat64::div(s1, s2, static_cast<FRM_modes>(rm), fflags);
         });
 }
 
@@ -3901,7 +3941,7 @@ static FORCE_INLINE execute_status execute_float_cmp_op(STATE_ACCESS &a, uint64_
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJ_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnj.s");
+    dump_insn(a, pc, insn, insn_id::FSGNJ_S);
     return execute_float_binary_op<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, const uint32_t *fflags) -> uint32_t {
             (void) fflags;
@@ -3911,7 +3951,7 @@ static FORCE_INLINE execute_status execute_FSGNJ_S(STATE_ACCESS &a, uint64_t &pc
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJN_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnjn.s");
+    dump_insn(a, pc, insn, insn_id::FSGNJN_S);
     return execute_float_binary_op<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, const uint32_t *fflags) -> uint32_t {
             (void) fflags;
@@ -3921,7 +3961,7 @@ static FORCE_INLINE execute_status execute_FSGNJN_S(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJX_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnjx.s");
+    dump_insn(a, pc, insn, insn_id::FSGNJX_S);
     return execute_float_binary_op<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, const uint32_t *fflags) -> uint32_t {
             (void) fflags;
@@ -3945,7 +3985,7 @@ static FORCE_INLINE execute_status execute_FSGN_S(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJ_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnj.d");
+    dump_insn(a, pc, insn, insn_id::FSGNJ_D);
     return execute_float_binary_op<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, const uint32_t *fflags) -> uint64_t {
             (void) fflags;
@@ -3955,7 +3995,7 @@ static FORCE_INLINE execute_status execute_FSGNJ_D(STATE_ACCESS &a, uint64_t &pc
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJN_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnjn.d");
+    dump_insn(a, pc, insn, insn_id::FSGNJN_D);
     return execute_float_binary_op<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, const uint32_t *fflags) -> uint64_t {
             (void) fflags;
@@ -3965,7 +4005,7 @@ static FORCE_INLINE execute_status execute_FSGNJN_D(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSGNJX_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsgnjx.d");
+    dump_insn(a, pc, insn, insn_id::FSGNJX_D);
     return execute_float_binary_op<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, const uint32_t *fflags) -> uint64_t {
             (void) fflags;
@@ -3989,14 +4029,14 @@ static FORCE_INLINE execute_status execute_FSGN_D(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMIN_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmin.s");
+    dump_insn(a, pc, insn, insn_id::FMIN_S);
     return execute_float_binary_op<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t *fflags) -> uint32_t { return i_sfloat32::min(s1, s2, fflags); });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMAX_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmax.s");
+    dump_insn(a, pc, insn, insn_id::FMAX_S);
     return execute_float_binary_op<uint32_t>(a, pc, insn,
         [](uint32_t s1, uint32_t s2, uint32_t *fflags) -> uint32_t { return i_sfloat32::max(s1, s2, fflags); });
 }
@@ -4015,14 +4055,14 @@ static FORCE_INLINE execute_status execute_FMINMAX_S(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMIN_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmin.d");
+    dump_insn(a, pc, insn, insn_id::FMIN_D);
     return execute_float_binary_op<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t *fflags) -> uint64_t { return i_sfloat64::min(s1, s2, fflags); });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMAX_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmax.d");
+    dump_insn(a, pc, insn, insn_id::FMAX_D);
     return execute_float_binary_op<uint64_t>(a, pc, insn,
         [](uint64_t s1, uint64_t s2, uint32_t *fflags) -> uint64_t { return i_sfloat64::max(s1, s2, fflags); });
 }
@@ -4102,7 +4142,7 @@ static FORCE_INLINE execute_status execute_FCVT_F_X(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_S_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.s.d");
+    dump_insn(a, pc, insn, insn_id::FCVT_S_D);
     return execute_FCVT_F_F<uint64_t, uint32_t>(a, pc, insn,
         [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
             return sfloat_cvt_f64_f32(s1, static_cast<FRM_modes>(rm), fflags);
@@ -4111,7 +4151,7 @@ static FORCE_INLINE execute_status execute_FCVT_S_D(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_D_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.d.s");
+    dump_insn(a, pc, insn, insn_id::FCVT_D_S);
     return execute_FCVT_F_F<uint32_t, uint64_t>(a, pc, insn,
         [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
             // FCVT.D.S will never round, since it's a widen operation.
@@ -4122,23 +4162,23 @@ static FORCE_INLINE execute_status execute_FCVT_D_S(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSQRT_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsqrt.s");
+    dump_insn(a, pc, insn, insn_id::FSQRT_S);
     return execute_float_unary_op_rm<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
-        return i_sfloat32::sqrt(s1, static_cast<FRM_modes>(rm), fflags);
+        return i_hfloat32::sqrt(s1, static_cast<FRM_modes>(rm), fflags);
     });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FSQRT_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fsqrt.d");
+    dump_insn(a, pc, insn, insn_id::FSQRT_D);
     return execute_float_unary_op_rm<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
-        return i_sfloat64::sqrt(s1, static_cast<FRM_modes>(rm), fflags);
+        return i_hfloat64::sqrt(s1, static_cast<FRM_modes>(rm), fflags);
     });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLE_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fle.s");
+    dump_insn(a, pc, insn, insn_id::FLE_S);
     return execute_float_cmp_op<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat32::le(s1, s2, fflags));
     });
@@ -4146,7 +4186,7 @@ static FORCE_INLINE execute_status execute_FLE_S(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLT_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "flt.s");
+    dump_insn(a, pc, insn, insn_id::FLT_S);
     return execute_float_cmp_op<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat32::lt(s1, s2, fflags));
     });
@@ -4154,7 +4194,7 @@ static FORCE_INLINE execute_status execute_FLT_S(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FEQ_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "feq.s");
+    dump_insn(a, pc, insn, insn_id::FEQ_S);
     return execute_float_cmp_op<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat32::eq(s1, s2, fflags));
     });
@@ -4176,7 +4216,7 @@ static FORCE_INLINE execute_status execute_FCMP_S(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLE_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fle.d");
+    dump_insn(a, pc, insn, insn_id::FLE_D);
     return execute_float_cmp_op<uint64_t>(a, pc, insn, [](uint64_t s1, uint64_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat64::le(s1, s2, fflags));
     });
@@ -4184,7 +4224,7 @@ static FORCE_INLINE execute_status execute_FLE_D(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FLT_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "flt.d");
+    dump_insn(a, pc, insn, insn_id::FLT_D);
     return execute_float_cmp_op<uint64_t>(a, pc, insn, [](uint64_t s1, uint64_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat64::lt(s1, s2, fflags));
     });
@@ -4192,7 +4232,7 @@ static FORCE_INLINE execute_status execute_FLT_D(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FEQ_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "feq.d");
+    dump_insn(a, pc, insn, insn_id::FEQ_D);
     return execute_float_cmp_op<uint64_t>(a, pc, insn, [](uint64_t s1, uint64_t s2, uint32_t *fflags) -> uint64_t {
         return static_cast<uint64_t>(i_sfloat64::eq(s1, s2, fflags));
     });
@@ -4214,7 +4254,7 @@ static FORCE_INLINE execute_status execute_FCMP_D(STATE_ACCESS &a, uint64_t &pc,
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_W_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.w.s");
+    dump_insn(a, pc, insn, insn_id::FCVT_W_S);
     return execute_FCVT_X_F<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const int32_t val = i_sfloat32::cvt_f_i<int32_t>(s1, static_cast<FRM_modes>(rm), fflags);
         // For XLEN > 32, FCVT.W.S sign-extends the 32-bit result.
@@ -4224,7 +4264,7 @@ static FORCE_INLINE execute_status execute_FCVT_W_S(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_WU_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.wu.s");
+    dump_insn(a, pc, insn, insn_id::FCVT_WU_S);
     return execute_FCVT_X_F<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const uint32_t val = i_sfloat32::cvt_f_i<uint32_t>(s1, static_cast<FRM_modes>(rm), fflags);
         // For XLEN > 32, FCVT.WU.S sign-extends the 32-bit result.
@@ -4234,7 +4274,7 @@ static FORCE_INLINE execute_status execute_FCVT_WU_S(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_L_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.l.s");
+    dump_insn(a, pc, insn, insn_id::FCVT_L_S);
     return execute_FCVT_X_F<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const int64_t val = i_sfloat32::cvt_f_i<int64_t>(s1, static_cast<FRM_modes>(rm), fflags);
         return static_cast<uint64_t>(val);
@@ -4243,7 +4283,7 @@ static FORCE_INLINE execute_status execute_FCVT_L_S(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_LU_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.lu.s");
+    dump_insn(a, pc, insn, insn_id::FCVT_LU_S);
     return execute_FCVT_X_F<uint32_t>(a, pc, insn, [](uint32_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat32::cvt_f_i<uint64_t>(s1, static_cast<FRM_modes>(rm), fflags);
     });
@@ -4251,7 +4291,7 @@ static FORCE_INLINE execute_status execute_FCVT_LU_S(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_W_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.w.d");
+    dump_insn(a, pc, insn, insn_id::FCVT_W_D);
     return execute_FCVT_X_F<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const int32_t val = i_sfloat64::cvt_f_i<int32_t>(s1, static_cast<FRM_modes>(rm), fflags);
         // For RV64, FCVT.W.D sign-extends the 32-bit result.
@@ -4261,7 +4301,7 @@ static FORCE_INLINE execute_status execute_FCVT_W_D(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_WU_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.wu.d");
+    dump_insn(a, pc, insn, insn_id::FCVT_WU_D);
     return execute_FCVT_X_F<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const uint32_t val = i_sfloat64::cvt_f_i<uint32_t>(s1, static_cast<FRM_modes>(rm), fflags);
         // For RV64, FCVT.WU.D sign-extends the 32-bit result.
@@ -4271,7 +4311,7 @@ static FORCE_INLINE execute_status execute_FCVT_WU_D(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_L_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.l.d");
+    dump_insn(a, pc, insn, insn_id::FCVT_L_D);
     return execute_FCVT_X_F<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         const int64_t val = i_sfloat64::cvt_f_i<int64_t>(s1, static_cast<FRM_modes>(rm), fflags);
         return static_cast<uint64_t>(val);
@@ -4280,7 +4320,7 @@ static FORCE_INLINE execute_status execute_FCVT_L_D(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_LU_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.lu.d");
+    dump_insn(a, pc, insn, insn_id::FCVT_LU_D);
     return execute_FCVT_X_F<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat64::cvt_f_i<uint64_t>(s1, static_cast<FRM_modes>(rm), fflags);
     });
@@ -4288,7 +4328,7 @@ static FORCE_INLINE execute_status execute_FCVT_LU_D(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_S_W(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.s.w");
+    dump_insn(a, pc, insn, insn_id::FCVT_S_W);
     return execute_FCVT_F_X<uint32_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
         return i_sfloat32::cvt_i_f(static_cast<int32_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4296,7 +4336,7 @@ static FORCE_INLINE execute_status execute_FCVT_S_W(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_S_WU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.s.wu");
+    dump_insn(a, pc, insn, insn_id::FCVT_S_WU);
     return execute_FCVT_F_X<uint32_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
         return i_sfloat32::cvt_i_f(static_cast<uint32_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4304,7 +4344,7 @@ static FORCE_INLINE execute_status execute_FCVT_S_WU(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_S_L(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.s.l");
+    dump_insn(a, pc, insn, insn_id::FCVT_S_L);
     return execute_FCVT_F_X<uint32_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
         return i_sfloat32::cvt_i_f(static_cast<int64_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4312,7 +4352,7 @@ static FORCE_INLINE execute_status execute_FCVT_S_L(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_S_LU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.s.lu");
+    dump_insn(a, pc, insn, insn_id::FCVT_S_LU);
     return execute_FCVT_F_X<uint32_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint32_t {
         return i_sfloat32::cvt_i_f(s1, static_cast<FRM_modes>(rm), fflags);
     });
@@ -4320,7 +4360,7 @@ static FORCE_INLINE execute_status execute_FCVT_S_LU(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_D_W(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.d.w");
+    dump_insn(a, pc, insn, insn_id::FCVT_D_W);
     return execute_FCVT_F_X<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat64::cvt_i_f(static_cast<int32_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4328,7 +4368,7 @@ static FORCE_INLINE execute_status execute_FCVT_D_W(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_D_WU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.d.wu");
+    dump_insn(a, pc, insn, insn_id::FCVT_D_WU);
     return execute_FCVT_F_X<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat64::cvt_i_f(static_cast<uint32_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4336,7 +4376,7 @@ static FORCE_INLINE execute_status execute_FCVT_D_WU(STATE_ACCESS &a, uint64_t &
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_D_L(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.d.l");
+    dump_insn(a, pc, insn, insn_id::FCVT_D_L);
     return execute_FCVT_F_X<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat64::cvt_i_f(static_cast<int64_t>(s1), static_cast<FRM_modes>(rm), fflags);
     });
@@ -4344,7 +4384,7 @@ static FORCE_INLINE execute_status execute_FCVT_D_L(STATE_ACCESS &a, uint64_t &p
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCVT_D_LU(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fcvt.d.lu");
+    dump_insn(a, pc, insn, insn_id::FCVT_D_LU);
     return execute_FCVT_F_X<uint64_t>(a, pc, insn, [](uint64_t s1, uint32_t rm, uint32_t *fflags) -> uint64_t {
         return i_sfloat64::cvt_i_f(s1, static_cast<FRM_modes>(rm), fflags);
     });
@@ -4365,25 +4405,25 @@ static FORCE_INLINE execute_status execute_FMV_F_X(STATE_ACCESS &a, uint64_t &pc
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMV_W_X(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmv.w.x");
+    dump_insn(a, pc, insn, insn_id::FMV_W_X);
     return execute_FMV_F_X<uint32_t>(a, pc, insn);
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMV_D_X(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmv.d.x");
+    dump_insn(a, pc, insn, insn_id::FMV_D_X);
     return execute_FMV_F_X<uint64_t>(a, pc, insn);
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCLASS_S(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fclass.s");
+    dump_insn(a, pc, insn, insn_id::FCLASS_S);
     return execute_FCLASS<uint32_t>(a, pc, insn, [](uint32_t s1) -> uint64_t { return i_sfloat32::fclass(s1); });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMV_X_W(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmv.x.w");
+    dump_insn(a, pc, insn, insn_id::FMV_X_W);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return advance_to_next_insn(a, pc);
@@ -4410,13 +4450,13 @@ static FORCE_INLINE execute_status execute_FMV_FCLASS_S(STATE_ACCESS &a, uint64_
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FCLASS_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fclass.d");
+    dump_insn(a, pc, insn, insn_id::FCLASS_D);
     return execute_FCLASS<uint64_t>(a, pc, insn, [](uint64_t s1) -> uint64_t { return i_sfloat64::fclass(s1); });
 }
 
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_FMV_X_D(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "fmv.x.d");
+    dump_insn(a, pc, insn, insn_id::FMV_X_D);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return advance_to_next_insn(a, pc);
@@ -4595,7 +4635,7 @@ static FORCE_INLINE execute_status execute_C_ADDI4SPN(STATE_ACCESS &a, uint64_t
     if (unlikely(insn == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
-    dump_insn(a, pc, insn, "c.addi4spn");
+    dump_insn(a, pc, insn, insn_id::C_ADDI4SPN);
     // rd cannot be zero
     const uint32_t rd = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const uint32_t imm = insn_get_CIW_imm(insn);
@@ -4612,7 +4652,7 @@ static FORCE_INLINE execute_status execute_C_ADDI4SPN(STATE_ACCESS &a, uint64_t
 /// \brief Implementation of the C.FLD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_FLD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.fld");
+    dump_insn(a, pc, insn, insn_id::C_FLD);
     const uint32_t rd = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const int32_t imm = insn_get_CL_CS_imm(insn);
@@ -4622,7 +4662,7 @@ static FORCE_INLINE execute_status execute_C_FLD(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.LW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.lw");
+    dump_insn(a, pc, insn, insn_id::C_LW);
     const uint32_t rd = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const int32_t imm = insn_get_C_LW_C_SW_imm(insn);
@@ -4632,7 +4672,7 @@ static FORCE_INLINE execute_status execute_C_LW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.LD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.ld");
+    dump_insn(a, pc, insn, insn_id::C_LD);
     const uint32_t rd = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const int32_t imm = insn_get_CL_CS_imm(insn);
@@ -4642,7 +4682,7 @@ static FORCE_INLINE execute_status execute_C_LD(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.FSD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_FSD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.fsd");
+    dump_insn(a, pc, insn, insn_id::C_FSD);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const uint32_t rs2 = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const int32_t imm = insn_get_CL_CS_imm(insn);
@@ -4652,7 +4692,7 @@ static FORCE_INLINE execute_status execute_C_FSD(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.SW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SW(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.sw");
+    dump_insn(a, pc, insn, insn_id::C_SW);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const uint32_t rs2 = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const int32_t imm = insn_get_C_LW_C_SW_imm(insn);
@@ -4662,7 +4702,7 @@ static FORCE_INLINE execute_status execute_C_SW(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.SD instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SD(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.sd");
+    dump_insn(a, pc, insn, insn_id::C_SD);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const uint32_t rs2 = insn_get_CIW_CL_rd_CS_CA_rs2(insn);
     const int32_t imm = insn_get_CL_CS_imm(insn);
@@ -4673,7 +4713,7 @@ static FORCE_INLINE execute_status execute_C_SD(STATE_ACCESS &a, uint64_t &pc, u
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_NOP(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
     (void) insn;
-    dump_insn(a, pc, insn, "c.nop");
+    dump_insn(a, pc, insn, insn_id::C_NOP);
     // C.NOP with imm != 0 is just a HINT that must execute as no-op (see RISC-V spec)
     // Really do nothing
     return advance_to_next_insn<2>(a, pc);
@@ -4682,7 +4722,7 @@ static FORCE_INLINE execute_status execute_C_NOP(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.ADDI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ADDI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rd) {
-    dump_insn(a, pc, insn, "c.addi");
+    dump_insn(a, pc, insn, insn_id::C_ADDI);
     const int32_t imm = insn_get_CI_CB_imm_se(insn);
     // C.ADDI with imm == 0 is just a HINT that must execute as no-op (see RISC-V spec)
     if (unlikely(imm == 0)) {
@@ -4707,7 +4747,7 @@ static FORCE_INLINE execute_status execute_C_Q1_SET0(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the C.addiw instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ADDIW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.addiw");
+    dump_insn(a, pc, insn, insn_id::C_ADDIW);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -4723,7 +4763,7 @@ static FORCE_INLINE execute_status execute_C_ADDIW(STATE_ACCESS &a, uint64_t &pc
 /// \brief Implementation of the C.LI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.li");
+    dump_insn(a, pc, insn, insn_id::C_LI);
     const uint32_t rd = insn_get_rd(insn);
     // C.LI with rd == 0 is just a HINT that must execute as no-op (see RISC-V spec)
     if (unlikely(rd == 0)) {
@@ -4737,7 +4777,7 @@ static FORCE_INLINE execute_status execute_C_LI(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.ADDI16SP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ADDI16SP(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.addi16sp");
+    dump_insn(a, pc, insn, insn_id::C_ADDI16SP);
     const int32_t imm = insn_get_C_ADDI16SP_imm(insn);
     if (unlikely(imm == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -4752,7 +4792,7 @@ static FORCE_INLINE execute_status execute_C_ADDI16SP(STATE_ACCESS &a, uint64_t
 /// \brief Implementation of the C.LUI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LUI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rd) {
-    dump_insn(a, pc, insn, "c.lui");
+    dump_insn(a, pc, insn, insn_id::C_LUI);
     const int32_t imm = insn_get_C_LUI_imm(insn);
     if (unlikely(imm == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -4777,7 +4817,7 @@ static FORCE_INLINE execute_status execute_C_Q1_SET1(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the C.SRLI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SRLI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.srli");
+    dump_insn(a, pc, insn, insn_id::C_SRLI);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const uint32_t imm = insn_get_CI_CB_imm(insn);
     // C.SRLI with imm == 0 is just a HINT that must execute as no-op (see RISC-V spec)
@@ -4792,7 +4832,7 @@ static FORCE_INLINE execute_status execute_C_SRLI(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.SRAI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SRAI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.srai");
+    dump_insn(a, pc, insn, insn_id::C_SRAI);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const uint32_t imm = insn_get_CI_CB_imm(insn);
     // C.SRAI with imm == 0 is just a HINT that must execute as no-op (see RISC-V spec)
@@ -4807,7 +4847,7 @@ static FORCE_INLINE execute_status execute_C_SRAI(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.ANDI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ANDI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.andi");
+    dump_insn(a, pc, insn, insn_id::C_ANDI);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     const int32_t imm = insn_get_CI_CB_imm_se(insn);
     const uint64_t rs1_value = a.read_x(rs1);
@@ -4830,7 +4870,7 @@ static FORCE_INLINE execute_status execute_C_arithmetic(STATE_ACCESS &a, uint64_
 /// \brief Implementation of the C.SUB instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SUB(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.sub");
+    dump_insn(a, pc, insn, insn_id::C_SUB);
     return execute_C_arithmetic(a, pc, insn, [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t {
         uint64_t val = 0;
         __builtin_sub_overflow(rs1_value, rs2_value, &val);
@@ -4841,7 +4881,7 @@ static FORCE_INLINE execute_status execute_C_SUB(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.XOR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_XOR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.xor");
+    dump_insn(a, pc, insn, insn_id::C_XOR);
     return execute_C_arithmetic(a, pc, insn,
         [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t { return rs1_value ^ rs2_value; });
 }
@@ -4849,7 +4889,7 @@ static FORCE_INLINE execute_status execute_C_XOR(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.OR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_OR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.or");
+    dump_insn(a, pc, insn, insn_id::C_OR);
     return execute_C_arithmetic(a, pc, insn,
         [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t { return rs1_value | rs2_value; });
 }
@@ -4857,7 +4897,7 @@ static FORCE_INLINE execute_status execute_C_OR(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.AND instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_AND(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.and");
+    dump_insn(a, pc, insn, insn_id::C_AND);
     return execute_C_arithmetic(a, pc, insn,
         [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t { return rs1_value & rs2_value; });
 }
@@ -4865,7 +4905,7 @@ static FORCE_INLINE execute_status execute_C_AND(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.SUBW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SUBW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.subw");
+    dump_insn(a, pc, insn, insn_id::C_SUBW);
     return execute_C_arithmetic(a, pc, insn, [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t {
         // Convert 64-bit to 32-bit
         auto rs1w = static_cast<int32_t>(rs1_value);
@@ -4879,7 +4919,7 @@ static FORCE_INLINE execute_status execute_C_SUBW(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.ADDW instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ADDW(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.addw");
+    dump_insn(a, pc, insn, insn_id::C_ADDW);
     return execute_C_arithmetic(a, pc, insn, [](uint64_t rs1_value, uint64_t rs2_value) -> uint64_t {
         // Discard upper 32 bits
         auto rs1w = static_cast<int32_t>(rs1_value);
@@ -4929,7 +4969,7 @@ static FORCE_INLINE execute_status execute_C_Q1_SET2(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the C_J instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_J(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.j");
+    dump_insn(a, pc, insn, insn_id::C_J);
     const uint64_t new_pc = pc + static_cast<uint64_t>(insn_get_C_J_imm(insn));
     return execute_jump(a, pc, new_pc);
 }
@@ -4937,7 +4977,7 @@ static FORCE_INLINE execute_status execute_C_J(STATE_ACCESS &a, uint64_t &pc, ui
 /// \brief Implementation of the C.BEQZ instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_BEQZ(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.beqz");
+    dump_insn(a, pc, insn, insn_id::C_BEQZ);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     if (a.read_x(rs1) == 0) {
         const int32_t imm = insn_get_C_BEQZ_BNEZ_imm(insn);
@@ -4950,7 +4990,7 @@ static FORCE_INLINE execute_status execute_C_BEQZ(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.BNEZ instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_BNEZ(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.bnez");
+    dump_insn(a, pc, insn, insn_id::C_BNEZ);
     const uint32_t rs1 = insn_get_CL_CS_CA_CB_rs1(insn);
     if (a.read_x(rs1) != 0) {
         const int32_t imm = insn_get_C_BEQZ_BNEZ_imm(insn);
@@ -4963,7 +5003,7 @@ static FORCE_INLINE execute_status execute_C_BNEZ(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.SLLI instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SLLI(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.slli");
+    dump_insn(a, pc, insn, insn_id::C_SLLI);
     const uint32_t rd = insn_get_rd(insn);
     // C.SLLI with rd == 0 is just a HINT that must execute as no-op (see RISC-V spec)
     if (unlikely(rd == 0)) {
@@ -4982,7 +5022,7 @@ static FORCE_INLINE execute_status execute_C_SLLI(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.FLDSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_FLDSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.fldsp");
+    dump_insn(a, pc, insn, insn_id::C_FLDSP);
     const uint32_t rd = insn_get_rd(insn);
     const int32_t imm = insn_get_C_FLDSP_LDSP_imm(insn);
     return execute_C_FL<uint64_t>(a, pc, mcycle, rd, 0x2, imm);
@@ -4991,7 +5031,7 @@ static FORCE_INLINE execute_status execute_C_FLDSP(STATE_ACCESS &a, uint64_t &pc
 /// \brief Implementation of the C.LWSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LWSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.lwsp");
+    dump_insn(a, pc, insn, insn_id::C_LWSP);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -5003,7 +5043,7 @@ static FORCE_INLINE execute_status execute_C_LWSP(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.LDSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_LDSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.ldsp");
+    dump_insn(a, pc, insn, insn_id::C_LDSP);
     const uint32_t rd = insn_get_rd(insn);
     if (unlikely(rd == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
@@ -5015,7 +5055,7 @@ static FORCE_INLINE execute_status execute_C_LDSP(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.JR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_JR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rs1) {
-    dump_insn(a, pc, insn, "c.jr");
+    dump_insn(a, pc, insn, insn_id::C_JR);
     if (unlikely(rs1 == 0)) {
         return raise_illegal_insn_exception(a, pc, insn);
     }
@@ -5027,7 +5067,7 @@ static FORCE_INLINE execute_status execute_C_JR(STATE_ACCESS &a, uint64_t &pc, u
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_MV(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rd,
     uint32_t rs2) {
-    dump_insn(a, pc, insn, "c.mv");
+    dump_insn(a, pc, insn, insn_id::C_MV);
     // C.SLLI with rd == 0 is just a HINT that must execute as no-op (see RISC-V spec)
     if (unlikely(rd == 0)) {
         return advance_to_next_insn<2>(a, pc);
@@ -5040,7 +5080,7 @@ static FORCE_INLINE execute_status execute_C_MV(STATE_ACCESS &a, uint64_t &pc, u
 /// \brief Implementation of the C.EBREAK instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_EBREAK(STATE_ACCESS &a, uint64_t &pc, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.ebreak");
+    dump_insn(a, pc, insn, insn_id::C_EBREAK);
     pc = raise_exception(a, pc, MCAUSE_BREAKPOINT, pc);
     return advance_to_raised_exception(a, pc);
 }
@@ -5048,7 +5088,7 @@ static FORCE_INLINE execute_status execute_C_EBREAK(STATE_ACCESS &a, uint64_t &p
 /// \brief Implementation of the C.JALR instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_JALR(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rs1) {
-    dump_insn(a, pc, insn, "c.jalr");
+    dump_insn(a, pc, insn, insn_id::C_JALR);
     const uint64_t new_pc = a.read_x(rs1) & ~static_cast<uint64_t>(1);
     const uint64_t val = pc + 2;
     a.write_x(0x1, val);
@@ -5059,7 +5099,7 @@ static FORCE_INLINE execute_status execute_C_JALR(STATE_ACCESS &a, uint64_t &pc,
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_ADD(STATE_ACCESS &a, uint64_t &pc, uint32_t insn, uint32_t rd,
     uint32_t rs2) {
-    dump_insn(a, pc, insn, "c.add");
+    dump_insn(a, pc, insn, insn_id::C_ADD);
     // C.ADD with rd == 0 is just a HINT that must execute as no-op (see RISC-V spec)
     if (unlikely(rd == 0)) {
         return advance_to_next_insn<2>(a, pc);
@@ -5094,7 +5134,7 @@ static FORCE_INLINE execute_status execute_C_Q2_SET0(STATE_ACCESS &a, uint64_t &
 /// \brief Implementation of the C.FSDSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_FSDSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.fsdsp");
+    dump_insn(a, pc, insn, insn_id::C_FSDSP);
     const uint32_t rs2 = insn_get_CR_CSS_rs2(insn);
     const int32_t imm = insn_get_C_FSDSP_SDSP_imm(insn);
     return execute_C_FS<uint64_t>(a, pc, mcycle, rs2, 0x2, imm);
@@ -5103,7 +5143,7 @@ static FORCE_INLINE execute_status execute_C_FSDSP(STATE_ACCESS &a, uint64_t &pc
 /// \brief Implementation of the C.SWSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SWSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.swsp");
+    dump_insn(a, pc, insn, insn_id::C_SWSP);
     const uint32_t rs2 = insn_get_CR_CSS_rs2(insn);
     const int32_t imm = insn_get_C_SWSP_imm(insn);
     return execute_C_S<uint32_t>(a, pc, mcycle, rs2, 0x2, imm);
@@ -5112,16 +5152,255 @@ static FORCE_INLINE execute_status execute_C_SWSP(STATE_ACCESS &a, uint64_t &pc,
 /// \brief Implementation of the C.SDSP instruction.
 template <typename STATE_ACCESS>
 static FORCE_INLINE execute_status execute_C_SDSP(STATE_ACCESS &a, uint64_t &pc, uint64_t mcycle, uint32_t insn) {
-    dump_insn(a, pc, insn, "c.sdsp");
+    dump_insn(a, pc, insn, insn_id::C_SDSP);
     const uint32_t rs2 = insn_get_CR_CSS_rs2(insn);
     const int32_t imm = insn_get_C_FSDSP_SDSP_imm(insn);
     return execute_C_S<uint64_t>(a, pc, mcycle, rs2, 0x2, imm);
 }
 
+/// \brief State the interpreter loop shares with fused instruction handlers.
+struct fusion_context {
+    uint64_t mcycle_tick_end;  ///< Inner interpreter loop will stop when mcycle reaches this value
+    uint64_t fetch_vaddr_page; ///< Fetch virtual address translation page cache
+    uint64_t fetch_vh_offset;  ///< Fetch virtual address host pointer offset cache
+};
+
+/// \brief Peeks at the instruction that follows a fusion head.
+/// \param pc Virtual address of the instruction that follows the head, which already executed.
+/// \param mcycle Cycle in which the head retired.
+/// \param ctx Fusion context.
+/// \param insn Receives the instruction (2 additional bytes are read if it is compressed).
+/// \return True if the instruction can be executed in the same inner loop iteration as the head.
+/// \details This is the case when it retires before the inner loop ends, and when reading it hits the fetch
+///  translation cache without crossing a page boundary. Otherwise it must go through the regular fetch.
+static FORCE_INLINE bool fusion_peek(uint64_t pc, uint64_t mcycle, const fusion_context &ctx, uint32_t &insn) {
+#if defined(MICROARCHITECTURE) || defined(NO_INSN_FUSION)
+    // Fusion is disabled, or pointless in the microarchitecture, which interprets a single cycle at a time
+    (void) pc;
+    (void) mcycle;
+    (void) ctx;
+    (void) insn;
+    return false;
+#else
+    if (mcycle + 1 >= ctx.mcycle_tick_end || (pc & ~PAGE_OFFSET_MASK) != ctx.fetch_vaddr_page ||
+        (pc & PAGE_OFFSET_MASK) > PAGE_OFFSET_MASK - 3) {
+        return false;
+    }
+    insn = aliased_unaligned_read<uint32_t, uint16_t>(cast_addr_to_ptr<unsigned char *>(pc + ctx.fetch_vh_offset));
+    return true;
+#endif
+}
+
+/// \brief Executes LUI or AUIPC, fused with a following instruction that consumes its result.
+/// \details Covers the idioms that materialize addresses and constants: lui+addi(w), auipc+addi, auipc+jalr,
+///  and lui/auipc followed by a load or store based on the register just written.
+///  Each instruction still goes through its own handler and retires in its own cycle,
+///  but the second one skips the fetch, the decoder, and an iteration of the interpreter loop.
+template <typename STATE_ACCESS, typename HEAD>
+static FORCE_INLINE execute_status execute_fused_U(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle,
+    const fusion_context &ctx, uint32_t insn, const HEAD &head) {
+    // LUI and AUIPC never fail
+    head(a, pc, insn);
+    const uint32_t rd = insn_get_rd(insn);
+    uint32_t next = 0;
+    if (rd == 0 || !fusion_peek(pc, mcycle, ctx, next) || insn_get_rs1(next) != rd) {
+        return execute_status::success;
+    }
+    // Compressed instructions never match the opcodes below
+    switch (static_cast<insn_funct3_00000_opcode>(insn_get_funct3_00000_opcode(next))) {
+        case insn_funct3_00000_opcode::ADDI:
+            ++mcycle;
+            return execute_ADDI(a, pc, next);
+        case insn_funct3_00000_opcode::ADDIW:
+            ++mcycle;
+            return execute_ADDIW(a, pc, next);
+        case insn_funct3_00000_opcode::JALR:
+            ++mcycle;
+            return execute_JALR(a, pc, next);
+        case insn_funct3_00000_opcode::LB:
+            ++mcycle;
+            return execute_LB(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LH:
+            ++mcycle;
+            return execute_LH(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LW:
+            ++mcycle;
+            return execute_LW(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LD:
+            ++mcycle;
+            return execute_LD(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LBU:
+            ++mcycle;
+            return execute_LBU(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LHU:
+            ++mcycle;
+            return execute_LHU(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::LWU:
+            ++mcycle;
+            return execute_LWU(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::SB:
+            ++mcycle;
+            return execute_SB(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::SH:
+            ++mcycle;
+            return execute_SH(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::SW:
+            ++mcycle;
+            return execute_SW(a, pc, mcycle, next);
+        case insn_funct3_00000_opcode::SD:
+            ++mcycle;
+            return execute_SD(a, pc, mcycle, next);
+        default:
+            return execute_status::success;
+    }
+}
+
+/// \brief Executes a set-less-than instruction, fused with a following branch that tests its result against zero.
+/// \details Covers the compare-and-branch idioms slt(i)(u)+beqz/bnez, in both their regular and compressed forms.
+///  SLT and SLTU share their opcode and funct3 with MULHSU and MULHU, so the head is the decoder for both.
+///  It can therefore fail, and the multiplications can be fused just the same.
+template <typename STATE_ACCESS, typename HEAD>
+static FORCE_INLINE execute_status execute_fused_compare(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle,
+    const fusion_context &ctx, uint32_t insn, const HEAD &head) {
+    const execute_status status = head(a, pc, insn);
+    const uint32_t rd = insn_get_rd(insn);
+    uint32_t next = 0;
+    if (status != execute_status::success || rd == 0 || !fusion_peek(pc, mcycle, ctx, next)) {
+        return status;
+    }
+    if ((next & 3) == 3) {
+        // Either operand of the branch may be the zero register
+        const uint32_t rs1 = insn_get_rs1(next);
+        const uint32_t rs2 = insn_get_rs2(next);
+        if ((rs1 != rd || rs2 != 0) && (rs1 != 0 || rs2 != rd)) {
+            return execute_status::success;
+        }
+        switch (static_cast<insn_funct3_00000_opcode>(insn_get_funct3_00000_opcode(next))) {
+            case insn_funct3_00000_opcode::BEQ:
+                ++mcycle;
+                return execute_BEQ(a, pc, next);
+            case insn_funct3_00000_opcode::BNE:
+                ++mcycle;
+                return execute_BNE(a, pc, next);
+            default:
+                return execute_status::success;
+        }
+    }
+    next = static_cast<uint16_t>(next);
+    if (insn_get_CL_CS_CA_CB_rs1(next) != rd) {
+        return execute_status::success;
+    }
+    switch (static_cast<insn_c_funct3>(insn_get_c_funct3(next))) {
+        case insn_c_funct3::C_BEQZ:
+            ++mcycle;
+            return execute_C_BEQZ(a, pc, next);
+        case insn_c_funct3::C_BNEZ:
+            ++mcycle;
+            return execute_C_BNEZ(a, pc, next);
+        default:
+            return execute_status::success;
+    }
+}
+
+/// \brief Executes a chain of C.LI and C.ADDI instructions, optionally terminated by C.BEQZ or C.BNEZ.
+/// \details Such chains initialize and update counters and arguments, and the final branch closes counted loops.
+///  The chain is interrupted, as the inner interpreter loop would be, when it reaches mcycle_tick_end.
+template <typename STATE_ACCESS>
+static FORCE_INLINE execute_status execute_fused_C_LI_ADDI(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle,
+    const fusion_context &ctx, uint32_t insn) {
+    for (;;) {
+        // C.LI, C.ADDI and C.NOP never fail
+        if (static_cast<insn_c_funct3>(insn_get_c_funct3(insn)) == insn_c_funct3::C_LI) {
+            execute_C_LI(a, pc, insn);
+        } else {
+            execute_C_Q1_SET0(a, pc, insn);
+        }
+        uint32_t next = 0;
+        if (!fusion_peek(pc, mcycle, ctx, next)) {
+            return execute_status::success;
+        }
+        insn = static_cast<uint16_t>(next);
+        switch (static_cast<insn_c_funct3>(insn_get_c_funct3(insn))) {
+            case insn_c_funct3::C_LI:
+            case insn_c_funct3::C_Q1_SET0:
+                ++mcycle;
+                break;
+            case insn_c_funct3::C_BEQZ:
+                ++mcycle;
+                return execute_C_BEQZ(a, pc, insn);
+            case insn_c_funct3::C_BNEZ:
+                ++mcycle;
+                return execute_C_BNEZ(a, pc, insn);
+            default:
+                return execute_status::success;
+        }
+    }
+}
+
+/// \brief Interpreter loop variant flags
+/// \details The interpreter loop is instantiated once per combination of these flags. Each variant assumes state that
+///  can only change when an instruction returns a status above execute_status::success, or when an interrupt is
+///  raised. The loop checks the assumptions only at those points, and returns when they no longer hold, so the
+///  variant that matches the new state can take over.
+enum interpret_mode : int {
+    INTERPRET_MODE_DYNAMIC = 0,  ///< Nothing is assumed, all checks are performed at run time
+    INTERPRET_MODE_STATIC = 1,   ///< The flags below describe the state the variant runs in
+    INTERPRET_MODE_FS_ON = 2,    ///< Floating-point state is enabled (mstatus.FS is not Off)
+    INTERPRET_MODE_FETCH_VM = 4, ///< Instruction fetches are translated (S/U-mode with satp.MODE not Bare)
+};
+
+/// \brief Obtains the interpreter loop variant that matches current state.
+/// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \param a Machine state accessor object.
+/// \returns Combination of interpret_mode flags, always including INTERPRET_MODE_STATIC.
+template <typename STATE_ACCESS>
+static FORCE_INLINE int get_interpret_mode(STATE_ACCESS &a) {
+    int mode = INTERPRET_MODE_STATIC;
+    if ((a.read_mstatus() & MSTATUS_FS_MASK) != MSTATUS_FS_OFF) {
+        mode |= INTERPRET_MODE_FS_ON;
+    }
+    if (a.read_iflags_PRV() <= PRV_S && (a.read_satp() >> SATP_MODE_SHIFT) != SATP_MODE_BARE) {
+        mode |= INTERPRET_MODE_FETCH_VM;
+    }
+    return mode;
+}
+
+/// \brief Checks if the running interpreter loop variant still matches current state.
+/// \tparam MODE Combination of interpret_mode flags of the running variant.
+/// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \param a Machine state accessor object.
+template <int MODE, typename STATE_ACCESS>
+static FORCE_INLINE bool is_interpret_mode(STATE_ACCESS &a) {
+    if constexpr ((MODE & INTERPRET_MODE_STATIC) != 0) {
+        return get_interpret_mode(a) == MODE;
+    } else {
+        (void) a;
+        return true;
+    }
+}
+
+/// \brief Checks if floating-point state is disabled.
+/// \tparam MODE Combination of interpret_mode flags of the running variant.
+/// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \param a Machine state accessor object.
+template <int MODE, typename STATE_ACCESS>
+static FORCE_INLINE bool is_fs_off(STATE_ACCESS &a) {
+    if constexpr ((MODE & INTERPRET_MODE_STATIC) != 0) {
+        (void) a;
+        return (MODE & INTERPRET_MODE_FS_ON) == 0;
+    } else {
+        return (a.read_mstatus() & MSTATUS_FS_MASK) == MSTATUS_FS_OFF;
+    }
+}
+
 /// \brief Decodes and executes an instruction.
 /// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \tparam MODE Combination of interpret_mode flags of the running interpreter loop variant.
 /// \param a Machine state accessor object.
 /// \param pc Current pc.
+/// \param mcycle Current mcycle.
+/// \param mcycle_end Interpreter loop will stop when mcycle reaches this value.
+/// \param ctx Fusion context.
 /// \param insn Instruction.
 /// \return execute_status::failure if an exception was raised, or
 ///  execute_status::success otherwise.
@@ -5130,8 +5409,9 @@ static FORCE_INLINE execute_status execute_C_SDSP(STATE_ACCESS &a, uint64_t &pc,
 ///  See [RV32/64G Instruction Set
 ///  Listings](https://content.riscv.org/wp-content/uploads/2017/05/riscv-spec-v2.2.pdf#chapter.19) and [Instruction
 ///  listings for RISC-V](https://content.riscv.org/wp-content/uploads/2017/05/riscv-spec-v2.2.pdf#table.19.2).
-template <typename STATE_ACCESS>
-static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle, uint32_t insn) {
+template <typename STATE_ACCESS, int MODE>
+static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, uint64_t &mcycle, uint64_t mcycle_end,
+    const fusion_context &ctx, uint32_t insn) {
     // Is compressed instruction
     if ((insn & 3) != 3) {
         // The fetch may read 4 bytes as an optimization,
@@ -5150,11 +5430,11 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_c_funct3::C_SD:
                 return execute_C_SD(a, pc, mcycle, insn);
             case insn_c_funct3::C_Q1_SET0:
-                return execute_C_Q1_SET0(a, pc, insn);
+                return execute_fused_C_LI_ADDI(a, pc, mcycle, ctx, insn);
             case insn_c_funct3::C_ADDIW:
                 return execute_C_ADDIW(a, pc, insn);
             case insn_c_funct3::C_LI:
-                return execute_C_LI(a, pc, insn);
+                return execute_fused_C_LI_ADDI(a, pc, mcycle, ctx, insn);
             case insn_c_funct3::C_Q1_SET1:
                 return execute_C_Q1_SET1(a, pc, insn);
             case insn_c_funct3::C_Q1_SET2:
@@ -5184,7 +5464,7 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
                 // we can put the next check before all of them.
                 // If FS is OFF, attempts to read or write the float state will cause an illegal instruction
                 // exception.
-                if (unlikely((a.read_mstatus() & MSTATUS_FS_MASK) == MSTATUS_FS_OFF)) {
+                if (unlikely(is_fs_off<MODE>(a))) {
                     return raise_illegal_insn_exception(a, pc, insn);
                 }
                 switch (c_funct3) {
@@ -5237,9 +5517,11 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_funct3_00000_opcode::SLLI:
                 return execute_SLLI(a, pc, insn);
             case insn_funct3_00000_opcode::SLTI:
-                return execute_SLTI(a, pc, insn);
+                return execute_fused_compare(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_SLTI(a, pc, insn); });
             case insn_funct3_00000_opcode::SLTIU:
-                return execute_SLTIU(a, pc, insn);
+                return execute_fused_compare(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_SLTIU(a, pc, insn); });
             case insn_funct3_00000_opcode::XORI:
                 return execute_XORI(a, pc, insn);
             case insn_funct3_00000_opcode::ORI:
@@ -5292,7 +5574,8 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_funct3_00000_opcode::AUIPC_101:
             case insn_funct3_00000_opcode::AUIPC_110:
             case insn_funct3_00000_opcode::AUIPC_111:
-                return execute_AUIPC(a, pc, insn);
+                return execute_fused_U(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_AUIPC(a, pc, insn); });
             case insn_funct3_00000_opcode::LUI_000:
             case insn_funct3_00000_opcode::LUI_001:
             case insn_funct3_00000_opcode::LUI_010:
@@ -5301,7 +5584,8 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_funct3_00000_opcode::LUI_101:
             case insn_funct3_00000_opcode::LUI_110:
             case insn_funct3_00000_opcode::LUI_111:
-                return execute_LUI(a, pc, insn);
+                return execute_fused_U(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_LUI(a, pc, insn); });
             case insn_funct3_00000_opcode::JAL_000:
             case insn_funct3_00000_opcode::JAL_001:
             case insn_funct3_00000_opcode::JAL_010:
@@ -5324,9 +5608,11 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_funct3_00000_opcode::SLL_MULH:
                 return execute_SLL_MULH(a, pc, insn);
             case insn_funct3_00000_opcode::SLT_MULHSU:
-                return execute_SLT_MULHSU(a, pc, insn);
+                return execute_fused_compare(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_SLT_MULHSU(a, pc, insn); });
             case insn_funct3_00000_opcode::SLTU_MULHU:
-                return execute_SLTU_MULHU(a, pc, insn);
+                return execute_fused_compare(a, pc, mcycle, ctx, insn,
+                    [](STATE_ACCESS &a, uint64_t &pc, uint32_t insn) { return execute_SLTU_MULHU(a, pc, insn); });
             case insn_funct3_00000_opcode::XOR_DIV:
                 return execute_XOR_DIV(a, pc, insn);
             case insn_funct3_00000_opcode::SRL_DIVU_SRA:
@@ -5340,14 +5626,14 @@ static FORCE_INLINE execute_status execute_insn(STATE_ACCESS &a, uint64_t &pc, u
             case insn_funct3_00000_opcode::SRLW_DIVUW_SRAW:
                 return execute_SRLW_DIVUW_SRAW(a, pc, insn);
             case insn_funct3_00000_opcode::PRIVILEGED:
-                return execute_privileged(a, pc, mcycle, insn);
+                return execute_privileged(a, pc, mcycle, mcycle_end, insn);
             default: {
                 // Here we are sure that the next instruction, at best, can only be a floating point instruction,
                 // or, at worst, an illegal instruction.
                 // Since all float instructions try to read the float state,
                 // we can put the next check before all of them.
                 // If FS is OFF, attempts to read or write the float state will cause an illegal instruction exception.
-                if (unlikely((a.read_mstatus() & MSTATUS_FS_MASK) == MSTATUS_FS_OFF)) {
+                if (unlikely(is_fs_off<MODE>(a))) {
                     return raise_illegal_insn_exception(a, pc, insn);
                 }
                 switch (funct3_00000_opcode) {
@@ -5408,22 +5694,81 @@ enum class fetch_status : int {
     success    ///< Instruction fetch succeeded: proceed to execute
 };
 
+/// \brief Fetch translation cache constants.
+enum fetch_cache_constants : uint64_t {
+    FETCH_CACHE_SIZE = 16, ///< Number of entries in the fetch translation cache
+};
+
+static_assert((FETCH_CACHE_SIZE & (FETCH_CACHE_SIZE - 1)) == 0 && PMA_TLB_SIZE % FETCH_CACHE_SIZE == 0,
+    "code assumes fetch cache entries map to a subset of code TLB entries");
+
+/// \brief Fetch translation cache.
+/// \details Holds the translations of the last pages instructions were fetched from, indexed like the code TLB.
+///  Pages that share a fetch cache entry also share a code TLB entry, and the code TLB is only ever flushed as a
+///  whole, so an entry is valid exactly while the code TLB still holds it. This allows the cache to survive
+///  instructions that do not flush the code TLB, instead of being reset after every trap.
+using fetch_cache = std::array<tlb_hot_entry, FETCH_CACHE_SIZE>;
+
+/// \brief Gets a fetch translation cache entry index.
+/// \param vaddr Target virtual address.
+static inline uint64_t fetch_cache_get_entry_index(uint64_t vaddr) {
+    return tlb_get_entry_index(vaddr) & (FETCH_CACHE_SIZE - 1);
+}
+
+/// \brief Invalidates all fetch translation cache entries.
+/// \param fcache Fetch translation cache.
+/// \param fetch_vaddr_page Fetch virtual address translation page cache.
+static NO_INLINE void fetch_cache_flush(fetch_cache &fcache, uint64_t &fetch_vaddr_page) {
+    fetch_vaddr_page = PAGE_OFFSET_MASK;
+    for (auto &fce : fcache) {
+        fce.vaddr_page = TLB_INVALID_PAGE;
+    }
+}
+
+/// \brief Invalidates the fetch translation cache if the code TLB was flushed.
+/// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \param a Machine state accessor object.
+/// \param fcache Fetch translation cache.
+/// \param fetch_vaddr_page Fetch virtual address translation page cache.
+/// \details The page of the last fetch is always in the cache, and no code TLB entry can be replaced between the
+///  last fetch and this check. Therefore probing the code TLB for that page tells if it was flushed.
+template <typename STATE_ACCESS>
+static FORCE_INLINE void fetch_cache_revalidate(STATE_ACCESS &a, fetch_cache &fcache, uint64_t &fetch_vaddr_page) {
+#ifdef MICROARCHITECTURE
+    // The microarchitecture interprets a single cycle at a time, so probing the code TLB is not worth it
+    (void) a;
+    fetch_vaddr_page = PAGE_OFFSET_MASK;
+    (void) fcache;
+#else
+    unsigned char *hptr = nullptr;
+    if (likely(fetch_vaddr_page == PAGE_OFFSET_MASK ||
+            (a.template translate_vaddr_via_tlb<TLB_CODE, uint16_t>(fetch_vaddr_page, &hptr)))) {
+        return;
+    }
+    INC_COUNTER(a.get_statistics(), fcache_flush);
+    fetch_cache_flush(fcache, fetch_vaddr_page);
+#endif
+}
+
 /// \brief Translate fetch pc to a host pointer (slow path that goes through virtual address translation).
 /// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \tparam MODE Combination of interpret_mode flags of the running interpreter loop variant.
 /// \param a Machine state accessor object.
 /// \param pc Virtual address for the current instruction being executed.
 /// \param vaddr Virtual address to be fetched.
 /// \param phptr Receives host pointer.
 /// \return Returns fetch_status::success if load succeeded, fetch_status::exception if it caused an exception.
 //          In that case, raise the exception.
-template <typename STATE_ACCESS>
+template <typename STATE_ACCESS, int MODE>
 static FORCE_INLINE fetch_status fetch_translate_pc_slow(STATE_ACCESS &a, uint64_t &pc, uint64_t vaddr,
     unsigned char **phptr) {
-    uint64_t paddr{};
-    // Walk page table and obtain the physical address
-    if (unlikely(!translate_virtual_address(a, &paddr, vaddr, PTE_XWR_X_SHIFT))) {
-        pc = raise_exception(a, pc, MCAUSE_FETCH_PAGE_FAULT, vaddr);
-        return fetch_status::exception;
+    uint64_t paddr = vaddr;
+    // Walk page table and obtain the physical address, unless the variant knows fetches are not translated
+    if constexpr ((MODE & INTERPRET_MODE_STATIC) == 0 || (MODE & INTERPRET_MODE_FETCH_VM) != 0) {
+        if (unlikely(!translate_virtual_address(a, &paddr, vaddr, PTE_XWR_X_SHIFT))) {
+            pc = raise_exception(a, pc, MCAUSE_FETCH_PAGE_FAULT, vaddr);
+            return fetch_status::exception;
+        }
     }
     // Walk memory map to find the range that contains the physical address
     auto &pma = a.template find_pma_entry<uint16_t>(paddr);
@@ -5441,37 +5786,56 @@ static FORCE_INLINE fetch_status fetch_translate_pc_slow(STATE_ACCESS &a, uint64
 
 /// \brief Translate fetch pc to a host pointer.
 /// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \tparam MODE Combination of interpret_mode flags of the running interpreter loop variant.
 /// \param a Machine state accessor object.
+/// \param fcache Fetch translation cache.
 /// \param pc Virtual address for the current instruction being executed.
 /// \param vaddr Virtual address to be fetched.
 /// \param phptr Receives the host pointer.
 /// \return Returns fetch_status::success if load succeeded, fetch_status::exception if it caused an exception.
 //          In that case, raise the exception.
-template <typename STATE_ACCESS>
-static FORCE_INLINE fetch_status fetch_translate_pc(STATE_ACCESS &a, uint64_t &pc, uint64_t vaddr,
-    unsigned char **phptr) {
-    // Try to perform the address translation via TLB first
+template <typename STATE_ACCESS, int MODE>
+static FORCE_INLINE fetch_status fetch_translate_pc(STATE_ACCESS &a, fetch_cache &fcache, uint64_t &pc,
+    uint64_t vaddr, unsigned char **phptr) {
+    const uint64_t vaddr_page = vaddr & ~PAGE_OFFSET_MASK;
+    auto &fce = fcache[fetch_cache_get_entry_index(vaddr)];
+    // Try the fetch translation cache first, which hits only when the TLB would also hit
+    if (likely(fce.vaddr_page == vaddr_page)) {
+        INC_COUNTER(a.get_statistics(), fcache_hit);
+        *phptr = cast_addr_to_ptr<unsigned char *>(fce.vh_offset + vaddr);
+        return fetch_status::success;
+    }
+    INC_COUNTER(a.get_statistics(), fcache_miss);
+    // Then try to perform the address translation via TLB
     if (unlikely(!(a.template translate_vaddr_via_tlb<TLB_CODE, uint16_t>(vaddr, phptr)))) {
         INC_COUNTER(a.get_statistics(), tlb_cmiss);
         // Outline the slow path into a function call to minimize host CPU code cache pressure
-        return fetch_translate_pc_slow(a, pc, vaddr, phptr);
+        if (unlikely((fetch_translate_pc_slow<STATE_ACCESS, MODE>(a, pc, vaddr, phptr)) == fetch_status::exception)) {
+            return fetch_status::exception;
+        }
+    } else {
+        INC_COUNTER(a.get_statistics(), tlb_chit);
     }
-    INC_COUNTER(a.get_statistics(), tlb_chit);
+    // Update fetch translation cache
+    fce.vaddr_page = vaddr_page;
+    fce.vh_offset = cast_ptr_to_addr<uint64_t>(*phptr) - vaddr;
     return fetch_status::success;
 }
 
 /// \brief Loads the next instruction.
 /// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \tparam MODE Combination of interpret_mode flags of the running interpreter loop variant.
 /// \param a Machine state accessor object.
 /// \param pc Virtual address for the current instruction being executed.
 /// \param insn Receives the instruction.
+/// \param fcache Fetch translation cache.
 /// \param fetch_vaddr_page Fetch virtual address translation page cache.
 /// \param fetch_vh_offset Fetch virtual address host pointer offset cache.
 /// \return Returns fetch_status::success if load succeeded, fetch_status::exception if it caused an exception.
 //          In that case, raise the exception.
-template <typename STATE_ACCESS>
-static FORCE_INLINE fetch_status fetch_insn(STATE_ACCESS &a, uint64_t &pc, uint32_t &insn, uint64_t &fetch_vaddr_page,
-    uint64_t &fetch_vh_offset) {
+template <typename STATE_ACCESS, int MODE>
+static FORCE_INLINE fetch_status fetch_insn(STATE_ACCESS &a, uint64_t &pc, uint32_t &insn, fetch_cache &fcache,
+    uint64_t &fetch_vaddr_page, uint64_t &fetch_vh_offset) {
     unsigned char *hptr = nullptr;
     const uint64_t vaddr_page = pc & ~PAGE_OFFSET_MASK;
     // If pc is in the same page as the last pc fetch,
@@ -5480,7 +5844,7 @@ static FORCE_INLINE fetch_status fetch_insn(STATE_ACCESS &a, uint64_t &pc, uint3
         hptr = cast_addr_to_ptr<unsigned char *>(pc + fetch_vh_offset);
     } else {
         // Not in the same page as last the fetch, we need to perform address translation
-        if (unlikely(fetch_translate_pc(a, pc, pc, &hptr) == fetch_status::exception)) {
+        if (unlikely((fetch_translate_pc<STATE_ACCESS, MODE>(a, fcache, pc, pc, &hptr)) == fetch_status::exception)) {
             return fetch_status::exception;
         }
         // Update fetch address translation cache
@@ -5496,7 +5860,8 @@ static FORCE_INLINE fetch_status fetch_insn(STATE_ACCESS &a, uint64_t &pc, uint3
         if (unlikely((insn & 3) == 3)) {
             // We have to perform a new address translation to read the next 2 bytes since we changed pages.
             const uint64_t vaddr = pc + 2;
-            if (unlikely(fetch_translate_pc(a, pc, vaddr, &hptr) == fetch_status::exception)) {
+            if (unlikely(
+                    (fetch_translate_pc<STATE_ACCESS, MODE>(a, fcache, pc, vaddr, &hptr)) == fetch_status::exception)) {
                 return fetch_status::exception;
             }
             // Update fetch translation cache
@@ -5526,9 +5891,63 @@ static void assert_no_brk(STATE_ACCESS &a) {
     assert(a.read_iflags_H() == 0);       // LCOV_EXCL_LINE
 }
 
+/// \brief Returns the first mcycle after a given mcycle at which the guest pc is sampled for profiling
+/// \param mcycle Current mcycle.
+/// \param pc_sample_period Number of cycles between guest pc samples.
+/// \returns Next multiple of pc_sample_period, saturating at UINT64_MAX.
+static inline uint64_t get_next_pc_sample_mcycle(uint64_t mcycle, uint64_t pc_sample_period) {
+    const uint64_t delta = pc_sample_period - mcycle % pc_sample_period;
+    return mcycle <= UINT64_MAX - delta ? mcycle + delta : UINT64_MAX;
+}
+
+/// \brief Returns the first RTC tick after a given mcycle at which the outer loop has work to do
+/// \param a Machine state accessor object.
+/// \param mcycle Current mcycle.
+/// \returns The next RTC tick when external interrupts must be polled, otherwise the first RTC tick
+///  at which the RTC interrupt becomes pending, saturating at UINT64_MAX.
+/// \details Other than through RTC ticks, pending interrupts can only change in instructions returning
+///  execute_status::success_and_serve_interrupts or above, and these always break the inner loop.
+///  This includes writes to mtimecmp, so the event horizon is recomputed whenever it may move.
+template <typename STATE_ACCESS>
+static inline uint64_t get_next_rtc_event_mcycle(STATE_ACCESS &a, uint64_t mcycle) {
+    const uint64_t delta = RTC_FREQ_DIV - mcycle % RTC_FREQ_DIV;
+    const uint64_t next_tick = mcycle <= UINT64_MAX - delta ? mcycle + delta : UINT64_MAX;
+#ifdef MICROARCHITECTURE
+    // The microarchitecture interprets a single cycle at a time, so there is nothing to gain
+    (void) a;
+    return next_tick;
+#else
+    // External interrupts are polled at every tick in unreproducible mode
+    if (a.read_iunrep()) {
+        return next_tick;
+    }
+    // Once the RTC interrupt is pending, ticks have nothing left to do until mtimecmp is written
+    if (a.read_mip() & MIP_MTIP_MASK) {
+        return UINT64_MAX;
+    }
+    // Must match the condition in set_rtc_interrupt(), which never fires for a zero timecmp_cycle
+    const uint64_t timecmp_cycle = rtc_time_to_cycle(a.read_clint_mtimecmp());
+    if (timecmp_cycle == 0) {
+        return UINT64_MAX;
+    }
+    // rtc_time_to_cycle() always returns a tick
+    return std::max(next_tick, timecmp_cycle);
+#endif
+}
+
 /// \brief Interpreter hot loop
-template <typename STATE_ACCESS>
-static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_end, uint64_t mcycle) {
+/// \tparam STATE_ACCESS Class of machine state accessor object.
+/// \tparam MODE Combination of interpret_mode flags of this variant.
+/// \param a Machine state accessor object.
+/// \param mcycle_end Target mcycle.
+/// \param mcycle Current mcycle.
+/// \param interrupts_served On entry, whether interrupts were already served at the current mcycle.
+///  On return, whether interrupts were served at the committed mcycle.
+/// \details A static variant returns execute_status::success before mcycle_end when current state no longer
+///  matches MODE, with pc and mcycle committed to machine state.
+template <typename STATE_ACCESS, int MODE>
+static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_end, uint64_t mcycle,
+    bool &interrupts_served) {
     // The interpret loop is constantly reading and modifying the pc and mcycle variables,
     // because of this care is taken to make them stack variables that are propagated across inline functions,
     // helping the C++ compiler optimize them into registers instead of stack variables when compiling,
@@ -5541,36 +5960,71 @@ static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_
     // Read machine program counter
     uint64_t pc = a.read_pc();
 
-    // Initialize fetch address translation cache invalidated
+    // Initialize fetch address translation caches invalidated
     uint64_t fetch_vaddr_page = PAGE_OFFSET_MASK;
     uint64_t fetch_vh_offset = 0;
+    fetch_cache fcache{};
+    fetch_cache_flush(fcache, fetch_vaddr_page);
+
+    // When profiling, the guest pc is sampled whenever mcycle crosses a multiple of the sample period
+    const uint64_t pc_sample_period = a.get_pc_sample_period();
+    uint64_t mcycle_sample = UINT64_MAX;
+    if (unlikely(pc_sample_period != 0)) {
+        mcycle_sample = mcycle % pc_sample_period == 0 ? mcycle : get_next_pc_sample_mcycle(mcycle, pc_sample_period);
+    }
 
     // The outer loop continues until there is an interruption that should be handled
     // externally, or mcycle reaches mcycle_end
     while (mcycle < mcycle_end) {
         INC_COUNTER(a.get_statistics(), outer_loop);
 
-        if (rtc_is_tick(mcycle)) {
-            // Set interrupt flag for RTC
-            set_rtc_interrupt(a, mcycle);
+        // A variant that took over from another resumes right after interrupts were served
+        if (likely(!interrupts_served)) {
+            if (rtc_is_tick(mcycle)) {
+                INC_COUNTER(a.get_statistics(), rtc_tick);
 
-            // Polling external interrupts only in WFI instructions is not enough
-            // because Linux won't execute WFI instructions while under heavy load,
-            // yet external interrupts still need to be triggered.
-            // Therefore we poll for external interrupt once a while in the interpreter loop.
-            a.poll_external_interrupts(mcycle, mcycle);
-        }
+                // Set interrupt flag for RTC
+                set_rtc_interrupt(a, mcycle);
+
+                // Polling external interrupts only in WFI instructions is not enough
+                // because Linux won't execute WFI instructions while under heavy load,
+                // yet external interrupts still need to be triggered.
+                // Therefore we poll for external interrupt once a while in the interpreter loop.
+                a.poll_external_interrupts(mcycle, mcycle);
+            }
+
+            // Raise the highest priority pending interrupt, if any
+            pc = raise_interrupt_if_any(a, pc);
+
+            // Raising an interrupt may have changed the privilege level, flushing the code TLB
+            fetch_cache_revalidate(a, fcache, fetch_vaddr_page);
 
-        // Raise the highest priority pending interrupt, if any
-        pc = raise_interrupt_if_any(a, pc);
+            // Let another variant take over if the privilege level, address translation or FS state changed
+            if (unlikely(!is_interpret_mode<MODE>(a))) {
+                interrupts_served = true;
+                break;
+            }
+        }
+        interrupts_served = false;
 
 #ifndef NDEBUG
         // After raising any exception for a given interrupt, we expect no pending break
         assert_no_brk(a);
 #endif
 
-        // Limit mcycle_tick_end up to the next RTC tick, while avoiding unsigned overflows
-        const uint64_t mcycle_tick_end = mcycle + std::min(mcycle_end - mcycle, RTC_FREQ_DIV - mcycle % RTC_FREQ_DIV);
+        // Sample the guest pc for profiling.
+        // Breaking the inner loop at sample points does not change the execution,
+        // because there can be no pending interrupts after an inner loop iteration.
+        if (unlikely(mcycle >= mcycle_sample)) {
+            a.sample_pc(pc);
+            mcycle_sample = get_next_pc_sample_mcycle(mcycle, pc_sample_period);
+        }
+
+        // Limit mcycle_tick_end up to the next RTC tick that has work to do, skipping ticks that
+        // would neither raise the RTC interrupt nor poll external interrupts, while avoiding unsigned overflows,
+        // and up to the next guest pc sample
+        const uint64_t mcycle_tick_end = std::min(
+            mcycle + std::min(mcycle_end - mcycle, get_next_rtc_event_mcycle(a, mcycle) - mcycle), mcycle_sample);
 
         // The inner loop continues until there is an interrupt condition
         // or mcycle reaches mcycle_tick_end
@@ -5580,19 +6034,21 @@ static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_
             uint32_t insn = 0;
 
             // Try to fetch the next instruction
-            if (likely(fetch_insn(a, pc, insn, fetch_vaddr_page, fetch_vh_offset) == fetch_status::success)) {
-                // Try to execute it
-                const execute_status status = execute_insn(a, pc, mcycle, insn);
+            if (likely((fetch_insn<STATE_ACCESS, MODE>(a, pc, insn, fcache, fetch_vaddr_page, fetch_vh_offset)) ==
+                    fetch_status::success)) {
+                // Try to execute it, possibly along with the instructions that follow it
+                const execute_status status = execute_insn<STATE_ACCESS, MODE>(a, pc, mcycle, mcycle_end,
+                    fusion_context{mcycle_tick_end, fetch_vaddr_page, fetch_vh_offset}, insn);
 
                 // When execute status is above success, we have to deal with special loop conditions,
                 // this is very unlikely to happen most of the time
                 if (unlikely(status > execute_status::success)) {
-                    // We must invalidate the fetch cache whenever privilege mode changes,
-                    // either due to a raised exception (execute_status::failure) or
-                    // due to MRET/SRET instructions (execute_status::success_and_serve_interrupts)
-                    // As a simplification (and optimization), the next line will also invalidate in more cases,
-                    // but this it's fine.
-                    fetch_vaddr_page = PAGE_OFFSET_MASK;
+                    // We must invalidate the fetch cache whenever the code TLB is flushed,
+                    // either due to a privilege mode change in a raised exception (execute_status::failure)
+                    // or in MRET/SRET instructions (execute_status::success_and_serve_interrupts),
+                    // or due to writes to satp and SFENCE.VMA instructions.
+                    // Only these statuses can follow a flush, and the next line checks if one happened.
+                    fetch_cache_revalidate(a, fcache, fetch_vaddr_page);
                     // All status above execute_status::success_and_serve_interrupts will require breaking the loop
                     if (unlikely(status >= execute_status::success_and_serve_interrupts)) {
                         // Increment the cycle counter mcycle
@@ -5609,6 +6065,12 @@ static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_
                             return status;
                         }
                     }
+                    // Privilege level, address translation and FS state only change along with such a status.
+                    // Breaking the inner loop does not change the execution, for the same reason as above.
+                    if (unlikely(!is_interpret_mode<MODE>(a))) {
+                        ++mcycle;
+                        break;
+                    }
                 }
             }
 
@@ -5628,6 +6090,42 @@ static NO_INLINE execute_status interpret_loop(STATE_ACCESS &a, uint64_t mcycle_
     return execute_status::success;
 }
 
+/// \brief Runs the interpreter loop variants that match the state, switching between them as the state changes
+template <typename STATE_ACCESS>
+static execute_status interpret_variants(STATE_ACCESS &a, uint64_t mcycle_end, uint64_t mcycle) {
+    bool interrupts_served = false;
+#if defined(MICROARCHITECTURE) || defined(NO_INTERPRET_VARIANTS)
+    // The microarchitecture interprets a single cycle at a time, and cannot afford the code size anyway
+    return interpret_loop<STATE_ACCESS, INTERPRET_MODE_DYNAMIC>(a, mcycle_end, mcycle, interrupts_served);
+#else
+    for (;;) {
+        execute_status status = execute_status::success;
+        switch (get_interpret_mode(a)) {
+            case INTERPRET_MODE_STATIC:
+                status = interpret_loop<STATE_ACCESS, INTERPRET_MODE_STATIC>(a, mcycle_end, mcycle, interrupts_served);
+                break;
+            case INTERPRET_MODE_STATIC | INTERPRET_MODE_FS_ON:
+                status = interpret_loop<STATE_ACCESS, INTERPRET_MODE_STATIC | INTERPRET_MODE_FS_ON>(a, mcycle_end,
+                    mcycle, interrupts_served);
+                break;
+            case INTERPRET_MODE_STATIC | INTERPRET_MODE_FETCH_VM:
+                status = interpret_loop<STATE_ACCESS, INTERPRET_MODE_STATIC | INTERPRET_MODE_FETCH_VM>(a, mcycle_end,
+                    mcycle, interrupts_served);
+                break;
+            default:
+                status = interpret_loop<STATE_ACCESS,
+                    INTERPRET_MODE_STATIC | INTERPRET_MODE_FS_ON | INTERPRET_MODE_FETCH_VM>(a, mcycle_end, mcycle,
+                    interrupts_served);
+                break;
+        }
+        mcycle = a.read_mcycle();
+        if (status != execute_status::success || mcycle >= mcycle_end) {
+            return status;
+        }
+    }
+#endif
+}
+
 template <typename STATE_ACCESS>
 interpreter_break_reason interpret(STATE_ACCESS &a, uint64_t mcycle_end) {
     static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "code assumes little-endian byte ordering");
@@ -5654,8 +6152,8 @@ interpreter_break_reason interpret(STATE_ACCESS &a, uint64_t mcycle_end) {
     a.reset_iflags_X();
 
     // Run the interpreter loop,
-    // the loop is outlined in a dedicated function so the compiler can optimize it better
-    const execute_status status = interpret_loop(a, mcycle_end, mcycle);
+    // the loop is outlined in dedicated functions so the compiler can optimize it better
+    const execute_status status = interpret_variants(a, mcycle_end, mcycle);
 
     // Detect and return the reason for stopping the interpreter loop
     if (a.read_iflags_H()) {
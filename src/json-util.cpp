@@ -219,6 +219,54 @@ uarch_interpreter_break_reason uarch_interpreter_break_reason_from_name(const st
     throw std::domain_error{"invalid uarch interpreter break reason"};
 }
 
+static rollup_input_status rollup_input_status_from_name(const std::string &name) {
+    using ris = rollup_input_status;
+    const static std::unordered_map<std::string, ris> g_ris_name = {{"accepted", ris::accepted},
+        {"rejected", ris::rejected}, {"exception", ris::exception}, {"halted", ris::halted},
+        {"reached_target_mcycle", ris::reached_target_mcycle}};
+    auto got = g_ris_name.find(name);
+    if (got == g_ris_name.end()) {
+        throw std::domain_error{"invalid rollup input status"};
+    }
+    return got->second;
+}
+
+static std::string rollup_input_status_name(rollup_input_status status) {
+    switch (status) {
+        case rollup_input_status::accepted:
+            return "accepted";
+        case rollup_input_status::rejected:
+            return "rejected";
+        case rollup_input_status::exception:
+            return "exception";
+        case rollup_input_status::halted:
+            return "halted";
+        case rollup_input_status::reached_target_mcycle:
+            return "reached_target_mcycle";
+    }
+    throw std::domain_error{"invalid rollup input status"};
+}
+
+static uarch_state_transition_type uarch_state_transition_type_from_name(const std::string &name) {
+    if (name == "step") {
+        return uarch_state_transition_type::step;
+    }
+    if (name == "reset") {
+        return uarch_state_transition_type::reset;
+    }
+    throw std::domain_error{"invalid uarch state transition type"};
+}
+
+static std::string uarch_state_transition_type_name(uarch_state_transition_type type) {
+    switch (type) {
+        case uarch_state_transition_type::step:
+            return "step";
+        case uarch_state_transition_type::reset:
+            return "reset";
+    }
+    throw std::domain_error{"invalid uarch state transition type"};
+}
+
 static std::string access_type_name(access_type at) {
     switch (at) {
         case access_type::read:
@@ -413,6 +461,8 @@ void ju_get_opt_field(const nlohmann::json &j, const K &key, concurrency_runtime
         return;
     }
     ju_get_opt_field(j[key], "update_merkle_tree"s, value.update_merkle_tree, path + to_string(key) + "/");
+    ju_get_opt_field(j[key], "verify_uarch_state_transitions"s, value.verify_uarch_state_transitions,
+        path + to_string(key) + "/");
 }
 
 template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
@@ -435,6 +485,37 @@ template void ju_get_opt_field<bool>(const nlohmann::json &j, const bool &key, h
 template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, htif_runtime_config &value,
     const std::string &path);
 
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_hashes_runtime_config &value,
+    const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    ju_get_opt_field(j[key], "period"s, value.period, path + to_string(key) + "/");
+    ju_get_opt_field(j[key], "start"s, value.start, path + to_string(key) + "/");
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    periodic_hashes_runtime_config &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    periodic_hashes_runtime_config &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, profile_runtime_config &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    ju_get_opt_field(j[key], "enabled"s, value.enabled, path + to_string(key) + "/");
+    ju_get_opt_field(j[key], "pc_sample_period"s, value.pc_sample_period, path + to_string(key) + "/");
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, profile_runtime_config &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    profile_runtime_config &value, const std::string &path);
+
 template <typename K>
 void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_runtime_config &value, const std::string &path) {
     if (!contains(j, key)) {
@@ -442,6 +523,8 @@ void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_runtime_con
     }
     ju_get_field(j[key], "concurrency"s, value.concurrency, path + to_string(key) + "/");
     ju_get_field(j[key], "htif"s, value.htif, path + to_string(key) + "/");
+    ju_get_opt_field(j[key], "periodic_hashes"s, value.periodic_hashes, path + to_string(key) + "/");
+    ju_get_opt_field(j[key], "profile"s, value.profile, path + to_string(key) + "/");
     ju_get_opt_field(j[key], "skip_root_hash_check"s, value.skip_root_hash_check, path + to_string(key) + "/");
     ju_get_opt_field(j[key], "skip_version_check"s, value.skip_version_check, path + to_string(key) + "/");
     ju_get_opt_field(j[key], "soft_yield"s, value.soft_yield, path + to_string(key) + "/");
@@ -547,6 +630,86 @@ template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t
 template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
     not_default_constructible<machine_merkle_tree::proof_type> &value, const std::string &path);
 
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_merkle_tree::multi_proof_type::target_type &value,
+    const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jk, "address"s, value.address, new_path);
+    uint64_t log2_size = 0;
+    ju_get_field(jk, "log2_size"s, log2_size, new_path);
+    if (log2_size > INT_MAX) {
+        throw std::domain_error("field \""s + new_path + "log2_size\" is out of bounds");
+    }
+    value.log2_size = static_cast<int>(log2_size);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    machine_merkle_tree::multi_proof_type::target_type &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    machine_merkle_tree::multi_proof_type::target_type &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_merkle_tree::multi_proof_type::targets_type &value,
+    const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    machine_merkle_tree::multi_proof_type::targets_type &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    machine_merkle_tree::multi_proof_type::targets_type &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &path) {
+    value = {};
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    uint64_t log2_root_size = 0;
+    ju_get_field(jk, "log2_root_size"s, log2_root_size, new_path);
+    if (log2_root_size > INT_MAX) {
+        throw std::domain_error("field \""s + new_path + "log2_root_size\" is out of bounds");
+    }
+    machine_merkle_tree::multi_proof_type::targets_type targets;
+    ju_get_vector_like_field(jk, "targets"s, targets, new_path);
+    value.emplace(static_cast<int>(log2_root_size), targets);
+    auto &proof = value.value();
+    // Target hashes are listed together with their targets, which must already be sorted
+    const auto targets_path = new_path + "targets/";
+    const auto &jtargets = jk["targets"];
+    for (uint64_t i = 0; i < targets.size(); ++i) {
+        if (proof.get_targets()[i].address != targets[i].address) {
+            throw std::invalid_argument("field \""s + new_path + "targets\" not sorted by address");
+        }
+        machine_merkle_tree::multi_proof_type::hash_type target_hash;
+        ju_get_field(jtargets[i], "hash"s, target_hash, targets_path + to_string(i) + "/");
+        proof.set_target_hash(i, target_hash);
+    }
+    machine_merkle_tree::multi_proof_type::hash_type root_hash;
+    ju_get_field(jk, "root_hash"s, root_hash, new_path);
+    proof.set_root_hash(root_hash);
+    std::vector<machine_merkle_tree::multi_proof_type::hash_type> sibling_hashes;
+    ju_get_vector_like_field(jk, "sibling_hashes"s, sibling_hashes, new_path);
+    for (const auto &sibling_hash : sibling_hashes) {
+        proof.push_back_sibling_hash(sibling_hash);
+    }
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &path);
+
 template <typename K>
 void ju_get_opt_field(const nlohmann::json &j, const K &key, access_type &value, const std::string &path) {
     if (!contains(j, key)) {
@@ -1148,6 +1311,312 @@ template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t
 template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
     machine_memory_range_descrs &value, const std::string &path);
 
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_root_hash &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jhash = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jhash, "mcycle"s, value.mcycle, new_path);
+    ju_get_field(jhash, "hash"s, value.hash, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, periodic_root_hash &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, periodic_root_hash &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_root_hashes &value, const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, periodic_root_hashes &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    periodic_root_hashes &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, insn_count &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jcount = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jcount, "insn"s, value.insn, new_path);
+    ju_get_field(jcount, "count"s, value.count, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, insn_count &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, insn_count &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, insn_pair_count &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jcount = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jcount, "insn"s, value.insn, new_path);
+    ju_get_field(jcount, "next_insn"s, value.next_insn, new_path);
+    ju_get_field(jcount, "count"s, value.count, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, insn_pair_count &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, insn_pair_count &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, pc_sample &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jsample = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jsample, "pc"s, value.pc, new_path);
+    ju_get_field(jsample, "count"s, value.count, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, pc_sample &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, pc_sample &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_profile &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jprofile = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_vector_like_field(jprofile, "insn_counts"s, value.insn_counts, new_path);
+    ju_get_vector_like_field(jprofile, "insn_pair_counts"s, value.insn_pair_counts, new_path);
+    ju_get_vector_like_field(jprofile, "pc_samples"s, value.pc_samples, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, machine_profile &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, machine_profile &value,
+    const std::string &path);
+
+/// \brief Attempts to load binary data encoded as base64 from a field in a JSON object
+/// \tparam K Key type
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+static void ju_get_opt_base64_field(const nlohmann::json &j, const K &key, std::string &value,
+    const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    if (!jk.is_string()) {
+        throw std::invalid_argument("field \""s + path + to_string(key) + "\" not a string");
+    }
+    value = decode_base64(jk.template get<std::string>());
+}
+
+/// \brief Attempts to load a list of binary data encoded as base64 from a field in a JSON object
+/// \tparam K Key type
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+static void ju_get_opt_base64_vector_field(const nlohmann::json &j, const K &key, std::vector<std::string> &value,
+    const std::string &path) {
+    value.clear();
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    if (!jk.is_array()) {
+        throw std::invalid_argument("field \""s + path + to_string(key) + "\" not an array");
+    }
+    const auto new_path = path + to_string(key) + "/";
+    for (uint64_t i = 0; i < jk.size(); ++i) {
+        ju_get_opt_base64_field(jk, i, value.emplace_back(), new_path);
+    }
+}
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_data &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jinput = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_opt_base64_field(jinput, "metadata"s, value.metadata, new_path);
+    ju_get_opt_base64_field(jinput, "payload"s, value.payload, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, rollup_input_data &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, rollup_input_data &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, std::vector<rollup_input_data> &value,
+    const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    std::vector<rollup_input_data> &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    std::vector<rollup_input_data> &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, memory_range_data &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jrange = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jrange, "address"s, value.address, new_path);
+    ju_get_opt_field(jrange, "length"s, value.length, new_path);
+    ju_get_opt_base64_field(jrange, "data"s, value.data, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, memory_range_data &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key, memory_range_data &value,
+    const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, std::vector<memory_range_data> &value,
+    const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    std::vector<memory_range_data> &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    std::vector<memory_range_data> &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_status &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    if (!jk.is_string()) {
+        throw std::invalid_argument("field \""s + path + to_string(key) + "\" not a string");
+    }
+    value = rollup_input_status_from_name(jk.template get<std::string>());
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, rollup_input_status &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    rollup_input_status &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_result &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jresult = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jresult, "status"s, value.status, new_path);
+    ju_get_opt_base64_vector_field(jresult, "vouchers"s, value.vouchers, new_path);
+    ju_get_opt_base64_vector_field(jresult, "notices"s, value.notices, new_path);
+    ju_get_opt_base64_vector_field(jresult, "reports"s, value.reports, new_path);
+    ju_get_opt_base64_field(jresult, "exception"s, value.exception, new_path);
+    ju_get_opt_vector_like_field(jresult, "voucher_hashes"s, value.voucher_hashes, new_path);
+    ju_get_opt_vector_like_field(jresult, "notice_hashes"s, value.notice_hashes, new_path);
+    ju_get_opt_field(jresult, "root_hash"s, value.root_hash, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, rollup_input_result &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    rollup_input_result &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_results &value, const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, rollup_input_results &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    rollup_input_results &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transition_type &value,
+    const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jk = j[key];
+    if (!jk.is_string()) {
+        throw std::invalid_argument("field \""s + path + to_string(key) + "\" not a string");
+    }
+    value = uarch_state_transition_type_from_name(jk.template get<std::string>());
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key,
+    uarch_state_transition_type &value, const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    uarch_state_transition_type &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transition &value, const std::string &path) {
+    if (!contains(j, key)) {
+        return;
+    }
+    const auto &jtransition = j[key];
+    const auto new_path = path + to_string(key) + "/";
+    ju_get_field(jtransition, "type"s, value.type, new_path);
+    ju_get_field(jtransition, "root_hash_before"s, value.root_hash_before, new_path);
+    not_default_constructible<access_log> log;
+    ju_get_field(jtransition, "log"s, log, new_path);
+    if (!log.has_value()) {
+        throw std::logic_error("log conversion bug");
+    }
+    value.log = std::move(log).value();
+    ju_get_field(jtransition, "root_hash_after"s, value.root_hash_after, new_path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, uarch_state_transition &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    uarch_state_transition &value, const std::string &path);
+
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transitions &value,
+    const std::string &path) {
+    ju_get_opt_vector_like_field(j, key, value, path);
+}
+
+template void ju_get_opt_field<uint64_t>(const nlohmann::json &j, const uint64_t &key, uarch_state_transitions &value,
+    const std::string &path);
+
+template void ju_get_opt_field<std::string>(const nlohmann::json &j, const std::string &key,
+    uarch_state_transitions &value, const std::string &path);
+
 void to_json(nlohmann::json &j, const machine::csr &csr) {
     j = csr_to_name(csr);
 }
@@ -1172,6 +1641,26 @@ void to_json(nlohmann::json &j, const machine_merkle_tree::proof_type &p) {
         {"root_hash", encode_base64(p.get_root_hash())}, {"sibling_hashes", s}};
 }
 
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type::target_type &t) {
+    j = nlohmann::json{{"address", t.address}, {"log2_size", t.log2_size}};
+}
+
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type::targets_type &ts) {
+    j = nlohmann::json::array();
+    std::transform(ts.cbegin(), ts.cend(), std::back_inserter(j), [](const auto &t) -> nlohmann::json { return t; });
+}
+
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type &p) {
+    nlohmann::json t = nlohmann::json::array();
+    for (size_t i = 0; i < p.get_targets().size(); ++i) {
+        const auto &target = p.get_targets()[i];
+        t.push_back({{"address", target.address}, {"log2_size", target.log2_size},
+            {"hash", encode_base64(p.get_target_hashes()[i])}});
+    }
+    j = nlohmann::json{{"log2_root_size", p.get_log2_root_size()}, {"root_hash", encode_base64(p.get_root_hash())},
+        {"targets", t}, {"sibling_hashes", p.get_sibling_hashes()}};
+}
+
 void to_json(nlohmann::json &j, const access &a) {
     j = nlohmann::json{
         {"type", access_type_name(a.get_type())},
@@ -1355,6 +1844,7 @@ void to_json(nlohmann::json &j, const machine_config &config) {
 void to_json(nlohmann::json &j, const concurrency_runtime_config &config) {
     j = nlohmann::json{
         {"update_merkle_tree", config.update_merkle_tree},
+        {"verify_uarch_state_transitions", config.verify_uarch_state_transitions},
     };
 }
 
@@ -1364,10 +1854,26 @@ void to_json(nlohmann::json &j, const htif_runtime_config &config) {
     };
 }
 
+void to_json(nlohmann::json &j, const periodic_hashes_runtime_config &config) {
+    j = nlohmann::json{
+        {"period", config.period},
+        {"start", config.start},
+    };
+}
+
+void to_json(nlohmann::json &j, const profile_runtime_config &config) {
+    j = nlohmann::json{
+        {"enabled", config.enabled},
+        {"pc_sample_period", config.pc_sample_period},
+    };
+}
+
 void to_json(nlohmann::json &j, const machine_runtime_config &runtime) {
     j = nlohmann::json{
         {"concurrency", runtime.concurrency},
         {"htif", runtime.htif},
+        {"periodic_hashes", runtime.periodic_hashes},
+        {"profile", runtime.profile},
         {"skip_root_hash_check", runtime.skip_root_hash_check},
         {"skip_version_check", runtime.skip_version_check},
         {"soft_yield", runtime.soft_yield},
@@ -1384,4 +1890,98 @@ void to_json(nlohmann::json &j, const machine_memory_range_descrs &mrds) {
         [](const auto &a) -> nlohmann::json { return a; });
 }
 
+void to_json(nlohmann::json &j, const periodic_root_hash &h) {
+    j = nlohmann::json{{"mcycle", h.mcycle}, {"hash", encode_base64(h.hash)}};
+}
+
+void to_json(nlohmann::json &j, const periodic_root_hashes &hs) {
+    j = nlohmann::json::array();
+    std::transform(hs.cbegin(), hs.cend(), std::back_inserter(j), [](const auto &h) -> nlohmann::json { return h; });
+}
+
+void to_json(nlohmann::json &j, const insn_count &c) {
+    j = nlohmann::json{{"insn", c.insn}, {"count", c.count}};
+}
+
+void to_json(nlohmann::json &j, const insn_pair_count &c) {
+    j = nlohmann::json{{"insn", c.insn}, {"next_insn", c.next_insn}, {"count", c.count}};
+}
+
+void to_json(nlohmann::json &j, const pc_sample &s) {
+    j = nlohmann::json{{"pc", s.pc}, {"count", s.count}};
+}
+
+void to_json(nlohmann::json &j, const machine_profile &p) {
+    j = nlohmann::json{
+        {"insn_counts", p.insn_counts}, {"insn_pair_counts", p.insn_pair_counts}, {"pc_samples", p.pc_samples}};
+}
+
+void to_json(nlohmann::json &j, const rollup_input &i) {
+    j = nlohmann::json{{"metadata", encode_base64(i.metadata, i.metadata_length)},
+        {"payload", encode_base64(i.payload, i.payload_length)}};
+}
+
+void to_json(nlohmann::json &j, const rollup_inputs &is) {
+    j = nlohmann::json::array();
+    std::transform(is.cbegin(), is.cend(), std::back_inserter(j), [](const auto &i) -> nlohmann::json { return i; });
+}
+
+void to_json(nlohmann::json &j, const rollup_input_status &s) {
+    j = rollup_input_status_name(s);
+}
+
+/// \brief Encodes a list of binary data as an array of base64 strings
+/// \param outputs List of binary data
+/// \returns JSON array
+static nlohmann::json encode_base64_array(const std::vector<std::string> &outputs) {
+    auto j = nlohmann::json::array();
+    std::transform(outputs.cbegin(), outputs.cend(), std::back_inserter(j),
+        [](const std::string &o) -> nlohmann::json { return encode_base64(o); });
+    return j;
+}
+
+void to_json(nlohmann::json &j, const rollup_input_result &r) {
+    j = nlohmann::json{{"status", r.status}, {"vouchers", encode_base64_array(r.vouchers)},
+        {"notices", encode_base64_array(r.notices)}, {"reports", encode_base64_array(r.reports)},
+        {"exception", encode_base64(r.exception)}, {"voucher_hashes", r.voucher_hashes},
+        {"notice_hashes", r.notice_hashes}, {"root_hash", r.root_hash}};
+}
+
+void to_json(nlohmann::json &j, const rollup_input_results &rs) {
+    j = nlohmann::json::array();
+    std::transform(rs.cbegin(), rs.cend(), std::back_inserter(j), [](const auto &r) -> nlohmann::json { return r; });
+}
+
+void to_json(nlohmann::json &j, const memory_range_read &r) {
+    j = nlohmann::json{{"address", r.address}, {"length", r.length}};
+}
+
+void to_json(nlohmann::json &j, const memory_range_reads &rs) {
+    j = nlohmann::json::array();
+    std::transform(rs.cbegin(), rs.cend(), std::back_inserter(j), [](const auto &r) -> nlohmann::json { return r; });
+}
+
+void to_json(nlohmann::json &j, const memory_range_write &w) {
+    j = nlohmann::json{{"address", w.address}, {"data", encode_base64(w.data, w.length)}};
+}
+
+void to_json(nlohmann::json &j, const memory_range_writes &ws) {
+    j = nlohmann::json::array();
+    std::transform(ws.cbegin(), ws.cend(), std::back_inserter(j), [](const auto &w) -> nlohmann::json { return w; });
+}
+
+void to_json(nlohmann::json &j, const uarch_state_transition_type &type) {
+    j = uarch_state_transition_type_name(type);
+}
+
+void to_json(nlohmann::json &j, const uarch_state_transition &t) {
+    j = nlohmann::json{{"type", t.type}, {"root_hash_before", t.root_hash_before}, {"log", t.log},
+        {"root_hash_after", t.root_hash_after}};
+}
+
+void to_json(nlohmann::json &j, const uarch_state_transitions &ts) {
+    j = nlohmann::json::array();
+    std::transform(ts.cbegin(), ts.cend(), std::back_inserter(j), [](const auto &t) -> nlohmann::json { return t; });
+}
+
 } // namespace cartesi
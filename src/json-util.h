@@ -51,6 +51,21 @@ using optional_param = new_optional<0, T>;
 template <typename T>
 using not_default_constructible = new_optional<1, T>;
 
+/// \brief Rollup input decoded from JSON, which owns the data the corresponding rollup_input points to
+struct rollup_input_data {
+    std::string metadata; ///< Contents of the input metadata memory range
+    std::string payload;  ///< Contents of the rx buffer memory range
+};
+
+/// \brief Memory range decoded from JSON, which owns the data the corresponding memory_range_write points to
+/// \details Ranges to be read carry only their length, and ranges that were read or are to be written carry only
+/// their data.
+struct memory_range_data {
+    uint64_t address{}; ///< Start of range
+    uint64_t length{};  ///< Length of range in bytes, when data is absent
+    std::string data;   ///< Contents of the range
+};
+
 // Forward declaration of generic ju_get_field
 template <typename T, typename K>
 void ju_get_field(const nlohmann::json &j, const K &key, T &value, const std::string &path = "params/");
@@ -165,6 +180,26 @@ template <typename K>
 void ju_get_opt_field(const nlohmann::json &j, const K &key, htif_runtime_config &value,
     const std::string &path = "params/");
 
+/// \brief Attempts to load a periodic_hashes_runtime_config object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_hashes_runtime_config &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a profile_runtime_config object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, profile_runtime_config &value,
+    const std::string &path = "params/");
+
 /// \brief Attempts to load an machine_runtime_config object from a field in a JSON object
 /// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
 /// \param j JSON object to load from
@@ -195,6 +230,36 @@ template <typename K>
 void ju_get_opt_field(const nlohmann::json &j, const K &key,
     not_default_constructible<machine_merkle_tree::proof_type> &value, const std::string &path = "params/");
 
+/// \brief Attempts to load a Merkle tree multi-proof target object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_merkle_tree::multi_proof_type::target_type &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a Merkle tree multi-proof targets array from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_merkle_tree::multi_proof_type::targets_type &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a Merkle tree multi-proof object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &path = "params/");
+
 /// \brief Attempts to load an access_type name from a field in a JSON object
 /// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
 /// \param j JSON object to load from
@@ -422,6 +487,164 @@ template <typename K>
 void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_memory_range_descrs &value,
     const std::string &path = "params/");
 
+/// \brief Attempts to load a periodic_root_hash object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_root_hash &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a periodic_root_hashes object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, periodic_root_hashes &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load an insn_count object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, insn_count &value, const std::string &path = "params/");
+
+/// \brief Attempts to load an insn_pair_count object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, insn_pair_count &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a pc_sample object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, pc_sample &value, const std::string &path = "params/");
+
+/// \brief Attempts to load a machine_profile object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, machine_profile &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a rollup_input_data object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_data &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a list of rollup_input_data objects from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, std::vector<rollup_input_data> &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a memory_range_data object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, memory_range_data &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a list of memory_range_data objects from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, std::vector<memory_range_data> &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a rollup_input_status name from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_status &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a rollup_input_result object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_result &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a rollup_input_results object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, rollup_input_results &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a uarch_state_transition_type name from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transition_type &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a uarch_state_transition object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transition &value,
+    const std::string &path = "params/");
+
+/// \brief Attempts to load a uarch_state_transitions object from a field in a JSON object
+/// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
+/// \param j JSON object to load from
+/// \param key Key to load value from
+/// \param value Object to store value
+/// \param path Path to j
+template <typename K>
+void ju_get_opt_field(const nlohmann::json &j, const K &key, uarch_state_transitions &value,
+    const std::string &path = "params/");
+
 /// \brief Attempts to load an array from a field in a JSON object
 /// \tparam K Key type (explicit extern declarations for uint64_t and std::string are provided)
 /// \param j JSON object to load from
@@ -560,6 +783,9 @@ void to_json(nlohmann::json &j, const access_log::type &log_type);
 void to_json(nlohmann::json &j, const machine_merkle_tree::hash_type &h);
 void to_json(nlohmann::json &j, const std::vector<machine_merkle_tree::hash_type> &hs);
 void to_json(nlohmann::json &j, const machine_merkle_tree::proof_type &p);
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type::target_type &t);
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type::targets_type &ts);
+void to_json(nlohmann::json &j, const machine_merkle_tree::multi_proof_type &p);
 void to_json(nlohmann::json &j, const access &a);
 void to_json(nlohmann::json &j, const bracket_note &b);
 void to_json(nlohmann::json &j, const std::vector<bracket_note> &bs);
@@ -581,9 +807,29 @@ void to_json(nlohmann::json &j, const uarch_config &config);
 void to_json(nlohmann::json &j, const machine_config &config);
 void to_json(nlohmann::json &j, const concurrency_runtime_config &config);
 void to_json(nlohmann::json &j, const htif_runtime_config &config);
+void to_json(nlohmann::json &j, const periodic_hashes_runtime_config &config);
+void to_json(nlohmann::json &j, const profile_runtime_config &config);
 void to_json(nlohmann::json &j, const machine_runtime_config &runtime);
 void to_json(nlohmann::json &j, const machine::csr &csr);
 void to_json(nlohmann::json &j, const machine_memory_range_descrs &mrds);
+void to_json(nlohmann::json &j, const periodic_root_hash &h);
+void to_json(nlohmann::json &j, const periodic_root_hashes &hs);
+void to_json(nlohmann::json &j, const insn_count &c);
+void to_json(nlohmann::json &j, const insn_pair_count &c);
+void to_json(nlohmann::json &j, const pc_sample &s);
+void to_json(nlohmann::json &j, const machine_profile &p);
+void to_json(nlohmann::json &j, const rollup_input &i);
+void to_json(nlohmann::json &j, const rollup_inputs &is);
+void to_json(nlohmann::json &j, const rollup_input_status &s);
+void to_json(nlohmann::json &j, const rollup_input_result &r);
+void to_json(nlohmann::json &j, const rollup_input_results &rs);
+void to_json(nlohmann::json &j, const memory_range_read &r);
+void to_json(nlohmann::json &j, const memory_range_reads &rs);
+void to_json(nlohmann::json &j, const memory_range_write &w);
+void to_json(nlohmann::json &j, const memory_range_writes &ws);
+void to_json(nlohmann::json &j, const uarch_state_transition_type &type);
+void to_json(nlohmann::json &j, const uarch_state_transition &t);
+void to_json(nlohmann::json &j, const uarch_state_transitions &ts);
 
 // Extern template declarations
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, std::string &value,
@@ -624,6 +870,14 @@ extern template void ju_get_opt_field(const nlohmann::json &j, const bool &key,
     const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, htif_runtime_config &value,
     const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key,
+    periodic_hashes_runtime_config &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
+    periodic_hashes_runtime_config &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, profile_runtime_config &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, profile_runtime_config &value,
+    const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, machine_runtime_config &value,
     const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, machine_runtime_config &value,
@@ -636,6 +890,18 @@ extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &k
     not_default_constructible<machine_merkle_tree::proof_type> &value, const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
     not_default_constructible<machine_merkle_tree::proof_type> &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key,
+    machine_merkle_tree::multi_proof_type::target_type &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
+    machine_merkle_tree::multi_proof_type::target_type &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key,
+    machine_merkle_tree::multi_proof_type::targets_type &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
+    machine_merkle_tree::multi_proof_type::targets_type &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
+    not_default_constructible<machine_merkle_tree::multi_proof_type> &value, const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, access_type &value,
     const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, access_type &value,
@@ -734,6 +1000,70 @@ extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &k
     const std::string &base = "params/");
 extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
     machine_memory_range_descrs &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, periodic_root_hash &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, periodic_root_hash &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, periodic_root_hashes &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, periodic_root_hashes &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, insn_count &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, insn_count &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, insn_pair_count &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, insn_pair_count &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, pc_sample &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, pc_sample &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, machine_profile &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, machine_profile &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, rollup_input_data &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, rollup_input_data &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, std::vector<rollup_input_data> &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, std::vector<rollup_input_data> &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, memory_range_data &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, memory_range_data &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key,
+    std::vector<memory_range_data> &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key,
+    std::vector<memory_range_data> &value, const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, rollup_input_status &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, rollup_input_status &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, rollup_input_result &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, rollup_input_result &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, rollup_input_results &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, rollup_input_results &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, uarch_state_transition_type &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, uarch_state_transition_type &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, uarch_state_transition &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, uarch_state_transition &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const uint64_t &key, uarch_state_transitions &value,
+    const std::string &base = "params/");
+extern template void ju_get_opt_field(const nlohmann::json &j, const std::string &key, uarch_state_transitions &value,
+    const std::string &base = "params/");
 
 } // namespace cartesi
 
@@ -180,6 +180,19 @@ int cm_jsonrpc_verify_uarch_reset_state_transition(const cm_jsonrpc_mg_mgr *mgr,
     return cm_result_failure(err_msg);
 }
 
+int cm_jsonrpc_verify_uarch_state_transitions(const cm_jsonrpc_mg_mgr *mgr,
+    const cm_uarch_state_transition_array *transitions, const cm_machine_runtime_config *runtime_config,
+    bool one_based, char **err_msg) try {
+    const auto *cpp_mgr = convert_from_c(mgr);
+    const cartesi::uarch_state_transitions cpp_transitions = convert_from_c(transitions);
+    const cartesi::machine_runtime_config cpp_runtime = convert_from_c(runtime_config);
+    cartesi::jsonrpc_virtual_machine::verify_uarch_state_transitions(*cpp_mgr, cpp_transitions, cpp_runtime,
+        one_based);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 int cm_jsonrpc_fork(const cm_jsonrpc_mg_mgr *mgr, char **address, char **err_msg) try {
     const auto *cpp_mgr = convert_from_c(mgr);
     auto cpp_address = cartesi::jsonrpc_virtual_machine::fork(*cpp_mgr);
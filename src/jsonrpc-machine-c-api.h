@@ -126,6 +126,19 @@ CM_API int cm_jsonrpc_verify_uarch_reset_state_transition(const cm_jsonrpc_mg_mg
     const cm_access_log *log, const cm_hash *root_hash_after, const cm_machine_runtime_config *runtime_config,
     bool one_based, char **err_msg);
 
+/// \brief Checks the validity of a sequence of state transitions caused by uarch steps and uarch resets
+/// \param mgr Cartesi jsonrpc connection manager. Must be pointer to valid object
+/// \param transitions State transitions, in the order they happened
+/// \param runtime_config Runtime config to be used
+/// \param one_based Use 1-based indices when reporting errors
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring
+/// \returns 0 for successful verification, non zero code for error
+CM_API int cm_jsonrpc_verify_uarch_state_transitions(const cm_jsonrpc_mg_mgr *mgr,
+    const cm_uarch_state_transition_array *transitions, const cm_machine_runtime_config *runtime_config,
+    bool one_based, char **err_msg);
+
 /// \brief Checks the validity of a state transition
 /// \param mgr Cartesi jsonrpc connection manager. Must be pointer to valid object
 /// \param root_hash_before State hash before step
@@ -1006,6 +1006,38 @@ static json jsonrpc_machine_verify_uarch_reset_state_transition_handler(const js
     return jsonrpc_response_ok(j);
 }
 
+/// \brief JSONRPC handler for the machine.verify_uarch_state_transitions method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_verify_uarch_state_transitions_handler(const json &j, mg_connection *con,
+    http_handler_data *h) {
+    (void) con;
+    (void) h;
+    static const char *param_name[] = {"transitions", "runtime", "one_based"};
+    auto args = parse_args<cartesi::uarch_state_transitions, cartesi::optional_param<cartesi::machine_runtime_config>,
+        cartesi::optional_param<bool>>(j, param_name);
+    switch (count_args(args)) {
+        case 1:
+            cartesi::machine::verify_uarch_state_transitions(std::get<0>(args));
+            break;
+        case 2:
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            cartesi::machine::verify_uarch_state_transitions(std::get<0>(args), std::get<1>(args).value());
+            break;
+        case 3:
+            // NOLINTBEGIN(bugprone-unchecked-optional-access)
+            cartesi::machine::verify_uarch_state_transitions(std::get<0>(args), std::get<1>(args).value(),
+                std::get<2>(args).value());
+            // NOLINTEND(bugprone-unchecked-optional-access)
+            break;
+        default:
+            throw std::runtime_error{"error detecting number of arguments"};
+    }
+    return jsonrpc_response_ok(j);
+}
+
 /// \brief JSONRPC handler for the machine.get_proof method
 /// \param j JSON request object
 /// \param con Mongoose connection
@@ -1024,6 +1056,21 @@ static json jsonrpc_machine_get_proof_handler(const json &j, mg_connection *con,
     return jsonrpc_response_ok(j, h->machine->get_proof(std::get<0>(args), static_cast<int>(std::get<1>(args))));
 }
 
+/// \brief JSONRPC handler for the machine.get_multi_proof method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_get_multi_proof_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"targets"};
+    auto args = parse_args<cartesi::machine_merkle_tree::multi_proof_type::targets_type>(j, param_name);
+    return jsonrpc_response_ok(j, h->machine->get_multi_proof(std::get<0>(args)));
+}
+
 /// \brief JSONRPC handler for the machine.verify_merkle_tree method
 /// \param j JSON request object
 /// \param con Mongoose connection
@@ -1146,6 +1193,101 @@ static json jsonrpc_machine_write_virtual_memory_handler(const json &j, mg_conne
     return jsonrpc_response_ok(j);
 }
 
+/// \brief Allocates the buffers for a list of memory ranges to be read
+/// \param data Ranges to be read, which receive buffers of the requested lengths.
+/// \returns List of ranges pointing to the buffers.
+static cartesi::memory_range_reads make_memory_range_reads(std::vector<cartesi::memory_range_data> &data) {
+    cartesi::memory_range_reads reads;
+    reads.reserve(data.size());
+    for (auto &d : data) {
+        d.data.resize(d.length);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reads.push_back({d.address, reinterpret_cast<unsigned char *>(d.data.data()), d.length});
+    }
+    return reads;
+}
+
+/// \brief Points a list of memory ranges at the data decoded from JSON
+/// \param data Ranges decoded from JSON.
+/// \returns List of ranges pointing to the data.
+static cartesi::memory_range_writes make_memory_range_writes(const std::vector<cartesi::memory_range_data> &data) {
+    cartesi::memory_range_writes writes;
+    writes.reserve(data.size());
+    for (const auto &d : data) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        writes.push_back({d.address, reinterpret_cast<const unsigned char *>(d.data.data()), d.data.size()});
+    }
+    return writes;
+}
+
+/// \brief JSONRPC handler for the machine.read_memory_ranges method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_read_memory_ranges_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"ranges"};
+    auto args = parse_args<std::vector<cartesi::memory_range_data>>(j, param_name);
+    auto &data = std::get<0>(args);
+    h->machine->read_memory_ranges(make_memory_range_reads(data));
+    return jsonrpc_response_ok(j, make_memory_range_writes(data));
+}
+
+/// \brief JSONRPC handler for the machine.write_memory_ranges method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_write_memory_ranges_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"ranges"};
+    auto args = parse_args<std::vector<cartesi::memory_range_data>>(j, param_name);
+    h->machine->write_memory_ranges(make_memory_range_writes(std::get<0>(args)));
+    return jsonrpc_response_ok(j);
+}
+
+/// \brief JSONRPC handler for the machine.read_virtual_memory_ranges method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_read_virtual_memory_ranges_handler(const json &j, mg_connection *con,
+    http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"ranges"};
+    auto args = parse_args<std::vector<cartesi::memory_range_data>>(j, param_name);
+    auto &data = std::get<0>(args);
+    h->machine->read_virtual_memory_ranges(make_memory_range_reads(data));
+    return jsonrpc_response_ok(j, make_memory_range_writes(data));
+}
+
+/// \brief JSONRPC handler for the machine.write_virtual_memory_ranges method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_write_virtual_memory_ranges_handler(const json &j, mg_connection *con,
+    http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"ranges"};
+    auto args = parse_args<std::vector<cartesi::memory_range_data>>(j, param_name);
+    h->machine->write_virtual_memory_ranges(make_memory_range_writes(std::get<0>(args)));
+    return jsonrpc_response_ok(j);
+}
+
 /// \brief JSONRPC handler for the machine.replace_memory_range method
 /// \param j JSON request object
 /// \param con Mongoose connection
@@ -1162,6 +1304,22 @@ static json jsonrpc_machine_replace_memory_range_handler(const json &j, mg_conne
     return jsonrpc_response_ok(j);
 }
 
+/// \brief JSONRPC handler for the machine.clear_memory_range method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_clear_memory_range_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"start", "length"};
+    auto args = parse_args<uint64_t, uint64_t>(j, param_name);
+    h->machine->clear_memory_range(std::get<0>(args), std::get<1>(args));
+    return jsonrpc_response_ok(j);
+}
+
 /// \brief JSONRPC handler for the machine.read_csr method
 /// \param j JSON request object
 /// \param con Mongoose connection
@@ -1603,6 +1761,78 @@ static json jsonrpc_machine_get_memory_ranges_handler(const json &j, mg_connecti
     return jsonrpc_response_ok(j, h->machine->get_memory_ranges());
 }
 
+/// \brief JSONRPC handler for the machine.get_periodic_root_hashes method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_get_periodic_root_hashes_handler(const json &j, mg_connection *con,
+    http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    jsonrpc_check_no_params(j);
+    return jsonrpc_response_ok(j, h->machine->get_periodic_root_hashes());
+}
+
+/// \brief JSONRPC handler for the machine.get_profile method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_get_profile_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    jsonrpc_check_no_params(j);
+    return jsonrpc_response_ok(j, h->machine->get_profile());
+}
+
+/// \brief JSONRPC handler for the machine.advance_rollup method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_advance_rollup_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"inputs", "mcycle_end"};
+    auto args = parse_args<std::vector<cartesi::rollup_input_data>, uint64_t>(j, param_name);
+    const auto &data = std::get<0>(args);
+    cartesi::rollup_inputs inputs;
+    inputs.reserve(data.size());
+    for (const auto &d : data) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        inputs.push_back({reinterpret_cast<const unsigned char *>(d.metadata.data()), d.metadata.size(),
+            reinterpret_cast<const unsigned char *>(d.payload.data()), d.payload.size()});
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+    return jsonrpc_response_ok(j, h->machine->advance_rollup(inputs, std::get<1>(args)));
+}
+
+/// \brief JSONRPC handler for the machine.inspect_rollup method
+/// \param j JSON request object
+/// \param con Mongoose connection
+/// \param h Handler data
+/// \returns JSON response object
+static json jsonrpc_machine_inspect_rollup_handler(const json &j, mg_connection *con, http_handler_data *h) {
+    (void) con;
+    if (!h->machine) {
+        return jsonrpc_response_invalid_request(j, "no machine");
+    }
+    static const char *param_name[] = {"query", "mcycle_end"};
+    auto args = parse_args<std::string, uint64_t>(j, param_name);
+    auto bin = cartesi::decode_base64(std::get<0>(args));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return jsonrpc_response_ok(j,
+        h->machine->inspect_rollup(reinterpret_cast<const unsigned char *>(bin.data()), bin.size(),
+            std::get<1>(args)));
+}
+
 /// \brief Sends a JSONRPC response through the Mongoose connection
 /// \param con Mongoose connection
 /// \param j JSON response object
@@ -1644,16 +1874,23 @@ static json jsonrpc_dispatch_method(const json &j, mg_connection *con, http_hand
         {"machine.log_uarch_reset", jsonrpc_machine_log_uarch_reset_handler},
         {"machine.verify_uarch_reset_log", jsonrpc_machine_verify_uarch_reset_log_handler},
         {"machine.verify_uarch_reset_state_transition", jsonrpc_machine_verify_uarch_reset_state_transition_handler},
+        {"machine.verify_uarch_state_transitions", jsonrpc_machine_verify_uarch_state_transitions_handler},
         {"machine.verify_uarch_step_log", jsonrpc_machine_verify_uarch_step_log_handler},
         {"machine.verify_uarch_step_state_transition", jsonrpc_machine_verify_uarch_step_state_transition_handler},
         {"machine.get_proof", jsonrpc_machine_get_proof_handler},
+        {"machine.get_multi_proof", jsonrpc_machine_get_multi_proof_handler},
         {"machine.get_root_hash", jsonrpc_machine_get_root_hash_handler},
         {"machine.read_word", jsonrpc_machine_read_word_handler},
         {"machine.read_memory", jsonrpc_machine_read_memory_handler},
         {"machine.write_memory", jsonrpc_machine_write_memory_handler},
         {"machine.read_virtual_memory", jsonrpc_machine_read_virtual_memory_handler},
         {"machine.write_virtual_memory", jsonrpc_machine_write_virtual_memory_handler},
+        {"machine.read_memory_ranges", jsonrpc_machine_read_memory_ranges_handler},
+        {"machine.write_memory_ranges", jsonrpc_machine_write_memory_ranges_handler},
+        {"machine.read_virtual_memory_ranges", jsonrpc_machine_read_virtual_memory_ranges_handler},
+        {"machine.write_virtual_memory_ranges", jsonrpc_machine_write_virtual_memory_ranges_handler},
         {"machine.replace_memory_range", jsonrpc_machine_replace_memory_range_handler},
+        {"machine.clear_memory_range", jsonrpc_machine_clear_memory_range_handler},
         {"machine.read_csr", jsonrpc_machine_read_csr_handler},
         {"machine.write_csr", jsonrpc_machine_write_csr_handler},
         {"machine.get_csr_address", jsonrpc_machine_get_csr_address_handler},
@@ -1682,6 +1919,10 @@ static json jsonrpc_dispatch_method(const json &j, mg_connection *con, http_hand
         {"machine.verify_merkle_tree", jsonrpc_machine_verify_merkle_tree_handler},
         {"machine.verify_dirty_page_maps", jsonrpc_machine_verify_dirty_page_maps_handler},
         {"machine.get_memory_ranges", jsonrpc_machine_get_memory_ranges_handler},
+        {"machine.get_periodic_root_hashes", jsonrpc_machine_get_periodic_root_hashes_handler},
+        {"machine.get_profile", jsonrpc_machine_get_profile_handler},
+        {"machine.advance_rollup", jsonrpc_machine_advance_rollup_handler},
+        {"machine.inspect_rollup", jsonrpc_machine_inspect_rollup_handler},
     };
     auto method = j["method"].get<std::string>();
     SLOG(debug) << h->server_address << " handling \"" << method << "\" method";
@@ -320,12 +320,27 @@ void jsonrpc_virtual_machine::verify_uarch_reset_state_transition(const jsonrpc_
         std::tie(b64_root_hash_before, log, b64_root_hash_after, runtime, one_based), result);
 }
 
+void jsonrpc_virtual_machine::verify_uarch_state_transitions(const jsonrpc_mg_mgr_ptr &mgr,
+    const uarch_state_transitions &transitions, const machine_runtime_config &runtime, bool one_based) {
+    bool result = false;
+    jsonrpc_request(mgr->get_mgr(), mgr->get_remote_address(), "machine.verify_uarch_state_transitions",
+        std::tie(transitions, runtime, one_based), result);
+}
+
 interpreter_break_reason jsonrpc_virtual_machine::do_run(uint64_t mcycle_end) {
     interpreter_break_reason result = interpreter_break_reason::failed;
     jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.run", std::tie(mcycle_end), result);
     return result;
 }
 
+interpreter_break_reason jsonrpc_virtual_machine::do_run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end,
+    uint64_t period) {
+    (void) reference;
+    (void) mcycle_end;
+    (void) period;
+    throw std::runtime_error("lockstep co-simulation requires local machines");
+}
+
 void jsonrpc_virtual_machine::do_store(const std::string &directory) {
     bool result = false;
     jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.store", std::tie(directory), result);
@@ -430,6 +445,47 @@ void jsonrpc_virtual_machine::do_write_virtual_memory(uint64_t address, const un
         std::tie(address, b64), result);
 }
 
+/// \brief Copies the chunks returned by the server into the buffers of the ranges that were read
+/// \param ranges Ranges that were read.
+/// \param chunks Chunks returned by the server.
+static void copy_memory_range_data(const memory_range_reads &ranges, const std::vector<memory_range_data> &chunks) {
+    if (chunks.size() != ranges.size()) {
+        throw std::runtime_error("jsonrpc server error: invalid number of memory ranges");
+    }
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (chunks[i].data.size() != ranges[i].length) {
+            throw std::runtime_error("jsonrpc server error: invalid decoded base64 data length");
+        }
+        std::memcpy(ranges[i].data, chunks[i].data.data(), ranges[i].length);
+    }
+}
+
+void jsonrpc_virtual_machine::do_read_memory_ranges(const memory_range_reads &ranges) const {
+    std::vector<memory_range_data> result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.read_memory_ranges", std::tie(ranges),
+        result);
+    copy_memory_range_data(ranges, result);
+}
+
+void jsonrpc_virtual_machine::do_write_memory_ranges(const memory_range_writes &ranges) {
+    bool result = false;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.write_memory_ranges", std::tie(ranges),
+        result);
+}
+
+void jsonrpc_virtual_machine::do_read_virtual_memory_ranges(const memory_range_reads &ranges) const {
+    std::vector<memory_range_data> result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.read_virtual_memory_ranges",
+        std::tie(ranges), result);
+    copy_memory_range_data(ranges, result);
+}
+
+void jsonrpc_virtual_machine::do_write_virtual_memory_ranges(const memory_range_writes &ranges) {
+    bool result = false;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.write_virtual_memory_ranges",
+        std::tie(ranges), result);
+}
+
 uint64_t jsonrpc_virtual_machine::do_read_pc(void) const {
     return read_csr(csr::pc);
 }
@@ -829,12 +885,29 @@ machine_merkle_tree::proof_type jsonrpc_virtual_machine::do_get_proof(uint64_t a
     return std::move(result).value();
 }
 
+machine_merkle_tree::multi_proof_type jsonrpc_virtual_machine::do_get_multi_proof(
+    const machine_merkle_tree::multi_proof_type::targets_type &targets) const {
+    not_default_constructible<machine_merkle_tree::multi_proof_type> result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.get_multi_proof", std::tie(targets),
+        result);
+    if (!result.has_value()) {
+        throw std::runtime_error("jsonrpc server error: missing result");
+    }
+    return std::move(result).value();
+}
+
 void jsonrpc_virtual_machine::do_replace_memory_range(const memory_range_config &new_range) {
     bool result = false;
     jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.replace_memory_range", std::tie(new_range),
         result);
 }
 
+void jsonrpc_virtual_machine::do_clear_memory_range(uint64_t start, uint64_t length) {
+    bool result = false;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.clear_memory_range",
+        std::tie(start, length), result);
+}
+
 access_log jsonrpc_virtual_machine::do_log_uarch_step(const access_log::type &log_type, bool one_based) {
     not_default_constructible<access_log> result;
     jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.log_uarch_step",
@@ -917,6 +990,35 @@ machine_memory_range_descrs jsonrpc_virtual_machine::do_get_memory_ranges(void)
     return result;
 }
 
+periodic_root_hashes jsonrpc_virtual_machine::do_get_periodic_root_hashes(void) {
+    periodic_root_hashes result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.get_periodic_root_hashes", std::tie(),
+        result);
+    return result;
+}
+
+machine_profile jsonrpc_virtual_machine::do_get_profile(void) const {
+    machine_profile result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.get_profile", std::tie(), result);
+    return result;
+}
+
+rollup_input_results jsonrpc_virtual_machine::do_advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) {
+    rollup_input_results result;
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.advance_rollup",
+        std::tie(inputs, mcycle_end), result);
+    return result;
+}
+
+rollup_input_result jsonrpc_virtual_machine::do_inspect_rollup(const unsigned char *query, uint64_t length,
+    uint64_t mcycle_end) {
+    rollup_input_result result;
+    auto b64 = encode_base64(query, length);
+    jsonrpc_request(m_mgr->get_mgr(), m_mgr->get_remote_address(), "machine.inspect_rollup",
+        std::tie(b64, mcycle_end), result);
+    return result;
+}
+
 #pragma GCC diagnostic pop
 
 } // namespace cartesi
@@ -23,6 +23,7 @@
 
 #include "i-virtual-machine.h"
 #include "semantic-version.h"
+#include "uarch-state-transition.h"
 
 namespace cartesi {
 
@@ -66,6 +67,9 @@ public:
         const access_log &log, const hash_type &root_hash_after, const machine_runtime_config &r = {},
         bool one_based = false);
 
+    static void verify_uarch_state_transitions(const jsonrpc_mg_mgr_ptr &mgr,
+        const uarch_state_transitions &transitions, const machine_runtime_config &r = {}, bool one_based = false);
+
     static std::string fork(const jsonrpc_mg_mgr_ptr &mgr);
     static uint64_t get_x_address(const jsonrpc_mg_mgr_ptr &mgr, int i);
     static uint64_t get_f_address(const jsonrpc_mg_mgr_ptr &mgr, int i);
@@ -76,6 +80,8 @@ private:
     machine_config do_get_initial_config(void) const override;
 
     interpreter_break_reason do_run(uint64_t mcycle_end) override;
+    interpreter_break_reason do_run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end,
+        uint64_t period) override;
     void do_store(const std::string &dir) override;
     uint64_t do_read_csr(csr r) const override;
     void do_write_csr(csr w, uint64_t val) override;
@@ -87,6 +93,10 @@ private:
     void do_write_memory(uint64_t address, const unsigned char *data, size_t length) override;
     void do_read_virtual_memory(uint64_t address, unsigned char *data, uint64_t length) const override;
     void do_write_virtual_memory(uint64_t address, const unsigned char *data, size_t length) override;
+    void do_read_memory_ranges(const memory_range_reads &ranges) const override;
+    void do_write_memory_ranges(const memory_range_writes &ranges) override;
+    void do_read_virtual_memory_ranges(const memory_range_reads &ranges) const override;
+    void do_write_virtual_memory_ranges(const memory_range_writes &ranges) override;
     uint64_t do_read_pc(void) const override;
     void do_write_pc(uint64_t val) override;
     uint64_t do_read_fcsr(void) const override;
@@ -180,7 +190,10 @@ private:
     void do_write_plic_girqsrvd(uint64_t val) override;
     void do_get_root_hash(hash_type &hash) const override;
     machine_merkle_tree::proof_type do_get_proof(uint64_t address, int log2_size) const override;
+    machine_merkle_tree::multi_proof_type do_get_multi_proof(
+        const machine_merkle_tree::multi_proof_type::targets_type &targets) const override;
     void do_replace_memory_range(const memory_range_config &new_range) override;
+    void do_clear_memory_range(uint64_t start, uint64_t length) override;
     access_log do_log_uarch_step(const access_log::type &log_type, bool /*one_based = false*/) override;
     void do_destroy() override;
     void do_snapshot() override;
@@ -196,6 +209,10 @@ private:
     void do_write_uarch_cycle(uint64_t val) override;
     uarch_interpreter_break_reason do_run_uarch(uint64_t uarch_cycle_end) override;
     machine_memory_range_descrs do_get_memory_ranges(void) const override;
+    periodic_root_hashes do_get_periodic_root_hashes(void) override;
+    machine_profile do_get_profile(void) const override;
+    rollup_input_results do_advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) override;
+    rollup_input_result do_inspect_rollup(const unsigned char *query, uint64_t length, uint64_t mcycle_end) override;
 
     jsonrpc_mg_mgr_ptr m_mgr;
 };
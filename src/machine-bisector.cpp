@@ -0,0 +1,140 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "machine-bisector.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#include "machine-config.h"
+#include "os.h"
+#include "pma-constants.h"
+
+namespace cartesi {
+
+machine_bisector::machine_bisector(std::string directory, std::string checkpoints_directory,
+    const machine_runtime_config &runtime, uint64_t max_checkpoints, uint64_t min_checkpoint_distance) :
+    m_directory(std::move(directory)),
+    m_checkpoints_directory(std::move(checkpoints_directory)),
+    m_runtime(runtime),
+    m_max_checkpoints(max_checkpoints),
+    m_min_checkpoint_distance(
+        min_checkpoint_distance != 0 ? min_checkpoint_distance : default_min_checkpoint_distance),
+    m_machine(std::make_unique<machine>(m_directory, m_runtime)) {
+    m_initial_mcycle = m_machine->read_mcycle();
+}
+
+machine_bisector::~machine_bisector() {
+    for (const auto &[mcycle, c] : m_checkpoints) {
+        remove_checkpoint(c);
+    }
+}
+
+/// \brief Lists the files written by machine::store()
+/// \param dir Directory where the machine was stored.
+/// \returns Names of the files, including the ones that might be missing.
+static std::vector<std::string> get_stored_files(const std::string &dir) {
+    const auto c = machine_config::load(dir);
+    std::vector<std::string> files{machine_config::get_config_filename(dir), dir + "/hash", c.dtb.image_filename,
+        c.ram.image_filename, c.tlb.image_filename,
+        machine_config::get_image_filename(dir, PMA_UARCH_RAM_START, PMA_UARCH_RAM_LENGTH)};
+    for (const auto &f : c.flash_drive) {
+        files.push_back(f.image_filename);
+    }
+    if (c.rollup.has_value()) {
+        const auto &r = c.rollup.value();
+        for (const auto *m : {&r.rx_buffer, &r.tx_buffer, &r.input_metadata, &r.voucher_hashes, &r.notice_hashes}) {
+            files.push_back(m->image_filename);
+        }
+    }
+    return files;
+}
+
+void machine_bisector::remove_checkpoint(const checkpoint &c) noexcept {
+    for (const auto &f : c.files) {
+        std::remove(f.c_str());
+    }
+    os_rmdir(c.directory.c_str());
+}
+
+void machine_bisector::store_checkpoint(void) {
+    const uint64_t mcycle = m_machine->read_mcycle();
+    if (m_max_checkpoints == 0 || mcycle == m_initial_mcycle || m_checkpoints.find(mcycle) != m_checkpoints.end()) {
+        return;
+    }
+    if (m_checkpoints.size() >= m_max_checkpoints) {
+        auto lru = m_checkpoints.begin();
+        for (auto it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it) {
+            if (it->second.last_use < lru->second.last_use) {
+                lru = it;
+            }
+        }
+        remove_checkpoint(lru->second);
+        m_checkpoints.erase(lru);
+    }
+    checkpoint c;
+    c.directory = m_checkpoints_directory + "/" + std::to_string(mcycle);
+    try {
+        m_machine->store(c.directory);
+        c.files = get_stored_files(c.directory);
+    } catch (...) {
+        remove_checkpoint(c);
+        throw;
+    }
+    c.last_use = ++m_use_count;
+    m_checkpoints.emplace(mcycle, std::move(c));
+}
+
+machine_bisector::hash_type machine_bisector::get_root_hash(uint64_t mcycle) {
+    if (mcycle < m_initial_mcycle) {
+        throw std::invalid_argument{"mcycle is before the stored machine"};
+    }
+    // Nearest stored state at or before mcycle
+    uint64_t nearest_mcycle = m_initial_mcycle;
+    const std::string *nearest_directory = &m_directory;
+    auto it = m_checkpoints.upper_bound(mcycle);
+    if (it != m_checkpoints.begin()) {
+        --it;
+        nearest_mcycle = it->first;
+        nearest_directory = &it->second.directory;
+        it->second.last_use = ++m_use_count;
+    }
+    // Reload only if the working machine went past mcycle or is behind the nearest stored state
+    const uint64_t current_mcycle = m_machine->read_mcycle();
+    if (current_mcycle > mcycle || current_mcycle < nearest_mcycle) {
+        m_machine.reset();
+        m_machine = std::make_unique<machine>(*nearest_directory, m_runtime);
+    }
+    if (m_machine->read_mcycle() < mcycle) {
+        // A checkpoint close to the nearest stored state saves less replay than it costs to store and load
+        if (m_machine->read_mcycle() - nearest_mcycle >= m_min_checkpoint_distance) {
+            store_checkpoint();
+        }
+        for (;;) {
+            const auto break_reason = m_machine->run(mcycle);
+            if (break_reason != interpreter_break_reason::yielded_automatically &&
+                break_reason != interpreter_break_reason::yielded_softly) {
+                break;
+            }
+        }
+    }
+    hash_type hash;
+    m_machine->get_root_hash(hash);
+    return hash;
+}
+
+} // namespace cartesi
@@ -0,0 +1,119 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MACHINE_BISECTOR_H
+#define MACHINE_BISECTOR_H
+
+/// \file
+/// \brief Root hashes at arbitrary mcycles, for bisecting disputes.
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "machine-merkle-tree.h"
+#include "machine-runtime-config.h"
+#include "machine.h"
+
+namespace cartesi {
+
+/// \class machine_bisector
+/// \brief Answers "root hash at mcycle X" queries about a stored machine.
+/// \details Queries are answered by running a working machine forward from the nearest state at or before X.
+/// That state is the working machine itself, when it has not gone past X, or a checkpoint. Before the working
+/// machine moves forward, its current state is stored as a checkpoint, unless it is already one. During a
+/// bisection, each query therefore replays at most the remaining half of the search interval, so finding the first
+/// divergent mcycle among n replays O(n) cycles in O(log n) queries, instead of O(n log n) cycles when replaying from
+/// the start every time.
+/// At most max_checkpoints checkpoints are kept. When one more is needed, the least recently used one is removed.
+/// Checkpoints are stored with machine::store() under the checkpoints directory, so placing it on a memory-backed
+/// filesystem keeps them in memory.
+class machine_bisector final {
+public:
+    /// \brief Type of hash
+    using hash_type = machine_merkle_tree::hash_type;
+
+    /// \brief Default minimum number of cycles between checkpoints
+    /// \details Storing and loading a checkpoint takes about as long as replaying this many cycles.
+    static constexpr uint64_t default_min_checkpoint_distance = UINT64_C(1) << 26;
+
+    /// \brief Constructor
+    /// \param directory Directory of the stored machine at the start of the disputed range.
+    /// \param checkpoints_directory Existing directory under which checkpoints are stored.
+    /// \param runtime Runtime configuration for each machine the bisector loads.
+    /// \param max_checkpoints Maximum number of checkpoints kept at once, besides the stored machine itself.
+    /// \param min_checkpoint_distance Minimum number of cycles between a new checkpoint and the nearest stored state
+    /// before it, or 0 for default_min_checkpoint_distance.
+    machine_bisector(std::string directory, std::string checkpoints_directory,
+        const machine_runtime_config &runtime = {}, uint64_t max_checkpoints = 16,
+        uint64_t min_checkpoint_distance = 0);
+
+    /// \brief Destructor
+    /// \details Removes all checkpoints.
+    ~machine_bisector();
+
+    machine_bisector(const machine_bisector &other) = delete;
+    machine_bisector(machine_bisector &&other) = delete;
+    machine_bisector &operator=(const machine_bisector &other) = delete;
+    machine_bisector &operator=(machine_bisector &&other) = delete;
+
+    /// \brief Obtains the root hash of the machine at a given mcycle
+    /// \param mcycle Cycle of interest, no less than get_initial_mcycle().
+    /// \returns The root hash.
+    /// \details If the machine halts or yields manually before reaching mcycle, it stays in that state, which is
+    /// the state at mcycle.
+    hash_type get_root_hash(uint64_t mcycle);
+
+    /// \brief Returns the mcycle of the stored machine
+    uint64_t get_initial_mcycle(void) const {
+        return m_initial_mcycle;
+    }
+
+    /// \brief Returns the number of checkpoints currently kept
+    uint64_t get_checkpoint_count(void) const {
+        return m_checkpoints.size();
+    }
+
+private:
+    /// \brief Stored state of the working machine at an earlier mcycle
+    struct checkpoint {
+        std::string directory;          ///< Directory where the machine was stored
+        std::vector<std::string> files; ///< Files written to directory
+        uint64_t last_use{};            ///< Value of m_use_count when the checkpoint was last used
+    };
+
+    /// \brief Stores the current state of the working machine as a checkpoint, unless it is one already
+    void store_checkpoint(void);
+
+    /// \brief Removes a checkpoint from storage
+    static void remove_checkpoint(const checkpoint &c) noexcept;
+
+    std::string m_directory;                      ///< Directory of the stored machine
+    std::string m_checkpoints_directory;          ///< Directory under which checkpoints are stored
+    machine_runtime_config m_runtime;             ///< Runtime configuration for each machine loaded
+    uint64_t m_max_checkpoints;                   ///< Maximum number of checkpoints kept at once
+    uint64_t m_min_checkpoint_distance;           ///< Minimum number of cycles between checkpoints
+    uint64_t m_initial_mcycle{};                  ///< mcycle of the stored machine
+    std::unique_ptr<machine> m_machine;           ///< Working machine
+    std::map<uint64_t, checkpoint> m_checkpoints; ///< Checkpoints indexed by mcycle
+    uint64_t m_use_count{};                       ///< Number of times a checkpoint was stored or used
+};
+
+} // namespace cartesi
+
+#endif
@@ -25,6 +25,7 @@
 #include "machine-merkle-tree.h"
 #include "machine-runtime-config.h"
 #include "semantic-version.h"
+#include "uarch-state-transition.h"
 
 /// \brief Helper function that returns error result from C api function
 int cm_result_failure(char **err_msg);
@@ -62,6 +63,9 @@ cm_access_log *convert_to_c(const cartesi::access_log &cpp_access_log);
 /// \brief Helper function converts access log to C api structure
 cartesi::access_log convert_from_c(const cm_access_log *c_acc_log);
 
+/// \brief Helper function that parses uarch state transitions from C api structure
+cartesi::uarch_state_transitions convert_from_c(const cm_uarch_state_transition_array *c_transitions);
+
 /// \brief Helper function converts C++ string to allocated C string
 char *convert_to_c(const std::string &cpp_str);
 
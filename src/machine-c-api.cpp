@@ -18,6 +18,7 @@
 #include "machine-c-api-internal.h"
 
 #include <any>
+#include <cstddef>
 #include <cstring>
 #include <exception>
 #include <functional>
@@ -30,6 +31,7 @@
 #include <utility>
 
 #include "i-virtual-machine.h"
+#include "machine-bisector.h"
 #include "machine-config.h"
 #include "machine.h"
 #include "semantic-version.h"
@@ -474,8 +476,13 @@ cartesi::machine_runtime_config convert_from_c(const cm_machine_runtime_config *
     }
     cartesi::machine_runtime_config new_cpp_machine_runtime_config{};
     new_cpp_machine_runtime_config.concurrency =
-        cartesi::concurrency_runtime_config{c_config->concurrency.update_merkle_tree};
+        cartesi::concurrency_runtime_config{c_config->concurrency.update_merkle_tree,
+            c_config->concurrency.verify_uarch_state_transitions};
     new_cpp_machine_runtime_config.htif = cartesi::htif_runtime_config{c_config->htif.no_console_putchar};
+    new_cpp_machine_runtime_config.periodic_hashes =
+        cartesi::periodic_hashes_runtime_config{c_config->periodic_hashes.period, c_config->periodic_hashes.start};
+    new_cpp_machine_runtime_config.profile =
+        cartesi::profile_runtime_config{c_config->profile.enabled, c_config->profile.pc_sample_period};
     new_cpp_machine_runtime_config.skip_root_hash_check = c_config->skip_root_hash_check;
     new_cpp_machine_runtime_config.skip_version_check = c_config->skip_version_check;
     new_cpp_machine_runtime_config.soft_yield = c_config->soft_yield;
@@ -607,35 +614,76 @@ static int cm_log2_size_to_index(int log2_size, int log2_target_size) {
     return index;
 }
 
+/// \brief Copies a proof into a C proof whose sibling hashes entry has room for all sibling hashes
+static void copy_to_c(const cartesi::machine_merkle_tree::proof_type &proof, cm_merkle_tree_proof *c_proof) {
+    c_proof->log2_root_size = proof.get_log2_root_size();
+    c_proof->log2_target_size = proof.get_log2_target_size();
+    c_proof->target_address = proof.get_target_address();
+
+    memcpy(&c_proof->root_hash, static_cast<const uint8_t *>(proof.get_root_hash().data()), sizeof(cm_hash));
+    memcpy(&c_proof->target_hash, static_cast<const uint8_t *>(proof.get_target_hash().data()), sizeof(cm_hash));
+
+    c_proof->sibling_hashes.count = c_proof->log2_root_size - c_proof->log2_target_size;
+    for (size_t log2_size = c_proof->log2_target_size; log2_size < c_proof->log2_root_size; ++log2_size) {
+        const int current_index =
+            cm_log2_size_to_index(static_cast<int>(log2_size), static_cast<int>(c_proof->log2_target_size));
+        const cartesi::machine_merkle_tree::hash_type &sibling_hash =
+            proof.get_sibling_hash(static_cast<int>(log2_size));
+        memcpy(&(c_proof->sibling_hashes.entry[current_index]), static_cast<const uint8_t *>(sibling_hash.data()),
+            sizeof(cm_hash));
+    }
+}
+
 static cm_merkle_tree_proof *convert_to_c(const cartesi::machine_merkle_tree::proof_type &proof) {
     auto *new_merkle_tree_proof = new cm_merkle_tree_proof{};
+    const auto sibling_hashes_count = proof.get_log2_root_size() - proof.get_log2_target_size();
+    new_merkle_tree_proof->sibling_hashes.entry = new cm_hash[sibling_hashes_count]{};
+    copy_to_c(proof, new_merkle_tree_proof);
+    return new_merkle_tree_proof;
+}
 
-    new_merkle_tree_proof->log2_root_size = proof.get_log2_root_size();
-    new_merkle_tree_proof->log2_target_size = proof.get_log2_target_size();
-    new_merkle_tree_proof->target_address = proof.get_target_address();
+static cm_merkle_tree_multi_proof *convert_to_c(const cartesi::machine_merkle_tree::multi_proof_type &proof) {
+    auto *new_merkle_tree_multi_proof = new cm_merkle_tree_multi_proof{};
 
-    memcpy(&new_merkle_tree_proof->root_hash, static_cast<const uint8_t *>(proof.get_root_hash().data()),
-        sizeof(cm_hash));
-    memcpy(&new_merkle_tree_proof->target_hash, static_cast<const uint8_t *>(proof.get_target_hash().data()),
+    new_merkle_tree_multi_proof->log2_root_size = proof.get_log2_root_size();
+    memcpy(&new_merkle_tree_multi_proof->root_hash, static_cast<const uint8_t *>(proof.get_root_hash().data()),
         sizeof(cm_hash));
 
-    new_merkle_tree_proof->sibling_hashes.count =
-        new_merkle_tree_proof->log2_root_size - new_merkle_tree_proof->log2_target_size;
-    new_merkle_tree_proof->sibling_hashes.entry = new cm_hash[new_merkle_tree_proof->sibling_hashes.count];
-    memset(new_merkle_tree_proof->sibling_hashes.entry, 0,
-        sizeof(cm_hash) * new_merkle_tree_proof->sibling_hashes.count);
-
-    for (size_t log2_size = new_merkle_tree_proof->log2_target_size; log2_size < new_merkle_tree_proof->log2_root_size;
-         ++log2_size) {
-        const int current_index = cm_log2_size_to_index(static_cast<int>(log2_size),
-            static_cast<int>(new_merkle_tree_proof->log2_target_size));
-        const cartesi::machine_merkle_tree::hash_type sibling_hash =
-            proof.get_sibling_hash(static_cast<int>(log2_size));
-        memcpy(&(new_merkle_tree_proof->sibling_hashes.entry[current_index]),
-            static_cast<const uint8_t *>(sibling_hash.data()), sizeof(cm_hash));
+    const auto &targets = proof.get_targets();
+    new_merkle_tree_multi_proof->targets.count = targets.size();
+    new_merkle_tree_multi_proof->targets.entry = new cm_merkle_tree_multi_proof_target[targets.size()]{};
+    for (size_t i = 0; i < targets.size(); ++i) {
+        auto &target = new_merkle_tree_multi_proof->targets.entry[i];
+        target.address = targets[i].address;
+        target.log2_size = targets[i].log2_size;
+        memcpy(&target.hash, static_cast<const uint8_t *>(proof.get_target_hashes()[i].data()), sizeof(cm_hash));
     }
 
-    return new_merkle_tree_proof;
+    const auto &sibling_hashes = proof.get_sibling_hashes();
+    new_merkle_tree_multi_proof->sibling_hashes.count = sibling_hashes.size();
+    new_merkle_tree_multi_proof->sibling_hashes.entry = new cm_hash[sibling_hashes.size()]{};
+    for (size_t i = 0; i < sibling_hashes.size(); ++i) {
+        memcpy(&new_merkle_tree_multi_proof->sibling_hashes.entry[i],
+            static_cast<const uint8_t *>(sibling_hashes[i].data()), sizeof(cm_hash));
+    }
+
+    return new_merkle_tree_multi_proof;
+}
+
+static cartesi::machine_merkle_tree::multi_proof_type::targets_type convert_from_c(
+    const cm_merkle_tree_multi_proof_target_array *c_targets) {
+    if (c_targets == nullptr) {
+        throw std::invalid_argument("invalid targets");
+    }
+    if (c_targets->count > 0 && c_targets->entry == nullptr) {
+        throw std::invalid_argument("invalid targets entries");
+    }
+    cartesi::machine_merkle_tree::multi_proof_type::targets_type targets;
+    targets.reserve(c_targets->count);
+    for (size_t i = 0; i < c_targets->count; ++i) {
+        targets.push_back({c_targets->entry[i].address, c_targets->entry[i].log2_size});
+    }
+    return targets;
 }
 
 // ----------------------------------------------
@@ -811,6 +859,127 @@ cm_access_log *convert_to_c(const cartesi::access_log &cpp_access_log) {
     return new_access_log;
 }
 
+/// \brief Storage for access logs that is reused across calls to avoid allocations
+/// \details All pointers in log point into the vectors below. The vectors are only ever resized,
+/// so once their capacities fit the logs being produced, filling the buffer does not allocate.
+struct cm_access_log_buffer_tag {
+    cm_access_log log{};
+    std::vector<cm_access> accesses;
+    std::vector<cm_hash_array> sibling_hash_arrays;
+    std::vector<uint8_t> hashes;
+    std::vector<uint8_t> data;
+    std::vector<cm_bracket_note> brackets;
+    std::vector<const char *> notes;
+    std::vector<char> text;
+};
+
+/// \brief Copies an access log into a reusable buffer
+/// \returns Pointer to the log stored in the buffer
+static const cm_access_log *copy_to_c(const cartesi::access_log &cpp_access_log, cm_access_log_buffer *buffer) {
+    const auto &cpp_accesses = cpp_access_log.get_accesses();
+    const auto &cpp_brackets = cpp_access_log.get_brackets();
+    const auto &cpp_notes = cpp_access_log.get_notes();
+    // Size all storage up front so pointers taken below remain valid
+    size_t hashes_count = 0;
+    size_t data_size = 0;
+    for (const auto &a : cpp_accesses) {
+        if (a.get_sibling_hashes().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            hashes_count += a.get_sibling_hashes()->size();
+        }
+        if (a.get_read().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            data_size += a.get_read()->size();
+        }
+        if (a.get_written().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            data_size += a.get_written()->size();
+        }
+    }
+    size_t text_size = 0;
+    for (const auto &b : cpp_brackets) {
+        text_size += b.text.size() + 1;
+    }
+    for (const auto &n : cpp_notes) {
+        text_size += n.size() + 1;
+    }
+    buffer->accesses.resize(cpp_accesses.size());
+    buffer->sibling_hash_arrays.resize(cpp_accesses.size());
+    buffer->hashes.resize(hashes_count * sizeof(cm_hash));
+    buffer->data.resize(data_size);
+    buffer->brackets.resize(cpp_brackets.size());
+    buffer->notes.resize(cpp_notes.size());
+    buffer->text.resize(text_size);
+    auto *next_hash = reinterpret_cast<cm_hash *>(buffer->hashes.data());
+    uint8_t *next_data = buffer->data.data();
+    char *next_text = buffer->text.data();
+    const auto copy_data = [&next_data](const cartesi::access_data &d, uint8_t **c_data, size_t *c_size) {
+        *c_size = d.size();
+        *c_data = d.empty() ? nullptr : next_data;
+        memcpy(next_data, d.data(), d.size());
+        next_data += d.size();
+    };
+    const auto copy_text = [&next_text](const std::string &t) {
+        char *c_text = next_text;
+        memcpy(c_text, t.c_str(), t.size() + 1);
+        next_text += t.size() + 1;
+        return c_text;
+    };
+    for (size_t i = 0; i < cpp_accesses.size(); ++i) {
+        const auto &a = cpp_accesses[i];
+        auto &c_access = buffer->accesses[i];
+        c_access = cm_access{};
+        c_access.type = convert_to_c(a.get_type());
+        c_access.address = a.get_address();
+        c_access.log2_size = a.get_log2_size();
+        memcpy(&c_access.read_hash, static_cast<const uint8_t *>(a.get_read_hash().data()), sizeof(cm_hash));
+        if (a.get_read().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            copy_data(*a.get_read(), &c_access.read_data, &c_access.read_data_size);
+        }
+        if (a.get_written_hash().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            memcpy(&c_access.written_hash, static_cast<const uint8_t *>(a.get_written_hash()->data()),
+                sizeof(cm_hash));
+        }
+        if (a.get_written().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            copy_data(*a.get_written(), &c_access.written_data, &c_access.written_data_size);
+        }
+        if (a.get_sibling_hashes().has_value()) {
+            // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+            const auto &sibling_hashes = *a.get_sibling_hashes();
+            auto &c_sibling_hashes = buffer->sibling_hash_arrays[i];
+            c_sibling_hashes.entry = next_hash;
+            c_sibling_hashes.count = sibling_hashes.size();
+            for (const auto &h : sibling_hashes) {
+                memcpy(next_hash++, static_cast<const uint8_t *>(h.data()), sizeof(cm_hash));
+            }
+            c_access.sibling_hashes = &c_sibling_hashes;
+        }
+    }
+    for (size_t i = 0; i < cpp_brackets.size(); ++i) {
+        auto &c_bracket = buffer->brackets[i];
+        c_bracket.type = convert_to_c(cpp_brackets[i].type);
+        c_bracket.where = cpp_brackets[i].where;
+        c_bracket.text = copy_text(cpp_brackets[i].text);
+    }
+    for (size_t i = 0; i < cpp_notes.size(); ++i) {
+        buffer->notes[i] = copy_text(cpp_notes[i]);
+    }
+    auto &c_log = buffer->log;
+    c_log.accesses.entry = buffer->accesses.data();
+    c_log.accesses.count = buffer->accesses.size();
+    c_log.brackets.entry = buffer->brackets.data();
+    c_log.brackets.count = buffer->brackets.size();
+    c_log.notes.entry = buffer->notes.data();
+    c_log.notes.count = buffer->notes.size();
+    c_log.log_type.annotations = cpp_access_log.get_log_type().has_annotations();
+    c_log.log_type.proofs = cpp_access_log.get_log_type().has_proofs();
+    c_log.log_type.large_data = cpp_access_log.get_log_type().has_large_data();
+    return &c_log;
+}
+
 cartesi::access_log convert_from_c(const cm_access_log *c_acc_log) {
     if (c_acc_log == nullptr) {
         throw std::invalid_argument("invalid access log");
@@ -833,6 +1002,22 @@ cartesi::access_log convert_from_c(const cm_access_log *c_acc_log) {
     return new_cpp_acc_log;
 }
 
+cartesi::uarch_state_transitions convert_from_c(const cm_uarch_state_transition_array *c_transitions) {
+    if (c_transitions == nullptr || (c_transitions->count > 0 && c_transitions->entry == nullptr)) {
+        throw std::invalid_argument("invalid uarch state transitions");
+    }
+    cartesi::uarch_state_transitions new_cpp_transitions;
+    new_cpp_transitions.reserve(c_transitions->count);
+    for (size_t i = 0; i < c_transitions->count; ++i) {
+        const auto &t = c_transitions->entry[i];
+        new_cpp_transitions.push_back(cartesi::uarch_state_transition{
+            t.type == CM_UARCH_STATE_TRANSITION_RESET ? cartesi::uarch_state_transition_type::reset :
+                                                        cartesi::uarch_state_transition_type::step,
+            convert_from_c(&t.root_hash_before), convert_from_c(t.log), convert_from_c(&t.root_hash_after)});
+    }
+    return new_cpp_transitions;
+}
+
 // --------------------------------------------
 // Memory range description conversion functions
 // --------------------------------------------
@@ -854,6 +1039,50 @@ cm_memory_range_descr_array *convert_to_c(const cartesi::machine_memory_range_de
     return new_mrda;
 }
 
+// --------------------------------------------
+// Periodic root hash conversion functions
+// --------------------------------------------
+cm_periodic_root_hash_array *convert_to_c(const cartesi::periodic_root_hashes &cpp_hashes) {
+    auto *new_hashes = new cm_periodic_root_hash_array{};
+    new_hashes->count = cpp_hashes.size();
+    new_hashes->entry = new cm_periodic_root_hash[new_hashes->count]{};
+    for (size_t i = 0; i < new_hashes->count; ++i) {
+        new_hashes->entry[i].mcycle = cpp_hashes[i].mcycle;
+        memcpy(&new_hashes->entry[i].hash, static_cast<const uint8_t *>(cpp_hashes[i].hash.data()), sizeof(cm_hash));
+    }
+    return new_hashes;
+}
+
+// --------------------------------------------
+// Machine profile conversion functions
+// --------------------------------------------
+cm_machine_profile *convert_to_c(const cartesi::machine_profile &cpp_profile) {
+    auto *new_profile = new cm_machine_profile{};
+    auto &insn_counts = new_profile->insn_counts;
+    insn_counts.count = cpp_profile.insn_counts.size();
+    insn_counts.entry = new cm_insn_count[insn_counts.count]{};
+    for (size_t i = 0; i < insn_counts.count; ++i) {
+        insn_counts.entry[i].insn = convert_to_c(cpp_profile.insn_counts[i].insn);
+        insn_counts.entry[i].count = cpp_profile.insn_counts[i].count;
+    }
+    auto &insn_pair_counts = new_profile->insn_pair_counts;
+    insn_pair_counts.count = cpp_profile.insn_pair_counts.size();
+    insn_pair_counts.entry = new cm_insn_pair_count[insn_pair_counts.count]{};
+    for (size_t i = 0; i < insn_pair_counts.count; ++i) {
+        insn_pair_counts.entry[i].insn = convert_to_c(cpp_profile.insn_pair_counts[i].insn);
+        insn_pair_counts.entry[i].next_insn = convert_to_c(cpp_profile.insn_pair_counts[i].next_insn);
+        insn_pair_counts.entry[i].count = cpp_profile.insn_pair_counts[i].count;
+    }
+    auto &pc_samples = new_profile->pc_samples;
+    pc_samples.count = cpp_profile.pc_samples.size();
+    pc_samples.entry = new cm_pc_sample[pc_samples.count]{};
+    for (size_t i = 0; i < pc_samples.count; ++i) {
+        pc_samples.entry[i].pc = cpp_profile.pc_samples[i].pc;
+        pc_samples.entry[i].count = cpp_profile.pc_samples[i].count;
+    }
+    return new_profile;
+}
+
 // -----------------------------------------------------
 // Public API functions for generation of default configs
 // -----------------------------------------------------
@@ -976,6 +1205,22 @@ int cm_machine_run(cm_machine *m, uint64_t mcycle_end, CM_BREAK_REASON *break_re
     return cm_result_failure(err_msg);
 }
 
+int cm_machine_run_lockstep(cm_machine *m, cm_machine *reference, uint64_t mcycle_end, uint64_t period,
+    CM_BREAK_REASON *break_reason_result, char **err_msg) try {
+    auto *cpp_machine = convert_from_c(m);
+    auto *cpp_reference = convert_from_c(reference);
+    cartesi::interpreter_break_reason break_reason = cpp_machine->run_lockstep(*cpp_reference, mcycle_end, period);
+    if (break_reason_result) {
+        *break_reason_result = static_cast<CM_BREAK_REASON>(break_reason);
+    }
+    return cm_result_success(err_msg);
+} catch (...) {
+    if (break_reason_result) {
+        *break_reason_result = CM_BREAK_REASON_FAILED;
+    }
+    return cm_result_failure(err_msg);
+}
+
 int cm_read_uarch_x(const cm_machine *m, int i, uint64_t *val, char **err_msg) try {
     if (val == nullptr) {
         throw std::invalid_argument("invalid val output");
@@ -1033,6 +1278,22 @@ int cm_log_uarch_reset(cm_machine *m, cm_access_log_type log_type, bool one_base
     return cm_result_failure(err_msg);
 }
 
+int cm_log_uarch_reset_into(cm_machine *m, cm_access_log_type log_type, bool one_based,
+    cm_access_log_buffer *buffer, const cm_access_log **access_log, char **err_msg) try {
+    if (buffer == nullptr) {
+        throw std::invalid_argument("invalid access log buffer");
+    }
+    if (access_log == nullptr) {
+        throw std::invalid_argument("invalid access log output");
+    }
+    auto *cpp_machine = convert_from_c(m);
+    cartesi::access_log::type cpp_log_type{log_type.proofs, log_type.annotations, log_type.large_data};
+    *access_log = copy_to_c(cpp_machine->log_uarch_reset(cpp_log_type, one_based), buffer);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 int cm_machine_run_uarch(cm_machine *m, uint64_t uarch_cycle_end, CM_UARCH_BREAK_REASON *status_result,
     char **err_msg) try {
     auto *cpp_machine = convert_from_c(m);
@@ -1059,6 +1320,36 @@ int cm_log_uarch_step(cm_machine *m, cm_access_log_type log_type, bool one_based
     return cm_result_failure(err_msg);
 }
 
+int cm_log_uarch_step_into(cm_machine *m, cm_access_log_type log_type, bool one_based, cm_access_log_buffer *buffer,
+    const cm_access_log **access_log, char **err_msg) try {
+    if (buffer == nullptr) {
+        throw std::invalid_argument("invalid access log buffer");
+    }
+    if (access_log == nullptr) {
+        throw std::invalid_argument("invalid access log output");
+    }
+    auto *cpp_machine = convert_from_c(m);
+    cartesi::access_log::type cpp_log_type{log_type.proofs, log_type.annotations, log_type.large_data};
+    *access_log = copy_to_c(cpp_machine->log_uarch_step(cpp_log_type, one_based), buffer);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_new_access_log_buffer(cm_access_log_buffer **buffer, char **err_msg) try {
+    if (buffer == nullptr) {
+        throw std::invalid_argument("invalid access log buffer output");
+    }
+    *buffer = new cm_access_log_buffer{};
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+void cm_delete_access_log_buffer(cm_access_log_buffer *buffer) {
+    delete buffer;
+}
+
 void cm_delete_access_log(cm_access_log *acc_log) {
     if (acc_log == nullptr) {
         return;
@@ -1099,6 +1390,16 @@ int cm_verify_uarch_reset_log(const cm_access_log *log, const cm_machine_runtime
     return cm_result_failure(err_msg);
 }
 
+int cm_verify_uarch_state_transitions(const cm_uarch_state_transition_array *transitions,
+    const cm_machine_runtime_config *runtime_config, bool one_based, char **err_msg) try {
+    const cartesi::uarch_state_transitions cpp_transitions = convert_from_c(transitions);
+    const cartesi::machine_runtime_config cpp_runtime_config = convert_from_c(runtime_config);
+    cartesi::machine::verify_uarch_state_transitions(cpp_transitions, cpp_runtime_config, one_based);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 int cm_verify_uarch_step_state_transition(const cm_hash *root_hash_before, const cm_access_log *log,
     const cm_hash *root_hash_after, const cm_machine_runtime_config *runtime_config, bool one_based,
     char **err_msg) try {
@@ -1140,6 +1441,26 @@ int cm_get_proof(const cm_machine *m, uint64_t address, int log2_size, cm_merkle
     return cm_result_failure(err_msg);
 }
 
+int cm_get_proof_into(const cm_machine *m, uint64_t address, int log2_size, cm_merkle_tree_proof *proof,
+    char **err_msg) try {
+    if (proof == nullptr) {
+        throw std::invalid_argument("invalid proof output");
+    }
+    if (proof->sibling_hashes.entry == nullptr && proof->sibling_hashes.count > 0) {
+        throw std::invalid_argument("invalid proof sibling hashes");
+    }
+    const auto *cpp_machine = convert_from_c(m);
+    const cartesi::machine_merkle_tree::proof_type cpp_proof = cpp_machine->get_proof(address, log2_size);
+    if (proof->sibling_hashes.count <
+        static_cast<size_t>(cpp_proof.get_log2_root_size() - cpp_proof.get_log2_target_size())) {
+        throw std::length_error("proof sibling hashes buffer is too small");
+    }
+    copy_to_c(cpp_proof, proof);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 void cm_delete_merkle_tree_proof(cm_merkle_tree_proof *proof) {
     if (proof == nullptr) {
         return;
@@ -1148,6 +1469,29 @@ void cm_delete_merkle_tree_proof(cm_merkle_tree_proof *proof) {
     delete proof;
 }
 
+int cm_get_multi_proof(const cm_machine *m, const cm_merkle_tree_multi_proof_target_array *targets,
+    cm_merkle_tree_multi_proof **proof, char **err_msg) try {
+    if (proof == nullptr) {
+        throw std::invalid_argument("invalid proof output");
+    }
+    const auto *cpp_machine = convert_from_c(m);
+    const auto cpp_targets = convert_from_c(targets);
+    const cartesi::machine_merkle_tree::multi_proof_type cpp_proof = cpp_machine->get_multi_proof(cpp_targets);
+    *proof = convert_to_c(cpp_proof);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+void cm_delete_merkle_tree_multi_proof(cm_merkle_tree_multi_proof *proof) {
+    if (proof == nullptr) {
+        return;
+    }
+    delete[] proof->targets.entry;
+    delete[] proof->sibling_hashes.entry;
+    delete proof;
+}
+
 void cm_delete_semantic_version(const cm_semantic_version *version) {
     if (version == nullptr) {
         return;
@@ -1194,6 +1538,73 @@ int cm_read_csr(const cm_machine *m, CM_PROC_CSR r, uint64_t *val, char **err_ms
     return cm_result_failure(err_msg);
 }
 
+int cm_read_csrs(const cm_machine *m, const CM_PROC_CSR *csrs, uint64_t *vals, size_t count, char **err_msg) try {
+    if (count > 0 && csrs == nullptr) {
+        throw std::invalid_argument("invalid csrs");
+    }
+    if (count > 0 && vals == nullptr) {
+        throw std::invalid_argument("invalid vals output");
+    }
+    const auto *cpp_machine = convert_from_c(m);
+    for (size_t i = 0; i < count; ++i) {
+        vals[i] = cpp_machine->read_csr(static_cast<cartesi::machine::csr>(csrs[i]));
+    }
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_read_processor_state(const cm_machine *m, cm_processor_config *state, char **err_msg) try {
+    if (state == nullptr) {
+        throw std::invalid_argument("invalid state output");
+    }
+    const auto *cpp_machine = convert_from_c(m);
+    using csr = cartesi::machine::csr;
+    const auto read_csr = [cpp_machine](csr r) { return cpp_machine->read_csr(r); };
+    cartesi::processor_config p{};
+    for (int i = 0; i < cartesi::X_REG_COUNT; ++i) {
+        p.x[i] = cpp_machine->read_x(i);
+    }
+    for (int i = 0; i < cartesi::F_REG_COUNT; ++i) {
+        p.f[i] = cpp_machine->read_f(i);
+    }
+    p.pc = read_csr(csr::pc);
+    p.fcsr = read_csr(csr::fcsr);
+    p.mvendorid = read_csr(csr::mvendorid);
+    p.marchid = read_csr(csr::marchid);
+    p.mimpid = read_csr(csr::mimpid);
+    p.mcycle = read_csr(csr::mcycle);
+    p.icycleinstret = read_csr(csr::icycleinstret);
+    p.mstatus = read_csr(csr::mstatus);
+    p.mtvec = read_csr(csr::mtvec);
+    p.mscratch = read_csr(csr::mscratch);
+    p.mepc = read_csr(csr::mepc);
+    p.mcause = read_csr(csr::mcause);
+    p.mtval = read_csr(csr::mtval);
+    p.misa = read_csr(csr::misa);
+    p.mie = read_csr(csr::mie);
+    p.mip = read_csr(csr::mip);
+    p.medeleg = read_csr(csr::medeleg);
+    p.mideleg = read_csr(csr::mideleg);
+    p.mcounteren = read_csr(csr::mcounteren);
+    p.menvcfg = read_csr(csr::menvcfg);
+    p.stvec = read_csr(csr::stvec);
+    p.sscratch = read_csr(csr::sscratch);
+    p.sepc = read_csr(csr::sepc);
+    p.scause = read_csr(csr::scause);
+    p.stval = read_csr(csr::stval);
+    p.satp = read_csr(csr::satp);
+    p.scounteren = read_csr(csr::scounteren);
+    p.senvcfg = read_csr(csr::senvcfg);
+    p.ilrsc = read_csr(csr::ilrsc);
+    p.iflags = read_csr(csr::iflags);
+    p.iunrep = read_csr(csr::iunrep);
+    *state = convert_to_c(p);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 int cm_write_csr(cm_machine *m, CM_PROC_CSR w, uint64_t val, char **err_msg) try {
     auto *cpp_machine = convert_from_c(m);
     auto cpp_csr = static_cast<cartesi::machine::csr>(w);
@@ -1253,6 +1664,77 @@ int cm_write_virtual_memory(cm_machine *m, uint64_t address, const unsigned char
     return cm_result_failure(err_msg);
 }
 
+static cartesi::memory_range_reads convert_from_c(const cm_memory_range_read *c_ranges, size_t count) {
+    if (count != 0 && c_ranges == nullptr) {
+        throw std::invalid_argument("invalid memory ranges");
+    }
+    cartesi::memory_range_reads ranges(count);
+    // Both C and C++ structs are trivially copyable and have the same layout,
+    // so it is safe to copy the whole array at once
+    static_assert(std::is_trivially_copyable_v<cartesi::memory_range_read>);
+    static_assert(sizeof(cm_memory_range_read) == sizeof(cartesi::memory_range_read));
+    static_assert(offsetof(cm_memory_range_read, address) == offsetof(cartesi::memory_range_read, address));
+    static_assert(offsetof(cm_memory_range_read, data) == offsetof(cartesi::memory_range_read, data));
+    static_assert(offsetof(cm_memory_range_read, length) == offsetof(cartesi::memory_range_read, length));
+    if (count != 0) {
+        memcpy(ranges.data(), c_ranges, count * sizeof(cm_memory_range_read));
+    }
+    return ranges;
+}
+
+static cartesi::memory_range_writes convert_from_c(const cm_memory_range_write *c_ranges, size_t count) {
+    if (count != 0 && c_ranges == nullptr) {
+        throw std::invalid_argument("invalid memory ranges");
+    }
+    cartesi::memory_range_writes ranges(count);
+    // Both C and C++ structs are trivially copyable and have the same layout,
+    // so it is safe to copy the whole array at once
+    static_assert(std::is_trivially_copyable_v<cartesi::memory_range_write>);
+    static_assert(sizeof(cm_memory_range_write) == sizeof(cartesi::memory_range_write));
+    static_assert(offsetof(cm_memory_range_write, address) == offsetof(cartesi::memory_range_write, address));
+    static_assert(offsetof(cm_memory_range_write, data) == offsetof(cartesi::memory_range_write, data));
+    static_assert(offsetof(cm_memory_range_write, length) == offsetof(cartesi::memory_range_write, length));
+    if (count != 0) {
+        memcpy(ranges.data(), c_ranges, count * sizeof(cm_memory_range_write));
+    }
+    return ranges;
+}
+
+int cm_read_memory_ranges(const cm_machine *m, const cm_memory_range_read *ranges, size_t count,
+    char **err_msg) try {
+    const auto *cpp_machine = convert_from_c(m);
+    cpp_machine->read_memory_ranges(convert_from_c(ranges, count));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_write_memory_ranges(cm_machine *m, const cm_memory_range_write *ranges, size_t count, char **err_msg) try {
+    auto *cpp_machine = convert_from_c(m);
+    cpp_machine->write_memory_ranges(convert_from_c(ranges, count));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_read_virtual_memory_ranges(const cm_machine *m, const cm_memory_range_read *ranges, size_t count,
+    char **err_msg) try {
+    const auto *cpp_machine = convert_from_c(m);
+    cpp_machine->read_virtual_memory_ranges(convert_from_c(ranges, count));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_write_virtual_memory_ranges(cm_machine *m, const cm_memory_range_write *ranges, size_t count,
+    char **err_msg) try {
+    auto *cpp_machine = convert_from_c(m);
+    cpp_machine->write_virtual_memory_ranges(convert_from_c(ranges, count));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 int cm_read_x(const cm_machine *m, int i, uint64_t *val, char **err_msg) try {
     if (val == nullptr) {
         throw std::invalid_argument("invalid val output");
@@ -1514,6 +1996,14 @@ int cm_replace_memory_range(cm_machine *m, const cm_memory_range_config *new_ran
     return cm_result_failure(err_msg);
 }
 
+int cm_clear_memory_range(cm_machine *m, uint64_t start, uint64_t length, char **err_msg) try {
+    auto *cpp_machine = convert_from_c(m);
+    cpp_machine->clear_memory_range(start, length);
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
 void cm_delete_memory_range_config(const cm_memory_range_config *config) {
     if (config == nullptr) {
         return;
@@ -1596,3 +2086,228 @@ CM_API void cm_delete_memory_range_descr_array(cm_memory_range_descr_array *mrds
     delete[] mrds->entry;
     delete mrds;
 }
+
+CM_API int cm_get_periodic_root_hashes(cm_machine *m, cm_periodic_root_hash_array **hashes, char **err_msg) try {
+    if (hashes == nullptr) {
+        throw std::invalid_argument("invalid periodic root hashes output");
+    }
+    auto *cpp_machine = convert_from_c(m);
+    *hashes = convert_to_c(cpp_machine->get_periodic_root_hashes());
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+CM_API void cm_delete_periodic_root_hash_array(cm_periodic_root_hash_array *hashes) {
+    if (hashes == nullptr) {
+        return;
+    }
+    delete[] hashes->entry;
+    delete hashes;
+}
+
+CM_API int cm_get_profile(const cm_machine *m, cm_machine_profile **profile, char **err_msg) try {
+    if (profile == nullptr) {
+        throw std::invalid_argument("invalid profile output");
+    }
+    const auto *cpp_machine = convert_from_c(m);
+    *profile = convert_to_c(cpp_machine->get_profile());
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+CM_API void cm_delete_machine_profile(cm_machine_profile *profile) {
+    if (profile == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < profile->insn_counts.count; ++i) {
+        delete[] profile->insn_counts.entry[i].insn;
+    }
+    delete[] profile->insn_counts.entry;
+    for (size_t i = 0; i < profile->insn_pair_counts.count; ++i) {
+        delete[] profile->insn_pair_counts.entry[i].insn;
+        delete[] profile->insn_pair_counts.entry[i].next_insn;
+    }
+    delete[] profile->insn_pair_counts.entry;
+    delete[] profile->pc_samples.entry;
+    delete profile;
+}
+
+// --------------------------------------------
+// Rollup conversion functions
+// --------------------------------------------
+static cartesi::rollup_inputs convert_from_c(const cm_rollup_input_array *c_inputs) {
+    if (c_inputs == nullptr) {
+        throw std::invalid_argument("invalid rollup inputs");
+    }
+    if (c_inputs->count != 0 && c_inputs->entry == nullptr) {
+        throw std::invalid_argument("invalid rollup input entries");
+    }
+    cartesi::rollup_inputs inputs;
+    inputs.reserve(c_inputs->count);
+    for (size_t i = 0; i < c_inputs->count; ++i) {
+        const auto &input = c_inputs->entry[i];
+        inputs.push_back({input.metadata, input.metadata_length, input.payload, input.payload_length});
+    }
+    return inputs;
+}
+
+static void convert_to_c(const std::string &cpp_output, cm_rollup_output &output) {
+    output.length = cpp_output.size();
+    output.data = new uint8_t[output.length];
+    memcpy(output.data, cpp_output.data(), output.length);
+}
+
+static void convert_to_c(const std::vector<std::string> &cpp_outputs, cm_rollup_output_array &outputs) {
+    outputs.count = cpp_outputs.size();
+    outputs.entry = new cm_rollup_output[outputs.count]{};
+    for (size_t i = 0; i < outputs.count; ++i) {
+        convert_to_c(cpp_outputs[i], outputs.entry[i]);
+    }
+}
+
+static void convert_to_c(const std::vector<cartesi::machine_merkle_tree::hash_type> &cpp_hashes,
+    cm_hash_array &hashes) {
+    hashes.count = cpp_hashes.size();
+    hashes.entry = new cm_hash[hashes.count]{};
+    for (size_t i = 0; i < hashes.count; ++i) {
+        memcpy(&hashes.entry[i], cpp_hashes[i].data(), sizeof(cm_hash));
+    }
+}
+
+static void convert_to_c(const cartesi::rollup_input_result &cpp_result, cm_rollup_input_result &result) {
+    result.status = static_cast<CM_ROLLUP_INPUT_STATUS>(cpp_result.status);
+    convert_to_c(cpp_result.vouchers, result.vouchers);
+    convert_to_c(cpp_result.notices, result.notices);
+    convert_to_c(cpp_result.reports, result.reports);
+    convert_to_c(cpp_result.exception, result.exception);
+    convert_to_c(cpp_result.voucher_hashes, result.voucher_hashes);
+    convert_to_c(cpp_result.notice_hashes, result.notice_hashes);
+    memcpy(&result.root_hash, cpp_result.root_hash.data(), sizeof(cm_hash));
+}
+
+static void delete_rollup_output_array(cm_rollup_output_array &outputs) {
+    for (size_t i = 0; i < outputs.count; ++i) {
+        delete[] outputs.entry[i].data;
+    }
+    delete[] outputs.entry;
+}
+
+static void delete_rollup_input_result_fields(cm_rollup_input_result &result) {
+    delete_rollup_output_array(result.vouchers);
+    delete_rollup_output_array(result.notices);
+    delete_rollup_output_array(result.reports);
+    delete[] result.exception.data;
+    delete[] result.voucher_hashes.entry;
+    delete[] result.notice_hashes.entry;
+}
+
+CM_API int cm_advance_rollup(cm_machine *m, const cm_rollup_input_array *inputs, uint64_t mcycle_end,
+    cm_rollup_input_result_array **results, char **err_msg) try {
+    if (results == nullptr) {
+        throw std::invalid_argument("invalid rollup input results output");
+    }
+    auto *cpp_machine = convert_from_c(m);
+    const auto cpp_results = cpp_machine->advance_rollup(convert_from_c(inputs), mcycle_end);
+    auto *new_results = new cm_rollup_input_result_array{};
+    new_results->count = cpp_results.size();
+    new_results->entry = new cm_rollup_input_result[new_results->count]{};
+    for (size_t i = 0; i < new_results->count; ++i) {
+        convert_to_c(cpp_results[i], new_results->entry[i]);
+    }
+    *results = new_results;
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+CM_API void cm_delete_rollup_input_result_array(cm_rollup_input_result_array *results) {
+    if (results == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < results->count; ++i) {
+        delete_rollup_input_result_fields(results->entry[i]);
+    }
+    delete[] results->entry;
+    delete results;
+}
+
+CM_API int cm_inspect_rollup(cm_machine *m, const uint8_t *query, size_t length, uint64_t mcycle_end,
+    cm_rollup_input_result **result, char **err_msg) try {
+    if (result == nullptr) {
+        throw std::invalid_argument("invalid rollup input result output");
+    }
+    auto *cpp_machine = convert_from_c(m);
+    const auto cpp_result = cpp_machine->inspect_rollup(query, length, mcycle_end);
+    auto *new_result = new cm_rollup_input_result{};
+    convert_to_c(cpp_result, *new_result);
+    *result = new_result;
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+CM_API void cm_delete_rollup_input_result(cm_rollup_input_result *result) {
+    if (result == nullptr) {
+        return;
+    }
+    delete_rollup_input_result_fields(*result);
+    delete result;
+}
+
+// --------------------------------------------
+// Bisector pointer conversion functions
+// --------------------------------------------
+static cartesi::machine_bisector *convert_from_c(cm_bisector *b) {
+    if (b == nullptr) {
+        throw std::invalid_argument("invalid bisector");
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<cartesi::machine_bisector *>(b);
+}
+
+int cm_create_bisector(const char *dir, const char *checkpoints_dir, const cm_machine_runtime_config *runtime_config,
+    uint64_t max_checkpoints, uint64_t min_checkpoint_distance, cm_bisector **new_bisector, char **err_msg) try {
+    if (new_bisector == nullptr) {
+        throw std::invalid_argument("invalid new bisector output");
+    }
+    const cartesi::machine_runtime_config r = convert_from_c(runtime_config);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    *new_bisector = reinterpret_cast<cm_bisector *>(new cartesi::machine_bisector(null_to_empty(dir),
+        null_to_empty(checkpoints_dir), r, max_checkpoints, min_checkpoint_distance));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+void cm_delete_bisector(cm_bisector *b) {
+    if (b == nullptr) {
+        return;
+    }
+    auto *cpp_bisector = convert_from_c(b);
+    delete cpp_bisector;
+}
+
+int cm_bisector_get_root_hash(cm_bisector *b, uint64_t mcycle, cm_hash *hash, char **err_msg) try {
+    if (hash == nullptr) {
+        throw std::invalid_argument("invalid hash output");
+    }
+    auto *cpp_bisector = convert_from_c(b);
+    const auto cpp_hash = cpp_bisector->get_root_hash(mcycle);
+    memcpy(hash, static_cast<const uint8_t *>(cpp_hash.data()), sizeof(cm_hash));
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
+
+int cm_bisector_get_checkpoint_count(cm_bisector *b, uint64_t *count, char **err_msg) try {
+    if (count == nullptr) {
+        throw std::invalid_argument("invalid count output");
+    }
+    const auto *cpp_bisector = convert_from_c(b);
+    *count = cpp_bisector->get_checkpoint_count();
+    return cm_result_success(err_msg);
+} catch (...) {
+    return cm_result_failure(err_msg);
+}
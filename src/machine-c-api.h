@@ -355,6 +355,31 @@ typedef struct { // NOLINT(modernize-use-using)
     cm_hash_array sibling_hashes;
 } cm_merkle_tree_proof;
 
+/// \brief Target node of a Merkle tree multi-proof
+typedef struct {      // NOLINT(modernize-use-using)
+    uint64_t address; ///< Address of target node
+    int log2_size;    ///< log<sub>2</sub> of size subintended by target node
+    cm_hash hash;     ///< Hash of target node (ignored when requesting a multi-proof)
+} cm_merkle_tree_multi_proof_target;
+
+/// \brief Array of Merkle tree multi-proof targets
+typedef struct { // NOLINT(modernize-use-using)
+    cm_merkle_tree_multi_proof_target *entry;
+    size_t count;
+} cm_merkle_tree_multi_proof_target_array;
+
+/// \brief Merkle tree multi-proof structure
+/// \details
+/// This structure holds a proof that several disjoint nodes in the tree
+/// have certain hashes. Targets are sorted by address. Sibling hashes are
+/// shared by all targets and listed in increasing order of address.
+typedef struct { // NOLINT(modernize-use-using)
+    size_t log2_root_size;
+    cm_hash root_hash;
+    cm_merkle_tree_multi_proof_target_array targets;
+    cm_hash_array sibling_hashes;
+} cm_merkle_tree_multi_proof;
+
 /// \brief Type of state access
 typedef enum {       // NOLINT(modernize-use-using)
     CM_ACCESS_READ,  ///< Read operation
@@ -424,6 +449,7 @@ typedef struct {                    // NOLINT(modernize-use-using)
 /// \brief Concurrency runtime configuration
 typedef struct { // NOLINT(modernize-use-using)
     uint64_t update_merkle_tree;
+    uint64_t verify_uarch_state_transitions;
 } cm_concurrency_runtime_config;
 
 /// \brief HTIF runtime configuration
@@ -431,10 +457,24 @@ typedef struct { // NOLINT(modernize-use-using)
     bool no_console_putchar;
 } cm_htif_runtime_config;
 
+/// \brief Periodic hashes runtime configuration
+typedef struct { // NOLINT(modernize-use-using)
+    uint64_t period; ///< Number of cycles between root hashes (0 disables periodic hashes)
+    uint64_t start;  ///< First mcycle to hash (0 means the first hash is at mcycle period)
+} cm_periodic_hashes_runtime_config;
+
+/// \brief Profiling runtime configuration
+typedef struct { // NOLINT(modernize-use-using)
+    bool enabled;              ///< Count the instructions executed by the interpreter
+    uint64_t pc_sample_period; ///< Number of cycles between guest pc samples (0 disables sampling)
+} cm_profile_runtime_config;
+
 /// \brief Machine runtime configuration
 typedef struct { // NOLINT(modernize-use-using)
     cm_concurrency_runtime_config concurrency;
     cm_htif_runtime_config htif;
+    cm_periodic_hashes_runtime_config periodic_hashes;
+    cm_profile_runtime_config profile;
     bool skip_root_hash_check;
     bool skip_version_check;
     bool soft_yield;
@@ -448,6 +488,12 @@ typedef struct { // NOLINT(modernize-use-using)
 /// where pointer size depend on types, this api might not work
 typedef struct cm_machine_tag cm_machine; // NOLINT(modernize-use-using)
 
+/// \brief Bisector of the root hashes of a stored machine
+typedef struct cm_bisector_tag cm_bisector; // NOLINT(modernize-use-using)
+
+/// \brief Reusable storage for access logs returned by cm_log_uarch_step_into and cm_log_uarch_reset_into
+typedef struct cm_access_log_buffer_tag cm_access_log_buffer; // NOLINT(modernize-use-using)
+
 /// \brief Semantic version
 typedef struct { // NOLINT(modernize-use-using)
     uint32_t major;
@@ -470,6 +516,150 @@ typedef struct { // NOLINT(modernize-use-using)
     size_t count;
 } cm_memory_range_descr_array;
 
+/// \brief Root hash of the machine state at a given mcycle
+typedef struct { // NOLINT(modernize-use-using)
+    uint64_t mcycle;
+    cm_hash hash;
+} cm_periodic_root_hash;
+
+/// \brief Periodic root hash array
+typedef struct { // NOLINT(modernize-use-using)
+    cm_periodic_root_hash *entry;
+    size_t count;
+} cm_periodic_root_hash_array;
+
+/// \brief Number of times an instruction was executed
+typedef struct { // NOLINT(modernize-use-using)
+    const char *insn;
+    uint64_t count;
+} cm_insn_count;
+
+/// \brief Instruction count array
+typedef struct { // NOLINT(modernize-use-using)
+    cm_insn_count *entry;
+    size_t count;
+} cm_insn_count_array;
+
+/// \brief Number of times an instruction was immediately followed by another
+typedef struct { // NOLINT(modernize-use-using)
+    const char *insn;
+    const char *next_insn;
+    uint64_t count;
+} cm_insn_pair_count;
+
+/// \brief Instruction pair count array
+typedef struct { // NOLINT(modernize-use-using)
+    cm_insn_pair_count *entry;
+    size_t count;
+} cm_insn_pair_count_array;
+
+/// \brief Number of samples taken while the guest was at a given pc
+typedef struct { // NOLINT(modernize-use-using)
+    uint64_t pc;
+    uint64_t count;
+} cm_pc_sample;
+
+/// \brief Guest pc sample array
+typedef struct { // NOLINT(modernize-use-using)
+    cm_pc_sample *entry;
+    size_t count;
+} cm_pc_sample_array;
+
+/// \brief Profile of the instructions executed by a machine
+typedef struct { // NOLINT(modernize-use-using)
+    cm_insn_count_array insn_counts;           ///< Instructions executed at least once, from most to least executed
+    cm_insn_pair_count_array insn_pair_counts; ///< Pairs of consecutive instructions, from most to least frequent
+    cm_pc_sample_array pc_samples;             ///< Sampled guest pcs, from most to least sampled
+} cm_machine_profile;
+
+/// \brief Memory range to be read, along with the buffer that receives its contents
+typedef struct {         // NOLINT(modernize-use-using)
+    uint64_t address;    ///< Start of range
+    unsigned char *data; ///< Receives the contents of the range
+    uint64_t length;     ///< Length of range in bytes
+} cm_memory_range_read;
+
+/// \brief Memory range to be written, along with its new contents
+typedef struct {               // NOLINT(modernize-use-using)
+    uint64_t address;          ///< Start of range
+    const unsigned char *data; ///< New contents of the range
+    uint64_t length;           ///< Length of range in bytes
+} cm_memory_range_write;
+
+/// \brief Input fed to a rollup machine
+/// \details The data is copied straight into the rollup memory ranges, so it only needs to live during the call.
+typedef struct {             // NOLINT(modernize-use-using)
+    const uint8_t *metadata; ///< Contents of the input metadata memory range
+    size_t metadata_length;  ///< Length of metadata in bytes
+    const uint8_t *payload;  ///< Contents of the rx buffer memory range
+    size_t payload_length;   ///< Length of payload in bytes
+} cm_rollup_input;
+
+/// \brief Array of rollup inputs
+typedef struct { // NOLINT(modernize-use-using)
+    const cm_rollup_input *entry;
+    size_t count;
+} cm_rollup_input_array;
+
+/// \brief How a rollup machine finished processing an input
+typedef enum {                            // NOLINT(modernize-use-using)
+    CM_ROLLUP_INPUT_ACCEPTED,             ///< Machine yielded manually with reason rx-accepted
+    CM_ROLLUP_INPUT_REJECTED,             ///< Machine yielded manually with reason rx-rejected
+    CM_ROLLUP_INPUT_EXCEPTION,            ///< Machine yielded manually with reason tx-exception
+    CM_ROLLUP_INPUT_HALTED,               ///< Machine halted
+    CM_ROLLUP_INPUT_REACHED_TARGET_MCYCLE ///< Machine reached the target mcycle before yielding manually
+} CM_ROLLUP_INPUT_STATUS;
+
+/// \brief Output produced by a rollup machine
+typedef struct {   // NOLINT(modernize-use-using)
+    uint8_t *data; ///< Contents of the output
+    size_t length; ///< Length of data in bytes
+} cm_rollup_output;
+
+/// \brief Array of rollup outputs
+typedef struct { // NOLINT(modernize-use-using)
+    cm_rollup_output *entry;
+    size_t count;
+} cm_rollup_output_array;
+
+/// \brief Outputs produced by a rollup machine while processing an input
+typedef struct {                     // NOLINT(modernize-use-using)
+    CM_ROLLUP_INPUT_STATUS status;   ///< How processing of the input ended
+    cm_rollup_output_array vouchers; ///< Each voucher, as found in the tx buffer
+    cm_rollup_output_array notices;  ///< Each notice, as found in the tx buffer
+    cm_rollup_output_array reports;  ///< Each report, as found in the tx buffer
+    cm_rollup_output exception;      ///< Payload of the exception, if any
+    cm_hash_array voucher_hashes;    ///< Hashes in the voucher hashes memory range
+    cm_hash_array notice_hashes;     ///< Hashes in the notice hashes memory range
+    cm_hash root_hash;               ///< Root hash when the input was accepted or rejected
+} cm_rollup_input_result;
+
+/// \brief Array of rollup input results
+typedef struct { // NOLINT(modernize-use-using)
+    cm_rollup_input_result *entry;
+    size_t count;
+} cm_rollup_input_result_array;
+
+/// \brief Operation that produced the log of a uarch state transition
+typedef enum {                      // NOLINT(modernize-use-using)
+    CM_UARCH_STATE_TRANSITION_STEP, ///< Log produced by cm_log_uarch_step
+    CM_UARCH_STATE_TRANSITION_RESET ///< Log produced by cm_log_uarch_reset
+} CM_UARCH_STATE_TRANSITION_TYPE;
+
+/// \brief State transition caused by a single uarch step or uarch reset
+typedef struct {                         // NOLINT(modernize-use-using)
+    CM_UARCH_STATE_TRANSITION_TYPE type; ///< Operation that produced the log
+    cm_hash root_hash_before;            ///< State hash before the operation
+    const cm_access_log *log;            ///< State access log, with proofs
+    cm_hash root_hash_after;             ///< State hash after the operation
+} cm_uarch_state_transition;
+
+/// \brief Array of uarch state transitions
+typedef struct { // NOLINT(modernize-use-using)
+    const cm_uarch_state_transition *entry;
+    size_t count;
+} cm_uarch_state_transition_array;
+
 // ---------------------------------
 // API function definitions
 // ---------------------------------
@@ -536,6 +726,22 @@ CM_API void cm_delete_machine(cm_machine *m);
 /// \returns 0 for success, non zero code for error
 CM_API int cm_machine_run(cm_machine *m, uint64_t mcycle_end, CM_BREAK_REASON *break_reason_result, char **err_msg);
 
+/// \brief Runs the machine like cm_machine_run, checking it against a reference machine every period cycles.
+/// \param m Pointer to valid machine instance
+/// \param reference Pointer to another valid machine instance in the same state, advanced with the
+/// microarchitecture
+/// \param mcycle_end End cycle value
+/// \param period Number of cycles between comparisons of root hashes
+/// \param break_reason Receives reason for machine run interruption when not NULL
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Fails with CM_ERROR_RUNTIME_ERROR at the first comparison where the root hashes differ.
+CM_API int cm_machine_run_lockstep(cm_machine *m, cm_machine *reference, uint64_t mcycle_end, uint64_t period,
+    CM_BREAK_REASON *break_reason_result, char **err_msg);
+
 /// \brief Runs the machine for one micro cycle logging all accesses to the state.
 /// \param m Pointer to valid machine instance
 /// \param log_type Type of access log to generate.
@@ -553,6 +759,37 @@ CM_API int cm_log_uarch_step(cm_machine *m, cm_access_log_type log_type, bool on
 /// \param acc_log Valid pointer to cm_access_log object
 CM_API void cm_delete_access_log(cm_access_log *acc_log);
 
+/// \brief Creates an empty buffer that access logs can be repeatedly written into
+/// \param buffer Receives the new buffer. It must be deleted with cm_delete_access_log_buffer.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+CM_API int cm_new_access_log_buffer(cm_access_log_buffer **buffer, char **err_msg);
+
+/// \brief Deletes a buffer acquired from cm_new_access_log_buffer
+/// \param buffer Valid pointer to cm_access_log_buffer object
+/// \details Logs previously returned into this buffer become invalid.
+CM_API void cm_delete_access_log_buffer(cm_access_log_buffer *buffer);
+
+/// \brief Runs the machine for one micro cycle logging all accesses to the state into a reusable buffer.
+/// \param m Pointer to valid machine instance
+/// \param log_type Type of access log to generate.
+/// \param one_based Use 1-based indices when reporting errors.
+/// \param buffer Buffer that receives the contents of the log.
+/// \param access_log Receives a pointer to the log stored in the buffer.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details The log is owned by the buffer and remains valid until the buffer is written into again or deleted.
+/// It must not be passed to cm_delete_access_log. Once the buffer has grown to fit the logs being produced,
+/// the C API performs no further allocations to return them.
+CM_API int cm_log_uarch_step_into(cm_machine *m, cm_access_log_type log_type, bool one_based,
+    cm_access_log_buffer *buffer, const cm_access_log **access_log, char **err_msg);
+
 /// \brief Checks the internal consistency of an access log
 /// \param log State access log to be verified
 /// \param r Machine runtime configuration to use during verification. Must be pointer to valid object
@@ -605,6 +842,21 @@ CM_API int cm_verify_uarch_reset_state_transition(const cm_hash *root_hash_befor
 CM_API int cm_verify_uarch_reset_log(const cm_access_log *log, const cm_machine_runtime_config *runtime_config,
     bool one_based, char **err_msg);
 
+/// \brief Checks the validity of a sequence of state transitions caused by cm_log_uarch_step and cm_log_uarch_reset
+/// \param transitions State transitions, in the order they happened
+/// \param runtime_config Machine runtime configuration to use during verification. Must be pointer to valid object
+/// \param one_based Use 1-based indices when reporting errors
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for successful verification, non zero code for error
+/// \details The root hash before each transition must match the root hash after the previous one.
+/// Transitions are verified in parallel, using up to runtime_config->concurrency.verify_uarch_state_transitions
+/// threads (0 uses all hardware threads).
+CM_API int cm_verify_uarch_state_transitions(const cm_uarch_state_transition_array *transitions,
+    const cm_machine_runtime_config *runtime_config, bool one_based, char **err_msg);
+
 /// \brief Obtains the proof for a node in the Merkle tree
 /// \param m Pointer to valid machine instance
 /// \param address Address of target node. Must be aligned to a 2<sup>log2_size</sup> boundary
@@ -621,10 +873,48 @@ CM_API int cm_verify_uarch_reset_log(const cm_access_log *log, const cm_machine_
 CM_API int cm_get_proof(const cm_machine *m, uint64_t address, int log2_size, cm_merkle_tree_proof **proof,
     char **err_msg);
 
+/// \brief Obtains the proof for a node in the Merkle tree into a caller-provided buffer
+/// \param m Pointer to valid machine instance
+/// \param address Address of target node. Must be aligned to a 2<sup>log2_size</sup> boundary
+/// \param log2_size log<sub>2</sub> of size subintended by target node.
+/// Must be between 3 (for a word) and 64 (for the entire address space), inclusive
+/// \param proof Receives the proof. On entry, proof->sibling_hashes.entry must point to an array
+/// of proof->sibling_hashes.count hashes, which must be at least 64-log2_size.
+/// On success, proof->sibling_hashes.count is set to the number of sibling hashes written.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details The proof must not be passed to cm_delete_merkle_tree_proof.
+CM_API int cm_get_proof_into(const cm_machine *m, uint64_t address, int log2_size, cm_merkle_tree_proof *proof,
+    char **err_msg);
+
 /// \brief  Deletes the instance of cm_merkle_tree_proof acquired from cm_get_proof
 /// \param proof Valid pointer to cm_merkle_tree_proof object
 CM_API void cm_delete_merkle_tree_proof(cm_merkle_tree_proof *proof);
 
+/// \brief Obtains a multi-proof for several nodes in the Merkle tree
+/// \param m Pointer to valid machine instance
+/// \param targets Target nodes. Each address must be aligned to a 2<sup>log2_size</sup> boundary,
+/// each log2_size must be between 3 (for a word) and 64 (for the entire address space), inclusive,
+/// and no two targets may overlap
+/// \param proof Receives the multi-proof
+/// proof must be deleted with the function cm_delete_merkle_tree_multi_proof
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Nodes smaller than a page size must lie entirely inside the same PMA range.
+/// Sibling hashes shared by several targets are only included once.
+CM_API int cm_get_multi_proof(const cm_machine *m, const cm_merkle_tree_multi_proof_target_array *targets,
+    cm_merkle_tree_multi_proof **proof, char **err_msg);
+
+/// \brief  Deletes the instance of cm_merkle_tree_multi_proof acquired from cm_get_multi_proof
+/// \param proof Valid pointer to cm_merkle_tree_multi_proof object
+CM_API void cm_delete_merkle_tree_multi_proof(cm_merkle_tree_multi_proof *proof);
+
 /// \brief Obtains the root hash of the Merkle tree
 /// \param m Pointer to valid machine instance
 /// \param hash Valid pointer to cm_hash structure that  receives the hash.
@@ -655,6 +945,28 @@ CM_API int cm_verify_merkle_tree(const cm_machine *m, bool *result, char **err_m
 /// \returns 0 for success, non zero code for error
 CM_API int cm_read_csr(const cm_machine *m, CM_PROC_CSR r, uint64_t *val, char **err_msg);
 
+/// \brief Reads the values of several CSRs at once
+/// \param m Pointer to valid machine instance
+/// \param csrs Array of CSRs to read
+/// \param vals Receives the values read, in the same order as csrs
+/// \param count Number of entries in csrs and vals
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+CM_API int cm_read_csrs(const cm_machine *m, const CM_PROC_CSR *csrs, uint64_t *vals, size_t count, char **err_msg);
+
+/// \brief Reads a snapshot of the processor state
+/// \param m Pointer to valid machine instance
+/// \param state Receives the general-purpose registers, floating-point registers and processor CSRs
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+CM_API int cm_read_processor_state(const cm_machine *m, cm_processor_config *state, char **err_msg);
+
 /// \brief Write the value of any CSR
 /// \param m Pointer to valid machine instance
 /// \param w CSR to write
@@ -738,6 +1050,57 @@ CM_API int cm_read_virtual_memory(const cm_machine *m, uint64_t address, unsigne
 CM_API int cm_write_virtual_memory(cm_machine *m, uint64_t address, const unsigned char *data, size_t length,
     char **err_msg);
 
+/// \brief Reads a list of chunks of data from the machine memory in a single call.
+/// \param m Pointer to valid machine instance
+/// \param ranges Array with the physical address, length and destination buffer of each chunk.
+/// \param count Number of entries in \p ranges.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Unlike cm_read_memory, chunks may span several adjacent PMA regions.
+CM_API int cm_read_memory_ranges(const cm_machine *m, const cm_memory_range_read *ranges, size_t count,
+    char **err_msg);
+
+/// \brief Writes a list of chunks of data to the machine memory in a single call.
+/// \param m Pointer to valid machine instance
+/// \param ranges Array with the physical address, length and source buffer of each chunk.
+/// \param count Number of entries in \p ranges.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Unlike cm_write_memory, chunks may span several adjacent PMA regions, as long as every byte
+/// lies in a memory PMA. Chunks are written in order, so when one fails, those before it have already been written.
+CM_API int cm_write_memory_ranges(cm_machine *m, const cm_memory_range_write *ranges, size_t count, char **err_msg);
+
+/// \brief Reads a list of chunks of data from the machine virtual memory in a single call.
+/// \param m Pointer to valid machine instance
+/// \param ranges Array with the virtual address, length and destination buffer of each chunk.
+/// \param count Number of entries in \p ranges.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+CM_API int cm_read_virtual_memory_ranges(const cm_machine *m, const cm_memory_range_read *ranges, size_t count,
+    char **err_msg);
+
+/// \brief Writes a list of chunks of data to the machine virtual memory in a single call.
+/// \param m Pointer to valid machine instance
+/// \param ranges Array with the virtual address, length and source buffer of each chunk.
+/// \param count Number of entries in \p ranges.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Chunks are written in order, so when one fails, those before it have already been written.
+CM_API int cm_write_virtual_memory_ranges(cm_machine *m, const cm_memory_range_write *ranges, size_t count,
+    char **err_msg);
+
 /// \brief Reads the value of a general-purpose register.
 /// \param m Pointer to valid machine instance
 /// \param i Register index. Between 0 and X_REG_COUNT-1, inclusive.
@@ -1712,6 +2075,19 @@ CM_API int cm_get_default_config(const cm_machine_config **config, char **err_ms
 /// \details The machine must contain an existing memory range matching the start and length specified in new_range
 CM_API int cm_replace_memory_range(cm_machine *m, const cm_memory_range_config *new_range, char **err_msg);
 
+/// \brief Fills a memory range with zeros
+/// \param m Pointer to valid machine instance
+/// \param start Start of memory range
+/// \param length Length of memory range
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details The machine must contain an existing memory range matching start and length.
+/// Unlike replacing the range, only the pages in use are zeroed and rehashed.
+CM_API int cm_clear_memory_range(cm_machine *m, uint64_t start, uint64_t length, char **err_msg);
+
 /// \brief Deletes a machine memory range config
 /// \returns void
 CM_API void cm_delete_memory_range_config(const cm_memory_range_config *config);
@@ -1862,6 +2238,20 @@ CM_API int cm_reset_uarch(cm_machine *m, char **err_msg);
 CM_API int cm_log_uarch_reset(cm_machine *m, cm_access_log_type log_type, bool one_based, cm_access_log **access_log,
     char **err_msg);
 
+/// \brief Resets the microarchitecture state logging all accesses to the state into a reusable buffer.
+/// \param m Pointer to valid machine instance
+/// \param log_type Type of access log to generate.
+/// \param one_based Use 1-based indices when reporting errors.
+/// \param buffer Buffer that receives the contents of the log.
+/// \param access_log Receives a pointer to the log stored in the buffer.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring
+/// \returns 0 for success, non zero code for error
+/// \details See cm_log_uarch_step_into for the lifetime of the returned log.
+CM_API int cm_log_uarch_reset_into(cm_machine *m, cm_access_log_type log_type, bool one_based,
+    cm_access_log_buffer *buffer, const cm_access_log **access_log, char **err_msg);
+
 /// \brief Runs the machine in the microarchitecture until the mcycle advances by one unit or the micro cycles counter
 /// (uarch_cycle) reaches uarch_cycle_end
 /// \param m Pointer to valid machine instance
@@ -1891,6 +2281,135 @@ CM_API int cm_get_memory_ranges(cm_machine *m, cm_memory_range_descr_array **mrd
 /// \returns void
 CM_API void cm_delete_memory_range_descr_array(cm_memory_range_descr_array *mrda);
 
+/// \brief Returns the root hashes computed by cm_machine_run at period boundaries since the previous call.
+/// \param m Pointer to valid machine instance
+/// \param hashes Receives pointer to array of root hashes, in increasing mcycle order. Must be deleted by the
+/// function caller using cm_delete_periodic_root_hash_array.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Periodic hashes are enabled by the periodic_hashes field of the runtime configuration.
+/// While the machine runs, the pages modified in each period are copied and hashed in the background.
+CM_API int cm_get_periodic_root_hashes(cm_machine *m, cm_periodic_root_hash_array **hashes, char **err_msg);
+
+/// \brief Delete periodic root hash array acquired from cm_get_periodic_root_hashes.
+/// \param hashes Pointer to array of root hashes to delete.
+/// \returns void
+CM_API void cm_delete_periodic_root_hash_array(cm_periodic_root_hash_array *hashes);
+
+/// \brief Returns the profile collected by cm_machine_run so far.
+/// \param m Pointer to valid machine instance
+/// \param profile Receives pointer to profile, which is empty if profiling is disabled. Must be deleted by the
+/// function caller using cm_delete_machine_profile.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Profiling is enabled by the profile field of the runtime configuration.
+/// Instruction counts are exact, while guest pcs are sampled every pc_sample_period cycles.
+CM_API int cm_get_profile(const cm_machine *m, cm_machine_profile **profile, char **err_msg);
+
+/// \brief Delete profile acquired from cm_get_profile.
+/// \param profile Pointer to profile to delete.
+/// \returns void
+CM_API void cm_delete_machine_profile(cm_machine_profile *profile);
+
+/// \brief Advances the rollup state through a batch of inputs.
+/// \param m Pointer to valid machine instance
+/// \param inputs Inputs to feed to the machine, in order
+/// \param mcycle_end Maximum value of mcycle before function returns
+/// \param results Receives pointer to array with a leading entry for the run up to the first input, followed by the
+/// outputs and status of each input processed. Must be deleted by the function caller using
+/// cm_delete_rollup_input_result_array.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details The machine runs until it yields manually asking for an input. The outputs it produces on the way, and
+/// the status of that yield, go into the leading entry. Each input is then copied into the rollup memory ranges,
+/// and the machine runs until it yields manually again, while the vouchers, notices and reports it produces are
+/// collected. Processing stops at the first input that is not accepted, so the caller can roll the machine back
+/// before advancing through the remaining inputs.
+CM_API int cm_advance_rollup(cm_machine *m, const cm_rollup_input_array *inputs, uint64_t mcycle_end,
+    cm_rollup_input_result_array **results, char **err_msg);
+
+/// \brief Delete rollup input result array acquired from cm_advance_rollup.
+/// \param results Pointer to array of results to delete.
+/// \returns void
+CM_API void cm_delete_rollup_input_result_array(cm_rollup_input_result_array *results);
+
+/// \brief Inspects the rollup state with a query.
+/// \param m Pointer to valid machine instance
+/// \param query Contents of the rx buffer memory range
+/// \param length Length of query in bytes
+/// \param mcycle_end Maximum value of mcycle before function returns
+/// \param result Receives pointer to the reports and status of the query. Must be deleted by the function caller
+/// using cm_delete_rollup_input_result.
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details The root hash is not computed.
+CM_API int cm_inspect_rollup(cm_machine *m, const uint8_t *query, size_t length, uint64_t mcycle_end,
+    cm_rollup_input_result **result, char **err_msg);
+
+/// \brief Delete rollup input result acquired from cm_inspect_rollup.
+/// \param result Pointer to result to delete.
+/// \returns void
+CM_API void cm_delete_rollup_input_result(cm_rollup_input_result *result);
+
+/// \brief Creates a bisector, which answers queries for the root hash of a stored machine at any later mcycle.
+/// \param dir Directory where the machine is serialized
+/// \param checkpoints_dir Existing directory under which the bisector stores checkpoints
+/// \param runtime_config Runtime configuration for each machine the bisector loads. Must be pointer to valid object
+/// \param max_checkpoints Maximum number of checkpoints kept at once
+/// \param min_checkpoint_distance Minimum number of cycles between a new checkpoint and the nearest stored state
+/// before it, or 0 for the default of 2^26 cycles
+/// \param new_bisector Receives the pointer to new bisector instance
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details Each query replays the machine from the nearest checkpoint at or before the queried mcycle. When the
+/// queries bisect a range, this replays O(n) cycles in total instead of O(n log n). Placing checkpoints_dir on a
+/// memory-backed filesystem keeps checkpoints in memory. Checkpoints are stored machines, so storing and loading one
+/// costs about as much as replaying the default minimum distance, and closer checkpoints slow bisection down.
+CM_API int cm_create_bisector(const char *dir, const char *checkpoints_dir,
+    const cm_machine_runtime_config *runtime_config, uint64_t max_checkpoints, uint64_t min_checkpoint_distance,
+    cm_bisector **new_bisector, char **err_msg);
+
+/// \brief Deletes a bisector instance, removing all its checkpoints.
+/// \param b Pointer to a valid bisector instance
+CM_API void cm_delete_bisector(cm_bisector *b);
+
+/// \brief Obtains the root hash of the stored machine at a given mcycle.
+/// \param b Pointer to a valid bisector instance
+/// \param mcycle Cycle of interest, no less than the mcycle of the stored machine
+/// \param hash Receives the root hash
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+/// \details If the machine halts or yields manually before reaching mcycle, the root hash is the one of that state.
+CM_API int cm_bisector_get_root_hash(cm_bisector *b, uint64_t mcycle, cm_hash *hash, char **err_msg);
+
+/// \brief Obtains the number of checkpoints a bisector currently keeps.
+/// \param b Pointer to a valid bisector instance
+/// \param count Receives the number of checkpoints
+/// \param err_msg Receives the error message if function execution fails
+/// or NULL in case of successful function execution. In case of failure error_msg
+/// must be deleted by the function caller using cm_delete_cstring.
+/// err_msg can be NULL, meaning the error message won't be received.
+/// \returns 0 for success, non zero code for error
+CM_API int cm_bisector_get_checkpoint_count(cm_bisector *b, uint64_t *count, char **err_msg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,52 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MACHINE_MEMORY_RANGES_H
+#define MACHINE_MEMORY_RANGES_H
+
+/// \file
+/// \brief Lists of memory ranges read or written in a single call.
+
+#include <cstdint>
+#include <vector>
+
+namespace cartesi {
+
+/// \brief Memory range to be read, along with the buffer that receives its contents
+/// \details Kept trivial so the C API can copy arrays of ranges with memcpy.
+struct memory_range_read {
+    uint64_t address;    ///< Start of range
+    unsigned char *data; ///< Receives the contents of the range
+    uint64_t length;     ///< Length of range in bytes
+};
+
+/// \brief List of memory ranges to be read, in order
+using memory_range_reads = std::vector<memory_range_read>;
+
+/// \brief Memory range to be written, along with its new contents
+/// \details The range does not own its data.
+struct memory_range_write {
+    uint64_t address;          ///< Start of range
+    const unsigned char *data; ///< New contents of the range
+    uint64_t length;           ///< Length of range in bytes
+};
+
+/// \brief List of memory ranges to be written, in order
+using memory_range_writes = std::vector<memory_range_write>;
+
+} // namespace cartesi
+
+#endif
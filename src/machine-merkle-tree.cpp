@@ -16,10 +16,13 @@
 
 #include "machine-merkle-tree.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 
 /// \file
 /// \brief Merkle tree implementation.
@@ -58,17 +61,13 @@ int machine_merkle_tree::set_page_node_map(address_type page_index, tree_node *n
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 machine_merkle_tree::tree_node *machine_merkle_tree::create_node(void) const {
-#ifdef MERKLE_DUMP_STATS
     m_num_nodes++;
-#endif
     return new tree_node{};
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 void machine_merkle_tree::destroy_node(tree_node *node) const {
-#ifdef MERKLE_DUMP_STATS
     --m_num_nodes;
-#endif
     delete node;
 }
 
@@ -104,6 +103,17 @@ machine_merkle_tree::tree_node *machine_merkle_tree::new_page_node(address_type
     return node;
 }
 
+void machine_merkle_tree::prune_node(tree_node *node, int log2_size) {
+    tree_node *parent = node->parent;
+    assert(parent);
+    parent->child[parent->child[0] == node ? 0 : 1] = nullptr;
+    if (parent->mark != m_merkle_update_nonce) {
+        m_merkle_update_fifo.emplace_back(log2_size + 1, parent);
+        parent->mark = m_merkle_update_nonce;
+    }
+    destroy_node(node);
+}
+
 void machine_merkle_tree::get_page_node_hash(hasher_type &h, const unsigned char *start, int log2_size,
     hash_type &hash) const {
     if (log2_size > get_log2_word_size()) {
@@ -129,6 +139,87 @@ void machine_merkle_tree::get_page_node_hash(hasher_type &h, const unsigned char
     }
 }
 
+void machine_merkle_tree::init_page_hash_cache_entry(page_hash_cache_entry &entry, address_type page_index) {
+    entry.page_index = page_index;
+    entry.data.fill(0);
+    for (size_t i = 1, log2_size = get_log2_page_size(); i < entry.hash.size(); i <<= 1, --log2_size) {
+        std::fill_n(&entry.hash[i], i, get_pristine_hash(static_cast<int>(log2_size)));
+    }
+}
+
+void machine_merkle_tree::update_page_hash_cache_entry(hasher_type &h, page_hash_cache_entry &entry,
+    const unsigned char *page_data) {
+    // Rehash words that changed since the page was cached
+    std::array<bool, 2 * m_page_word_count> changed{};
+    for (size_t w = 0; w < m_page_word_count; ++w) {
+        const unsigned char *word = page_data + w * get_word_size();
+        unsigned char *cached_word = entry.data.data() + w * get_word_size();
+        if (memcmp(word, cached_word, get_word_size()) != 0) {
+            memcpy(cached_word, word, get_word_size());
+            h.begin();
+            h.add_data(word, get_word_size());
+            h.end(entry.hash[m_page_word_count + w]);
+            changed[m_page_word_count + w] = true;
+        }
+    }
+    // Then their ancestors, bottom up
+    for (size_t i = m_page_word_count - 1; i > 0; --i) {
+        if (changed[2 * i] || changed[2 * i + 1]) {
+            get_concat_hash(h, entry.hash[2 * i], entry.hash[2 * i + 1], entry.hash[i]);
+            changed[i] = true;
+        }
+    }
+}
+
+const machine_merkle_tree::page_hash_cache_entry &machine_merkle_tree::get_page_hash_cache_entry(hasher_type &h,
+    address_type page_index, const unsigned char *page_data) const {
+    auto it = m_page_hash_cache_map.find(page_index);
+    if (it != m_page_hash_cache_map.end()) {
+        // Move entry to the front, marking it as most recently used
+        m_page_hash_cache.splice(m_page_hash_cache.begin(), m_page_hash_cache, it->second);
+    } else {
+        // Recycle the least recently used entry if the cache is full
+        if (m_page_hash_cache.size() >= m_page_hash_cache_capacity) {
+            m_page_hash_cache_map.erase(m_page_hash_cache.back().page_index);
+            m_page_hash_cache.splice(m_page_hash_cache.begin(), m_page_hash_cache, std::prev(m_page_hash_cache.end()));
+        } else {
+            m_page_hash_cache.emplace_front();
+        }
+        // Start from a pristine page, and let the words that differ from it be rehashed below
+        init_page_hash_cache_entry(m_page_hash_cache.front(), page_index);
+        m_page_hash_cache_map[page_index] = m_page_hash_cache.begin();
+    }
+    auto &entry = m_page_hash_cache.front();
+    update_page_hash_cache_entry(h, entry, page_data);
+    return entry;
+}
+
+void machine_merkle_tree::get_cached_page_node_hash(hasher_type &h, address_type page_index,
+    const unsigned char *page_data, hash_type &hash) const {
+    assert(page_index == get_page_index(page_index));
+    if (!page_data) {
+        hash = get_pristine_hash(get_log2_page_size());
+        return;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(m_page_hash_cache_mutex);
+        if (m_page_hash_cache_capacity != 0) {
+            hash = get_page_hash_cache_entry(h, page_index, page_data).hash[1];
+            return;
+        }
+    }
+    get_page_node_hash(h, page_data, get_log2_page_size(), hash);
+}
+
+void machine_merkle_tree::set_page_hash_cache_capacity(size_t capacity) {
+    const std::lock_guard<std::mutex> lock(m_page_hash_cache_mutex);
+    m_page_hash_cache_capacity = capacity;
+    while (m_page_hash_cache.size() > capacity) {
+        m_page_hash_cache_map.erase(m_page_hash_cache.back().page_index);
+        m_page_hash_cache.pop_back();
+    }
+}
+
 void machine_merkle_tree::get_page_node_hash(address_type page_index, hash_type &hash) const {
     assert(page_index == get_page_index(page_index));
     tree_node *node = get_page_node(page_index);
@@ -236,8 +327,107 @@ void machine_merkle_tree::get_inside_page_sibling_hashes(hasher_type &h, address
 void machine_merkle_tree::get_inside_page_sibling_hashes(address_type address, int log2_size, hash_type &hash,
     const unsigned char *page_data, hash_type &page_hash, proof_type &proof) const {
     hasher_type h;
-    get_inside_page_sibling_hashes(h, address, log2_size, hash, page_data, get_log2_page_size(), page_hash,
-        0 /* parent hasn't diverted */, 0 /* curr node hasn't diverged */, proof);
+    std::unique_lock<std::mutex> lock(m_page_hash_cache_mutex);
+    if (m_page_hash_cache_capacity == 0) {
+        lock.unlock();
+        get_inside_page_sibling_hashes(h, address, log2_size, hash, page_data, get_log2_page_size(), page_hash,
+            0 /* parent hasn't diverted */, 0 /* curr node hasn't diverged */, proof);
+        return;
+    }
+    // Read the path from the cached page tree
+    const auto &entry = get_page_hash_cache_entry(h, get_page_index(address), page_data);
+    size_t i = (UINT64_C(1) << (get_log2_page_size() - log2_size)) + (get_offset_in_page(address) >> log2_size);
+    hash = entry.hash[i];
+    for (int log2_curr_size = log2_size; log2_curr_size < get_log2_page_size(); ++log2_curr_size, i >>= 1) {
+        proof.set_sibling_hash(entry.hash[i ^ 1], log2_curr_size);
+    }
+    page_hash = entry.hash[1];
+}
+
+void machine_merkle_tree::get_multi_proof_hashes(hasher_type &h, const tree_node *node, address_type address,
+    int log2_size, size_t first, size_t last, const page_data_getter &get_page_data, multi_proof_type &proof) const {
+    const auto &targets = proof.get_targets();
+    // If the node is a target itself, we are done
+    if (last - first == 1 && targets[first].log2_size == log2_size) {
+        proof.set_target_hash(first, node ? node->hash : get_pristine_hash(log2_size));
+        return;
+    }
+    // Targets smaller than a page must be proven from the page data
+    if (log2_size == get_log2_page_size()) {
+        const hash_type &page_hash = node ? node->hash : get_pristine_hash(get_log2_page_size());
+        const unsigned char *page_data = get_page_data(address);
+        if (!page_data) {
+            if (page_hash != get_pristine_hash(get_log2_page_size())) {
+                throw std::runtime_error{"inconsistent merkle tree"};
+            }
+            get_inside_page_multi_proof_hashes(nullptr, 1, address, log2_size, first, last, proof);
+            return;
+        }
+        std::unique_ptr<page_hash_cache_entry> scratch;
+        const page_hash_cache_entry *entry = nullptr;
+        std::unique_lock<std::mutex> lock(m_page_hash_cache_mutex);
+        if (m_page_hash_cache_capacity != 0) {
+            entry = &get_page_hash_cache_entry(h, address, page_data);
+        } else {
+            lock.unlock();
+            scratch = std::make_unique<page_hash_cache_entry>();
+            init_page_hash_cache_entry(*scratch, address);
+            update_page_hash_cache_entry(h, *scratch, page_data);
+            entry = scratch.get();
+        }
+        // Check if hash stored in node matches what we just computed
+        if (entry->hash[1] != page_hash) {
+            // Caller probably forgot to update the Merkle tree
+            throw std::runtime_error{"inconsistent merkle tree"};
+        }
+        get_inside_page_multi_proof_hashes(entry, 1, address, log2_size, first, last, proof);
+        return;
+    }
+    const int log2_child_size = log2_size - 1;
+    const address_type middle = address + (UINT64_C(1) << log2_child_size);
+    const auto begin = targets.begin();
+    const auto split = static_cast<size_t>(std::lower_bound(begin + first, begin + last, middle,
+        [](const multi_proof_type::target_type &t, address_type a) { return t.address < a; }) - begin);
+    const auto child_hash = [node, log2_child_size](int bit) -> const hash_type & {
+        return node ? get_child_hash(log2_child_size, node, bit) : get_pristine_hash(log2_child_size);
+    };
+    // Children without targets are siblings, collected in address order
+    if (first < split) {
+        get_multi_proof_hashes(h, node ? node->child[0] : nullptr, address, log2_child_size, first, split,
+            get_page_data, proof);
+    } else {
+        proof.push_back_sibling_hash(child_hash(0));
+    }
+    if (split < last) {
+        get_multi_proof_hashes(h, node ? node->child[1] : nullptr, middle, log2_child_size, split, last, get_page_data,
+            proof);
+    } else {
+        proof.push_back_sibling_hash(child_hash(1));
+    }
+}
+
+void machine_merkle_tree::get_inside_page_multi_proof_hashes(const page_hash_cache_entry *entry, size_t index,
+    address_type address, int log2_size, size_t first, size_t last, multi_proof_type &proof) {
+    const auto &targets = proof.get_targets();
+    if (last - first == 1 && targets[first].log2_size == log2_size) {
+        proof.set_target_hash(first, entry ? entry->hash[index] : get_pristine_hash(log2_size));
+        return;
+    }
+    const int log2_child_size = log2_size - 1;
+    const address_type middle = address + (UINT64_C(1) << log2_child_size);
+    const auto begin = targets.begin();
+    const auto split = static_cast<size_t>(std::lower_bound(begin + first, begin + last, middle,
+        [](const multi_proof_type::target_type &t, address_type a) { return t.address < a; }) - begin);
+    if (first < split) {
+        get_inside_page_multi_proof_hashes(entry, 2 * index, address, log2_child_size, first, split, proof);
+    } else {
+        proof.push_back_sibling_hash(entry ? entry->hash[2 * index] : get_pristine_hash(log2_child_size));
+    }
+    if (split < last) {
+        get_inside_page_multi_proof_hashes(entry, 2 * index + 1, middle, log2_child_size, split, last, proof);
+    } else {
+        proof.push_back_sibling_hash(entry ? entry->hash[2 * index + 1] : get_pristine_hash(log2_child_size));
+    }
 }
 
 void machine_merkle_tree::dump_merkle_tree(void) const {
@@ -252,6 +442,14 @@ bool machine_merkle_tree::begin_update(void) {
 bool machine_merkle_tree::update_page_node_hash(address_type page_index, const hash_type &hash) {
     assert(get_page_index(page_index) == page_index);
     tree_node *node = get_page_node(page_index);
+    // Pristine pages are represented by nullptr, so release the page node if there is one
+    if (hash == get_pristine_hash(get_log2_page_size())) {
+        if (node) {
+            m_page_node_map.erase(page_index);
+            prune_node(node, get_log2_page_size());
+        }
+        return true;
+    }
     // If there is no page node for this page index, allocate a fresh one
     if (!node) {
         node = new_page_node(page_index);
@@ -277,8 +475,13 @@ bool machine_merkle_tree::end_update(hasher_type &h) {
         int log2_size{};
         tree_node *node{};
         std::tie(log2_size, node) = m_merkle_update_fifo.front();
-        update_inner_node_hash(h, log2_size, node);
         m_merkle_update_fifo.pop_front();
+        // Inner nodes left without children are pristine, so prune them as well
+        if (!node->child[0] && !node->child[1] && node != m_root) {
+            prune_node(node, log2_size);
+            continue;
+        }
+        update_inner_node_hash(h, log2_size, node);
         if (node->parent && node->parent->mark != m_merkle_update_nonce) {
             m_merkle_update_fifo.emplace_back(log2_size + 1, node->parent);
             node->parent->mark = m_merkle_update_nonce;
@@ -288,11 +491,13 @@ bool machine_merkle_tree::end_update(hasher_type &h) {
     return true;
 }
 
-machine_merkle_tree::machine_merkle_tree(void) : m_root_storage{}, m_root{&m_root_storage}, m_merkle_update_nonce{1} {
+machine_merkle_tree::machine_merkle_tree(void) :
+    m_root_storage{},
+    m_root{&m_root_storage},
+    m_merkle_update_nonce{1},
+    m_num_nodes{0},
+    m_page_hash_cache_capacity{PAGE_HASH_CACHE_DEFAULT_CAPACITY} {
     m_root->hash = get_pristine_hash(get_log2_root_size());
-#ifdef MERKLE_DUMP_STATS
-    m_num_nodes = 0;
-#endif
 }
 
 machine_merkle_tree::~machine_merkle_tree() {
@@ -311,6 +516,65 @@ void machine_merkle_tree::get_root_hash(hash_type &hash) const {
     hash = m_root->hash;
 }
 
+uint64_t machine_merkle_tree::get_node_count(void) const {
+    return m_num_nodes;
+}
+
+bool machine_merkle_tree::is_pristine(const unsigned char *data, size_t length) {
+    // OR together blocks of words, which the compiler can vectorize,
+    // and only test for a non-zero byte once per block
+    constexpr size_t block_words = 16;
+    constexpr size_t block_size = block_words * sizeof(uint64_t);
+    size_t offset = 0;
+    for (; offset + block_size <= length; offset += block_size) {
+        std::array<uint64_t, block_words> words{};
+        memcpy(words.data(), data + offset, block_size);
+        uint64_t acc = 0;
+        for (const auto w : words) {
+            acc |= w;
+        }
+        if (acc != 0) {
+            return false;
+        }
+    }
+    for (; offset < length; ++offset) {
+        if (data[offset] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<machine_merkle_tree::address_type> machine_merkle_tree::get_non_pristine_pages(address_type start,
+    address_type length) const {
+    std::vector<address_type> pages;
+    if (length != 0) {
+        get_non_pristine_pages(m_root, 0, get_log2_root_size(), start, start + (length - 1), pages);
+    }
+    return pages;
+}
+
+void machine_merkle_tree::get_non_pristine_pages(const tree_node *node, address_type address, int log2_size,
+    address_type first, address_type last, std::vector<address_type> &pages) const {
+    // Pristine subtrees have no nodes
+    if (!node) {
+        return;
+    }
+    if (log2_size == get_log2_page_size()) {
+        pages.push_back(address);
+        return;
+    }
+    // Descend only into children that intersect the range
+    const int child_log2_size = log2_size - 1;
+    for (int bit = 0; bit < 2; ++bit) {
+        const address_type child_address = address + (static_cast<address_type>(bit) << child_log2_size);
+        const address_type child_last = child_address + ((UINT64_C(1) << child_log2_size) - 1);
+        if (child_last >= first && child_address <= last) {
+            get_non_pristine_pages(node->child[bit], child_address, child_log2_size, first, last, pages);
+        }
+    }
+}
+
 bool machine_merkle_tree::verify_tree(void) const {
     hasher_type h;
     return verify_tree(h, m_root, get_log2_root_size());
@@ -368,7 +632,8 @@ machine_merkle_tree::proof_type machine_merkle_tree::get_proof(address_type targ
     // Case 1
     // We hit a pristine node along the path to the target node
     if (!node) {
-        if (page_data) {
+        // Pages that became pristine were pruned, but their data must still be zeros
+        if (page_data && !is_pristine(page_data, get_page_size())) {
             throw std::runtime_error{"inconsistent merkle tree"};
         }
         // All remaining siblings along the path are pristine
@@ -425,6 +690,28 @@ machine_merkle_tree::proof_type machine_merkle_tree::get_proof(address_type targ
     return proof;
 }
 
+machine_merkle_tree::multi_proof_type machine_merkle_tree::get_multi_proof(multi_proof_type::targets_type targets,
+    const page_data_getter &get_page_data) const {
+    // Check for valid target node sizes
+    for (const auto &target : targets) {
+        if (target.log2_size > get_log2_root_size() || target.log2_size < get_log2_word_size()) {
+            throw std::runtime_error{"log2_target_size is out of bounds"};
+        }
+    }
+    // Sorts targets and checks their alignment
+    multi_proof_type proof{get_log2_root_size(), std::move(targets)};
+    hasher_type h;
+    get_multi_proof_hashes(h, m_root, 0, get_log2_root_size(), 0, proof.get_targets().size(), get_page_data, proof);
+    proof.set_root_hash(m_root->hash); // NOLINT: m_root can't be nullptr
+#ifndef NDEBUG
+    // Return proof only if it passes verification
+    if (!proof.verify(h)) {
+        throw std::runtime_error{"proof failed verification"};
+    }
+#endif
+    return proof;
+}
+
 std::ostream &operator<<(std::ostream &out, const machine_merkle_tree::hash_type &hash) {
     auto f = out.flags();
     for (const unsigned b : hash) {
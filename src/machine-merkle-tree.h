@@ -23,8 +23,12 @@
 #include <array>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <iosfwd>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "keccak-256-hasher.h"
 #include "merkle-tree-proof.h"
@@ -43,10 +47,14 @@ namespace cartesi {
 ///
 /// To optimize for space, subtrees corresponding to pristine
 /// memory are represented by <tt>nullptr</tt> nodes.
+/// Subtrees that become pristine during an update are pruned,
+/// so their nodes are released.
 /// Additionally, the tree is truncated below *page* nodes
 /// subintending LOG2_PAGE_SIZE bits of address space.
 /// The trees corresponding to pages are rebuilt from the
-/// original data whenever needed and never stored.
+/// original data whenever needed. Only the trees of a few
+/// recently used pages are kept in a cache, together with a
+/// copy of the page data they were computed from.
 /// Pages are divided into *words* that cover LOG2_WORD_SIZE
 /// bits of address space.
 /// Tree leaves contain Keccak-256 hashes of individual words.
@@ -83,6 +91,11 @@ private:
 
     static constexpr size_t m_page_size = static_cast<size_t>(1) << LOG2_PAGE_SIZE;
 
+    static constexpr size_t m_page_word_count = m_page_size / m_word_size;
+
+    /// \brief Default number of pages in the page hash cache.
+    static constexpr size_t PAGE_HASH_CACHE_DEFAULT_CAPACITY = 32;
+
 public:
     /// \brief Returns the LOG2_ROOT_SIZE parameter.
     static constexpr int get_log2_root_size(void) {
@@ -122,6 +135,13 @@ public:
     /// the path from the root to target node.
     using siblings_type = proof_type::sibling_hashes_type;
 
+    /// \brief Storage for the proof of several nodes at once.
+    using multi_proof_type = merkle_tree_multi_proof<hash_type, address_type>;
+
+    /// \brief Function that returns a pointer to the contiguous data of a page,
+    /// given its page index, or nullptr if the page is pristine.
+    using page_data_getter = std::function<const unsigned char *(address_type page_index)>;
+
 private:
     /// \brief Merkle tree node structure.
     /// \details A node is known to be an inner-node or a page-node implicitly
@@ -150,9 +170,25 @@ private:
     std::deque<std::pair<int, tree_node *>> m_merkle_update_fifo;
 
     // For statistics.
-#ifdef MERKLE_DUMP_STATS
     mutable uint64_t m_num_nodes;
-#endif
+
+    /// \brief Hashes of all nodes inside a page, from the page node down to its words.
+    /// \details Node 1 is the page node, node i has children 2i and 2i+1, and words are the
+    /// nodes from m_page_word_count to 2*m_page_word_count-1.
+    struct page_hash_cache_entry {
+        address_type page_index;                           ///< Page index of cached page.
+        std::array<unsigned char, m_page_size> data;       ///< Page data the hashes were computed from.
+        std::array<hash_type, 2 * m_page_word_count> hash; ///< Node hashes (entry 0 is unused).
+    };
+
+    // Cached page trees, from most to least recently used.
+    mutable std::list<page_hash_cache_entry> m_page_hash_cache;
+    // Sparse map from page index to the corresponding cache entry.
+    mutable std::unordered_map<address_type, std::list<page_hash_cache_entry>::iterator> m_page_hash_cache_map;
+    // Maximum number of pages in cache.
+    size_t m_page_hash_cache_capacity;
+    // Guards the page hash cache, which const methods modify.
+    mutable std::mutex m_page_hash_cache_mutex;
 
     /// \brief Maps a page_index to a node.
     /// \param page_index Page index.
@@ -175,6 +211,12 @@ private:
     /// Maps new node to the page index.
     tree_node *new_page_node(address_type page_index);
 
+    /// \brief Detaches a node from its parent and deallocates it.
+    /// \param node Node to be pruned. Must not be the root.
+    /// \param log2_size log<sub>2</sub> of size subintended by node.
+    /// \details Enqueues the parent so its hash is updated by end_update().
+    void prune_node(tree_node *node, int log2_size);
+
     /// \brief Updates an inner node hash from its children.
     /// \param h Hasher object.
     /// \param log2_size log<sub>2</sub> of size subintended by node.
@@ -217,6 +259,16 @@ private:
     /// \returns True if tree is consistent, false otherwise.
     bool verify_tree(hasher_type &h, tree_node *node, int log2_size) const;
 
+    /// \brief Collects the indices of non-pristine pages in a subtree that lie inside a range.
+    /// \param node Root of subtree.
+    /// \param address Address of first byte subintended by \p node.
+    /// \param log2_size log<sub>2</sub> of size subintended by \p node.
+    /// \param first Address of first byte in range.
+    /// \param last Address of last byte in range.
+    /// \param pages Receives the page indices, in increasing order.
+    void get_non_pristine_pages(const tree_node *node, address_type address, int log2_size, address_type first,
+        address_type last, std::vector<address_type> &pages) const;
+
     /// \brief Computes the page index for a memory address.
     /// \param address Memory address.
     /// \return The page index.
@@ -261,6 +313,31 @@ private:
         const unsigned char *curr_data, int log2_curr_size, hash_type &curr_hash, int parent_diverged,
         int curr_diverged, proof_type &proof) const;
 
+    /// \brief Resets a page hash cache entry to a pristine page.
+    /// \param entry Entry to reset.
+    /// \param page_index Page index for entry.
+    static void init_page_hash_cache_entry(page_hash_cache_entry &entry, address_type page_index);
+
+    /// \brief Brings a page hash cache entry up to date with the page data.
+    /// \param h Hasher object.
+    /// \param entry Entry to update.
+    /// \param page_data Pointer to start of contiguous page data.
+    /// \details Only words that differ from the copy of the page data in the entry are rehashed,
+    /// together with their ancestors inside the page.
+    static void update_page_hash_cache_entry(hasher_type &h, page_hash_cache_entry &entry,
+        const unsigned char *page_data);
+
+    /// \brief Returns the cached tree for a page, brought up to date with the page data.
+    /// \param h Hasher object.
+    /// \param page_index Page index.
+    /// \param page_data Pointer to start of contiguous page data.
+    /// \returns Cache entry for the page, now the most recently used.
+    /// \details Only words that differ from the cached copy of the page data are rehashed,
+    /// together with their ancestors inside the page. The caller must hold m_page_hash_cache_mutex
+    /// for as long as it uses the entry.
+    const page_hash_cache_entry &get_page_hash_cache_entry(hasher_type &h, address_type page_index,
+        const unsigned char *page_data) const;
+
     /// \brief Gets the sibling hashes along the path from a
     /// page node towards a target node.
     /// \param address Address of target node.
@@ -272,6 +349,29 @@ private:
     void get_inside_page_sibling_hashes(address_type address, int log2_size, hash_type &hash,
         const unsigned char *page_data, hash_type &page_hash, proof_type &proof) const;
 
+    /// \brief Collects the hashes of targets and siblings inside a subtree for a multi-proof.
+    /// \param h Hasher object.
+    /// \param node Root of subtree, or nullptr if subtree is pristine.
+    /// \param address Start of range subintended by \p node.
+    /// \param log2_size log<sub>2</sub> of size of range subintended by \p node.
+    /// \param first Index of first target inside \p node.
+    /// \param last Index one past the last target inside \p node.
+    /// \param get_page_data Function that returns the data for pages with targets smaller than a page.
+    /// \param proof Multi-proof to receive the hashes.
+    void get_multi_proof_hashes(hasher_type &h, const tree_node *node, address_type address, int log2_size,
+        size_t first, size_t last, const page_data_getter &get_page_data, multi_proof_type &proof) const;
+
+    /// \brief Collects the hashes of targets and siblings inside a page tree for a multi-proof.
+    /// \param entry Hashes of all nodes inside page, or nullptr if page is pristine.
+    /// \param index Index of node in \p entry.
+    /// \param address Start of range subintended by node.
+    /// \param log2_size log<sub>2</sub> of size of range subintended by node.
+    /// \param first Index of first target inside node.
+    /// \param last Index one past the last target inside node.
+    /// \param proof Multi-proof to receive the hashes.
+    static void get_inside_page_multi_proof_hashes(const page_hash_cache_entry *entry, size_t index,
+        address_type address, int log2_size, size_t first, size_t last, multi_proof_type &proof);
+
     // Precomputed hashes of spans of zero bytes with
     // increasing power-of-two sizes, from 2^LOG2_WORD_SIZE
     // to 2^LOG2_ROOT_SIZE bytes.
@@ -313,6 +413,8 @@ public:
     /// \param page_index Page index for node.
     /// \param hash New hash for node.
     /// \returns True if succeeded, false otherwise.
+    /// \details If \p hash is the pristine page hash, the page node is released
+    /// and end_update() prunes any ancestors that become pristine.
     /// \details This method is not thread safe, so be careful when using
     /// parallelization to compute Merkle trees
     bool update_page_node_hash(address_type page_index, const hash_type &hash);
@@ -336,12 +438,38 @@ public:
     /// \returns Proof if successful, otherwise throws exception.
     proof_type get_proof(address_type target_address, int log2_target_size, const unsigned char *page_data) const;
 
+    /// \brief Returns a multi-proof for several nodes in the tree.
+    /// \param targets Target nodes. Each must be aligned to its size, must be between
+    /// LOG2_WORD_SIZE and LOG2_ROOT_SIZE, inclusive, and no two may overlap.
+    /// \param get_page_data Function called once for each page that contains targets smaller than
+    /// LOG2_PAGE_SIZE. The data it returns only needs to remain valid until it is called again.
+    /// \returns Multi-proof if successful, otherwise throws exception.
+    /// \details Sibling hashes shared by several targets are collected only once, and
+    /// each page is hashed at most once, regardless of how many targets lie inside it.
+    multi_proof_type get_multi_proof(multi_proof_type::targets_type targets,
+        const page_data_getter &get_page_data) const;
+
     /// \brief Recursively builds hash for page node from contiguous memory.
     /// \param h Hasher object.
     /// \param page_data Pointer to start of contiguous page data.
     /// \param hash Receives the hash.
     void get_page_node_hash(hasher_type &h, const unsigned char *page_data, hash_type &hash) const;
 
+    /// \brief Builds hash for page node from contiguous memory, going through the page hash cache.
+    /// \param h Hasher object.
+    /// \param page_index Page index for node.
+    /// \param page_data Pointer to start of contiguous page data.
+    /// \param hash Receives the hash.
+    /// \details Pages that are updated often, one word at a time, should use this variant,
+    /// because it only rehashes the words that changed since the page was last cached.
+    /// The cache is guarded by a mutex, so this method may run concurrently with proof queries.
+    void get_cached_page_node_hash(hasher_type &h, address_type page_index, const unsigned char *page_data,
+        hash_type &hash) const;
+
+    /// \brief Sets the maximum number of pages kept in the page hash cache.
+    /// \param capacity Number of pages. Zero disables the cache.
+    void set_page_hash_cache_capacity(size_t capacity);
+
     /// \brief Gets currently stored hash for page node.
     /// \param page_index Page index for node.
     /// \param hash Receives the hash.
@@ -351,6 +479,23 @@ public:
     /// \param log2_size log<sub>2</sub> of size subintended by node.
     /// \return Reference to precomputed hash.
     static const hash_type &get_pristine_hash(int log2_size);
+
+    /// \brief Checks if a memory range is pristine (i.e., filled with zeros).
+    /// \param data Pointer to start of range.
+    /// \param length Length of range in bytes.
+    /// \return True if all bytes are zero, false otherwise.
+    static bool is_pristine(const unsigned char *data, size_t length);
+
+    /// \brief Returns the indices of pages with non-pristine hashes inside a range.
+    /// \param start Start of range.
+    /// \param length Length of range.
+    /// \returns Page indices, in increasing order.
+    /// \details Pristine subtrees are not stored, so only the branches leading to
+    /// non-pristine pages inside the range are visited.
+    std::vector<address_type> get_non_pristine_pages(address_type start, address_type length) const;
+
+    /// \brief Returns the number of nodes currently allocated in the tree, excluding the root.
+    uint64_t get_node_count(void) const;
 };
 
 std::ostream &operator<<(std::ostream &out, const machine_merkle_tree::hash_type &hash);
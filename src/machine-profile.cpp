@@ -0,0 +1,52 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+
+#include "machine-profile.h"
+
+namespace cartesi {
+
+machine_profile machine_profiler::get_profile(void) const {
+    machine_profile profile;
+    for (size_t i = 0; i < m_insn_counts.size(); ++i) {
+        if (m_insn_counts[i] != 0) {
+            profile.insn_counts.push_back({insn_id_name(static_cast<insn_id>(i)), m_insn_counts[i]});
+        }
+    }
+    // Stable, so ties remain in insn_id order
+    std::stable_sort(profile.insn_counts.begin(), profile.insn_counts.end(),
+        [](const insn_count &a, const insn_count &b) { return a.count > b.count; });
+    for (size_t i = 0; i < m_insn_pair_counts.size(); ++i) {
+        if (m_insn_pair_counts[i] != 0) {
+            profile.insn_pair_counts.push_back({insn_id_name(static_cast<insn_id>(i / INSN_ID_COUNT)),
+                insn_id_name(static_cast<insn_id>(i % INSN_ID_COUNT)), m_insn_pair_counts[i]});
+        }
+    }
+    std::stable_sort(profile.insn_pair_counts.begin(), profile.insn_pair_counts.end(),
+        [](const insn_pair_count &a, const insn_pair_count &b) { return a.count > b.count; });
+    profile.pc_samples.reserve(m_pc_samples.size());
+    for (const auto &[pc, count] : m_pc_samples) {
+        profile.pc_samples.push_back({pc, count});
+    }
+    // Ties are broken by pc, so the order does not depend on the hash table
+    std::sort(profile.pc_samples.begin(), profile.pc_samples.end(), [](const pc_sample &a, const pc_sample &b) {
+        return a.count > b.count || (a.count == b.count && a.pc < b.pc);
+    });
+    return profile;
+}
+
+} // namespace cartesi
@@ -0,0 +1,109 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MACHINE_PROFILE_H
+#define MACHINE_PROFILE_H
+
+/// \file
+/// \brief Runtime profiling of the instructions executed by the interpreter.
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler-defines.h"
+#include "insn-id.h"
+
+namespace cartesi {
+
+/// \brief Number of times an instruction was executed
+struct insn_count {
+    std::string insn; ///< Instruction mnemonic
+    uint64_t count{}; ///< Number of executions
+};
+
+/// \brief Number of times an instruction was immediately followed by another
+struct insn_pair_count {
+    std::string insn;      ///< Mnemonic of the first instruction
+    std::string next_insn; ///< Mnemonic of the instruction that followed it
+    uint64_t count{};      ///< Number of occurrences
+};
+
+/// \brief Number of samples taken while the guest was at a given pc
+struct pc_sample {
+    uint64_t pc{};    ///< Guest pc
+    uint64_t count{}; ///< Number of samples
+};
+
+/// \brief Profile of the instructions executed by a machine
+struct machine_profile {
+    std::vector<insn_count> insn_counts;           ///< Instructions executed at least once, from most to least executed
+    std::vector<insn_pair_count> insn_pair_counts; ///< Pairs of consecutive instructions, from most to least frequent
+    std::vector<pc_sample> pc_samples;             ///< Sampled guest pcs, from most to least sampled
+};
+
+/// \class machine_profiler
+/// \brief Collects a machine_profile while the interpreter runs.
+/// \details Instructions are counted in an array indexed by insn_id, so counting costs a single increment.
+/// Pairs of consecutive instructions are counted the same way, in a matrix indexed by both insn_ids. They are the
+/// candidates for instruction fusion in the interpreter.
+/// Guest pcs are sampled once every pc_sample_period cycles only, so the cost of recording them is negligible.
+class machine_profiler final {
+public:
+    /// \brief Constructor
+    /// \param pc_sample_period Number of cycles between guest pc samples (0 disables sampling).
+    explicit machine_profiler(uint64_t pc_sample_period) :
+        m_pc_sample_period(pc_sample_period),
+        m_insn_pair_counts(INSN_ID_COUNT * INSN_ID_COUNT) {}
+
+    /// \brief Counts an execution of an instruction
+    /// \param id Instruction identifier.
+    void count_insn(insn_id id) {
+        const auto i = static_cast<size_t>(id);
+        ++m_insn_counts[i];
+        if (likely(m_last_insn < INSN_ID_COUNT)) {
+            ++m_insn_pair_counts[m_last_insn * INSN_ID_COUNT + i];
+        }
+        m_last_insn = i;
+    }
+
+    /// \brief Records a guest pc sample
+    /// \param pc Guest pc.
+    void sample_pc(uint64_t pc) {
+        ++m_pc_samples[pc];
+    }
+
+    /// \brief Returns the number of cycles between guest pc samples (0 if disabled)
+    uint64_t get_pc_sample_period(void) const {
+        return m_pc_sample_period;
+    }
+
+    /// \brief Returns the profile collected so far
+    machine_profile get_profile(void) const;
+
+private:
+    uint64_t m_pc_sample_period;                         ///< Number of cycles between guest pc samples
+    std::array<uint64_t, INSN_ID_COUNT> m_insn_counts{}; ///< Number of executions of each instruction
+    std::vector<uint64_t> m_insn_pair_counts;            ///< Number of occurrences of each pair of instructions
+    size_t m_last_insn{INSN_ID_COUNT};                   ///< Last instruction executed, or INSN_ID_COUNT if none
+    std::unordered_map<uint64_t, uint64_t> m_pc_samples; ///< Number of samples taken at each guest pc
+};
+
+} // namespace cartesi
+
+#endif
@@ -0,0 +1,69 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MACHINE_ROLLUP_H
+#define MACHINE_ROLLUP_H
+
+/// \file
+/// \brief Inputs and outputs of the native rollup driver.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "machine-merkle-tree.h"
+
+namespace cartesi {
+
+/// \brief Input fed to the machine by the rollup driver
+/// \details The input does not own its data. The driver copies it straight into the rollup memory ranges.
+struct rollup_input {
+    const unsigned char *metadata{}; ///< Contents of the input metadata memory range
+    uint64_t metadata_length{};      ///< Length of metadata in bytes
+    const unsigned char *payload{};  ///< Contents of the rx buffer memory range
+    uint64_t payload_length{};       ///< Length of payload in bytes
+};
+
+/// \brief List of inputs, in the order they are fed to the machine
+using rollup_inputs = std::vector<rollup_input>;
+
+/// \brief How the machine finished processing an input
+enum class rollup_input_status {
+    accepted,             ///< Machine yielded manually with reason rx-accepted
+    rejected,             ///< Machine yielded manually with reason rx-rejected
+    exception,            ///< Machine yielded manually with reason tx-exception
+    halted,               ///< Machine halted
+    reached_target_mcycle ///< Machine reached the target mcycle before yielding manually
+};
+
+/// \brief Outputs produced by the machine while processing an input
+struct rollup_input_result {
+    rollup_input_status status{rollup_input_status::accepted};  ///< How processing of the input ended
+    std::vector<std::string> vouchers;                          ///< Each voucher, as found in the tx buffer
+    std::vector<std::string> notices;                           ///< Each notice, as found in the tx buffer
+    std::vector<std::string> reports;                           ///< Each report, as found in the tx buffer
+    std::string exception;                                      ///< Payload of the exception, if any
+    std::vector<machine_merkle_tree::hash_type> voucher_hashes; ///< Hashes in the voucher hashes memory range
+    std::vector<machine_merkle_tree::hash_type> notice_hashes;  ///< Hashes in the notice hashes memory range
+    machine_merkle_tree::hash_type root_hash{};                 ///< Root hash when the input was accepted or rejected
+};
+
+/// \brief List of results, one per input processed
+using rollup_input_results = std::vector<rollup_input_result>;
+
+} // namespace cartesi
+
+#endif
@@ -27,6 +27,7 @@ namespace cartesi {
 /// \brief Concurrency runtime configuration
 struct concurrency_runtime_config {
     uint64_t update_merkle_tree{};
+    uint64_t verify_uarch_state_transitions{};
 };
 
 /// \brief HTIF runtime configuration
@@ -34,10 +35,24 @@ struct htif_runtime_config {
     bool no_console_putchar;
 };
 
+/// \brief Periodic hashes runtime configuration
+struct periodic_hashes_runtime_config {
+    uint64_t period{}; ///< Number of cycles between root hashes (0 disables periodic hashes)
+    uint64_t start{};  ///< First mcycle to hash (0 means the first hash is at mcycle \p period)
+};
+
+/// \brief Profiling runtime configuration
+struct profile_runtime_config {
+    bool enabled{};              ///< Count the instructions executed by the interpreter
+    uint64_t pc_sample_period{}; ///< Number of cycles between guest pc samples (0 disables sampling)
+};
+
 /// \brief Machine runtime configuration
 struct machine_runtime_config {
     concurrency_runtime_config concurrency{};
     htif_runtime_config htif{};
+    periodic_hashes_runtime_config periodic_hashes{};
+    profile_runtime_config profile{};
     bool skip_root_hash_check{};
     bool skip_version_check{};
     bool soft_yield{};
@@ -22,10 +22,6 @@
 
 #include <cstdint>
 
-#ifdef DUMP_HIST
-#include <unordered_map>
-#endif
-
 #include <boost/container/static_vector.hpp>
 
 #include "pma.h"
@@ -39,6 +35,7 @@ struct unpacked_iflags {
     bool X;      ///< CPU has yielded with automatic reset.
     bool Y;      ///< CPU has yielded with manual reset.
     bool H;      ///< CPU has been permanently halted.
+    bool I;      ///< WFI fast-forwards mcycle while CPU is idle.
 };               ///< Cartesi-specific unpacked CSR iflags.
 
 /// \brief Machine state.
@@ -133,14 +130,11 @@ struct machine_state {
     machine_statistics stats;
 #endif
 
-#ifdef DUMP_HIST
-    std::unordered_map<std::string, uint64_t> insn_hist;
-#endif
-
     /// \brief Reads the value of the iflags register.
     /// \returns The value of the register.
     uint64_t read_iflags(void) const {
-        return packed_iflags(iflags.PRV, iflags.X, iflags.Y, iflags.H);
+        return packed_iflags(iflags.PRV, iflags.X, iflags.Y, iflags.H) |
+            (static_cast<uint64_t>(iflags.I) << IFLAGS_I_SHIFT);
     }
 
     /// \brief Reads the value of the iflags register.
@@ -150,6 +144,7 @@ struct machine_state {
         iflags.Y = (val >> IFLAGS_Y_SHIFT) & 1;
         iflags.X = (val >> IFLAGS_X_SHIFT) & 1;
         iflags.PRV = (val >> IFLAGS_PRV_SHIFT) & 3;
+        iflags.I = (val >> IFLAGS_I_SHIFT) & 1;
     }
 
     /// \brief Packs iflags into the CSR value
@@ -25,6 +25,7 @@ namespace cartesi {
 struct machine_statistics {
     uint64_t inner_loop;    ///< Counts executions of inner loop
     uint64_t outer_loop;    ///< Counts executions of outer loop
+    uint64_t rtc_tick;      ///< Counts RTC ticks processed by the outer loop
     uint64_t sv_int;        ///< Counts supervisor interrupts
     uint64_t sv_ex;         ///< Counts supervisor exceptions (except ECALL)
     uint64_t m_int;         ///< Counts machine interrupts
@@ -56,6 +57,11 @@ struct machine_statistics {
     uint64_t tlb_flush_fence_vma_asid;       ///< Counts TLB flush originated from SFENCE.VMA (asid)
     uint64_t tlb_flush_fence_vma_vaddr;      ///< Counts TLB flush originated from SFENCE.VMA (vaddr)
     uint64_t tlb_flush_fence_vma_asid_vaddr; ///< Counts TLB flush originated originated from SFENCE.VMA (vaddr,asid)
+
+    // Fetch translation cache
+    uint64_t fcache_hit;   ///< Counts fetch translation cache hits
+    uint64_t fcache_miss;  ///< Counts fetch translation cache misses
+    uint64_t fcache_flush; ///< Counts fetch translation cache flushes caused by code TLB flushes
 };
 
 #ifdef DUMP_COUNTERS
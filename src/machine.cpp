@@ -16,11 +16,14 @@
 
 #include "machine.h"
 
+#include <algorithm>
+#include <atomic>
 #include <boost/range/adaptor/sliced.hpp>
 #include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 #include "clint-factory.h"
 #include "dtb.h"
@@ -239,6 +242,48 @@ void machine::replace_memory_range(const memory_range_config &range) {
     throw std::invalid_argument{"attempt to replace inexistent memory range"};
 }
 
+void machine::clear_memory_range(uint64_t start, uint64_t length) {
+    for (auto &pma : m_s.pmas) {
+        if (pma.get_start() == start && pma.get_length() == length) {
+            if (DID_is_protected(pma.get_istart_DID())) {
+                throw std::invalid_argument{"attempt to clear a protected range "s + pma.get_description()};
+            }
+            if (!pma.get_istart_M()) {
+                throw std::invalid_argument{"attempt to clear a range that is not memory "s + pma.get_description()};
+            }
+            // Pages that are clean in the dirty page map match their hash in the Merkle tree,
+            // so only pages that are dirty or have a non-pristine hash can hold non-zero data.
+            // Pages in the write TLB may have been written without being marked dirty.
+            mark_write_tlb_dirty_pages();
+            auto pages = m_t.get_non_pristine_pages(start, length);
+            for (uint64_t page_start_in_range = 0; page_start_in_range < length;
+                 page_start_in_range += PMA_PAGE_SIZE) {
+                if (pma.is_page_marked_dirty(page_start_in_range)) {
+                    pages.push_back(start + page_start_in_range);
+                }
+            }
+            std::sort(pages.begin(), pages.end());
+            pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+            unsigned char *host_memory = pma.get_memory().get_host_memory();
+            machine_merkle_tree::hasher_type h;
+            m_t.begin_update();
+            for (const uint64_t page_address : pages) {
+                const uint64_t page_start_in_range = page_address - start;
+                memset(host_memory + page_start_in_range, 0, PMA_PAGE_SIZE);
+                pma.mark_clean_page(page_start_in_range);
+                if (!m_t.update_page_node_hash(page_address,
+                        machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size()))) {
+                    m_t.end_update(h);
+                    throw std::runtime_error{"error updating Merkle tree"};
+                }
+            }
+            m_t.end_update(h);
+            return;
+        }
+    }
+    throw std::invalid_argument{"attempt to clear inexistent memory range"};
+}
+
 template <TLB_entry_type ETYPE>
 static void load_tlb_entry(machine &m, uint64_t eidx, unsigned char *hmem) {
     tlb_hot_entry &tlbhe = m.get_state().tlb.hot[ETYPE][eidx];
@@ -316,6 +361,10 @@ machine::machine(const machine_config &c, const machine_runtime_config &r) :
 
     m_s.soft_yield = r.soft_yield;
 
+    if (r.profile.enabled) {
+        m_profiler = std::make_unique<machine_profiler>(r.profile.pc_sample_period);
+    }
+
     // General purpose registers
     for (int i = 1; i < X_REG_COUNT; i++) {
         write_x(i, m_c.processor.x[i]);
@@ -846,17 +895,15 @@ machine::~machine() {
     if (m_c.htif.console_getchar || has_virtio_console()) {
         os_close_tty();
     }
-#ifdef DUMP_HIST
-    (void) fprintf(stderr, "\nInstruction Histogram:\n");
-    for (auto v : m_s.insn_hist) {
-        (void) fprintf(stderr, "%s: %" PRIu64 "\n", v.first.c_str(), v.second);
-    }
-#endif
 #if DUMP_COUNTERS
-#define TLB_HIT_RATIO(s, a, b) (((double) (s).stats.b) / ((s).stats.a + (s).stats.b))
+#define COUNTER_RATIO(n, d) ((d) != 0 ? ((double) (n)) / (d) : 0.0)
+#define TLB_HIT_RATIO(s, a, b) COUNTER_RATIO((s).stats.b, (s).stats.a + (s).stats.b)
     (void) fprintf(stderr, "\nMachine Counters:\n");
     (void) fprintf(stderr, "inner loops: %" PRIu64 "\n", m_s.stats.inner_loop);
     (void) fprintf(stderr, "outers loops: %" PRIu64 "\n", m_s.stats.outer_loop);
+    (void) fprintf(stderr, "inner loops per outer loop: %.2f\n",
+        COUNTER_RATIO(m_s.stats.inner_loop, m_s.stats.outer_loop));
+    (void) fprintf(stderr, "rtc ticks: %" PRIu64 "\n", m_s.stats.rtc_tick);
     (void) fprintf(stderr, "supervisor ints: %" PRIu64 "\n", m_s.stats.sv_int);
     (void) fprintf(stderr, "supervisor ex: %" PRIu64 "\n", m_s.stats.sv_ex);
     (void) fprintf(stderr, "machine ints: %" PRIu64 "\n", m_s.stats.m_int);
@@ -890,6 +937,10 @@ machine::~machine() {
     (void) fprintf(stderr, "tlb_flush_fence_vma_asid: %" PRIu64 "\n", m_s.stats.tlb_flush_fence_vma_asid);
     (void) fprintf(stderr, "tlb_flush_fence_vma_vaddr: %" PRIu64 "\n", m_s.stats.tlb_flush_fence_vma_vaddr);
     (void) fprintf(stderr, "tlb_flush_fence_vma_asid_vaddr: %" PRIu64 "\n", m_s.stats.tlb_flush_fence_vma_asid_vaddr);
+    (void) fprintf(stderr, "fetch cache hit ratio: %.4f\n", TLB_HIT_RATIO(m_s, fcache_miss, fcache_hit));
+    (void) fprintf(stderr, "fcache_hit: %" PRIu64 "\n", m_s.stats.fcache_hit);
+    (void) fprintf(stderr, "fcache_miss: %" PRIu64 "\n", m_s.stats.fcache_miss);
+    (void) fprintf(stderr, "fcache_flush: %" PRIu64 "\n", m_s.stats.fcache_flush);
 #endif
 }
 
@@ -1608,6 +1659,9 @@ bool machine::verify_dirty_page_maps(void) const {
     return !broken;
 }
 
+/// \brief Number of page chunks per thread in update_merkle_tree(), trading load balance for per-chunk overhead
+constexpr uint64_t UPDATE_MERKLE_TREE_CHUNKS_PER_THREAD = 8;
+
 static uint64_t get_task_concurrency(uint64_t value) {
     const uint64_t concurrency = value > 0 ? value : std::max(os_get_concurrency(), UINT64_C(1));
     return std::min(concurrency, static_cast<uint64_t>(THREADS_MAX));
@@ -1625,57 +1679,57 @@ bool machine::update_merkle_tree(void) const {
         auto peek = pma->get_peek();
         // Each PMA has a number of pages
         auto pages_in_range = (pma->get_length() + PMA_PAGE_SIZE - 1) / PMA_PAGE_SIZE;
-        // For each PMA, we launch as many threads (n) as defined on concurrency
+        // For each PMA, we use as many threads (n) as defined on concurrency
         // runtime config or as the hardware supports.
         const uint64_t n = get_task_concurrency(m_r.concurrency.update_merkle_tree);
-        const bool succeeded = os_parallel_for(n, [&](int j, const parallel_for_mutex &mutex) -> bool {
-            auto scratch = unique_calloc<unsigned char>(PMA_PAGE_SIZE, std::nothrow_t{});
-            if (!scratch) {
-                return false;
-            }
-            machine_merkle_tree::hasher_type h;
-            // Thread j is responsible for page i if i % n == j.
-            for (uint64_t i = j; i < pages_in_range; i += n) {
-                const uint64_t page_start_in_range = i * PMA_PAGE_SIZE;
-                const uint64_t page_address = pma->get_start() + page_start_in_range;
-                const unsigned char *page_data = nullptr;
-                // Skip any clean pages
-                if (!pma->is_page_marked_dirty(page_start_in_range)) {
-                    continue;
-                }
-                // If the peek failed, or if it returned a page for update but
-                // we failed updating it, the entire process failed
-                if (!peek(*pma, *this, page_start_in_range, &page_data, scratch.get())) {
+        // Pages are split in chunks that idle threads can steal from busy ones.
+        const uint64_t chunk_size = std::max(pages_in_range / (n * UPDATE_MERKLE_TREE_CHUNKS_PER_THREAD), UINT64_C(1));
+        const bool succeeded = os_parallel_for_range(n, 0, pages_in_range, chunk_size,
+            [&](uint64_t first, uint64_t last, const parallel_for_mutex &mutex) -> bool {
+                auto scratch = unique_calloc<unsigned char>(PMA_PAGE_SIZE, std::nothrow_t{});
+                if (!scratch) {
                     return false;
                 }
-                if (page_data) {
-                    const bool is_pristine = std::all_of(page_data, page_data + PMA_PAGE_SIZE,
-                        [](unsigned char pp) -> bool { return pp == '\0'; });
-
-                    if (is_pristine) {
-                        // The update_page_node_hash function in the machine_merkle_tree is not thread
-                        // safe, so we protect it with a mutex
-                        const parallel_for_mutex_guard lock(mutex);
-                        if (!m_t.update_page_node_hash(page_address,
-                                machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size()))) {
-                            return false;
-                        }
-                    } else {
-                        hash_type hash;
-                        m_t.get_page_node_hash(h, page_data, hash);
-                        {
+                machine_merkle_tree::hasher_type h;
+                for (uint64_t i = first; i < last; ++i) {
+                    const uint64_t page_start_in_range = i * PMA_PAGE_SIZE;
+                    const uint64_t page_address = pma->get_start() + page_start_in_range;
+                    const unsigned char *page_data = nullptr;
+                    // Skip any clean pages
+                    if (!pma->is_page_marked_dirty(page_start_in_range)) {
+                        continue;
+                    }
+                    // If the peek failed, or if it returned a page for update but
+                    // we failed updating it, the entire process failed
+                    if (!peek(*pma, *this, page_start_in_range, &page_data, scratch.get())) {
+                        return false;
+                    }
+                    if (page_data) {
+                        if (machine_merkle_tree::is_pristine(page_data, PMA_PAGE_SIZE)) {
                             // The update_page_node_hash function in the machine_merkle_tree is not thread
-                            // safe, so we protect it with a mutex
+                            // safe, so we protect it with a mutex.
+                            // Pristine pages release their nodes in the tree.
                             const parallel_for_mutex_guard lock(mutex);
-                            if (!m_t.update_page_node_hash(page_address, hash)) {
+                            if (!m_t.update_page_node_hash(page_address,
+                                    machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size()))) {
                                 return false;
                             }
+                        } else {
+                            hash_type hash;
+                            m_t.get_page_node_hash(h, page_data, hash);
+                            {
+                                // The update_page_node_hash function in the machine_merkle_tree is not thread
+                                // safe, so we protect it with a mutex
+                                const parallel_for_mutex_guard lock(mutex);
+                                if (!m_t.update_page_node_hash(page_address, hash)) {
+                                    return false;
+                                }
+                            }
                         }
                     }
                 }
-            }
-            return true;
-        });
+                return true;
+            });
         // If any thread failed, we also failed
         if (!succeeded) {
             m_t.end_update(gh);
@@ -1710,7 +1764,8 @@ bool machine::update_merkle_tree_page(uint64_t address) {
     if (page_data) {
         const uint64_t page_address = pma.get_start() + page_start_in_range;
         hash_type hash;
-        m_t.get_page_node_hash(h, page_data, hash);
+        // Pages are updated here one word write at a time, so the cache saves rehashing the unmodified words
+        m_t.get_cached_page_node_hash(h, page_address, page_data, hash);
         if (!m_t.update_page_node_hash(page_address, hash)) {
             m_t.end_update(h);
             return false;
@@ -1789,6 +1844,38 @@ machine_merkle_tree::proof_type machine::get_proof(uint64_t address, int log2_si
     return get_proof(address, log2_size, skip_merkle_tree_update);
 }
 
+machine_merkle_tree::multi_proof_type machine::get_multi_proof(
+    const machine_merkle_tree::multi_proof_type::targets_type &targets) const {
+    for (const auto &target : targets) {
+        // Check for valid target node size
+        if (target.log2_size > machine_merkle_tree::get_log2_root_size() ||
+            target.log2_size < machine_merkle_tree::get_log2_word_size()) {
+            throw std::invalid_argument{"invalid log2_size"};
+        }
+        // Check target address alignment
+        if (target.address & ((~UINT64_C(0)) >> (64 - target.log2_size))) {
+            throw std::invalid_argument{"address not aligned to log2_size"};
+        }
+    }
+    if (!update_merkle_tree()) {
+        throw std::runtime_error{"error updating Merkle tree"};
+    }
+    // Targets smaller than a page lie entirely inside or entirely outside a PMA range,
+    // so their page data can be obtained just as in get_proof
+    auto scratch = unique_calloc<unsigned char>(PMA_PAGE_SIZE);
+    return m_t.get_multi_proof(targets, [this, &scratch](uint64_t page_address) -> const unsigned char * {
+        const pma_entry &pma = find_pma_entry(m_pmas, page_address, PMA_PAGE_SIZE);
+        const unsigned char *page_data = nullptr;
+        if (!pma.get_istart_E()) {
+            auto peek = pma.get_peek();
+            if (!peek(pma, *this, page_address - pma.get_start(), &page_data, scratch.get())) {
+                throw std::runtime_error{"PMA peek failed"};
+            }
+        }
+        return page_data;
+    });
+}
+
 void machine::read_memory(uint64_t address, unsigned char *data, uint64_t length) const {
     if (length == 0) {
         return;
@@ -1796,7 +1883,10 @@ void machine::read_memory(uint64_t address, unsigned char *data, uint64_t length
     if (!data) {
         throw std::invalid_argument{"invalid data buffer"};
     }
-    const pma_entry &pma = find_pma_entry(m_pmas, address, length);
+    read_pma_memory(find_pma_entry(m_pmas, address, length), address, data, length);
+}
+
+void machine::read_pma_memory(const pma_entry &pma, uint64_t address, unsigned char *data, uint64_t length) const {
     if (pma.get_istart_M()) {
         memcpy(data, pma.get_memory().get_host_memory() + (address - pma.get_start()), length);
         return;
@@ -1918,6 +2008,110 @@ void machine::write_virtual_memory(uint64_t vaddr_start, const unsigned char *da
     }
 }
 
+pma_entry &machine::find_pma_entry_prefix(uint64_t paddr, uint64_t length, uint64_t &prefix_length) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): remove const to reuse code
+    return const_cast<pma_entry &>(std::as_const(*this).find_pma_entry_prefix(paddr, length, prefix_length));
+}
+
+const pma_entry &machine::find_pma_entry_prefix(uint64_t paddr, uint64_t length, uint64_t &prefix_length) const {
+    const pma_entry &pma = find_pma_entry(m_pmas, paddr, 1);
+    prefix_length = pma.get_length() != 0 ? std::min(length, pma.get_length() - (paddr - pma.get_start())) : length;
+    return pma;
+}
+
+/// \brief Checks a memory range to be accessed by one of the vectored memory functions
+/// \param address Start of range.
+/// \param data Buffer holding the contents of the range.
+/// \param length Length of range.
+static void check_memory_range(uint64_t address, const unsigned char *data, uint64_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (!data) {
+        throw std::invalid_argument{"invalid data buffer"};
+    }
+    if (length - 1 > UINT64_MAX - address) {
+        throw std::invalid_argument{"memory range wraps around address space"};
+    }
+}
+
+/// \brief Checks if a PMA entry covers a physical address
+/// \param pma Pointer to PMA entry, possibly null.
+/// \param paddr Physical address.
+/// \returns True if \p pma is a non-empty PMA that covers \p paddr.
+static bool pma_covers(const pma_entry *pma, uint64_t paddr) {
+    return pma != nullptr && pma->get_length() != 0 && paddr >= pma->get_start() &&
+        paddr - pma->get_start() < pma->get_length();
+}
+
+void machine::read_memory_ranges(const memory_range_reads &ranges) const {
+    // Consecutive ranges often fall in the same PMA, so the last one is tried before searching
+    const pma_entry *pma = nullptr;
+    for (const auto &r : ranges) {
+        check_memory_range(r.address, r.data, r.length);
+        // Fast path: range entirely inside the same memory PMA as the previous one
+        if (pma != nullptr && pma->get_istart_M() && pma->contains(r.address, r.length)) {
+            memcpy(r.data, pma->get_memory().get_host_memory() + (r.address - pma->get_start()), r.length);
+            continue;
+        }
+        uint64_t address = r.address;
+        unsigned char *data = r.data;
+        uint64_t length = r.length;
+        while (length != 0) {
+            uint64_t prefix_length = 0;
+            if (pma_covers(pma, address)) {
+                prefix_length = std::min(length, pma->get_length() - (address - pma->get_start()));
+            } else {
+                pma = &find_pma_entry_prefix(address, length, prefix_length);
+                if (pma->get_length() == 0) {
+                    throw std::invalid_argument{"address range not entirely in PMAs"};
+                }
+            }
+            read_pma_memory(*pma, address, data, prefix_length);
+            address += prefix_length;
+            data += prefix_length;
+            length -= prefix_length;
+        }
+    }
+}
+
+void machine::write_memory_ranges(const memory_range_writes &ranges) {
+    pma_entry *pma = nullptr;
+    for (const auto &r : ranges) {
+        check_memory_range(r.address, r.data, r.length);
+        uint64_t address = r.address;
+        const unsigned char *data = r.data;
+        uint64_t length = r.length;
+        while (length != 0) {
+            uint64_t prefix_length = 0;
+            if (pma_covers(pma, address)) {
+                prefix_length = std::min(length, pma->get_length() - (address - pma->get_start()));
+            } else {
+                pma = &find_pma_entry_prefix(address, length, prefix_length);
+            }
+            if (!pma->get_istart_M() || pma->get_istart_E()) {
+                throw std::invalid_argument{"address range not entirely in memory PMA"};
+            }
+            pma->write_memory(address, data, prefix_length);
+            address += prefix_length;
+            data += prefix_length;
+            length -= prefix_length;
+        }
+    }
+}
+
+void machine::read_virtual_memory_ranges(const memory_range_reads &ranges) {
+    for (const auto &r : ranges) {
+        read_virtual_memory(r.address, r.data, r.length);
+    }
+}
+
+void machine::write_virtual_memory_ranges(const memory_range_writes &ranges) {
+    for (const auto &r : ranges) {
+        write_virtual_memory(r.address, r.data, r.length);
+    }
+}
+
 uint64_t machine::read_word(uint64_t word_address) const {
     // Make sure address is aligned
     if (word_address & (PMA_WORD_SIZE - 1)) {
@@ -2097,6 +2291,48 @@ void machine::verify_uarch_step_state_transition(const hash_type &root_hash_befo
     }
 }
 
+void machine::verify_uarch_state_transitions(const uarch_state_transitions &transitions,
+    const machine_runtime_config &r, bool one_based) {
+    // Consecutive transitions must form a chain
+    for (uint64_t i = 1; i < transitions.size(); ++i) {
+        if (transitions[i].root_hash_before != transitions[i - 1].root_hash_after) {
+            throw std::invalid_argument{"root hash before transition " + std::to_string(i + one_based) +
+                " does not match root hash after transition " + std::to_string(i - 1 + one_based)};
+        }
+    }
+    // Transitions past the first failure found so far are skipped, but earlier ones are still verified
+    // so the error reported is always the one for the first invalid transition
+    std::atomic<uint64_t> first_failed{transitions.size()};
+    std::string first_failed_what;
+    const uint64_t n = get_task_concurrency(r.concurrency.verify_uarch_state_transitions);
+    os_parallel_for_range(n, 0, transitions.size(), 1,
+        [&](uint64_t first, uint64_t last, const parallel_for_mutex &mutex) -> bool {
+            for (uint64_t i = first; i < last && i < first_failed.load(std::memory_order_relaxed); ++i) {
+                const auto &t = transitions[i];
+                try {
+                    if (t.type == uarch_state_transition_type::reset) {
+                        verify_uarch_reset_state_transition(t.root_hash_before, t.log, t.root_hash_after, r,
+                            one_based);
+                    } else {
+                        verify_uarch_step_state_transition(t.root_hash_before, t.log, t.root_hash_after, r,
+                            one_based);
+                    }
+                } catch (std::exception &e) {
+                    const parallel_for_mutex_guard lock(mutex);
+                    if (i < first_failed.load(std::memory_order_relaxed)) {
+                        first_failed.store(i, std::memory_order_relaxed);
+                        first_failed_what = e.what();
+                    }
+                }
+            }
+            return true;
+        });
+    if (first_failed.load() < transitions.size()) {
+        throw std::invalid_argument{
+            "transition " + std::to_string(first_failed.load() + one_based) + ": " + first_failed_what};
+    }
+}
+
 machine_config machine::get_default_config(void) {
     return machine_config{};
 }
@@ -2113,12 +2349,288 @@ uarch_interpreter_break_reason machine::run_uarch(uint64_t uarch_cycle_end) {
     return uarch_interpret(a, uarch_cycle_end);
 }
 
+uint64_t machine::get_next_periodic_hash_mcycle(uint64_t mcycle) const {
+    const uint64_t period = m_r.periodic_hashes.period;
+    // Without a start, the first hash is one period in
+    const uint64_t start = m_r.periodic_hashes.start != 0 ? m_r.periodic_hashes.start : period;
+    if (mcycle < start) {
+        return start;
+    }
+    // Hashes are taken at start + k * period, for all k >= 0
+    const uint64_t elapsed = (mcycle - start) / period * period;
+    if (elapsed == mcycle - start && m_periodic_hash_mcycle != mcycle) {
+        return mcycle;
+    }
+    if (UINT64_MAX - start - elapsed < period) {
+        return UINT64_MAX;
+    }
+    return start + elapsed + period;
+}
+
+void machine::snapshot_dirty_pages(periodic_root_hasher::snapshot &s) const {
+    static_assert(PMA_PAGE_SIZE == machine_merkle_tree::get_page_size(),
+        "PMA and machine_merkle_tree page sizes must match");
+    auto scratch = unique_calloc<unsigned char>(PMA_PAGE_SIZE);
+    // Go over the write TLB and mark as dirty all pages currently there
+    mark_write_tlb_dirty_pages();
+    for (const auto &pma : m_pmas) {
+        auto peek = pma->get_peek();
+        for (uint64_t page_start_in_range = 0; page_start_in_range < pma->get_length();
+             page_start_in_range += PMA_PAGE_SIZE) {
+            if (!pma->is_page_marked_dirty(page_start_in_range)) {
+                continue;
+            }
+            const unsigned char *page_data = nullptr;
+            if (!peek(*pma, *this, page_start_in_range, &page_data, scratch.get())) {
+                throw std::runtime_error{"peek failed"};
+            }
+            // The copy is what allows the interpreter to resume while the snapshot is hashed
+            if (page_data) {
+                s.add_page(pma->get_start() + page_start_in_range, page_data);
+            }
+        }
+        pma->mark_pages_clean();
+    }
+}
+
 interpreter_break_reason machine::run(uint64_t mcycle_end) {
     if (mcycle_end < read_mcycle()) {
         throw std::invalid_argument{"mcycle is past"};
     }
     state_access a(*this);
-    return interpret(a, mcycle_end);
+    if (m_r.periodic_hashes.period == 0) {
+        return interpret(a, mcycle_end);
+    }
+    // The hasher owns the Merkle tree until it finishes
+    periodic_root_hasher hasher(m_t, m_periodic_root_hashes);
+    for (;;) {
+        const uint64_t mcycle_hash = get_next_periodic_hash_mcycle(read_mcycle());
+        const auto break_reason = interpret(a, std::min(mcycle_hash, mcycle_end));
+        if (read_mcycle() == mcycle_hash) {
+            periodic_root_hasher::snapshot s;
+            s.mcycle = mcycle_hash;
+            snapshot_dirty_pages(s);
+            hasher.push(std::move(s));
+            m_periodic_hash_mcycle = mcycle_hash;
+        }
+        if (break_reason != interpreter_break_reason::reached_target_mcycle || read_mcycle() >= mcycle_end) {
+            hasher.finish();
+            return break_reason;
+        }
+    }
+}
+
+void machine::run_uarch_until(uint64_t mcycle_end) {
+    // Each run of the microarchitecture until it halts executes one instruction of the interpreter.
+    // Stop at the same points where run() would break.
+    while (read_mcycle() < mcycle_end) {
+        if (run_uarch(UINT64_MAX) != uarch_interpreter_break_reason::uarch_halted) {
+            throw std::runtime_error{"microarchitecture did not halt"};
+        }
+        reset_uarch();
+        if (read_iflags_H() || read_iflags_Y() || read_iflags_X()) {
+            break;
+        }
+    }
+}
+
+interpreter_break_reason machine::run_lockstep(machine &reference, uint64_t mcycle_end, uint64_t period) {
+    if (&reference == this) {
+        throw std::invalid_argument{"reference must be another machine"};
+    }
+    if (period == 0) {
+        throw std::invalid_argument{"lockstep period cannot be 0"};
+    }
+    if (mcycle_end < read_mcycle()) {
+        throw std::invalid_argument{"mcycle is past"};
+    }
+    const auto check = [&]() {
+        hash_type hash;
+        hash_type reference_hash;
+        get_root_hash(hash);
+        reference.get_root_hash(reference_hash);
+        if (hash != reference_hash) {
+            throw std::runtime_error{"machine diverged from reference at mcycle " + std::to_string(read_mcycle()) +
+                " (reference at mcycle " + std::to_string(reference.read_mcycle()) + ")"};
+        }
+    };
+    check();
+    for (;;) {
+        const uint64_t mcycle = read_mcycle();
+        const auto break_reason = run(mcycle + std::min(period, mcycle_end - mcycle));
+        reference.run_uarch_until(read_mcycle());
+        check();
+        if (break_reason != interpreter_break_reason::reached_target_mcycle || read_mcycle() >= mcycle_end) {
+            return break_reason;
+        }
+    }
+}
+
+periodic_root_hashes machine::get_periodic_root_hashes(void) {
+    return std::exchange(m_periodic_root_hashes, {});
+}
+
+machine_profile machine::get_profile(void) const {
+    if (!m_profiler) {
+        return {};
+    }
+    return m_profiler->get_profile();
+}
+
+/// \brief Reads an output the guest left at the start of the tx buffer.
+/// \param m Machine to read from.
+/// \param tx_buffer Configuration of the tx buffer memory range.
+/// \param header_length Length of the header, which ends with the big-endian length of the payload.
+/// \param with_header Whether the header is included in the returned output.
+/// \returns The output.
+static std::string read_rollup_output(const machine &m, const memory_range_config &tx_buffer, uint64_t header_length,
+    bool with_header) {
+    std::array<unsigned char, sizeof(uint64_t)> be_payload_length{};
+    m.read_memory(tx_buffer.start + header_length - be_payload_length.size(), be_payload_length.data(),
+        be_payload_length.size());
+    uint64_t payload_length = 0;
+    for (const unsigned char b : be_payload_length) {
+        payload_length = (payload_length << 8) | b;
+    }
+    if (payload_length > tx_buffer.length - header_length) {
+        throw std::runtime_error{"rollup output does not fit in tx buffer"};
+    }
+    const uint64_t start = with_header ? 0 : header_length;
+    std::string output(header_length - start + payload_length, '\0');
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    m.read_memory(tx_buffer.start + start, reinterpret_cast<unsigned char *>(output.data()), output.size());
+    return output;
+}
+
+/// \brief Reads the hashes the guest left in a rollup memory range, up to the first zero hash.
+/// \param m Machine to read from.
+/// \param range Configuration of the memory range.
+/// \returns The hashes.
+static std::vector<machine::hash_type> read_rollup_hashes(const machine &m, const memory_range_config &range) {
+    std::vector<machine::hash_type> hashes;
+    const machine::hash_type zero{};
+    machine::hash_type hash{};
+    for (uint64_t offset = 0; offset + hash.size() <= range.length; offset += hash.size()) {
+        m.read_memory(range.start + offset, hash.data(), hash.size());
+        if (hash == zero) {
+            break;
+        }
+        hashes.push_back(hash);
+    }
+    return hashes;
+}
+
+rollup_input_status machine::run_rollup_until_manual_yield(uint64_t mcycle_end, rollup_input_result &result) {
+    const auto &tx_buffer = m_c.rollup->tx_buffer;
+    for (;;) {
+        switch (run(mcycle_end)) {
+            case interpreter_break_reason::halted:
+                return rollup_input_status::halted;
+            case interpreter_break_reason::reached_target_mcycle:
+                return rollup_input_status::reached_target_mcycle;
+            case interpreter_break_reason::yielded_manually:
+                switch (read_htif_tohost_data() >> 32) {
+                    case HTIF_YIELD_REASON_RX_ACCEPTED:
+                        return rollup_input_status::accepted;
+                    case HTIF_YIELD_REASON_RX_REJECTED:
+                        return rollup_input_status::rejected;
+                    case HTIF_YIELD_REASON_TX_EXCEPTION:
+                        // offset and payload length precede the payload
+                        result.exception = read_rollup_output(*this, tx_buffer, 2 * 32, false);
+                        return rollup_input_status::exception;
+                    default:
+                        throw std::runtime_error{"invalid manual yield reason"};
+                }
+            case interpreter_break_reason::yielded_automatically:
+                switch (read_htif_tohost_data() >> 32) {
+                    case HTIF_YIELD_REASON_TX_VOUCHER:
+                        // address, offset and payload length precede the payload
+                        result.vouchers.push_back(read_rollup_output(*this, tx_buffer, 3 * 32, true));
+                        break;
+                    case HTIF_YIELD_REASON_TX_NOTICE:
+                        // offset and payload length precede the payload
+                        result.notices.push_back(read_rollup_output(*this, tx_buffer, 2 * 32, true));
+                        break;
+                    case HTIF_YIELD_REASON_TX_REPORT:
+                        result.reports.push_back(read_rollup_output(*this, tx_buffer, 2 * 32, true));
+                        break;
+                    default:
+                        // progress and other reasons are ignored
+                        break;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void machine::feed_rollup_request(const unsigned char *payload, uint64_t length, uint64_t fromhost_data) {
+    const auto &rx_buffer = m_c.rollup->rx_buffer;
+    if (length > rx_buffer.length) {
+        throw std::invalid_argument{"payload does not fit in rx buffer"};
+    }
+    clear_memory_range(rx_buffer.start, rx_buffer.length);
+    write_memory(rx_buffer.start, payload, length);
+    reset_iflags_Y();
+    write_htif_fromhost_data(fromhost_data);
+}
+
+rollup_input_results machine::advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) {
+    if (!m_c.rollup.has_value()) {
+        throw std::invalid_argument{"rollup device is not present"};
+    }
+    const auto &r = m_c.rollup.value();
+    rollup_input_results results;
+    results.reserve(inputs.size() + 1);
+    // The leading entry collects whatever the machine produces before it asks for the first input
+    auto &initial = results.emplace_back();
+    auto status = initial.status = run_rollup_until_manual_yield(mcycle_end, initial);
+    if (status != rollup_input_status::accepted && status != rollup_input_status::rejected) {
+        return results;
+    }
+    if (!read_iunrep()) {
+        get_root_hash(initial.root_hash);
+    }
+    for (const auto &input : inputs) {
+        auto &result = results.emplace_back();
+        if (input.metadata_length > r.input_metadata.length) {
+            throw std::invalid_argument{"metadata does not fit in input metadata memory range"};
+        }
+        clear_memory_range(r.input_metadata.start, r.input_metadata.length);
+        write_memory(r.input_metadata.start, input.metadata, input.metadata_length);
+        clear_memory_range(r.voucher_hashes.start, r.voucher_hashes.length);
+        clear_memory_range(r.notice_hashes.start, r.notice_hashes.length);
+        feed_rollup_request(input.payload, input.payload_length, 0);
+        status = result.status = run_rollup_until_manual_yield(mcycle_end, result);
+        if (status != rollup_input_status::accepted && status != rollup_input_status::rejected) {
+            break;
+        }
+        result.voucher_hashes = read_rollup_hashes(*this, r.voucher_hashes);
+        result.notice_hashes = read_rollup_hashes(*this, r.notice_hashes);
+        if (!read_iunrep()) {
+            get_root_hash(result.root_hash);
+        }
+        if (status != rollup_input_status::accepted) {
+            break;
+        }
+    }
+    return results;
+}
+
+rollup_input_result machine::inspect_rollup(const unsigned char *query, uint64_t length, uint64_t mcycle_end) {
+    if (!m_c.rollup.has_value()) {
+        throw std::invalid_argument{"rollup device is not present"};
+    }
+    rollup_input_result result;
+    result.status = run_rollup_until_manual_yield(mcycle_end, result);
+    if (result.status != rollup_input_status::accepted && result.status != rollup_input_status::rejected) {
+        return result;
+    }
+    result = rollup_input_result{};
+    feed_rollup_request(query, length, 1);
+    result.status = run_rollup_until_manual_yield(mcycle_end, result);
+    return result;
 }
 
 } // namespace cartesi
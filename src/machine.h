@@ -22,17 +22,23 @@
 
 #include <boost/container/static_vector.hpp>
 #include <memory>
+#include <optional>
 
 #include "access-log.h"
 #include "interpret.h"
 #include "machine-config.h"
 #include "machine-memory-range-descr.h"
+#include "machine-memory-ranges.h"
 #include "machine-merkle-tree.h"
+#include "machine-profile.h"
+#include "machine-rollup.h"
 #include "machine-runtime-config.h"
 #include "machine-state.h"
 #include "os.h"
+#include "periodic-root-hasher.h"
 #include "uarch-interpret.h"
 #include "uarch-machine.h"
+#include "uarch-state-transition.h"
 #include "virtio-device.h"
 
 namespace cartesi {
@@ -66,6 +72,10 @@ private:
 
     boost::container::static_vector<std::unique_ptr<virtio_device>, VIRTIO_MAX> m_vdevs; ///< Array of VirtIO devices
 
+    periodic_root_hashes m_periodic_root_hashes;    ///< Root hashes computed by run() and not yet retrieved
+    std::optional<uint64_t> m_periodic_hash_mcycle; ///< mcycle of the last periodic root hash taken by run()
+    std::unique_ptr<machine_profiler> m_profiler;   ///< Profiler, or nullptr if profiling is disabled
+
     static const pma_entry::flags m_dtb_flags;                   ///< PMA flags used for DTB
     static const pma_entry::flags m_ram_flags;                   ///< PMA flags used for RAM
     static const pma_entry::flags m_flash_drive_flags;           ///< PMA flags used for flash drives
@@ -135,6 +145,52 @@ private:
     template <typename CONTAINER>
     const pma_entry &find_pma_entry(const CONTAINER &pmas, uint64_t paddr, size_t length) const;
 
+    /// \brief Obtain PMA entry that covers the start of a physical memory region
+    /// \param paddr Start of physical memory region.
+    /// \param length Length of physical memory region.
+    /// \param prefix_length Receives the length of the part of the region, starting at \p paddr,
+    /// that lies in the returned entry.
+    /// \returns Corresponding entry if found, or the sentinel entry for an empty range, in which
+    /// case \p prefix_length receives \p length.
+    pma_entry &find_pma_entry_prefix(uint64_t paddr, uint64_t length, uint64_t &prefix_length);
+
+    const pma_entry &find_pma_entry_prefix(uint64_t paddr, uint64_t length, uint64_t &prefix_length) const;
+
+    /// \brief Reads a chunk of data from a PMA.
+    /// \param pma PMA entry that covers the entire chunk.
+    /// \param address Physical address to start reading.
+    /// \param data Receives chunk of memory.
+    /// \param length Size of chunk.
+    void read_pma_memory(const pma_entry &pma, uint64_t address, unsigned char *data, uint64_t length) const;
+
+    /// \brief Returns the first mcycle from a given one on where run() computes a periodic root hash.
+    /// \param mcycle Current value of mcycle.
+    /// \returns The next periodic hash mcycle, or UINT64_MAX if there is none.
+    /// \details This is mcycle itself when it is on a period boundary whose hash has not been taken yet,
+    ///  so runs that resume on a boundary record its hash.
+    uint64_t get_next_periodic_hash_mcycle(uint64_t mcycle) const;
+
+    /// \brief Copies all dirty pages into a snapshot and marks them clean.
+    /// \param s Snapshot that receives the pages.
+    void snapshot_dirty_pages(periodic_root_hasher::snapshot &s) const;
+
+    /// \brief Advances the machine with the microarchitecture until mcycle reaches mcycle_end, or the machine halts
+    ///  or yields.
+    /// \param mcycle_end Target value of mcycle.
+    void run_uarch_until(uint64_t mcycle_end);
+
+    /// \brief Runs the machine until it yields manually, collecting the rollup outputs it produces along the way.
+    /// \param mcycle_end Maximum value of mcycle before function returns.
+    /// \param result Receives the outputs.
+    /// \returns How the machine stopped.
+    rollup_input_status run_rollup_until_manual_yield(uint64_t mcycle_end, rollup_input_result &result);
+
+    /// \brief Copies a request into the rx buffer and resumes the machine from its manual yield.
+    /// \param payload Contents of the rx buffer memory range.
+    /// \param length Length of payload in bytes.
+    /// \param fromhost_data Value written to the HTIF fromhost data field (0 for advance, 1 for inspect).
+    void feed_rollup_request(const unsigned char *payload, uint64_t length, uint64_t fromhost_data);
+
 public:
     /// \brief Type of hash
     using hash_type = machine_merkle_tree::hash_type;
@@ -218,8 +274,51 @@ public:
     /// \returns The reason the machine was interrupted.
     /// \details Several conditions can cause the function to break before mcycle reaches mcycle_end. The most
     ///  frequent scenario is when the program executes a WFI instruction. Another example is when the machine halts.
+    /// When periodic hashes are enabled in the runtime config, the dirty pages are copied at each period boundary
+    /// and hashed in the background while the machine keeps running. The resulting root hashes are available
+    /// from get_periodic_root_hashes().
     interpreter_break_reason run(uint64_t mcycle_end);
 
+    /// \brief Runs the machine like run(), checking it against a reference machine every period cycles.
+    /// \param reference Machine that must start in the same state, advanced with the microarchitecture.
+    /// \param mcycle_end Maximum value of mcycle before function returns.
+    /// \param period Number of cycles between comparisons of root hashes.
+    /// \returns The reason the machine was interrupted.
+    /// \details The microarchitecture is the reference implementation of the interpreter, so this lockstep
+    ///  co-simulation checks the interpreter fast paths. Root hashes are also compared before running and whenever
+    ///  the machine breaks. Throws std::runtime_error at the first comparison where they differ.
+    interpreter_break_reason run_lockstep(machine &reference, uint64_t mcycle_end, uint64_t period);
+
+    /// \brief Returns the root hashes computed by run() at period boundaries since the previous call.
+    /// \returns List of (mcycle, root hash) pairs, in increasing mcycle order.
+    periodic_root_hashes get_periodic_root_hashes(void);
+
+    /// \brief Returns the profile collected by run() so far.
+    /// \returns Instruction counts and guest pc samples, or an empty profile if profiling is disabled.
+    /// \details Profiling is enabled by the profile field of the runtime config.
+    machine_profile get_profile(void) const;
+
+    /// \brief Advances the rollup state through a batch of inputs.
+    /// \param inputs Inputs to feed to the machine, in order.
+    /// \param mcycle_end Maximum value of mcycle before function returns.
+    /// \returns A leading entry for the run up to the first input, followed by the outputs and the status of each
+    ///  input processed.
+    /// \details The machine first runs until it yields manually asking for an input. Whatever it produces on the
+    ///  way, and how that run ended, go into the leading entry, so a machine that fails before accepting input is
+    ///  reported even when there are no inputs. Each input is then copied into the rollup memory ranges, and the
+    ///  machine runs until it yields manually again, while the vouchers, notices and reports it produces are
+    ///  collected. Processing stops at the first input that is not accepted, so the caller can roll the machine
+    ///  back before advancing through the remaining inputs. The machine is left at the manual yield that ended the
+    ///  last input processed.
+    rollup_input_results advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end);
+
+    /// \brief Inspects the rollup state with a query.
+    /// \param query Contents of the rx buffer memory range.
+    /// \param length Length of query in bytes.
+    /// \param mcycle_end Maximum value of mcycle before function returns.
+    /// \returns The reports and the status of the query. The root hash is not computed.
+    rollup_input_result inspect_rollup(const unsigned char *query, uint64_t length, uint64_t mcycle_end);
+
     /// \brief Runs the machine in the microarchitecture until the mcycles advances by one unit or the micro cycle
     /// counter (uarch_cycle) reaches uarch_cycle_end
     /// \param uarch_cycle_end uarch_cycle limit
@@ -273,6 +372,15 @@ public:
     static void verify_uarch_reset_state_transition(const hash_type &root_hash_before, const access_log &log,
         const hash_type &root_hash_after, const machine_runtime_config &runtime = {}, bool one_based = false);
 
+    /// \brief Checks the validity of a sequence of state transitions caused by log_uarch_step and log_uarch_reset
+    /// \param transitions State transitions, in the order they happened.
+    /// \param runtime Machine runtime configuration to use during verification.
+    /// \param one_based Use 1-based indices when reporting errors.
+    /// \details The root hash before each transition must match the root hash after the previous one.
+    /// Transitions are independent of each other, so they are verified in parallel.
+    static void verify_uarch_state_transitions(const uarch_state_transitions &transitions,
+        const machine_runtime_config &runtime = {}, bool one_based = false);
+
     static machine_config get_default_config(void);
 
     /// \brief Returns machine state for direct access.
@@ -285,6 +393,11 @@ public:
         return m_s;
     }
 
+    /// \brief Returns the profiler for direct access, or nullptr if profiling is disabled.
+    machine_profiler *get_profiler(void) const {
+        return m_profiler.get();
+    }
+
     /// \brief Returns a list of descriptions for all PMA entries registered in the machine, sorted by start
     machine_memory_range_descrs get_memory_ranges(void) const {
         return m_mrds;
@@ -350,6 +463,17 @@ public:
     /// This overload is used to optimize proof generation when the caller knows that the tree is already up to date.
     machine_merkle_tree::proof_type get_proof(uint64_t address, int log2_size, skip_merkle_tree_update_t) const;
 
+    /// \brief Obtains a multi-proof for several nodes in the Merkle tree.
+    /// \param targets Target nodes. Each address must be aligned to a 2<sup>log2_size</sup> boundary,
+    /// each log2_size must be between 3 (for a word) and 64 (for the entire address space), inclusive,
+    /// and no two targets may overlap.
+    /// \returns The multi-proof, with targets sorted by address.
+    /// \details Nodes smaller than a page size must lie entirely inside the same PMA range.
+    /// Sibling hashes shared by several targets are only included once, so this is much smaller
+    /// and faster to obtain than one proof per target.
+    machine_merkle_tree::multi_proof_type get_multi_proof(
+        const machine_merkle_tree::multi_proof_type::targets_type &targets) const;
+
     /// \brief Obtains the root hash of the Merkle tree.
     /// \param hash Receives the hash.
     void get_root_hash(hash_type &hash) const;
@@ -408,6 +532,28 @@ public:
     /// \param length Size of chunk.
     void write_virtual_memory(uint64_t vaddr_start, const unsigned char *data, size_t length);
 
+    /// \brief Reads a list of chunks of data from the machine memory.
+    /// \param ranges Physical address, length and destination buffer of each chunk.
+    /// \details Unlike read_memory(), chunks may span several adjacent PMA regions.
+    void read_memory_ranges(const memory_range_reads &ranges) const;
+
+    /// \brief Writes a list of chunks of data to the machine memory.
+    /// \param ranges Physical address, length and source buffer of each chunk.
+    /// \details Unlike write_memory(), chunks may span several adjacent PMA regions, as long as every
+    /// byte lies in a memory PMA. Chunks are written in order, so when one of them fails, those
+    /// before it have already been written.
+    void write_memory_ranges(const memory_range_writes &ranges);
+
+    /// \brief Reads a list of chunks of data from the machine virtual memory.
+    /// \param ranges Virtual address, length and destination buffer of each chunk.
+    void read_virtual_memory_ranges(const memory_range_reads &ranges);
+
+    /// \brief Writes a list of chunks of data to the machine virtual memory.
+    /// \param ranges Virtual address, length and source buffer of each chunk.
+    /// \details Chunks are written in order, so when one of them fails, those before it have
+    /// already been written.
+    void write_virtual_memory_ranges(const memory_range_writes &ranges);
+
     /// \brief Reads the value of a general-purpose register.
     /// \param index Register index. Between 0 and X_REG_COUNT-1, inclusive.
     /// \returns The value of the register.
@@ -859,6 +1005,14 @@ public:
     /// matching the start and length specified in range.
     void replace_memory_range(const memory_range_config &range);
 
+    /// \brief Fills a memory range with zeros.
+    /// \param start Start of memory range.
+    /// \param length Length of memory range.
+    /// \details The machine must contain an existing memory range matching start and length.
+    /// Only pages that are not already pristine are zeroed, and their nodes in the Merkle tree
+    /// are set straight to pristine, so the cost is proportional to the pages in use, not to the range length.
+    void clear_memory_range(uint64_t start, uint64_t length);
+
     /// \brief Reads the value of a microarchitecture register.
     /// \param index Register index. Between 0 and UARCH_X_REG_COUNT-1, inclusive.
     /// \returns The value of the register.
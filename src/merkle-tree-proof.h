@@ -18,9 +18,14 @@
 #define MERKLE_TREE_PROOF_H
 
 /// \file
-/// \brief Merkle tree proof structure
+/// \brief Merkle tree proof structures
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace cartesi {
@@ -272,6 +277,278 @@ private:
     sibling_hashes_type m_sibling_hashes; ///< Hashes of siblings in path from target to root
 };
 
+/// \brief Merkle tree multi-proof structure
+/// \details \{
+/// This structure holds a proof that several disjoint nodes in the tree,
+/// the targets, have certain hashes.
+/// Instead of one list of siblings per target, it holds the minimal set
+/// of sibling hashes needed to compute the root hash from all target hashes:
+/// siblings shared by different targets appear only once, and nodes whose
+/// hashes follow from the targets themselves are omitted.
+/// Targets are kept sorted by address, and sibling hashes are listed in
+/// increasing order of address.
+/// \}
+/// \tparam HASH_TYPE the type that holds a hash
+/// \tparam ADDRESS_TYPE the type that holds an address
+template <typename HASH_TYPE, typename ADDRESS_TYPE = uint64_t>
+class merkle_tree_multi_proof final {
+public:
+    using hash_type = HASH_TYPE;
+
+    using address_type = ADDRESS_TYPE;
+
+    /// \brief Target node
+    struct target_type {
+        address_type address; ///< Address of target node
+        int log2_size;        ///< log<sub>2</sub> of size subintended by target node
+    };
+
+    /// \brief Storage for the target nodes
+    using targets_type = std::vector<target_type>;
+
+    /// \brief Storage for the hashes of the target nodes, in the same order as the targets
+    using target_hashes_type = std::vector<hash_type>;
+
+    /// \brief Storage for the sibling hashes shared by all targets
+    using sibling_hashes_type = std::vector<hash_type>;
+
+    /// \brief Constructs a merkle_tree_multi_proof object for a set of targets
+    /// \param log2_root_size log<sub>2</sub> of size subintended by entire tree.
+    /// \param targets Target nodes. Each must be aligned to its size, and no two may overlap.
+    /// \details Targets are sorted by address. Their hashes, the root hash and the sibling hashes
+    /// must be filled in afterwards.
+    merkle_tree_multi_proof(int log2_root_size, targets_type targets) :
+        m_log2_root_size{log2_root_size},
+        m_root_hash{},
+        m_targets{std::move(targets)},
+        m_target_hashes(m_targets.size()),
+        m_sibling_hashes{} {
+        if (log2_root_size <= 0) {
+            throw std::out_of_range{"log2_root_size is not positive"};
+        }
+        if (m_targets.empty()) {
+            throw std::invalid_argument{"no targets"};
+        }
+        std::sort(m_targets.begin(), m_targets.end(),
+            [](const target_type &a, const target_type &b) { return a.address < b.address; });
+        for (size_t i = 0; i < m_targets.size(); ++i) {
+            const auto &target = m_targets[i];
+            const int log2_target_size = target.log2_size;
+            if (log2_target_size < 0) {
+                throw std::out_of_range{"log2_target_size is negative"};
+            }
+            if (log2_target_size > log2_root_size) {
+                throw std::out_of_range{"log2_target_size is greater than log2_root_size"};
+            }
+            if ((target.address & get_offset_mask(log2_target_size)) != 0) {
+                throw std::invalid_argument{"target address not aligned to log2_target_size"};
+            }
+            if ((target.address & ~get_offset_mask(log2_root_size)) != 0) {
+                throw std::out_of_range{"target address is out of range"};
+            }
+            if (i > 0) {
+                const auto &previous = m_targets[i - 1];
+                if ((previous.address | get_offset_mask(previous.log2_size)) >= target.address) {
+                    throw std::invalid_argument{"targets overlap"};
+                }
+            }
+        }
+    }
+
+    merkle_tree_multi_proof(const merkle_tree_multi_proof &other) = default;
+    merkle_tree_multi_proof(merkle_tree_multi_proof &&other) noexcept = default;
+    merkle_tree_multi_proof &operator=(const merkle_tree_multi_proof &other) = default;
+    merkle_tree_multi_proof &operator=(merkle_tree_multi_proof &&other) noexcept = default;
+    ~merkle_tree_multi_proof() = default;
+
+    /// \brief Gets log<sub>2</sub> of size subintended by entire tree.
+    /// \returns log<sub>2</sub> of size subintended by entire tree.
+    int get_log2_root_size(void) const {
+        return m_log2_root_size;
+    }
+
+    /// \brief Gets the target nodes, sorted by address
+    /// \return Reference to targets.
+    const targets_type &get_targets(void) const {
+        return m_targets;
+    }
+
+    /// \brief Set hash of a target node
+    /// \param index Index of target node.
+    /// \param hash New hash.
+    void set_target_hash(size_t index, const hash_type &hash) {
+        m_target_hashes.at(index) = hash;
+    }
+
+    /// \brief Gets the hashes of the target nodes
+    /// \return Reference to target hashes.
+    const target_hashes_type &get_target_hashes(void) const {
+        return m_target_hashes;
+    }
+
+    /// \brief Set hash of root node
+    /// \param hash New hash.
+    void set_root_hash(const hash_type &hash) {
+        m_root_hash = hash;
+    }
+
+    /// \brief Gets hash of root node
+    /// \return Reference to hash.
+    const hash_type &get_root_hash(void) const {
+        return m_root_hash;
+    }
+
+    /// \brief Appends a hash to the list of siblings
+    /// \param hash Sibling hash, which must come after all siblings already in the list.
+    void push_back_sibling_hash(const hash_type &hash) {
+        m_sibling_hashes.push_back(hash);
+    }
+
+    /// \brief Gets the sibling hashes, in increasing order of address
+    /// \return Reference to sibling hashes.
+    const sibling_hashes_type &get_sibling_hashes(void) const {
+        return m_sibling_hashes;
+    }
+
+    /// \brief Checks if two Merkle multi-proofs are equal
+    bool operator==(const merkle_tree_multi_proof &other) const {
+        if (get_log2_root_size() != other.get_log2_root_size()) {
+            return false;
+        }
+        if (get_root_hash() != other.get_root_hash()) {
+            return false;
+        }
+        if (m_targets.size() != other.m_targets.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < m_targets.size(); ++i) {
+            if (m_targets[i].address != other.m_targets[i].address ||
+                m_targets[i].log2_size != other.m_targets[i].log2_size) {
+                return false;
+            }
+        }
+        if (m_target_hashes != other.m_target_hashes) {
+            return false;
+        }
+        if (m_sibling_hashes != other.m_sibling_hashes) {
+            return false;
+        }
+        return true;
+    }
+
+    /// \brief Checks if two Merkle multi-proofs are different
+    bool operator!=(const merkle_tree_multi_proof<hash_type, address_type> &other) const {
+        return !(operator==(other));
+    }
+
+    ///< \brief Verify if multi-proof is valid
+    ///< \tparam HASHER_TYPE Hasher class to use
+    ///< \param h Hasher object to use
+    ///< \return True if multi-proof is valid, false otherwise
+    template <typename HASHER_TYPE>
+    bool verify(HASHER_TYPE &&h) const {
+        hash_type root_hash{};
+        return compute_root_hash(std::forward<HASHER_TYPE>(h), m_target_hashes, root_hash) &&
+            root_hash == get_root_hash();
+    }
+
+    ///< \brief Computes the root hash that results from replacing all target hashes
+    ///< \tparam HASHER_TYPE Hasher class to use
+    ///< \param h Hasher object to use
+    ///< \param new_target_hashes New target hashes, in the same order as the targets
+    ///< \return New root hash
+    template <typename HASHER_TYPE>
+    hash_type bubble_up(HASHER_TYPE &&h, const target_hashes_type &new_target_hashes) const {
+        if (new_target_hashes.size() != m_targets.size()) {
+            throw std::invalid_argument{"number of target hashes does not match number of targets"};
+        }
+        hash_type root_hash{};
+        if (!compute_root_hash(std::forward<HASHER_TYPE>(h), new_target_hashes, root_hash)) {
+            throw std::invalid_argument{"number of sibling hashes does not match targets"};
+        }
+        return root_hash;
+    }
+
+private:
+    /// \brief Returns mask for offsets inside a node
+    /// \param log2_size log<sub>2</sub> of size subintended by node.
+    /// \return Mask with the log2_size least significant bits set.
+    static address_type get_offset_mask(int log2_size) {
+        if (log2_size >= std::numeric_limits<address_type>::digits) {
+            return ~static_cast<address_type>(0);
+        }
+        return (static_cast<address_type>(1) << log2_size) - 1;
+    }
+
+    /// \brief Computes the root hash from the target hashes and the sibling hashes
+    /// \return True if the sibling hashes were used up exactly, false otherwise
+    template <typename HASHER_TYPE>
+    bool compute_root_hash(HASHER_TYPE &&h, const target_hashes_type &target_hashes, hash_type &root_hash) const {
+        static_assert(is_an_i_hasher<HASHER_TYPE>::value, "not an i_hasher");
+        static_assert(std::is_same<typename remove_cvref<HASHER_TYPE>::type::hash_type, hash_type>::value,
+            "incompatible hash types");
+        if (target_hashes.size() != m_targets.size()) {
+            return false;
+        }
+        size_t next_sibling = 0;
+        if (!compute_node_hash(h, target_hashes, 0, get_log2_root_size(), 0, m_targets.size(), next_sibling,
+                root_hash)) {
+            return false;
+        }
+        return next_sibling == m_sibling_hashes.size();
+    }
+
+    /// \brief Computes the hash of a node that contains some of the targets
+    /// \param h Hasher object to use
+    /// \param target_hashes Hashes of all targets
+    /// \param address Address of node
+    /// \param log2_size log<sub>2</sub> of size subintended by node
+    /// \param first Index of first target inside node
+    /// \param last Index one past the last target inside node
+    /// \param next_sibling Index of next sibling hash to consume
+    /// \param hash Receives the node hash
+    /// \return True if there were enough sibling hashes, false otherwise
+    template <typename HASHER_TYPE>
+    bool compute_node_hash(HASHER_TYPE &h, const target_hashes_type &target_hashes, address_type address,
+        int log2_size, size_t first, size_t last, size_t &next_sibling, hash_type &hash) const {
+        // Targets are disjoint, so a target as large as the node is the node itself
+        if (last - first == 1 && m_targets[first].log2_size == log2_size) {
+            hash = target_hashes[first];
+            return true;
+        }
+        const int log2_child_size = log2_size - 1;
+        const address_type middle = address + (static_cast<address_type>(1) << log2_child_size);
+        const auto begin = m_targets.begin();
+        const auto split = static_cast<size_t>(std::lower_bound(begin + first, begin + last, middle,
+            [](const target_type &t, address_type a) { return t.address < a; }) - begin);
+        // Children without targets are siblings, and come in address order
+        std::array<hash_type, 2> child_hash{};
+        const std::array<std::pair<size_t, size_t>, 2> child_targets{{{first, split}, {split, last}}};
+        for (int bit = 0; bit < 2; ++bit) {
+            const auto [child_first, child_last] = child_targets[bit];
+            if (child_first < child_last) {
+                if (!compute_node_hash(h, target_hashes, bit ? middle : address, log2_child_size, child_first,
+                        child_last, next_sibling, child_hash[bit])) {
+                    return false;
+                }
+            } else {
+                if (next_sibling >= m_sibling_hashes.size()) {
+                    return false;
+                }
+                child_hash[bit] = m_sibling_hashes[next_sibling++];
+            }
+        }
+        get_concat_hash(h, child_hash[0], child_hash[1], hash);
+        return true;
+    }
+
+    int m_log2_root_size;                 ///< log<sub>2</sub> of size subintended by tree
+    hash_type m_root_hash;                ///< Hash of root node
+    targets_type m_targets;               ///< Target nodes, sorted by address
+    target_hashes_type m_target_hashes;   ///< Hashes of target nodes
+    sibling_hashes_type m_sibling_hashes; ///< Hashes of siblings needed to reach the root, sorted by address
+};
+
 } // namespace cartesi
 
 #endif
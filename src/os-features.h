@@ -41,6 +41,10 @@
 #define HAVE_MKDIR
 #endif
 
+#if !defined(NO_RMDIR)
+#define HAVE_RMDIR
+#endif
+
 #if !defined(NO_TUNTAP) && defined(__linux__)
 #define HAVE_TUNTAP
 #endif
@@ -65,4 +69,12 @@
 #define HAVE_USLEEP
 #endif
 
+#if !defined(NO_THREAD_AFFINITY) && !defined(NO_THREADS) && defined(__linux__)
+#define HAVE_THREAD_AFFINITY
+#endif
+
+#if !defined(NO_PTHREAD_ATFORK) && !defined(NO_THREADS) && !defined(_WIN32) && !defined(__wasi__)
+#define HAVE_PTHREAD_ATFORK
+#endif
+
 #endif
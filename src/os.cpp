@@ -14,6 +14,7 @@
 // with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdint>
@@ -32,11 +33,23 @@
 #endif
 
 #ifdef HAVE_THREADS
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
 #include <mutex>
 #include <thread>
 #endif
 
+#if defined(HAVE_THREAD_AFFINITY) || defined(HAVE_PTHREAD_ATFORK)
+#include <pthread.h> // pthread_setaffinity_np/pthread_atfork
+#endif
+
+#ifdef HAVE_THREAD_AFFINITY
+#include <sched.h> // sched_getaffinity
+#endif
+
 #if defined(HAVE_TTY) || defined(HAVE_MMAP) || defined(HAVE_TERMIOS) || defined(_WIN32)
 #include <fcntl.h> // open
 #endif
@@ -76,6 +89,7 @@
 
 #define plat_write _write
 #define plat_mkdir(a, mode) _mkdir(a)
+#define plat_rmdir _rmdir
 
 #if defined(HAVE_SELECT)
 #include <winsock2.h> // select
@@ -83,8 +97,8 @@
 
 #else // not _WIN32
 
-#if defined(HAVE_TTY) || defined(HAVE_MMAP) || defined(HAVE_TERMIOS) || defined(HAVE_USLEEP)
-#include <unistd.h> // write/read/close
+#if defined(HAVE_TTY) || defined(HAVE_MMAP) || defined(HAVE_TERMIOS) || defined(HAVE_USLEEP) || defined(HAVE_RMDIR)
+#include <unistd.h> // write/read/close/rmdir
 #endif
 
 #if defined(HAVE_SELECT)
@@ -93,6 +107,7 @@
 
 #define plat_write write
 #define plat_mkdir mkdir
+#define plat_rmdir rmdir
 
 #endif // _WIN32
 
@@ -523,6 +538,14 @@ int os_mkdir(const char *path, int mode) {
 #endif // HAVE_MKDIR
 }
 
+int os_rmdir(const char *path) {
+#ifdef HAVE_RMDIR
+    return plat_rmdir(path);
+#else
+    return -1;
+#endif // HAVE_RMDIR
+}
+
 unsigned char *os_map_file(const char *path, uint64_t length, bool shared) {
     if (!path || *path == '\0') {
         throw std::runtime_error{"image file path must be specified"s};
@@ -688,34 +711,339 @@ uint64_t os_get_concurrency() {
 #endif
 }
 
-bool os_parallel_for(uint64_t n, const std::function<bool(uint64_t j, const parallel_for_mutex &mutex)> &task) {
+using parallel_for_range_task =
+    std::function<bool(uint64_t first, uint64_t last, const parallel_for_mutex &mutex)>;
+
 #ifdef HAVE_THREADS
-    if (n > 1) {
+/// \brief Parallel region being executed by os_parallel_for_range()
+/// \details The range is split into chunks that are distributed among one queue per participating
+/// thread. Each thread consumes chunks from the front of its own queue and, once it runs out,
+/// steals chunks from the back of the other queues.
+class parallel_for_region {
+    /// \brief Chunk of consecutive indices [first, last)
+    struct chunk {
+        uint64_t first;
+        uint64_t last;
+    };
+
+    /// \brief Queue of chunks owned by one participating thread
+    struct chunk_queue {
         std::mutex mutex;
-        const parallel_for_mutex for_mutex = {[&] { mutex.lock(); }, [&] { mutex.unlock(); }};
-        std::vector<std::future<bool>> futures;
-        futures.reserve(n);
+        std::deque<chunk> chunks;
+    };
+
+    const parallel_for_range_task &m_task;
+    std::vector<chunk_queue> m_queues;
+    std::atomic<uint64_t> m_next_queue{1}; // Queue 0 belongs to the calling thread
+    std::atomic<uint64_t> m_pending;
+    std::atomic<bool> m_succeeded{true};
+    std::mutex m_task_mutex;
+    const parallel_for_mutex m_for_mutex;
+    std::mutex m_done_mutex;
+    std::condition_variable m_done_cv;
+    std::exception_ptr m_exception;
+
+    bool pop_own(chunk_queue &q, chunk &c) {
+        const std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.chunks.empty()) {
+            return false;
+        }
+        c = q.chunks.front();
+        q.chunks.pop_front();
+        return true;
+    }
+
+    bool steal(uint64_t thief, chunk &c) {
+        const uint64_t n = m_queues.size();
+        for (uint64_t k = 1; k < n; ++k) {
+            auto &q = m_queues[(thief + k) % n];
+            const std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.chunks.empty()) {
+                c = q.chunks.back();
+                q.chunks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void execute(const chunk &c) {
+        // Once some task has failed, the remaining chunks are drained without running
+        if (m_succeeded.load(std::memory_order_relaxed)) {
+            try {
+                if (!m_task(c.first, c.last, m_for_mutex)) {
+                    m_succeeded = false;
+                }
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(m_done_mutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+                m_succeeded = false;
+            }
+        }
+        if (m_pending.fetch_sub(1) == 1) {
+            const std::lock_guard<std::mutex> lock(m_done_mutex);
+            m_done_cv.notify_all();
+        }
+    }
+
+public:
+    parallel_for_region(uint64_t n, uint64_t begin, uint64_t end, uint64_t chunk_size,
+        const parallel_for_range_task &task) :
+        m_task(task),
+        m_queues(n),
+        m_pending((end - begin + chunk_size - 1) / chunk_size),
+        m_for_mutex{[this] { m_task_mutex.lock(); }, [this] { m_task_mutex.unlock(); }} {
+        // Give each queue a contiguous run of chunks, so threads touch neighboring indices
+        const uint64_t chunks = m_pending;
+        uint64_t first = begin;
         for (uint64_t j = 0; j < n; ++j) {
-            futures.emplace_back(std::async(std::launch::async, task, j, for_mutex));
+            const uint64_t count = chunks / n + (j < chunks % n ? 1 : 0);
+            for (uint64_t k = 0; k < count; ++k) {
+                const uint64_t last = std::min(first + chunk_size, end);
+                m_queues[j].chunks.push_back(chunk{first, last});
+                first = last;
+            }
+        }
+    }
+
+    /// \brief Takes part in the region until there are no chunks left to be claimed
+    void participate(uint64_t j) {
+        chunk c{};
+        while (pop_own(m_queues[j], c) || steal(j, c)) {
+            execute(c);
+        }
+    }
+
+    /// \brief Claims the queue for a newly joined thread
+    uint64_t join() {
+        return std::min(m_next_queue.fetch_add(1), static_cast<uint64_t>(m_queues.size() - 1));
+    }
+
+    /// \brief Waits until all chunks have been executed and reports the outcome
+    bool wait() {
+        std::unique_lock<std::mutex> lock(m_done_mutex);
+        m_done_cv.wait(lock, [this] { return m_pending.load() == 0; });
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+        return m_succeeded;
+    }
+};
+
+/// \brief Persistent process-wide pool of threads used by os_parallel_for_range()
+class parallel_for_pool {
+    /// \brief Request for threads to join a region
+    struct ticket {
+        std::shared_ptr<parallel_for_region> region;
+        uint64_t count;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<ticket> m_tickets;
+    std::vector<std::thread> m_workers;
+    std::vector<uint64_t> m_affinity;
+#ifdef HAVE_THREAD_AFFINITY
+    cpu_set_t m_inherited_affinity{}; ///< Mask the process had when the pool started
+    bool m_inherited_affinity_valid{false};
+#endif
+    bool m_pinned{false}; ///< Whether workers have been pinned to the CPUs in m_affinity
+    bool m_stop{false};
+
+    void work() {
+        for (;;) {
+            std::shared_ptr<parallel_for_region> region;
+            uint64_t j = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || !m_tickets.empty(); });
+                if (m_stop) {
+                    return;
+                }
+                auto &t = m_tickets.front();
+                region = t.region;
+                if (--t.count == 0) {
+                    m_tickets.pop_front();
+                }
+                j = region->join();
+            }
+            region->participate(j);
+        }
+    }
+
+    bool apply_affinity(uint64_t i) {
+#ifdef HAVE_THREAD_AFFINITY
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (m_affinity.empty()) {
+            // Undo a previous pinning by going back to whatever the operator gave the process
+            if (!m_inherited_affinity_valid) {
+                return false;
+            }
+            set = m_inherited_affinity;
+        } else {
+            const uint64_t cpu = m_affinity[i % m_affinity.size()];
+            if (cpu >= CPU_SETSIZE) {
+                return false;
+            }
+            CPU_SET(cpu, &set);
+        }
+        return pthread_setaffinity_np(m_workers[i].native_handle(), sizeof(set), &set) == 0;
+#else
+        (void) i;
+        return m_affinity.empty();
+#endif
+    }
+
+#ifdef HAVE_PTHREAD_ATFORK
+    // Forked children only inherit the forking thread, so the pool must not be in use across a fork,
+    // and in the child it must forget about the workers that live only in the parent.
+    static void before_fork() {
+        get().m_mutex.lock();
+    }
+
+    static void after_fork_in_parent() {
+        get().m_mutex.unlock();
+    }
+
+    static void after_fork_in_child() {
+        auto &pool = get();
+        // The std::thread objects refer to threads that do not exist in the child, so they must never
+        // be joined or destroyed
+        new std::vector<std::thread>(std::move(pool.m_workers)); // NOLINT(cppcoreguidelines-owning-memory)
+        pool.m_workers.clear();
+        pool.m_tickets.clear();
+        pool.m_mutex.unlock();
+    }
+#endif
+
+    parallel_for_pool() {
+#ifdef HAVE_THREAD_AFFINITY
+        CPU_ZERO(&m_inherited_affinity);
+        m_inherited_affinity_valid = sched_getaffinity(0, sizeof(m_inherited_affinity), &m_inherited_affinity) == 0;
+#endif
+#ifdef HAVE_PTHREAD_ATFORK
+        pthread_atfork(before_fork, after_fork_in_parent, after_fork_in_child);
+#endif
+    }
+
+public:
+    parallel_for_pool(const parallel_for_pool &other) = delete;
+    parallel_for_pool(parallel_for_pool &&other) = delete;
+    parallel_for_pool &operator=(const parallel_for_pool &other) = delete;
+    parallel_for_pool &operator=(parallel_for_pool &&other) = delete;
+
+    ~parallel_for_pool() {
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto &t : m_workers) {
+            t.join();
+        }
+    }
+
+    /// \brief Returns the process-wide pool
+    static parallel_for_pool &get() {
+        static parallel_for_pool pool;
+        return pool;
+    }
+
+    /// \brief Runs region with help from up to n_helpers pool threads
+    bool run(const std::shared_ptr<parallel_for_region> &region, uint64_t n_helpers) {
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            while (m_workers.size() < n_helpers) {
+                m_workers.emplace_back([this] { work(); });
+                // New threads inherit the mask of the process unless the caller asked for a CPU list
+                if (m_pinned) {
+                    apply_affinity(m_workers.size() - 1);
+                }
+            }
+            m_tickets.push_back(ticket{region, n_helpers});
+        }
+        if (n_helpers > 1) {
+            m_cv.notify_all();
+        } else {
+            m_cv.notify_one();
+        }
+        region->participate(0);
+        // Threads that did not get to join are no longer needed
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto it = m_tickets.begin(); it != m_tickets.end(); ++it) {
+                if (it->region == region) {
+                    m_tickets.erase(it);
+                    break;
+                }
+            }
+        }
+        return region->wait();
+    }
+
+    bool set_affinity(const std::vector<uint64_t> &cpus) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_affinity = cpus;
+        // Without a CPU list, leave alone workers that were never pinned
+        if (m_affinity.empty() && !m_pinned) {
+            return true;
         }
-        // Check if any thread failed
         bool succeeded = true;
-        for (auto &f : futures) {
-            succeeded = succeeded && f.get();
+        for (uint64_t i = 0; i < m_workers.size(); ++i) {
+            succeeded = apply_affinity(i) && succeeded;
         }
-        // Return overall status
+        m_pinned = !m_affinity.empty();
         return succeeded;
     }
+};
+#endif
+
+bool os_parallel_for_range(uint64_t n, uint64_t begin, uint64_t end, uint64_t chunk_size,
+    const parallel_for_range_task &task) {
+    if (begin >= end) {
+        return true;
+    }
+    chunk_size = std::max(chunk_size, UINT64_C(1));
+#ifdef HAVE_THREADS
+    const uint64_t chunks = (end - begin + chunk_size - 1) / chunk_size;
+    n = std::min(n, chunks);
+    if (n > 1) {
+        auto region = std::make_shared<parallel_for_region>(n, begin, end, chunk_size, task);
+        return parallel_for_pool::get().run(region, n - 1);
+    }
+#else
+    (void) n;
 #endif
     // Run without extra threads when concurrency is 1 or as fallback
     const parallel_for_mutex for_mutex{[] {}, [] {}};
     bool succeeded = true;
-    for (uint64_t j = 0; j < n; ++j) {
-        succeeded = succeeded && task(j, for_mutex);
+    for (uint64_t first = begin; first < end && succeeded; first += std::min(chunk_size, end - first)) {
+        succeeded = task(first, first + std::min(chunk_size, end - first), for_mutex);
     }
     return succeeded;
 }
 
+bool os_parallel_for(uint64_t n, const std::function<bool(uint64_t j, const parallel_for_mutex &mutex)> &task) {
+    return os_parallel_for_range(n, 0, n, 1, [&task](uint64_t first, uint64_t last, const parallel_for_mutex &mutex) {
+        bool succeeded = true;
+        for (uint64_t j = first; j < last; ++j) {
+            succeeded = succeeded && task(j, mutex);
+        }
+        return succeeded;
+    });
+}
+
+bool os_set_parallel_for_affinity(const std::vector<uint64_t> &cpus) {
+#ifdef HAVE_THREADS
+    return parallel_for_pool::get().set_affinity(cpus);
+#else
+    return cpus.empty();
+#endif
+}
+
 bool os_select_fds(const os_select_before_callback &before_cb, const os_select_after_callback &after_cb,
     uint64_t *timeout_us) {
     // Create empty fd sets
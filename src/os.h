@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 /// \file
 /// \brief System-specific OS handling operations
@@ -88,6 +89,9 @@ void os_putchars(const uint8_t *data, size_t len);
 /// \brief Creates a new directory
 int os_mkdir(const char *path, int mode);
 
+/// \brief Removes an empty directory
+int os_rmdir(const char *path);
+
 /// \brief Maps a file to memory
 unsigned char *os_map_file(const char *path, uint64_t length, bool shared);
 
@@ -129,6 +133,24 @@ private:
 /// \return True if all thread tasks succeeded
 bool os_parallel_for(uint64_t n, const std::function<bool(uint64_t j, const parallel_for_mutex &mutex)> &task);
 
+/// \brief Runs a for loop over a range of indices in parallel using up to n threads
+/// \param n Maximum number of threads, including the calling thread.
+/// \param begin First index in range.
+/// \param end One past the last index in range.
+/// \param chunk_size Number of consecutive indices handed to each task invocation.
+/// \param task Task called once for each chunk [first, last) of the range.
+/// \return True if all thread tasks succeeded
+/// \details The calling thread always takes part in the loop. Additional threads come from a persistent
+/// process-wide pool, and chunks are spread over per-thread queues from which idle threads steal.
+bool os_parallel_for_range(uint64_t n, uint64_t begin, uint64_t end, uint64_t chunk_size,
+    const std::function<bool(uint64_t first, uint64_t last, const parallel_for_mutex &mutex)> &task);
+
+/// \brief Sets the CPU affinity of the threads used by os_parallel_for() and os_parallel_for_range()
+/// \param cpus List of CPU indices, assigned to threads in round-robin order.
+/// If empty, threads run on the CPUs the process had when the pool started.
+/// \return True if the affinity was applied, false if it is not supported or failed.
+bool os_set_parallel_for_affinity(const std::vector<uint64_t> &cpus);
+
 // Callbacks used by os_select_fds().
 using os_select_before_callback = std::function<void(select_fd_sets *fds, uint64_t *timeout_us)>;
 using os_select_after_callback = std::function<bool(int select_ret, select_fd_sets *fds)>;
@@ -0,0 +1,147 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <stdexcept>
+#include <utility>
+
+#include "periodic-root-hasher.h"
+
+namespace cartesi {
+
+/// \brief Maximum number of snapshots waiting to be hashed before push() blocks the interpreter
+constexpr size_t PERIODIC_ROOT_HASHER_MAX_PENDING = 2;
+
+void periodic_root_hasher::snapshot::add_page(uint64_t address, const unsigned char *data) {
+    page_addresses.push_back(address);
+    page_data.insert(page_data.end(), data, data + machine_merkle_tree::get_page_size());
+}
+
+periodic_root_hasher::periodic_root_hasher(machine_merkle_tree &t, periodic_root_hashes &hashes) :
+    m_t(t),
+    m_hashes(hashes) {
+#ifdef HAVE_THREADS
+    m_worker = std::thread(&periodic_root_hasher::work, this);
+#endif
+}
+
+periodic_root_hasher::~periodic_root_hasher() {
+    try {
+        finish();
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+    }
+}
+
+void periodic_root_hasher::hash(const snapshot &s) {
+    const auto pristine_page_hash = machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size());
+    m_t.begin_update();
+    for (size_t i = 0; i < s.page_addresses.size(); ++i) {
+        const unsigned char *page_data = s.page_data.data() + i * machine_merkle_tree::get_page_size();
+        bool updated = false;
+        if (machine_merkle_tree::is_pristine(page_data, machine_merkle_tree::get_page_size())) {
+            updated = m_t.update_page_node_hash(s.page_addresses[i], pristine_page_hash);
+        } else {
+            // Pages that are always dirty, such as the shadows, only change a few words between snapshots,
+            // so going through the cache avoids rehashing the whole page
+            machine_merkle_tree::hash_type page_hash;
+            m_t.get_cached_page_node_hash(m_h, s.page_addresses[i], page_data, page_hash);
+            updated = m_t.update_page_node_hash(s.page_addresses[i], page_hash);
+        }
+        if (!updated) {
+            m_t.end_update(m_h);
+            throw std::runtime_error{"error updating Merkle tree"};
+        }
+    }
+    if (!m_t.end_update(m_h)) {
+        throw std::runtime_error{"error updating Merkle tree"};
+    }
+    periodic_root_hash entry{};
+    entry.mcycle = s.mcycle;
+    m_t.get_root_hash(entry.hash);
+    m_hashes.push_back(entry);
+}
+
+#ifdef HAVE_THREADS
+
+void periodic_root_hasher::work(void) {
+    for (;;) {
+        snapshot s;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return !m_pending.empty() || m_finishing; });
+            if (m_pending.empty()) {
+                return;
+            }
+            s = std::move(m_pending.front());
+            m_pending.pop_front();
+            // Wake up the interpreter if it is waiting for room in the queue
+            m_cv.notify_all();
+            // After an error, remaining snapshots are dropped
+            if (m_error) {
+                continue;
+            }
+        }
+        try {
+            hash(s);
+        } catch (...) {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = std::current_exception();
+        }
+    }
+}
+
+void periodic_root_hasher::push(snapshot &&s) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_pending.size() < PERIODIC_ROOT_HASHER_MAX_PENDING; });
+    m_pending.push_back(std::move(s));
+    m_cv.notify_all();
+}
+
+void periodic_root_hasher::finish(void) {
+    if (m_worker.joinable()) {
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_finishing = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+#else
+
+void periodic_root_hasher::push(snapshot &&s) {
+    // Without threads, snapshots are hashed as soon as they are taken
+    if (!m_error) {
+        try {
+            hash(s);
+        } catch (...) {
+            m_error = std::current_exception();
+        }
+    }
+}
+
+void periodic_root_hasher::finish(void) {
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+#endif
+
+} // namespace cartesi
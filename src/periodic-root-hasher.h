@@ -0,0 +1,112 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef PERIODIC_ROOT_HASHER_H
+#define PERIODIC_ROOT_HASHER_H
+
+/// \file
+/// \brief Background computation of periodic root hashes.
+
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include "machine-merkle-tree.h"
+#include "os-features.h"
+
+#ifdef HAVE_THREADS
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace cartesi {
+
+/// \brief Root hash of the machine state at a given mcycle
+struct periodic_root_hash {
+    uint64_t mcycle{};                     ///< Value of mcycle when the state was hashed
+    machine_merkle_tree::hash_type hash{}; ///< Root hash of the state
+};
+
+/// \brief List of periodic root hashes, in increasing mcycle order
+using periodic_root_hashes = std::vector<periodic_root_hash>;
+
+/// \class periodic_root_hasher
+/// \brief Brings the Merkle tree up to date with snapshots of the machine state in a background thread.
+/// \details While the hasher is alive, it owns the Merkle tree: nobody else may touch the tree
+/// until finish() returns. The interpreter keeps running while snapshots are hashed, since
+/// a snapshot holds its own copy of every page that changed since the previous one.
+class periodic_root_hasher final {
+public:
+    /// \brief Copy of the pages of the machine state modified since the previous snapshot
+    struct snapshot {
+        uint64_t mcycle{};                    ///< Value of mcycle when the snapshot was taken
+        std::vector<uint64_t> page_addresses; ///< Address of each page in the snapshot
+        std::vector<unsigned char> page_data; ///< Contents of each page, back to back
+
+        /// \brief Appends a copy of a page to the snapshot.
+        /// \param address Address of the page.
+        /// \param data Pointer to contents of the page.
+        void add_page(uint64_t address, const unsigned char *data);
+    };
+
+    /// \brief Constructor
+    /// \param t Merkle tree to update.
+    /// \param hashes Receives the root hash computed for each snapshot.
+    periodic_root_hasher(machine_merkle_tree &t, periodic_root_hashes &hashes);
+
+    /// \brief Destructor
+    /// \details Waits for all pending snapshots, ignoring errors.
+    ~periodic_root_hasher();
+
+    periodic_root_hasher(const periodic_root_hasher &other) = delete;
+    periodic_root_hasher(periodic_root_hasher &&other) = delete;
+    periodic_root_hasher &operator=(const periodic_root_hasher &other) = delete;
+    periodic_root_hasher &operator=(periodic_root_hasher &&other) = delete;
+
+    /// \brief Hands a snapshot over to be hashed.
+    /// \param s Snapshot with all pages modified since the previous snapshot.
+    /// \details Blocks while too many snapshots are waiting to be hashed, bounding the memory they hold.
+    void push(snapshot &&s);
+
+    /// \brief Waits until all snapshots have been hashed.
+    /// \details Rethrows the first error that happened while hashing, if any.
+    void finish(void);
+
+private:
+    /// \brief Updates the Merkle tree with a snapshot and appends the resulting root hash.
+    void hash(const snapshot &s);
+
+    machine_merkle_tree &m_t;             ///< Merkle tree being updated
+    periodic_root_hashes &m_hashes;       ///< Root hashes computed so far
+    machine_merkle_tree::hasher_type m_h; ///< Hasher used by the Merkle tree updates
+    std::exception_ptr m_error;           ///< First error that happened while hashing
+#ifdef HAVE_THREADS
+    /// \brief Loop run by the background thread.
+    void work(void);
+
+    std::mutex m_mutex;             ///< Protects the members below
+    std::condition_variable m_cv;   ///< Signals changes to the members below
+    std::deque<snapshot> m_pending; ///< Snapshots waiting to be hashed
+    bool m_finishing{false};        ///< No more snapshots will be pushed
+    std::thread m_worker;           ///< Background thread
+#endif
+};
+
+} // namespace cartesi
+
+#endif
@@ -198,7 +198,8 @@ private:
 
     pma_peek m_peek; ///< Callback for peek operations.
 
-    std::vector<uint8_t> m_dirty_page_map; ///< Map of dirty pages.
+    std::vector<uint8_t> m_dirty_page_map;   ///< Map of dirty pages.
+    std::vector<uint8_t> m_written_page_map; ///< Map of pages written since it was last cleared, if tracked.
 
     std::variant<pma_empty, ///< Data specific to E ranges
         pma_device,         ///< Data specific to IO ranges
@@ -426,6 +427,9 @@ public:
             auto map_index = page_number >> 3;
             assert(map_index < m_dirty_page_map.size());
             m_dirty_page_map[map_index] |= (1 << (page_number & 7));
+            if (!m_written_page_map.empty()) {
+                m_written_page_map[map_index] |= (1 << (page_number & 7));
+            }
         }
     }
     /// \brief Mark all pages in rage as dirty
@@ -444,7 +448,8 @@ public:
         constexpr const auto log2_page_size = PMA_constants::PMA_PAGE_SIZE_LOG2;
         uint64_t page_in_range = ((address - get_start()) >> log2_page_size) << log2_page_size;
         constexpr const auto page_size = PMA_constants::PMA_PAGE_SIZE;
-        auto npages = (size + page_size - 1) / page_size;
+        // Count from the start of the first page, so unaligned ranges also mark the page they end in
+        auto npages = (address - get_start() - page_in_range + size + page_size - 1) / page_size;
         for (decltype(npages) i = 0; i < npages; ++i) {
             mark_dirty_page(page_in_range);
             page_in_range += page_size;
@@ -481,6 +486,30 @@ public:
         return std::fill(m_dirty_page_map.begin(), m_dirty_page_map.end(), 0);
     }
 
+    /// \brief Starts tracking written pages, independently of the dirty pages consumed by the Merkle tree
+    /// \details All pages start out marked as written.
+    void track_written_pages(void) {
+        m_written_page_map.assign(m_dirty_page_map.size(), 0xff);
+    }
+
+    /// \brief Checks if a given page was written since the map of written pages was last cleared
+    /// \param address_in_range Any address within page in range
+    /// \returns true if written or if written pages are not tracked, false otherwise
+    bool is_page_marked_written(uint64_t address_in_range) const {
+        if (!m_written_page_map.empty()) {
+            auto page_number = address_in_range >> PMA_constants::PMA_PAGE_SIZE_LOG2;
+            auto map_index = page_number >> 3;
+            assert(map_index < m_written_page_map.size());
+            return m_written_page_map[map_index] & (1 << (page_number & 7));
+        }
+        return true;
+    }
+
+    /// \brief Marks all pages in range as not written
+    void clear_written_pages(void) {
+        return std::fill(m_written_page_map.begin(), m_written_page_map.end(), 0);
+    }
+
     /// \brief Returns PMA description as a string
     /// \returns Description
     const std::string &get_description(void) const {
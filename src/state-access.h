@@ -356,6 +356,10 @@ private:
         return m_m.get_state().iflags.Y;
     }
 
+    bool do_read_iflags_I(void) const {
+        return m_m.get_state().iflags.I;
+    }
+
     uint8_t do_read_iflags_PRV(void) const {
         return m_m.get_state().iflags.PRV;
     }
@@ -668,6 +672,22 @@ private:
         return m_m.get_state().soft_yield;
     }
 
+    void do_count_insn(insn_id id) {
+        auto *profiler = m_m.get_profiler();
+        if (unlikely(profiler != nullptr)) {
+            profiler->count_insn(id);
+        }
+    }
+
+    uint64_t do_get_pc_sample_period() const {
+        const auto *profiler = m_m.get_profiler();
+        return profiler != nullptr ? profiler->get_pc_sample_period() : 0;
+    }
+
+    void do_sample_pc(uint64_t pc) {
+        m_m.get_profiler()->sample_pc(pc);
+    }
+
 #ifdef DUMP_COUNTERS
     machine_statistics &do_get_statistics() {
         return m_m.get_state().stats;
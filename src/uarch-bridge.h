@@ -17,6 +17,12 @@
 #ifndef UARCH_BRIDGE_H
 #define UARCH_BRIDGE_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
 #include "machine-state.h"
 #include "riscv-constants.h"
 #include "shadow-state.h"
@@ -30,6 +36,16 @@ namespace cartesi {
 /// \brief Allows microarchitecture code to access the machine state
 class uarch_bridge {
 public:
+    /// \brief Tells if an address falls within the shadow ranges that the bridge maps to machine state registers.
+    /// \param paddr Address accessed by the microarchitecture.
+    /// \returns True if paddr is within the shadow state, shadow PMAs or shadow TLB ranges.
+    /// \details These ranges belong to device PMAs, so no memory PMA can ever contain paddr when this is true.
+    static bool is_shadow_address(uint64_t paddr) {
+        return (paddr - PMA_SHADOW_STATE_START < PMA_SHADOW_STATE_LENGTH) ||
+            (paddr - PMA_SHADOW_PMAS_START < PMA_SHADOW_PMAS_LENGTH) ||
+            (paddr - PMA_SHADOW_TLB_START < PMA_SHADOW_TLB_LENGTH);
+    }
+
     /// \brief Updates the value of a machine state register.
     /// \param s Machine state.
     /// \param paddr Address that identifies the machine register to be written.
@@ -38,114 +54,13 @@ public:
     /// An exception is thrown if paddr can't me mapped to a valid state register.
     //// \}
     static void write_register(uint64_t paddr, machine_state &s, uint64_t data) {
-        if (try_write_x(s, paddr, data)) {
-            return;
-        }
-        if (try_write_f(s, paddr, data)) {
-            return;
-        }
-        if (try_write_tlb(s, paddr, data)) {
-            return;
-        }
-        switch (static_cast<shadow_state_csr>(paddr)) {
-            case shadow_state_csr::pc:
-                s.pc = data;
-                return;
-            case shadow_state_csr::fcsr:
-                s.fcsr = data;
-                return;
-            case shadow_state_csr::mcycle:
-                s.mcycle = data;
-                return;
-            case shadow_state_csr::icycleinstret:
-                s.icycleinstret = data;
-                return;
-            case shadow_state_csr::mstatus:
-                s.mstatus = data;
-                return;
-            case shadow_state_csr::mtvec:
-                s.mtvec = data;
-                return;
-            case shadow_state_csr::mscratch:
-                s.mscratch = data;
-                return;
-            case shadow_state_csr::mepc:
-                s.mepc = data;
-                return;
-            case shadow_state_csr::mcause:
-                s.mcause = data;
-                return;
-            case shadow_state_csr::mtval:
-                s.mtval = data;
-                return;
-            case shadow_state_csr::misa:
-                s.misa = data;
-                return;
-            case shadow_state_csr::mie:
-                s.mie = data;
-                return;
-            case shadow_state_csr::mip:
-                s.mip = data;
-                return;
-            case shadow_state_csr::medeleg:
-                s.medeleg = data;
-                return;
-            case shadow_state_csr::mideleg:
-                s.mideleg = data;
-                return;
-            case shadow_state_csr::mcounteren:
-                s.mcounteren = data;
-                return;
-            case shadow_state_csr::menvcfg:
-                s.menvcfg = data;
+        if (const auto *field = find_shadow_state_field(paddr)) {
+            if (field->write != nullptr) {
+                field->write(s, data);
                 return;
-            case shadow_state_csr::stvec:
-                s.stvec = data;
-                return;
-            case shadow_state_csr::sscratch:
-                s.sscratch = data;
-                return;
-            case shadow_state_csr::sepc:
-                s.sepc = data;
-                return;
-            case shadow_state_csr::scause:
-                s.scause = data;
-                return;
-            case shadow_state_csr::stval:
-                s.stval = data;
-                return;
-            case shadow_state_csr::satp:
-                s.satp = data;
-                return;
-            case shadow_state_csr::scounteren:
-                s.scounteren = data;
-                return;
-            case shadow_state_csr::senvcfg:
-                s.senvcfg = data;
-                return;
-            case shadow_state_csr::ilrsc:
-                s.ilrsc = data;
-                return;
-            case shadow_state_csr::iflags:
-                s.write_iflags(data);
-                return;
-            case shadow_state_csr::clint_mtimecmp:
-                s.clint.mtimecmp = data;
-                return;
-            case shadow_state_csr::plic_girqpend:
-                s.plic.girqpend = data;
-                return;
-            case shadow_state_csr::plic_girqsrvd:
-                s.plic.girqsrvd = data;
-                return;
-            case shadow_state_csr::htif_tohost:
-                s.htif.tohost = data;
-                return;
-            case shadow_state_csr::htif_fromhost:
-                s.htif.fromhost = data;
-                return;
-            default:
-                break;
+            }
+        } else if (try_write_tlb(s, paddr, data)) {
+            return;
         }
         throw std::runtime_error("invalid write memory access from microarchitecture");
     }
@@ -159,98 +74,13 @@ public:
     //// \}
     static uint64_t read_register(uint64_t paddr, machine_state &s) {
         uint64_t data = 0;
-        if (try_read_x(s, paddr, &data)) {
-            return data;
-        }
-        if (try_read_f(s, paddr, &data)) {
-            return data;
-        }
-        if (try_read_tlb(s, paddr, &data)) {
-            return data;
-        }
-        if (try_read_pma(s, paddr, &data)) {
+        if (const auto *field = find_shadow_state_field(paddr)) {
+            if (field->read != nullptr) {
+                return field->read(s);
+            }
+        } else if (try_read_tlb(s, paddr, &data) || try_read_pma(s, paddr, &data)) {
             return data;
         }
-        switch (static_cast<shadow_state_csr>(paddr)) {
-            case shadow_state_csr::pc:
-                return s.pc;
-            case shadow_state_csr::fcsr:
-                return s.fcsr;
-            case shadow_state_csr::mvendorid:
-                return MVENDORID_INIT;
-            case shadow_state_csr::marchid:
-                return MARCHID_INIT;
-            case shadow_state_csr::mimpid:
-                return MIMPID_INIT;
-            case shadow_state_csr::mcycle:
-                return s.mcycle;
-            case shadow_state_csr::icycleinstret:
-                return s.icycleinstret;
-            case shadow_state_csr::mstatus:
-                return s.mstatus;
-            case shadow_state_csr::mtvec:
-                return s.mtvec;
-            case shadow_state_csr::mscratch:
-                return s.mscratch;
-            case shadow_state_csr::mepc:
-                return s.mepc;
-            case shadow_state_csr::mcause:
-                return s.mcause;
-            case shadow_state_csr::mtval:
-                return s.mtval;
-            case shadow_state_csr::misa:
-                return s.misa;
-            case shadow_state_csr::mie:
-                return s.mie;
-            case shadow_state_csr::mip:
-                return s.mip;
-            case shadow_state_csr::medeleg:
-                return s.medeleg;
-            case shadow_state_csr::mideleg:
-                return s.mideleg;
-            case shadow_state_csr::mcounteren:
-                return s.mcounteren;
-            case shadow_state_csr::menvcfg:
-                return s.menvcfg;
-            case shadow_state_csr::stvec:
-                return s.stvec;
-            case shadow_state_csr::sscratch:
-                return s.sscratch;
-            case shadow_state_csr::sepc:
-                return s.sepc;
-            case shadow_state_csr::scause:
-                return s.scause;
-            case shadow_state_csr::stval:
-                return s.stval;
-            case shadow_state_csr::satp:
-                return s.satp;
-            case shadow_state_csr::scounteren:
-                return s.scounteren;
-            case shadow_state_csr::senvcfg:
-                return s.senvcfg;
-            case shadow_state_csr::ilrsc:
-                return s.ilrsc;
-            case shadow_state_csr::iflags:
-                return s.read_iflags();
-            case shadow_state_csr::clint_mtimecmp:
-                return s.clint.mtimecmp;
-            case shadow_state_csr::plic_girqpend:
-                return s.plic.girqpend;
-            case shadow_state_csr::plic_girqsrvd:
-                return s.plic.girqsrvd;
-            case shadow_state_csr::htif_tohost:
-                return s.htif.tohost;
-            case shadow_state_csr::htif_fromhost:
-                return s.htif.fromhost;
-            case shadow_state_csr::htif_ihalt:
-                return s.htif.ihalt;
-            case shadow_state_csr::htif_iconsole:
-                return s.htif.iconsole;
-            case shadow_state_csr::htif_iyield:
-                return s.htif.iyield;
-            default:
-                break;
-        }
         throw std::runtime_error("invalid read memory access from microarchitecture");
     }
 
@@ -258,94 +88,8 @@ public:
     /// \param paddr Address of the state register.
     /// \returns The register name, if paddr maps to a register, or nullptr otherwise.
     static const char *get_register_name(uint64_t paddr) {
-        switch (static_cast<shadow_state_csr>(paddr)) {
-            case shadow_state_csr::pc:
-                return "pc";
-            case shadow_state_csr::fcsr:
-                return "fcsr";
-            case shadow_state_csr::mvendorid:
-                return "mvendorid";
-            case shadow_state_csr::marchid:
-                return "marchid";
-            case shadow_state_csr::mimpid:
-                return "mimpid";
-            case shadow_state_csr::mcycle:
-                return "mcycle";
-            case shadow_state_csr::icycleinstret:
-                return "icycleinstret";
-            case shadow_state_csr::mstatus:
-                return "mstatus";
-            case shadow_state_csr::mtvec:
-                return "mtvec";
-            case shadow_state_csr::mscratch:
-                return "mscratch";
-            case shadow_state_csr::mepc:
-                return "mepc";
-            case shadow_state_csr::mcause:
-                return "mcause";
-            case shadow_state_csr::mtval:
-                return "mtval";
-            case shadow_state_csr::misa:
-                return "misa";
-            case shadow_state_csr::mie:
-                return "mie";
-            case shadow_state_csr::mip:
-                return "mip";
-            case shadow_state_csr::medeleg:
-                return "medeleg";
-            case shadow_state_csr::mideleg:
-                return "mideleg";
-            case shadow_state_csr::mcounteren:
-                return "mcounteren";
-            case shadow_state_csr::menvcfg:
-                return "menvcfg";
-            case shadow_state_csr::stvec:
-                return "stvec";
-            case shadow_state_csr::sscratch:
-                return "sscratch";
-            case shadow_state_csr::sepc:
-                return "sepc";
-            case shadow_state_csr::scause:
-                return "scause";
-            case shadow_state_csr::stval:
-                return "stval";
-            case shadow_state_csr::satp:
-                return "satp";
-            case shadow_state_csr::scounteren:
-                return "scounteren";
-            case shadow_state_csr::senvcfg:
-                return "senvcfg";
-            case shadow_state_csr::ilrsc:
-                return "ilrsc";
-            case shadow_state_csr::iflags:
-                return "iflags";
-            case shadow_state_csr::clint_mtimecmp:
-                return "clint.mtimecmp";
-            case shadow_state_csr::plic_girqpend:
-                return "plic.girqpend";
-            case shadow_state_csr::plic_girqsrvd:
-                return "plic.girqsrvd";
-            case shadow_state_csr::htif_tohost:
-                return "htif.tohost";
-            case shadow_state_csr::htif_fromhost:
-                return "htif.fromhost";
-            case shadow_state_csr::htif_ihalt:
-                return "htif.ihalt";
-            case shadow_state_csr::htif_iconsole:
-                return "htif.iconsole";
-            case shadow_state_csr::htif_iyield:
-                return "htif.iyield";
-            default:
-                break;
-        }
-        if (paddr >= shadow_state_get_x_abs_addr(0) && paddr <= shadow_state_get_x_abs_addr(X_REG_COUNT - 1) &&
-            (paddr & 0b111) == 0) {
-            return "x";
-        }
-
-        if (paddr >= shadow_state_get_f_abs_addr(0) && paddr <= shadow_state_get_f_abs_addr(F_REG_COUNT - 1) &&
-            (paddr & 0b111) == 0) {
-            return "f";
+        if (const auto *field = find_shadow_state_field(paddr)) {
+            return field->name;
         }
 
         if (paddr >= PMA_SHADOW_PMAS_START && paddr < PMA_SHADOW_PMAS_START + (PMA_MAX * PMA_WORD_SIZE * 2)) {
@@ -371,46 +115,118 @@ public:
     }
 
 private:
-    /// \brief Tries to write a general-purpose machine register.
-    /// \param s Machine state.
-    /// \param paddr Absolute address of the register within shadow-state range
-    /// \param data Data to write
-    /// \return true if the register was successfully written.
-    static bool try_write_x(machine_state &s, uint64_t paddr, uint64_t data) {
-        if (paddr < shadow_state_get_x_abs_addr(0)) {
-            return false;
-        }
-        if (paddr > shadow_state_get_x_abs_addr(X_REG_COUNT - 1)) {
-            return false;
-        }
-        if (paddr & 0b111) {
-            throw std::runtime_error("write register value not correctly aligned");
-        }
-        paddr -= shadow_state_get_x_abs_addr(0);
-        s.x[paddr >> 3] = data;
-        return true;
+    /// \brief Machine state register mapped to a word of the shadow state
+    struct shadow_state_field {
+        const char *name{};                               ///< Register name, or nullptr if the word is not mapped
+        uint64_t (*read)(machine_state &s){};             ///< Reads the register, or nullptr if it cannot be read
+        void (*write)(machine_state &s, uint64_t data){}; ///< Writes the register, or nullptr if it cannot be written
+    };
+
+    /// \brief Number of words in the shadow state
+    static constexpr uint64_t shadow_state_word_count = sizeof(shadow_state) / sizeof(uint64_t);
+
+    /// \brief Table of registers indexed by shadow state word
+    using shadow_state_field_table = std::array<shadow_state_field, shadow_state_word_count>;
+
+    /// \brief Finds the register mapped to an address within the shadow state
+    /// \param paddr Address accessed by the microarchitecture.
+    /// \returns Pointer to the table entry of the word containing paddr, or nullptr if paddr is outside the
+    /// shadow state or not aligned to a word. The entry may map no register.
+    static const shadow_state_field *find_shadow_state_field(uint64_t paddr) {
+        const uint64_t offset = paddr - PMA_SHADOW_STATE_START;
+        if (offset >= sizeof(shadow_state) || (offset & 0b111) != 0) {
+            return nullptr;
+        }
+        return &shadow_state_fields[offset >> 3];
     }
 
-    /// \brief Tries to read a general-purpose machine register.
-    /// \param s Machine state.
-    /// \param paddr Absolute address of the register within shadow-state range
-    /// \param data Pointer to word receiving value.
-    /// \return true if the register was successfully read
-    static bool try_read_x(machine_state &s, uint64_t paddr, uint64_t *data) {
-        if (paddr < shadow_state_get_x_abs_addr(0)) {
-            return false;
-        }
-        if (paddr > shadow_state_get_x_abs_addr(X_REG_COUNT - 1)) {
-            return false;
-        }
-        if (paddr & 0b111) {
-            throw std::runtime_error("read register value not correctly aligned");
-        }
-        paddr -= shadow_state_get_x_abs_addr(0);
-        *data = s.x[paddr >> 3];
-        return true;
+    /// \brief Fills the table entries of general-purpose registers
+    template <size_t... I>
+    static constexpr void set_x_fields(shadow_state_field_table &t, std::index_sequence<I...> /*unused*/) {
+        ((t[(offsetof(shadow_state, x) >> 3) + I] = {"x", [](machine_state &s) { return s.x[I]; },
+              [](machine_state &s, uint64_t data) { s.x[I] = data; }}),
+            ...);
+    }
+
+    /// \brief Fills the table entries of floating-point registers
+    template <size_t... I>
+    static constexpr void set_f_fields(shadow_state_field_table &t, std::index_sequence<I...> /*unused*/) {
+        ((t[(offsetof(shadow_state, f) >> 3) + I] = {"f", [](machine_state &s) { return s.f[I]; },
+              [](machine_state &s, uint64_t data) { s.f[I] = data; }}),
+            ...);
     }
 
+    /// \brief Builds the table of registers indexed by shadow state word
+    static constexpr shadow_state_field_table make_shadow_state_fields(void) {
+        shadow_state_field_table t{};
+        set_x_fields(t, std::make_index_sequence<X_REG_COUNT>{});
+        set_f_fields(t, std::make_index_sequence<F_REG_COUNT>{});
+        const auto set = [&t](shadow_state_csr csr, shadow_state_field field) {
+            t[static_cast<uint64_t>(csr) >> 3] = field;
+        };
+        // NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define UARCH_BRIDGE_CSR(csr, field)                                                                                   \
+    set(shadow_state_csr::csr,                                                                                         \
+        shadow_state_field{#csr, [](machine_state &s) -> uint64_t { return s.field; },                               \
+            [](machine_state &s, uint64_t data) { s.field = data; }})
+        UARCH_BRIDGE_CSR(pc, pc);
+        UARCH_BRIDGE_CSR(fcsr, fcsr);
+        UARCH_BRIDGE_CSR(mcycle, mcycle);
+        UARCH_BRIDGE_CSR(icycleinstret, icycleinstret);
+        UARCH_BRIDGE_CSR(mstatus, mstatus);
+        UARCH_BRIDGE_CSR(mtvec, mtvec);
+        UARCH_BRIDGE_CSR(mscratch, mscratch);
+        UARCH_BRIDGE_CSR(mepc, mepc);
+        UARCH_BRIDGE_CSR(mcause, mcause);
+        UARCH_BRIDGE_CSR(mtval, mtval);
+        UARCH_BRIDGE_CSR(misa, misa);
+        UARCH_BRIDGE_CSR(mie, mie);
+        UARCH_BRIDGE_CSR(mip, mip);
+        UARCH_BRIDGE_CSR(medeleg, medeleg);
+        UARCH_BRIDGE_CSR(mideleg, mideleg);
+        UARCH_BRIDGE_CSR(mcounteren, mcounteren);
+        UARCH_BRIDGE_CSR(menvcfg, menvcfg);
+        UARCH_BRIDGE_CSR(stvec, stvec);
+        UARCH_BRIDGE_CSR(sscratch, sscratch);
+        UARCH_BRIDGE_CSR(sepc, sepc);
+        UARCH_BRIDGE_CSR(scause, scause);
+        UARCH_BRIDGE_CSR(stval, stval);
+        UARCH_BRIDGE_CSR(satp, satp);
+        UARCH_BRIDGE_CSR(scounteren, scounteren);
+        UARCH_BRIDGE_CSR(senvcfg, senvcfg);
+        UARCH_BRIDGE_CSR(ilrsc, ilrsc);
+#undef UARCH_BRIDGE_CSR
+        // NOLINTEND(cppcoreguidelines-macro-usage)
+        set(shadow_state_csr::mvendorid, {"mvendorid", [](machine_state &) -> uint64_t { return MVENDORID_INIT; }});
+        set(shadow_state_csr::marchid, {"marchid", [](machine_state &) -> uint64_t { return MARCHID_INIT; }});
+        set(shadow_state_csr::mimpid, {"mimpid", [](machine_state &) -> uint64_t { return MIMPID_INIT; }});
+        set(shadow_state_csr::iflags,
+            {"iflags", [](machine_state &s) { return s.read_iflags(); },
+                [](machine_state &s, uint64_t data) { s.write_iflags(data); }});
+        set(shadow_state_csr::clint_mtimecmp,
+            {"clint.mtimecmp", [](machine_state &s) { return s.clint.mtimecmp; },
+                [](machine_state &s, uint64_t data) { s.clint.mtimecmp = data; }});
+        set(shadow_state_csr::plic_girqpend,
+            {"plic.girqpend", [](machine_state &s) { return s.plic.girqpend; },
+                [](machine_state &s, uint64_t data) { s.plic.girqpend = data; }});
+        set(shadow_state_csr::plic_girqsrvd,
+            {"plic.girqsrvd", [](machine_state &s) { return s.plic.girqsrvd; },
+                [](machine_state &s, uint64_t data) { s.plic.girqsrvd = data; }});
+        set(shadow_state_csr::htif_tohost,
+            {"htif.tohost", [](machine_state &s) { return s.htif.tohost; },
+                [](machine_state &s, uint64_t data) { s.htif.tohost = data; }});
+        set(shadow_state_csr::htif_fromhost,
+            {"htif.fromhost", [](machine_state &s) { return s.htif.fromhost; },
+                [](machine_state &s, uint64_t data) { s.htif.fromhost = data; }});
+        set(shadow_state_csr::htif_ihalt, {"htif.ihalt", [](machine_state &s) { return s.htif.ihalt; }});
+        set(shadow_state_csr::htif_iconsole, {"htif.iconsole", [](machine_state &s) { return s.htif.iconsole; }});
+        set(shadow_state_csr::htif_iyield, {"htif.iyield", [](machine_state &s) { return s.htif.iyield; }});
+        return t;
+    }
+
+    /// \brief Registers indexed by shadow state word, so a register access costs a single table lookup
+    static const shadow_state_field_table shadow_state_fields;
+
     /// \brief Tries to read a PMA entry field.
     /// \param s Machine state.
     /// \param paddr Absolute address of the PMA entry field within shadow PMAs range
@@ -435,46 +251,6 @@ private:
         return true;
     }
 
-    /// \brief Tries to write a floating-point machine register.
-    /// \param s Machine state.
-    /// \param paddr Absolute address of the register within shadow-state range
-    /// \param data Data to write
-    /// \return true if the register was successfully written.
-    static bool try_write_f(machine_state &s, uint64_t paddr, uint64_t data) {
-        if (paddr < shadow_state_get_f_abs_addr(0)) {
-            return false;
-        }
-        if (paddr > shadow_state_get_f_abs_addr(F_REG_COUNT - 1)) {
-            return false;
-        }
-        if (paddr & 0b111) {
-            throw std::runtime_error("read floating-point register value not correctly aligned");
-        }
-        paddr -= shadow_state_get_f_abs_addr(0);
-        s.f[paddr >> 3] = data;
-        return true;
-    }
-
-    /// \brief Tries to read a floating-point machine register.
-    /// \param s Machine state.
-    /// \param paddr Absolute address of the register within shadow-state range
-    /// \param data Pointer to word receiving value.
-    /// \return true if the register was successfully read
-    static bool try_read_f(machine_state &s, uint64_t paddr, uint64_t *data) {
-        if (paddr < shadow_state_get_f_abs_addr(0)) {
-            return false;
-        }
-        if (paddr > shadow_state_get_f_abs_addr(F_REG_COUNT - 1)) {
-            return false;
-        }
-        if (paddr & 0b111) {
-            throw std::runtime_error("read floating-point register value not correctly aligned");
-        }
-        paddr -= shadow_state_get_f_abs_addr(0);
-        *data = s.f[paddr >> 3];
-        return true;
-    }
-
     /// \brief Tries to read a TLB entry field.
     /// \param s Machine state.
     /// \param paddr Absolute address of the TLB entry fieldwithin shadow TLB range
@@ -647,6 +423,9 @@ private:
     }
 };
 
+inline constexpr uarch_bridge::shadow_state_field_table uarch_bridge::shadow_state_fields =
+    uarch_bridge::make_shadow_state_fields();
+
 } // namespace cartesi
 
 #endif
@@ -25,7 +25,11 @@ uarch_interpreter_break_reason uarch_interpret(uarch_step_state_access &a, uint6
         throw std::invalid_argument{"uarch_cycle is past"};
     }
     while (cycle < cycle_end) {
+#ifdef NO_UARCH_INSN_CACHE
         const UArchStepStatus status = uarch_step(a);
+#else
+        const UArchStepStatus status = uarch_step(a, a.get_insn_cache());
+#endif
         switch (status) {
             case UArchStepStatus::Success:
                 cycle += 1;
@@ -60,6 +60,11 @@ uarch_machine::uarch_machine(uarch_config c) : m_s{}, m_c{c} {
         }
         memcpy(m_s.ram.get_memory().get_host_memory(), uarch_pristine_ram, uarch_pristine_ram_len);
     }
+    // Resets only restore the pages written since the previous reset
+    m_s.ram.track_written_pages();
+    if (c.ram.image_filename.empty()) {
+        m_s.ram.clear_written_pages();
+    }
 }
 
 uint64_t uarch_machine::read_cycle(void) const {
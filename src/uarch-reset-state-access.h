@@ -21,6 +21,7 @@
 /// \brief State access implementation that record and logs all accesses
 
 #include "i-uarch-reset-state-access.h"
+#include "uarch-reset-state.h"
 #include "uarch-state.h"
 
 namespace cartesi {
@@ -70,11 +71,7 @@ private:
             m_us.x[i] = UARCH_X_INIT;
         }
         // Load embedded pristine RAM image
-        if (uarch_pristine_ram_len > m_us.ram.get_length()) {
-            throw std::runtime_error("embedded uarch ram image does not fit in uarch ram pma");
-        }
-        m_us.ram.fill_memory(m_us.ram.get_start(), 0, m_us.ram.get_length());
-        m_us.ram.write_memory(m_us.ram.get_start(), uarch_pristine_ram, uarch_pristine_ram_len);
+        uarch_reset_ram(m_us.ram);
     }
 };
 
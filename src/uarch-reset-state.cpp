@@ -16,7 +16,11 @@
 
 // NOLINTBEGIN(google-readability-casting, misc-const-correctness)
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "uarch-reset-state.h"
+#include "uarch-pristine.h"
 #include "uarch-record-reset-state-access.h"
 #include "uarch-replay-reset-state-access.h"
 #include "uarch-reset-state-access.h"
@@ -38,5 +42,27 @@ template void uarch_reset_state(uarch_record_reset_state_access &a);
 // Explicit instantiation for uarch_replay_step_state_access
 template void uarch_reset_state(uarch_replay_reset_state_access &a);
 
+void uarch_reset_ram(pma_entry &ram) {
+    if (uarch_pristine_ram_len > ram.get_length()) {
+        throw std::runtime_error("embedded uarch ram image does not fit in uarch ram pma");
+    }
+    for (uint64_t offset = 0; offset < ram.get_length(); offset += PMA_PAGE_SIZE) {
+        if (!ram.is_page_marked_written(offset)) {
+            continue;
+        }
+        // Pages past the end of the image are zero
+        const uint64_t paddr = ram.get_start() + offset;
+        const uint64_t image_length =
+            offset < uarch_pristine_ram_len ? std::min<uint64_t>(PMA_PAGE_SIZE, uarch_pristine_ram_len - offset) : 0;
+        if (image_length > 0) {
+            ram.write_memory(paddr, uarch_pristine_ram + offset, image_length);
+        }
+        if (image_length < PMA_PAGE_SIZE) {
+            ram.fill_memory(paddr + image_length, 0, PMA_PAGE_SIZE - image_length);
+        }
+    }
+    ram.clear_written_pages();
+}
+
 } // namespace cartesi
 // NOLINTEND(google-readability-casting, misc-const-correctness)
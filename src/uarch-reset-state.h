@@ -17,8 +17,15 @@
 #ifndef UARCH_RESET_STATE_H
 #define UARCH_RESET_STATE_H
 
+#include "pma.h"
+
 namespace cartesi {
 
+/// \brief Restores the uarch RAM to the embedded pristine image
+/// \param ram Uarch RAM range
+/// \details Only copies back the pages written since the last restore, when the range tracks written pages.
+void uarch_reset_ram(pma_entry &ram);
+
 /// \brief  Reset uarch to pristine state
 /// \tparam STATE_ACCESS state accessor type
 /// \param a state accessor instance
@@ -0,0 +1,49 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef UARCH_STATE_TRANSITION_H
+#define UARCH_STATE_TRANSITION_H
+
+/// \file
+/// \brief Microarchitecture state transitions verified in batches.
+
+#include <vector>
+
+#include "access-log.h"
+#include "machine-merkle-tree.h"
+
+namespace cartesi {
+
+/// \brief Operation that produced the log of a state transition
+enum class uarch_state_transition_type {
+    step, ///< Log produced by machine::log_uarch_step()
+    reset ///< Log produced by machine::log_uarch_reset()
+};
+
+/// \brief State transition caused by a single uarch step or uarch reset
+struct uarch_state_transition {
+    uarch_state_transition_type type{uarch_state_transition_type::step}; ///< Operation that produced the log
+    machine_merkle_tree::hash_type root_hash_before{};                    ///< State hash before the operation
+    access_log log{access_log::type{true}};                               ///< State access log, with proofs
+    machine_merkle_tree::hash_type root_hash_after{};                     ///< State hash after the operation
+};
+
+/// \brief List of state transitions, in the order they happened
+using uarch_state_transitions = std::vector<uarch_state_transition>;
+
+} // namespace cartesi
+
+#endif
@@ -20,6 +20,7 @@
 /// \file
 /// \brief Cartesi microarchitecture machine state structure definition.
 
+#include <array>
 #include <cstdint>
 
 #include "pma.h"
@@ -28,6 +29,18 @@
 
 namespace cartesi {
 
+/// \brief Number of entries in the decoded instruction cache of the microarchitecture
+constexpr uint64_t UARCH_INSN_CACHE_SIZE = 8192;
+
+/// \brief Entry of the decoded instruction cache of the microarchitecture
+struct uarch_insn_cache_entry {
+    uint32_t insn; ///< Instruction the entry was decoded from
+    uint32_t id;   ///< Decoded instruction, or 0 if the entry is empty
+};
+
+/// \brief Direct-mapped cache of decoded microarchitecture instructions, indexed by pc and tagged by instruction
+using uarch_insn_cache = std::array<uarch_insn_cache_entry, UARCH_INSN_CACHE_SIZE>;
+
 struct uarch_state {
     ~uarch_state() {
         ;
@@ -43,9 +56,10 @@ struct uarch_state {
     std::array<uint64_t, UARCH_X_REG_COUNT> x; ///< Register file.
     uint64_t cycle;                            ///< Cycles counter
     bool halt_flag;
-    pma_entry shadow_state; ///< Shadow uarch state
-    pma_entry ram;          ///< Memory range for micro RAM
-    pma_entry empty_pma;    ///< Empty range fallback
+    pma_entry shadow_state;        ///< Shadow uarch state
+    pma_entry ram;                 ///< Memory range for micro RAM
+    pma_entry empty_pma;           ///< Empty range fallback
+    uarch_insn_cache insn_cache{}; ///< Decoded instructions, not part of the state proper
 };
 
 } // namespace cartesi
@@ -73,6 +73,11 @@ public:
     /// \brief Default destructor
     ~uarch_step_state_access() = default;
 
+    /// \brief Returns the decoded instruction cache of the microarchitecture
+    uarch_insn_cache &get_insn_cache() {
+        return m_us.insn_cache;
+    }
+
 private:
     friend i_uarch_step_state_access<uarch_step_state_access>;
 
@@ -126,6 +131,10 @@ private:
     }
 
     uint64_t do_read_word(uint64_t paddr) {
+        // Machine state registers are the most frequent accesses, and no memory PMA can contain them
+        if (uarch_bridge::is_shadow_address(paddr)) {
+            return read_register(paddr);
+        }
         // Find a memory range that contains the specified address
         auto &pma = find_memory_pma_entry(paddr, sizeof(uint64_t));
         if (pma.get_istart_E()) {
@@ -151,6 +160,10 @@ private:
 
     /// \brief Fallback to error on all other word sizes
     void do_write_word(uint64_t paddr, uint64_t data) {
+        // Machine state registers are the most frequent accesses, and no memory PMA can contain them
+        if (uarch_bridge::is_shadow_address(paddr)) {
+            return write_register(paddr, data);
+        }
         // Find a memory range that contains the specified address
         auto &pma = find_memory_pma_entry(paddr, sizeof(uint64_t));
         if (pma.get_istart_E()) {
@@ -1148,5 +1148,314 @@ template UArchStepStatus uarch_step(uarch_record_step_state_access &a);
 // Explicit instantiation for uarch_replay_step_state_access
 template UArchStepStatus uarch_step(uarch_replay_step_state_access &a);
 
+// Decoded instruction cache
+//
+// Everything below is used only by the native interpreter, and is not part of the step specification. It remembers
+// the outcome of the decoding in executeInsn, so instructions executed again skip the chain of checks.
+
+/// \brief Instructions known to executeInsn, in the order it checks for them
+enum class UArchInsn : uint32 {
+    Unknown,
+    ADDI,
+    LD,
+    BLTU,
+    BEQ,
+    ANDI,
+    ADD,
+    JAL,
+    SLLI,
+    AND,
+    SD,
+    LUI,
+    JALR,
+    ADDIW,
+    SRLI,
+    SRLIW,
+    BNE,
+    LW,
+    AUIPC,
+    BGEU,
+    ADDW,
+    SRAI,
+    OR,
+    SRAIW,
+    BGE,
+    SUB,
+    LBU,
+    SLLIW,
+    SRL,
+    XOR,
+    SW,
+    SLL,
+    BLT,
+    SB,
+    SUBW,
+    XORI,
+    SRA,
+    LHU,
+    SH,
+    SRLW,
+    LWU,
+    SLLW,
+    LB,
+    SLTU,
+    SRAW,
+    LH,
+    ORI,
+    SLTIU,
+    SLT,
+    SLTI,
+    FENCE,
+    ECALL,
+    EBREAK
+};
+
+/// \brief Returns the instruction executeInsn would execute, or UArchInsn::Unknown if it is illegal
+static inline UArchInsn decodeInsn(uint32 insn) {
+    if (insnMatchOpcodeFunct3(insn, 0x13, 0x0)) {
+        return UArchInsn::ADDI;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x3)) {
+        return UArchInsn::LD;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x6)) {
+        return UArchInsn::BLTU;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x0)) {
+        return UArchInsn::BEQ;
+    } else if (insnMatchOpcodeFunct3(insn, 0x13, 0x7)) {
+        return UArchInsn::ANDI;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x0, 0x0)) {
+        return UArchInsn::ADD;
+    } else if (insnMatchOpcode(insn, 0x6f)) {
+        return UArchInsn::JAL;
+    } else if (insnMatchOpcodeFunct3Funct7Sr1(insn, 0x13, 0x1, 0x0)) {
+        return UArchInsn::SLLI;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x7, 0x0)) {
+        return UArchInsn::AND;
+    } else if (insnMatchOpcodeFunct3(insn, 0x23, 0x3)) {
+        return UArchInsn::SD;
+    } else if (insnMatchOpcode(insn, 0x37)) {
+        return UArchInsn::LUI;
+    } else if (insnMatchOpcodeFunct3(insn, 0x67, 0x0)) {
+        return UArchInsn::JALR;
+    } else if (insnMatchOpcodeFunct3(insn, 0x1b, 0x0)) {
+        return UArchInsn::ADDIW;
+    } else if (insnMatchOpcodeFunct3Funct7Sr1(insn, 0x13, 0x5, 0x0)) {
+        return UArchInsn::SRLI;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x1b, 0x5, 0x0)) {
+        return UArchInsn::SRLIW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x1)) {
+        return UArchInsn::BNE;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x2)) {
+        return UArchInsn::LW;
+    } else if (insnMatchOpcode(insn, 0x17)) {
+        return UArchInsn::AUIPC;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x7)) {
+        return UArchInsn::BGEU;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x3b, 0x0, 0x0)) {
+        return UArchInsn::ADDW;
+    } else if (insnMatchOpcodeFunct3Funct7Sr1(insn, 0x13, 0x5, 0x10)) {
+        return UArchInsn::SRAI;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x6, 0x0)) {
+        return UArchInsn::OR;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x1b, 0x5, 0x20)) {
+        return UArchInsn::SRAIW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x5)) {
+        return UArchInsn::BGE;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x0, 0x20)) {
+        return UArchInsn::SUB;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x4)) {
+        return UArchInsn::LBU;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x1b, 0x1, 0x0)) {
+        return UArchInsn::SLLIW;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x5, 0x0)) {
+        return UArchInsn::SRL;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x4, 0x0)) {
+        return UArchInsn::XOR;
+    } else if (insnMatchOpcodeFunct3(insn, 0x23, 0x2)) {
+        return UArchInsn::SW;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x1, 0x0)) {
+        return UArchInsn::SLL;
+    } else if (insnMatchOpcodeFunct3(insn, 0x63, 0x4)) {
+        return UArchInsn::BLT;
+    } else if (insnMatchOpcodeFunct3(insn, 0x23, 0x0)) {
+        return UArchInsn::SB;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x3b, 0x0, 0x20)) {
+        return UArchInsn::SUBW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x13, 0x4)) {
+        return UArchInsn::XORI;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x5, 0x20)) {
+        return UArchInsn::SRA;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x5)) {
+        return UArchInsn::LHU;
+    } else if (insnMatchOpcodeFunct3(insn, 0x23, 0x1)) {
+        return UArchInsn::SH;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x3b, 0x5, 0x0)) {
+        return UArchInsn::SRLW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x6)) {
+        return UArchInsn::LWU;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x3b, 0x1, 0x0)) {
+        return UArchInsn::SLLW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x0)) {
+        return UArchInsn::LB;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x3, 0x0)) {
+        return UArchInsn::SLTU;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x3b, 0x5, 0x20)) {
+        return UArchInsn::SRAW;
+    } else if (insnMatchOpcodeFunct3(insn, 0x3, 0x1)) {
+        return UArchInsn::LH;
+    } else if (insnMatchOpcodeFunct3(insn, 0x13, 0x6)) {
+        return UArchInsn::ORI;
+    } else if (insnMatchOpcodeFunct3(insn, 0x13, 0x3)) {
+        return UArchInsn::SLTIU;
+    } else if (insnMatchOpcodeFunct3Funct7(insn, 0x33, 0x2, 0x0)) {
+        return UArchInsn::SLT;
+    } else if (insnMatchOpcodeFunct3(insn, 0x13, 0x2)) {
+        return UArchInsn::SLTI;
+    } else if (insnMatchOpcodeFunct3(insn, 0xf, 0x0)) {
+        return UArchInsn::FENCE;
+    } else if (insn == uint32(0x73)) {
+        return UArchInsn::ECALL;
+    } else if (insn == uint32(0x100073)) {
+        return UArchInsn::EBREAK;
+    }
+    return UArchInsn::Unknown;
+}
+
+/// \brief Executes an instruction previously decoded by decodeInsn
+template <typename UarchState>
+static inline void executeDecodedInsn(UarchState &a, UArchInsn id, uint32 insn, uint64 pc) {
+    switch (id) {
+        case UArchInsn::ADDI:
+            return executeADDI(a, insn, pc);
+        case UArchInsn::LD:
+            return executeLD(a, insn, pc);
+        case UArchInsn::BLTU:
+            return executeBLTU(a, insn, pc);
+        case UArchInsn::BEQ:
+            return executeBEQ(a, insn, pc);
+        case UArchInsn::ANDI:
+            return executeANDI(a, insn, pc);
+        case UArchInsn::ADD:
+            return executeADD(a, insn, pc);
+        case UArchInsn::JAL:
+            return executeJAL(a, insn, pc);
+        case UArchInsn::SLLI:
+            return executeSLLI(a, insn, pc);
+        case UArchInsn::AND:
+            return executeAND(a, insn, pc);
+        case UArchInsn::SD:
+            return executeSD(a, insn, pc);
+        case UArchInsn::LUI:
+            return executeLUI(a, insn, pc);
+        case UArchInsn::JALR:
+            return executeJALR(a, insn, pc);
+        case UArchInsn::ADDIW:
+            return executeADDIW(a, insn, pc);
+        case UArchInsn::SRLI:
+            return executeSRLI(a, insn, pc);
+        case UArchInsn::SRLIW:
+            return executeSRLIW(a, insn, pc);
+        case UArchInsn::BNE:
+            return executeBNE(a, insn, pc);
+        case UArchInsn::LW:
+            return executeLW(a, insn, pc);
+        case UArchInsn::AUIPC:
+            return executeAUIPC(a, insn, pc);
+        case UArchInsn::BGEU:
+            return executeBGEU(a, insn, pc);
+        case UArchInsn::ADDW:
+            return executeADDW(a, insn, pc);
+        case UArchInsn::SRAI:
+            return executeSRAI(a, insn, pc);
+        case UArchInsn::OR:
+            return executeOR(a, insn, pc);
+        case UArchInsn::SRAIW:
+            return executeSRAIW(a, insn, pc);
+        case UArchInsn::BGE:
+            return executeBGE(a, insn, pc);
+        case UArchInsn::SUB:
+            return executeSUB(a, insn, pc);
+        case UArchInsn::LBU:
+            return executeLBU(a, insn, pc);
+        case UArchInsn::SLLIW:
+            return executeSLLIW(a, insn, pc);
+        case UArchInsn::SRL:
+            return executeSRL(a, insn, pc);
+        case UArchInsn::XOR:
+            return executeXOR(a, insn, pc);
+        case UArchInsn::SW:
+            return executeSW(a, insn, pc);
+        case UArchInsn::SLL:
+            return executeSLL(a, insn, pc);
+        case UArchInsn::BLT:
+            return executeBLT(a, insn, pc);
+        case UArchInsn::SB:
+            return executeSB(a, insn, pc);
+        case UArchInsn::SUBW:
+            return executeSUBW(a, insn, pc);
+        case UArchInsn::XORI:
+            return executeXORI(a, insn, pc);
+        case UArchInsn::SRA:
+            return executeSRA(a, insn, pc);
+        case UArchInsn::LHU:
+            return executeLHU(a, insn, pc);
+        case UArchInsn::SH:
+            return executeSH(a, insn, pc);
+        case UArchInsn::SRLW:
+            return executeSRLW(a, insn, pc);
+        case UArchInsn::LWU:
+            return executeLWU(a, insn, pc);
+        case UArchInsn::SLLW:
+            return executeSLLW(a, insn, pc);
+        case UArchInsn::LB:
+            return executeLB(a, insn, pc);
+        case UArchInsn::SLTU:
+            return executeSLTU(a, insn, pc);
+        case UArchInsn::SRAW:
+            return executeSRAW(a, insn, pc);
+        case UArchInsn::LH:
+            return executeLH(a, insn, pc);
+        case UArchInsn::ORI:
+            return executeORI(a, insn, pc);
+        case UArchInsn::SLTIU:
+            return executeSLTIU(a, insn, pc);
+        case UArchInsn::SLT:
+            return executeSLT(a, insn, pc);
+        case UArchInsn::SLTI:
+            return executeSLTI(a, insn, pc);
+        case UArchInsn::FENCE:
+            return executeFENCE(a, insn, pc);
+        case UArchInsn::ECALL:
+            return executeECALL(a, insn, pc);
+        case UArchInsn::EBREAK:
+            return executeEBREAK(a, insn, pc);
+        case UArchInsn::Unknown:
+            break;
+    }
+    throwRuntimeError(a, "illegal instruction");
+}
+
+UArchStepStatus uarch_step(uarch_step_state_access &a, uarch_insn_cache &cache) {
+    // Same accesses, in the same order, as uarch_step
+    uint64 cycle = readCycle(a);
+    if (cycle == UINT64_MAX) {
+        return UArchStepStatus::CycleOverflow;
+    }
+    if (readHaltFlag(a)) {
+        return UArchStepStatus::UArchHalted;
+    }
+    uint64 pc = readPc(a);
+    uint32 insn = readUint32(a, pc);
+    // Entries are tagged by the instruction itself, so they never go stale when the microarchitecture RAM changes
+    auto &entry = cache[uint64ShiftRight(pc, 2) & (cache.size() - 1)];
+    if (entry.insn != insn || entry.id == 0) {
+        entry.insn = insn;
+        entry.id = uint32(decodeInsn(insn));
+    }
+    executeDecodedInsn(a, UArchInsn(entry.id), insn, pc);
+    cycle = cycle + 1;
+    writeCycle(a, cycle);
+    return UArchStepStatus::Success;
+}
+
 } // namespace cartesi
 // NOLINTEND(google-readability-casting, misc-const-correctness)
@@ -17,6 +17,8 @@
 #ifndef UARCH_STEP_H
 #define UARCH_STEP_H
 
+#include "uarch-state.h"
+
 namespace cartesi {
 
 /// \brief Microarchitecture step execution status code
@@ -46,6 +48,13 @@ extern template UArchStepStatus uarch_step(uarch_record_step_state_access &a);
 // Declaration of explicit instantiation in module uarch-step.cpp
 extern template UArchStepStatus uarch_step(uarch_replay_step_state_access &a);
 
+/// \brief Advances the microarchitecture by one micro cycle, skipping the decoding of cached instructions
+/// \param a Microarchitecture state accessor
+/// \param cache Decoded instruction cache
+/// \returns Returns a status code indicating whether and how the microarchitecure was advanced
+/// \details Produces the same state as uarch_step. Cannot be used when logging, since it has no record accessor.
+UArchStepStatus uarch_step(uarch_step_state_access &a, uarch_insn_cache &cache);
+
 } // namespace cartesi
 
 #endif
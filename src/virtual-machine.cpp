@@ -16,6 +16,8 @@
 
 #include "virtual-machine.h"
 
+#include <stdexcept>
+
 namespace cartesi {
 
 virtual_machine::virtual_machine(const machine_config &c, const machine_runtime_config &r) :
@@ -36,6 +38,15 @@ interpreter_break_reason virtual_machine::do_run(uint64_t mcycle_end) {
     return m_machine->run(mcycle_end);
 }
 
+interpreter_break_reason virtual_machine::do_run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end,
+    uint64_t period) {
+    auto *local_reference = dynamic_cast<virtual_machine *>(&reference);
+    if (local_reference == nullptr) {
+        throw std::invalid_argument{"reference must be a local machine"};
+    }
+    return m_machine->run_lockstep(*local_reference->m_machine, mcycle_end, period);
+}
+
 access_log virtual_machine::do_log_uarch_step(const access_log::type &log_type, bool one_based) {
     return m_machine->log_uarch_step(log_type, one_based);
 }
@@ -44,6 +55,11 @@ machine_merkle_tree::proof_type virtual_machine::do_get_proof(uint64_t address,
     return m_machine->get_proof(address, log2_size);
 }
 
+machine_merkle_tree::multi_proof_type virtual_machine::do_get_multi_proof(
+    const machine_merkle_tree::multi_proof_type::targets_type &targets) const {
+    return m_machine->get_multi_proof(targets);
+}
+
 void virtual_machine::do_get_root_hash(hash_type &hash) const {
     m_machine->get_root_hash(hash);
 }
@@ -76,6 +92,22 @@ void virtual_machine::do_write_virtual_memory(uint64_t address, const unsigned c
     m_machine->write_virtual_memory(address, data, length);
 }
 
+void virtual_machine::do_read_memory_ranges(const memory_range_reads &ranges) const {
+    m_machine->read_memory_ranges(ranges);
+}
+
+void virtual_machine::do_write_memory_ranges(const memory_range_writes &ranges) {
+    m_machine->write_memory_ranges(ranges);
+}
+
+void virtual_machine::do_read_virtual_memory_ranges(const memory_range_reads &ranges) const {
+    m_machine->read_virtual_memory_ranges(ranges);
+}
+
+void virtual_machine::do_write_virtual_memory_ranges(const memory_range_writes &ranges) {
+    m_machine->write_virtual_memory_ranges(ranges);
+}
+
 uint64_t virtual_machine::do_read_x(int i) const {
     return m_machine->read_x(i);
 }
@@ -444,6 +476,10 @@ void virtual_machine::do_replace_memory_range(const memory_range_config &new_ran
     m_machine->replace_memory_range(new_range);
 }
 
+void virtual_machine::do_clear_memory_range(uint64_t start, uint64_t length) {
+    m_machine->clear_memory_range(start, length);
+}
+
 uint64_t virtual_machine::do_read_word(uint64_t address) const {
     return m_machine->read_word(address);
 }
@@ -516,4 +552,21 @@ machine_memory_range_descrs virtual_machine::do_get_memory_ranges(void) const {
     return m_machine->get_memory_ranges();
 }
 
+periodic_root_hashes virtual_machine::do_get_periodic_root_hashes(void) {
+    return m_machine->get_periodic_root_hashes();
+}
+
+machine_profile virtual_machine::do_get_profile(void) const {
+    return m_machine->get_profile();
+}
+
+rollup_input_results virtual_machine::do_advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) {
+    return m_machine->advance_rollup(inputs, mcycle_end);
+}
+
+rollup_input_result virtual_machine::do_inspect_rollup(const unsigned char *query, uint64_t length,
+    uint64_t mcycle_end) {
+    return m_machine->inspect_rollup(query, length, mcycle_end);
+}
+
 } // namespace cartesi
@@ -41,8 +41,12 @@ public:
 private:
     void do_store(const std::string &dir) override;
     interpreter_break_reason do_run(uint64_t mcycle_end) override;
+    interpreter_break_reason do_run_lockstep(i_virtual_machine &reference, uint64_t mcycle_end,
+        uint64_t period) override;
     access_log do_log_uarch_step(const access_log::type &log_type, bool one_based = false) override;
     machine_merkle_tree::proof_type do_get_proof(uint64_t address, int log2_size) const override;
+    machine_merkle_tree::multi_proof_type do_get_multi_proof(
+        const machine_merkle_tree::multi_proof_type::targets_type &targets) const override;
     void do_get_root_hash(hash_type &hash) const override;
     bool do_verify_merkle_tree(void) const override;
     uint64_t do_read_csr(csr r) const override;
@@ -51,6 +55,10 @@ private:
     void do_write_memory(uint64_t address, const unsigned char *data, size_t length) override;
     void do_read_virtual_memory(uint64_t address, unsigned char *data, uint64_t length) const override;
     void do_write_virtual_memory(uint64_t address, const unsigned char *data, size_t length) override;
+    void do_read_memory_ranges(const memory_range_reads &ranges) const override;
+    void do_write_memory_ranges(const memory_range_writes &ranges) override;
+    void do_read_virtual_memory_ranges(const memory_range_reads &ranges) const override;
+    void do_write_virtual_memory_ranges(const memory_range_writes &ranges) override;
     uint64_t do_read_x(int i) const override;
     void do_write_x(int i, uint64_t val) override;
     uint64_t do_read_f(int i) const override;
@@ -143,6 +151,7 @@ private:
     uint64_t do_read_plic_girqsrvd(void) const override;
     void do_write_plic_girqsrvd(uint64_t val) override;
     void do_replace_memory_range(const memory_range_config &new_range) override;
+    void do_clear_memory_range(uint64_t start, uint64_t length) override;
     uint64_t do_read_word(uint64_t address) const override;
     bool do_verify_dirty_page_maps(void) const override;
     machine_config do_get_initial_config(void) const override;
@@ -161,6 +170,10 @@ private:
     bool do_read_uarch_halt_flag(void) const override;
     uarch_interpreter_break_reason do_run_uarch(uint64_t uarch_cycle_end) override;
     machine_memory_range_descrs do_get_memory_ranges(void) const override;
+    periodic_root_hashes do_get_periodic_root_hashes(void) override;
+    machine_profile do_get_profile(void) const override;
+    rollup_input_results do_advance_rollup(const rollup_inputs &inputs, uint64_t mcycle_end) override;
+    rollup_input_result do_inspect_rollup(const unsigned char *query, uint64_t length, uint64_t mcycle_end) override;
 };
 
 } // namespace cartesi
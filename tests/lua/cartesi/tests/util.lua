@@ -208,6 +208,34 @@ function test_util.check_proof(proof)
     return hash == proof.root_hash
 end
 
+function test_util.check_multi_proof(proof)
+    local targets = proof.targets
+    local next_sibling = 1
+    -- Siblings are consumed in address order, by a left-to-right traversal of nodes containing targets
+    local function node_hash(address, log2_size, first, last)
+        if last - first == 1 and targets[first].log2_size == log2_size then return targets[first].hash end
+        local log2_child_size = log2_size - 1
+        local middle = address + (1 << log2_child_size)
+        local split = first
+        while split < last and math.ult(targets[split].address, middle) do
+            split = split + 1
+        end
+        local hashes = {}
+        for i, child in ipairs({ { address, first, split }, { middle, split, last } }) do
+            if child[2] < child[3] then
+                hashes[i] = node_hash(child[1], log2_child_size, child[2], child[3])
+            else
+                hashes[i] = proof.sibling_hashes[next_sibling]
+                next_sibling = next_sibling + 1
+            end
+            if not hashes[i] then return nil end
+        end
+        return cartesi.keccak(hashes[1], hashes[2])
+    end
+    local hash = node_hash(0, proof.log2_root_size, 1, #targets + 1)
+    return hash == proof.root_hash and next_sibling == #proof.sibling_hashes + 1
+end
+
 function test_util.align(v, el) return (v >> el << el) end
 
 function test_util.load_file(filename)
@@ -251,7 +251,7 @@ end
 
 local remote
 
-local function build_machine_config(config_options)
+local function build_machine_config(config_options, runtime_options)
     if not config_options then config_options = {} end
 
     -- Create new machine
@@ -278,11 +278,12 @@ local function build_machine_config(config_options)
             update_merkle_tree = concurrency_update_merkle_tree,
         },
     }
+    for k, v in pairs(runtime_options or {}) do runtime[k] = v end
     return config, runtime
 end
 
-local function build_machine(type, config_options)
-    local config, runtime = build_machine_config(config_options)
+local function build_machine(type, config_options, runtime_options)
+    local config, runtime = build_machine_config(config_options, runtime_options)
     local new_machine
     if type ~= "local" then
         if not remote then remote = connect() end
@@ -350,6 +351,40 @@ do_test("should provide proof for values in registers", function(machine)
     end
 end)
 
+print("\n\ntesting merkle tree get_multi_proof")
+do_test("should provide multi-proof that agrees with single proofs", function(machine)
+    machine:write_memory(0x80000000, string.rep("\x5a", 64), 64)
+    local targets = {
+        { address = 0x80001000, log2_size = 12 },
+        { address = 0x80000008, log2_size = 3 },
+        { address = 0x80000000, log2_size = 3 },
+        { address = 0x80000020, log2_size = 5 },
+        { address = cpu_csr_addr.mcycle, log2_size = 3 },
+        { address = 0x100000000, log2_size = 32 },
+    }
+    local proof = machine:get_multi_proof(targets)
+    assert(test_util.check_multi_proof(proof), "multi-proof failed")
+    assert(proof.root_hash == machine:get_root_hash())
+    assert(#proof.targets == #targets)
+    local total_siblings = 0
+    for i, target in ipairs(proof.targets) do
+        if i > 1 then assert(math.ult(proof.targets[i - 1].address, target.address), "targets not sorted") end
+        local single = machine:get_proof(target.address, target.log2_size)
+        assert(single.target_hash == target.hash, "target hash mismatch")
+        total_siblings = total_siblings + #single.sibling_hashes
+    end
+    assert(#proof.sibling_hashes < total_siblings, "siblings not shared")
+    -- Tampering with a target hash must be detected
+    proof.targets[1].hash = proof.targets[2].hash
+    assert(not test_util.check_multi_proof(proof), "tampered multi-proof passed")
+    -- Overlapping targets are rejected
+    local success, err = pcall(machine.get_multi_proof, machine, {
+        { address = 0x80000000, log2_size = 12 },
+        { address = 0x80000008, log2_size = 3 },
+    })
+    assert(not success and err:match("targets overlap"))
+end)
+
 print("\n\ntesting get_csr_address function binding")
 do_test("should return address value for csr register", function()
     local module = cartesi
@@ -633,6 +668,51 @@ do_test("mcycle value should be 1000 after execution", function(machine)
     assert(machine:read_csr("mcycle") == 1000)
 end)
 
+print("\n\n run machine with periodic hashes")
+test_util.make_do_test(build_machine, machine_type, nil, { periodic_hashes = { period = 100, start = 50 } })(
+    "periodic root hashes should match hashes obtained by stopping the machine",
+    function(machine)
+        local reference <close> = build_machine(machine_type)
+        machine:write_mcycle(0)
+        reference:write_mcycle(0)
+        -- periods crossing run boundaries, and a run ending exactly at a period boundary
+        for _, mcycle_end in ipairs({ 170, 250, 420 }) do machine:run(mcycle_end) end
+        local hashes = machine:get_periodic_root_hashes()
+        assert(#hashes > 0, "no periodic hashes were computed")
+        for i, h in ipairs(hashes) do
+            assert(h.mcycle == 50 + (i - 1) * 100, "wrong periodic hash mcycle")
+            reference:run(h.mcycle)
+            assert(h.hash == reference:get_root_hash(), "periodic hash does not match")
+        end
+        assert(#machine:get_periodic_root_hashes() == 0, "periodic hashes should only be returned once")
+        reference:run(machine:read_mcycle())
+        assert(machine:get_root_hash() == reference:get_root_hash(), "root hash does not match after periodic hashes")
+    end
+)
+
+print("\n\n run machine with profiling")
+test_util.make_do_test(build_machine, machine_type, nil, { profile = { enabled = true, pc_sample_period = 100 } })(
+    "profile should count executed instructions without changing the machine state",
+    function(machine)
+        local reference <close> = build_machine(machine_type)
+        machine:write_mcycle(0)
+        reference:write_mcycle(0)
+        machine:run(1000)
+        reference:run(1000)
+        local profile = machine:get_profile()
+        local insn_total = 0
+        for _, c in ipairs(profile.insn_counts) do insn_total = insn_total + c.count end
+        assert(insn_total > 0 and insn_total <= 1000, "instruction counts do not add up")
+        local pair_total = 0
+        for _, c in ipairs(profile.insn_pair_counts) do pair_total = pair_total + c.count end
+        assert(pair_total == insn_total - 1, "instruction pair counts do not add up")
+        local sample_total = 0
+        for _, s in ipairs(profile.pc_samples) do sample_total = sample_total + s.count end
+        assert(sample_total == 10, "wrong number of pc samples")
+        assert(machine:get_root_hash() == reference:get_root_hash(), "root hash does not match after profiling")
+    end
+)
+
 print("\n\n check reading and writing htif registers")
 do_test("htif register values should match", function(machine)
     -- Check HTIF interface bindings
@@ -658,6 +738,102 @@ do_test("written and read values should match", function(machine)
     assert(memory_read == "mydataol12345678")
 end)
 
+print("\n\n check memory reading/writing with buffers")
+do_test("buffers should be read and written in place", function(machine)
+    local module = machine_type == "local" and cartesi or protocol
+    local buffer = module.new_buffer("mydataol12345678")
+    assert(#buffer == 0x10)
+    machine:write_memory(0x800000FF, buffer)
+    assert(machine:read_memory(0x800000FF, 0x10) == "mydataol12345678")
+    -- slices share the bytes of the buffer they were taken from
+    local slice = buffer:sub(3, 6)
+    assert(#slice == 4 and slice:tostring() == "data")
+    slice:set(1, "DATA")
+    assert(buffer:tostring() == "myDATAol12345678")
+    assert(buffer:tostring(-8) == "12345678")
+    assert(buffer:byte(3) == string.byte("D"))
+    -- reading into a buffer fills it and returns it
+    local read = module.new_buffer(8)
+    assert(machine:read_memory(0x80000107, read) == read)
+    assert(read:tostring() == "12345678")
+    machine:write_memory(0x80000107, slice)
+    machine:read_memory(0x80000107, read)
+    assert(read:tostring() == "DATA5678")
+    assert(read:keccak() == cartesi.keccak("DATA5678"))
+    assert(read:keccak(1, 4) == cartesi.keccak("DATA"))
+    local _, err = pcall(slice.set, slice, 2, "DATA")
+    assert(err:match("data does not fit in buffer"))
+    -- ranges follow string.sub, past the end, with negative positions and when i > j
+    local abc = module.new_buffer("abc")
+    for _, range in ipairs({ { 4 }, { 5 }, { 5, 10 }, { 2, 10 }, { 0 }, { -2 }, { -5 }, { 1, -2 }, { -2, -1 },
+        { -3, -2 }, { 1, -5 }, { 3, 2 }, { -1, -2 } }) do
+        local i, j = range[1], range[2]
+        local expected = string.sub("abc", i, j)
+        assert(abc:sub(i, j):tostring() == expected, string.format("sub(%d, %s)", i, tostring(j)))
+        assert(abc:tostring(i, j) == expected, string.format("tostring(%d, %s)", i, tostring(j)))
+        assert(abc:keccak(i, j) == cartesi.keccak(expected), string.format("keccak(%d, %s)", i, tostring(j)))
+    end
+end)
+
+print("\n\n check lazy logs and proofs")
+do_test("lazy logs and proofs should match eager ones", function(machine)
+    local module = cartesi
+    if machine_type ~= "local" then
+        if not remote then remote = connect() end
+        module = remote
+    end
+    local proof = machine:get_proof(cartesi.UARCH_STATE_START_ADDRESS, 12)
+    local lazy_proof = machine:get_proof(cartesi.UARCH_STATE_START_ADDRESS, 12, true)
+    assert(type(lazy_proof) == "userdata")
+    for _, field in ipairs({ "target_address", "log2_target_size", "log2_root_size", "root_hash", "target_hash" }) do
+        assert(lazy_proof[field] == proof[field], field)
+    end
+    assert(#lazy_proof.sibling_hashes == #proof.sibling_hashes)
+    for i, hash in ipairs(proof.sibling_hashes) do
+        assert(lazy_proof.sibling_hashes[i] == hash)
+    end
+    local log_type = { proofs = true, annotations = true }
+    local initial_hash = machine:get_root_hash()
+    local log = machine:log_uarch_step(log_type, true)
+    local final_hash = machine:get_root_hash()
+    assert(type(log) == "userdata")
+    assert(log.log_type.proofs and log.log_type.annotations)
+    assert(#log.accesses > 0 and log.accesses[1].type == "read")
+    assert(log.accesses[#log.accesses + 1] == nil)
+    assert(log.accesses[1] == log.accesses[1], "accesses should be converted once")
+    assert(#log.notes == #log.accesses and #log.brackets > 0)
+    -- lazy logs are accepted wherever a log is
+    module.machine.verify_uarch_step_state_transition(initial_hash, log, final_hash, {})
+    module.machine.verify_uarch_step_log(log, {})
+end)
+
+print("\n\n check vectored memory reads and writes")
+do_test("memory ranges should be read and written in a single call", function(machine)
+    local module = machine_type == "local" and cartesi or protocol
+    assert(machine:write_memory_ranges({
+        { address = 0x80000100, data = "first" },
+        { address = 0x80001FFE, data = "across" },
+        { address = 0x80000200, data = module.new_buffer("third") },
+    }))
+    assert(machine:read_memory(0x80001FFE, 6) == "across")
+    local buffer = module.new_buffer(5)
+    local chunks = machine:read_memory_ranges({
+        { address = 0x80000100, length = 5 },
+        { address = 0x80001FFE, length = 6 },
+        { address = 0x80000200, buffer = buffer },
+        { address = 0x80000100, length = 0 },
+    })
+    assert(#chunks == 4)
+    assert(chunks[1] == "first" and chunks[2] == "across" and chunks[4] == "")
+    assert(chunks[3] == buffer and buffer:tostring() == "third")
+    -- virtual memory is identity mapped while paging is off
+    assert(machine:write_virtual_memory_ranges({ { address = 0x80000300, data = "virtual" } }))
+    local virtual_chunks = machine:read_virtual_memory_ranges({ { address = 0x80000300, length = 7 } })
+    assert(virtual_chunks[1] == "virtual")
+    local _, err = pcall(machine.write_memory_ranges, machine, { { address = 0, data = "x" } })
+    assert(err:match("address range not entirely in memory PMA"))
+end)
+
 print("\n\n dump step log  to console")
 do_test("dumped step log content should match", function()
     -- Dump log and check values
@@ -978,6 +1154,40 @@ test_util.make_do_test(build_machine, machine_type, { uarch = test_reset_uarch_c
     end
 )
 
+test_util.make_do_test(build_machine, machine_type, { uarch = test_reset_uarch_config })(
+    "Testing verify_uarch_state_transitions",
+    function(machine)
+        local module = cartesi
+        if machine_type ~= "local" then module = remote end
+        local log_type = { proofs = true, annotations = false }
+        local transitions = {}
+        local root_hash = machine:get_root_hash()
+        for _, type in ipairs({ "step", "step", "reset", "step" }) do
+            local log
+            if type == "step" then
+                log = machine:log_uarch_step(log_type)
+            else
+                log = machine:log_uarch_reset(log_type)
+            end
+            local root_hash_after = machine:get_root_hash()
+            transitions[#transitions + 1] =
+                { type = type, root_hash_before = root_hash, log = log, root_hash_after = root_hash_after }
+            root_hash = root_hash_after
+        end
+        -- verify happy path
+        module.machine.verify_uarch_state_transitions(transitions, {})
+        -- verifying broken chain
+        transitions[2], transitions[3] = transitions[3], transitions[2]
+        local _, err = pcall(module.machine.verify_uarch_state_transitions, transitions, {})
+        assert(err:match("root hash before transition 2 does not match root hash after transition 1"))
+        transitions[2], transitions[3] = transitions[3], transitions[2]
+        -- verifying wrong transition type
+        transitions[3].type = "step"
+        _, err = pcall(module.machine.verify_uarch_state_transitions, transitions, {})
+        assert(err:match("transition 3: "))
+    end
+)
+
 test_util.make_do_test(build_machine, machine_type, { uarch = test_reset_uarch_config })(
     "Dump of log produced by log_uarch_reset should match",
     function(machine)
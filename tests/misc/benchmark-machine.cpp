@@ -0,0 +1,957 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <base64.h>
+#include <json-util.h>
+#include <machine-bisector.h>
+#include <machine-c-api.h>
+#include <machine-merkle-tree.h>
+#include <machine.h>
+#include <os.h>
+#include <pma-constants.h>
+#include <riscv-constants.h>
+
+using namespace cartesi;
+
+namespace {
+
+/// \brief Result of a benchmark, kept for the machine-readable report
+struct benchmark_result {
+    std::string name;    ///< Benchmark name
+    double value;        ///< Median time per iteration in nanoseconds, or the value of a metric
+    std::string unit;    ///< Unit of value
+    uint64_t iterations; ///< Number of timed iterations (0 for metrics)
+    double min;          ///< Fastest iteration, in nanoseconds
+    double stddev;       ///< Standard deviation of iterations, in nanoseconds
+};
+
+/// \brief Results of all benchmarks run so far
+std::vector<benchmark_result> results; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// \brief Runs a benchmark for a fixed number of iterations and prints the time per iteration
+/// \param name Benchmark name.
+/// \param iterations Number of times to call f.
+/// \param f Function to benchmark.
+/// \param setup Function called before each call to f, and excluded from the timing.
+/// \returns Median time per iteration, in nanoseconds.
+/// \details Each iteration is timed separately, so the median is not skewed by the occasional preempted iteration.
+double run_benchmark(const std::string &name, uint64_t iterations, const std::function<void()> &f,
+    const std::function<void()> &setup = {}) {
+    if (setup) {
+        setup();
+    }
+    f(); // Warm up
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        if (setup) {
+            setup();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    const double median = n % 2 != 0 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+    double variance = 0;
+    for (const double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    const double stddev = std::sqrt(variance / static_cast<double>(n));
+    (void) fprintf(stdout, "%-48s %14.1f ns/iter %10" PRIu64 " iters (min %.1f, stddev %.1f%%)\n", name.c_str(),
+        median, iterations, samples.front(), 100.0 * stddev / mean);
+    results.push_back({name, median, "ns/iter", iterations, samples.front(), stddev});
+    return median;
+}
+
+/// \brief Prints a value measured by a benchmark other than time
+void print_metric(const std::string &name, uint64_t value, const char *unit) {
+    (void) fprintf(stdout, "%-48s %14" PRIu64 " %s\n", name.c_str(), value, unit);
+    results.push_back({name, static_cast<double>(value), unit, 0, 0, 0});
+}
+
+/// \brief Writes the results of all benchmarks run so far as JSON
+void write_results(const std::string &filename) {
+    auto j = nlohmann::json::array();
+    for (const auto &r : results) {
+        j.push_back({{"name", r.name}, {"value", r.value}, {"unit", r.unit}, {"iterations", r.iterations},
+            {"min", r.min}, {"stddev", r.stddev}});
+    }
+    std::ofstream ofs(filename);
+    ofs << j.dump(2) << '\n';
+    if (!ofs) {
+        throw std::runtime_error("unable to write results to '" + filename + "'");
+    }
+}
+
+/// \brief Reference implementation of a parallel for that spawns one thread per task, for comparison
+bool parallel_for_async(uint64_t n, const std::function<bool(uint64_t j)> &task) {
+    std::vector<std::future<bool>> futures;
+    futures.reserve(n);
+    for (uint64_t j = 0; j < n; ++j) {
+        futures.emplace_back(std::async(std::launch::async, task, j));
+    }
+    bool succeeded = true;
+    for (auto &f : futures) {
+        succeeded = f.get() && succeeded;
+    }
+    return succeeded;
+}
+
+void benchmark_parallel_for() {
+    const uint64_t n = std::max(os_get_concurrency(), UINT64_C(2));
+    std::atomic<uint64_t> sink{0};
+    for (const uint64_t items : {UINT64_C(16), UINT64_C(1024), UINT64_C(65536)}) {
+        const auto work = [&sink](uint64_t first, uint64_t last) {
+            uint64_t sum = 0;
+            for (uint64_t i = first; i < last; ++i) {
+                sum += i * i;
+            }
+            sink += sum;
+        };
+        run_benchmark("parallel_for/async/" + std::to_string(items), 2000, [&] {
+            parallel_for_async(n, [&](uint64_t j) {
+                work(j * items / n, (j + 1) * items / n);
+                return true;
+            });
+        });
+        run_benchmark("parallel_for/pool/" + std::to_string(items), 2000, [&] {
+            os_parallel_for_range(n, 0, items, std::max(items / (n * 8), UINT64_C(1)),
+                [&](uint64_t first, uint64_t last, const parallel_for_mutex & /*mutex*/) {
+                    work(first, last);
+                    return true;
+                });
+        });
+    }
+}
+
+void benchmark_merkle_tree_zeroing() {
+    using hash_type = machine_merkle_tree::hash_type;
+    constexpr uint64_t log2_range_size = 25;
+    constexpr uint64_t range_pages = (UINT64_C(1) << log2_range_size) >> machine_merkle_tree::get_log2_page_size();
+    const std::string suffix = "/" + std::to_string((UINT64_C(1) << log2_range_size) >> 20) + "MiB";
+    // Tree alone: pages set to a non-pristine hash, then all back to pristine
+    {
+        machine_merkle_tree t;
+        machine_merkle_tree::hasher_type h;
+        hash_type dirty{};
+        dirty.fill(0xff);
+        const auto fill_with = [&](const hash_type &hash) {
+            t.begin_update();
+            for (uint64_t i = 0; i < range_pages; ++i) {
+                t.update_page_node_hash(PMA_RAM_START + (i << machine_merkle_tree::get_log2_page_size()), hash);
+            }
+            t.end_update(h);
+        };
+        fill_with(dirty);
+        print_metric("merkle_tree/nodes_before_zeroing" + suffix, t.get_node_count(), "nodes");
+        fill_with(machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size()));
+        print_metric("merkle_tree/nodes_after_zeroing" + suffix, t.get_node_count(), "nodes");
+        run_benchmark(
+            "merkle_tree/update_zeroed_pages" + suffix, 20,
+            [&] { fill_with(machine_merkle_tree::get_pristine_hash(machine_merkle_tree::get_log2_page_size())); },
+            [&] { fill_with(dirty); });
+    }
+    // Whole machine: range written and hashed, then zeroed and hashed again
+    {
+        auto config = machine::get_default_config();
+        config.ram.length = UINT64_C(2) << log2_range_size;
+        machine m(config);
+        const std::vector<unsigned char> ones(UINT64_C(1) << log2_range_size, 0xff);
+        const std::vector<unsigned char> zeros(UINT64_C(1) << log2_range_size, 0);
+        hash_type hash;
+        run_benchmark(
+            "machine/root_hash_after_zeroing" + suffix, 20,
+            [&] {
+                m.write_memory(PMA_RAM_START, zeros.data(), zeros.size());
+                m.get_root_hash(hash);
+            },
+            [&] {
+                m.write_memory(PMA_RAM_START, ones.data(), ones.size());
+                m.get_root_hash(hash);
+            });
+        run_benchmark("machine/proof_in_zeroed_range" + suffix, 100,
+            [&] { (void) m.get_proof(PMA_RAM_START, machine_merkle_tree::get_log2_word_size()); });
+    }
+}
+
+void benchmark_page_proofs() {
+    using hash_type = machine_merkle_tree::hash_type;
+    std::vector<unsigned char> page(machine_merkle_tree::get_page_size());
+    for (size_t i = 0; i < page.size(); ++i) {
+        page[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    constexpr uint64_t page_index = PMA_RAM_START;
+    for (const size_t capacity : {size_t{0}, size_t{32}}) {
+        const std::string suffix = capacity != 0 ? "/cached" : "/uncached";
+        machine_merkle_tree t;
+        t.set_page_hash_cache_capacity(capacity);
+        machine_merkle_tree::hasher_type h;
+        hash_type hash;
+        t.get_cached_page_node_hash(h, page_index, page.data(), hash);
+        t.begin_update();
+        t.update_page_node_hash(page_index, hash);
+        t.end_update(h);
+        uint64_t word = 0;
+        run_benchmark("page_proofs/word_proof" + suffix, 10000, [&] {
+            word = (word + 7) % (machine_merkle_tree::get_page_size() / machine_merkle_tree::get_word_size());
+            (void) t.get_proof(page_index + word * machine_merkle_tree::get_word_size(),
+                machine_merkle_tree::get_log2_word_size(), page.data());
+        });
+        run_benchmark("page_proofs/word_write_and_update" + suffix, 10000, [&] {
+            word = (word + 7) % (machine_merkle_tree::get_page_size() / machine_merkle_tree::get_word_size());
+            ++page[word * machine_merkle_tree::get_word_size()];
+            t.get_cached_page_node_hash(h, page_index, page.data(), hash);
+            t.begin_update();
+            t.update_page_node_hash(page_index, hash);
+            t.end_update(h);
+        });
+    }
+}
+
+void benchmark_multi_proofs() {
+    using hash_type = machine_merkle_tree::hash_type;
+    constexpr uint64_t target_count = 256;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 24;
+    machine m(config);
+    std::vector<unsigned char> data(config.ram.length);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    m.write_memory(PMA_RAM_START, data.data(), data.size());
+    hash_type hash;
+    m.get_root_hash(hash);
+    // Same number of words, spread over more and more pages
+    for (const uint64_t pages : {UINT64_C(1), UINT64_C(16), UINT64_C(256)}) {
+        const std::string suffix = "/" + std::to_string(pages) + "pages";
+        machine_merkle_tree::multi_proof_type::targets_type targets;
+        for (uint64_t j = 0; j < target_count; ++j) {
+            targets.push_back({PMA_RAM_START + (j % pages) * PMA_PAGE_SIZE + (j / pages) * sizeof(uint64_t),
+                machine_merkle_tree::get_log2_word_size()});
+        }
+        uint64_t single_hashes = 0;
+        for (const auto &target : targets) {
+            single_hashes += m.get_proof(target.address, target.log2_size).get_sibling_hashes().size();
+        }
+        print_metric("multi_proof/single_siblings" + suffix, single_hashes, "hashes");
+        print_metric("multi_proof/multi_siblings" + suffix,
+            m.get_multi_proof(targets).get_sibling_hashes().size(), "hashes");
+        run_benchmark("multi_proof/single_proofs" + suffix, 20, [&] {
+            for (const auto &target : targets) {
+                (void) m.get_proof(target.address, target.log2_size);
+            }
+        });
+        run_benchmark("multi_proof/multi_proof" + suffix, 20, [&] { (void) m.get_multi_proof(targets); });
+    }
+}
+
+/// \brief Program that writes an increasing counter to the first word of 256 pages, in round robin
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t page_writer_program[] = {
+    0x00010117, // auipc x2, 0x10
+    0x03809193, // loop: slli x3, x1, 56
+    0x02c1d193, // srli x3, x3, 44
+    0x00310233, // add x4, x2, x3
+    0x00123023, // sd x1, 0(x4)
+    0x00108093, // addi x1, x1, 1
+    0xfedff06f, // j loop
+};
+
+void benchmark_periodic_hashes() {
+    using hash_type = machine_merkle_tree::hash_type;
+    constexpr uint64_t period = 100000;
+    constexpr uint64_t mcycle_end = 10 * period;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    config.processor.pc = PMA_RAM_START;
+    const auto *program = reinterpret_cast<const unsigned char *>(page_writer_program);
+    // Stopping at each period to hash, as the cartesi-machine.lua --periodic-hashes option used to do
+    run_benchmark("periodic_hashes/stop_and_hash", 5, [&] {
+        machine m(config);
+        m.write_memory(PMA_RAM_START, program, sizeof(page_writer_program));
+        hash_type hash;
+        for (uint64_t mcycle = period; mcycle <= mcycle_end; mcycle += period) {
+            m.run(mcycle);
+            m.get_root_hash(hash);
+        }
+    });
+    // Hashing in the background while the machine runs
+    machine_runtime_config runtime;
+    runtime.periodic_hashes.period = period;
+    run_benchmark("periodic_hashes/native", 5, [&] {
+        machine m(config, runtime);
+        m.write_memory(PMA_RAM_START, program, sizeof(page_writer_program));
+        m.run(mcycle_end);
+        (void) m.get_periodic_root_hashes();
+    });
+}
+
+void benchmark_profile() {
+    constexpr uint64_t mcycle_end = 1000000;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    config.processor.pc = PMA_RAM_START;
+    const auto *program = reinterpret_cast<const unsigned char *>(page_writer_program);
+    // Profiling disabled, so the cost of the checks left in the interpreter shows up in the comparison
+    run_benchmark("profile/disabled", 5, [&] {
+        machine m(config);
+        m.write_memory(PMA_RAM_START, program, sizeof(page_writer_program));
+        m.run(mcycle_end);
+    });
+    machine_runtime_config runtime;
+    runtime.profile.enabled = true;
+    runtime.profile.pc_sample_period = 1000;
+    run_benchmark("profile/enabled", 5, [&] {
+        machine m(config, runtime);
+        m.write_memory(PMA_RAM_START, program, sizeof(page_writer_program));
+        m.run(mcycle_end);
+        (void) m.get_profile();
+    });
+}
+
+/// \brief Program that loops over the instruction idioms fused by the interpreter, starting at offset 0x10
+/// \details The code before the loop is a trap handler that skips the faulting load at the end of the loop.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t idiom_program[] = {
+    0x34102ff3, // csrr t6, mepc
+    0x004f8f93, // addi t6, t6, 4
+    0x341f9073, // csrw mepc, t6
+    0x30200073, // mret
+    0x00000297, // auipc t0, 0
+    0x10028293, // addi t0, t0, 256
+    0x00001337, // lui t1, 1
+    0xffd3031b, // addiw t1, t1, -3
+    0x00000397, // auipc t2, 0
+    0x2003be03, // ld t3, 512(t2)
+    0x001e0e13, // addi t3, t3, 1
+    0x00000397, // auipc t2, 0
+    0x1fc3ba23, // sd t3, 500(t2)
+    0x005e3e93, // sltiu t4, t3, 5
+    0x000e9463, // bnez t4, 8
+    0x00150513, // addi a0, a0, 1
+    0x00652f33, // slt t5, a0, t1
+    0x01e00463, // beqz t5, 8
+    0x00768693, // addi a3, a3, 7
+    0x15fd4595, // c.li a1, 5; c.addi a1, -1
+    0x4401fdfd, // c.bnez a1, -2; c.li s0, 0
+    0x0625c011, // c.beqz s0, 4; c.addi a2, 9
+    0x00000297, // auipc t0, 0
+    0x00828067, // jr 8(t0)
+    0xfff00fb7, // lui t6, 0xfff00
+    0x000fbf83, // ld t6, 0(t6)
+    0xfa9ff06f, // j start
+};
+
+void benchmark_insn_fusion() {
+    constexpr uint64_t mcycle_end = 10000000;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    config.processor.pc = PMA_RAM_START + 0x10;
+    config.processor.mtvec = PMA_RAM_START;
+    const auto *program = reinterpret_cast<const unsigned char *>(idiom_program);
+    // Build with insn_fusion=no for the baseline
+    run_benchmark("insn_fusion/idioms", 5, [&] {
+        machine m(config);
+        m.write_memory(PMA_RAM_START, program, sizeof(idiom_program));
+        m.run(mcycle_end);
+    });
+    const auto *writer = reinterpret_cast<const unsigned char *>(page_writer_program);
+    config.processor.pc = PMA_RAM_START;
+    run_benchmark("insn_fusion/page_writer", 5, [&] {
+        machine m(config);
+        m.write_memory(PMA_RAM_START, writer, sizeof(page_writer_program));
+        m.run(mcycle_end);
+    });
+}
+
+/// \brief Program that loops over double precision floating-point arithmetic, starting at offset 0
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t float_program[] = {
+    0x00300293, // li t0, 3
+    0xd222f053, // fcvt.d.l ft0, t0
+    0x0200f0d3, // loop: fadd.d ft1, ft1, ft0
+    0x1210f153, // fmul.d ft2, ft1, ft1
+    0x1a1171d3, // fdiv.d ft3, ft2, ft1
+    0x5a01f253, // fsqrt.d ft4, ft3
+    0x1a20f2c3, // fmadd.d ft5, ft1, ft2, ft3
+    0x0a42f353, // fsub.d ft6, ft5, ft4
+    0xa210a353, // feq.d t1, ft1, ft1
+    0xfe5ff06f, // j loop
+};
+
+/// \brief Program that writes an increasing counter to the first word of 1024 pages, in round robin
+/// \details Touches more pages than the TLB holds, so every write walks the page table when paging is enabled.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t page_walker_program[] = {
+    0x00010117, // auipc x2, 0x10
+    0x03609193, // loop: slli x3, x1, 54
+    0x02a1d193, // srli x3, x3, 42
+    0x00310233, // add x4, x2, x3
+    0x00123023, // sd x1, 0(x4)
+    0x00108093, // addi x1, x1, 1
+    0xfedff06f, // j loop
+};
+
+/// \brief Runs a program from the start of RAM for a fixed number of mcycles and prints the interpreter speed
+/// \param name Benchmark name.
+/// \param config Machine configuration, with the processor ready to run the program.
+/// \param program Program to copy to the start of RAM.
+/// \param length Program length in bytes.
+/// \param prepare Function called on each new machine before running it, and excluded from the timing.
+void benchmark_program(const std::string &name, const machine_config &config, const uint32_t *program,
+    size_t length, const std::function<void(machine &m)> &prepare = {}) {
+    constexpr uint64_t mcycle_end = 10000000;
+    std::unique_ptr<machine> m;
+    const double ns = run_benchmark(
+        name, 5, [&] { m->run(mcycle_end); },
+        [&] {
+            m = std::make_unique<machine>(config);
+            m->write_memory(PMA_RAM_START, reinterpret_cast<const unsigned char *>(program), length);
+            if (prepare) {
+                prepare(*m);
+            }
+        });
+    print_metric(name + "/mips", static_cast<uint64_t>(static_cast<double>(mcycle_end) * 1000.0 / ns), "MIPS");
+}
+
+void benchmark_interpret() {
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 23;
+    config.processor.pc = PMA_RAM_START + 0x10;
+    config.processor.mtvec = PMA_RAM_START;
+    benchmark_program("interpret/integer", config, idiom_program, sizeof(idiom_program));
+    config.processor.pc = PMA_RAM_START;
+    config.processor.mstatus |= MSTATUS_FS_INITIAL;
+    benchmark_program("interpret/float", config, float_program, sizeof(float_program));
+    config.processor.mstatus &= ~MSTATUS_FS_MASK;
+    benchmark_program("interpret/page_walker/bare", config, page_walker_program, sizeof(page_walker_program));
+    // Supervisor mode with Sv39, with RAM identity mapped by a gigapage
+    constexpr uint64_t page_table = PMA_RAM_START + (UINT64_C(6) << 20);
+    config.processor.iflags = (static_cast<uint64_t>(PRV_S) << IFLAGS_PRV_SHIFT);
+    config.processor.satp = (static_cast<uint64_t>(SATP_MODE_SV39) << SATP_MODE_SHIFT) | (page_table >> LOG2_PAGE_SIZE);
+    const auto map_ram = [&](machine &m) {
+        const uint64_t pte = ((PMA_RAM_START >> LOG2_PAGE_SIZE) << PTE_PPN_SHIFT) | PTE_V_MASK | PTE_R_MASK |
+            PTE_W_MASK | PTE_X_MASK | PTE_A_MASK | PTE_D_MASK;
+        m.write_memory(page_table + (PMA_RAM_START >> 30) * sizeof(uint64_t),
+            reinterpret_cast<const unsigned char *>(&pte), sizeof(pte));
+    };
+    // The 256 pages touched by the page writer fit in the TLB, while the 1024 pages touched by the page walker do not
+    benchmark_program("interpret/page_writer/sv39", config, page_writer_program, sizeof(page_writer_program), map_ram);
+    benchmark_program("interpret/page_walker/sv39", config, page_walker_program, sizeof(page_walker_program),
+        map_ram);
+}
+
+/// \brief Microarchitecture program that loads and stores machine registers 100000 times, then halts
+/// \details Most of its accesses go through the shadow state, like those of the microarchitecture interpreter.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t uarch_register_program[] = {
+    0x00018437, // lui s0, 0x18
+    0x6a040413, // addi s0, s0, 0x6a0
+    0x05003283, // loop: ld t0, 0x50(zero)
+    0x11803303, // ld t1, 0x118(zero)
+    0x22803383, // ld t2, 0x228(zero)
+    0x22703423, // sd t2, 0x228(zero)
+    0x2e803383, // ld t2, 0x2e8(zero)
+    0x00020e37, // lui t3, 0x20
+    0x000e3e83, // ld t4, 0(t3)
+    0x00010f37, // lui t5, 0x10
+    0x008f3f83, // ld t6, 8(t5)
+    0x04503823, // sd t0, 0x50(zero)
+    0xfff40413, // addi s0, s0, -1
+    0xfc041ae3, // bnez s0, loop
+    0x00100893, // li a7, 1
+    0x00000073, // ecall
+};
+
+/// \brief Microarchitecture program that loops 100000 times over integer arithmetic, branches and stack accesses,
+/// then halts
+/// \details Its mix resembles the compiled interpreter more than uarch_register_program does, so it shows the
+/// cost of fetching and decoding uarch instructions. Build with uarch_insn_cache=no for the baseline.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+constexpr uint32_t uarch_compute_program[] = {
+    0x00018437, // lui s0, 0x18
+    0x6a040413, // addi s0, s0, 0x6a0
+    0x00601137, // lui sp, 0x601
+    0x00000513, // li a0, 0
+    0x00100593, // li a1, 1
+    0x00b50633, // loop: add a2, a0, a1
+    0x008646b3, // xor a3, a2, s0
+    0x00369713, // slli a4, a3, 3
+    0x00275793, // srli a5, a4, 2
+    0x00c7f833, // and a6, a5, a2
+    0x00b86533, // or a0, a6, a1
+    0x00a13023, // sd a0, 0(sp)
+    0x00013583, // ld a1, 0(sp)
+    0x00b532b3, // sltu t0, a0, a1
+    0x00028463, // beqz t0, skip
+    0x00158593, // addi a1, a1, 1
+    0xfff40413, // skip: addi s0, s0, -1
+    0xfc0418e3, // bnez s0, loop
+    0x00100893, // li a7, 1
+    0x00000073, // ecall
+};
+
+void benchmark_uarch() {
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    config.processor.pc = PMA_RAM_START + 0x10;
+    config.processor.mtvec = PMA_RAM_START;
+    const auto run_uarch_program = [&](const std::string &name, const uint32_t *program, size_t length) {
+        const auto image = std::filesystem::temp_directory_path() / ("benchmark-" + name + ".bin");
+        std::ofstream(image, std::ios::binary).write(reinterpret_cast<const char *>(program), length);
+        auto uarch_config = config;
+        uarch_config.uarch.ram.image_filename = image.string();
+        std::unique_ptr<machine> m;
+        run_benchmark(
+            "uarch/run_" + name, 20, [&] { m->run_uarch(UINT64_MAX); },
+            [&] { m = std::make_unique<machine>(uarch_config); });
+        print_metric("uarch/run_" + name + "/cycles", m->read_uarch_cycle(), "cycles");
+        std::filesystem::remove(image);
+    };
+    run_uarch_program("registers", uarch_register_program, sizeof(uarch_register_program));
+    run_uarch_program("compute", uarch_compute_program, sizeof(uarch_compute_program));
+    machine m(config);
+    m.write_memory(PMA_RAM_START, reinterpret_cast<const unsigned char *>(idiom_program), sizeof(idiom_program));
+    // Each iteration advances the machine by a single mcycle through the microarchitecture
+    run_benchmark("uarch/run_mcycle", 1000, [&] {
+        m.run_uarch(UINT64_MAX);
+        m.reset_uarch();
+    });
+    m.run_uarch(UINT64_MAX);
+    print_metric("uarch/run_mcycle/cycles", m.read_uarch_cycle(), "cycles");
+    m.reset_uarch();
+    // Times only the reset that follows each mcycle, which restores the uarch RAM pages written during it
+    run_benchmark("uarch/reset", 1000, [&] { m.reset_uarch(); }, [&] { m.run_uarch(UINT64_MAX); });
+    const access_log::type log_type(true, false);
+    const auto restart_if_halted = [&] {
+        if (m.read_uarch_halt_flag()) {
+            m.reset_uarch();
+        }
+    };
+    run_benchmark("uarch/log_step_with_proofs", 1000, [&] { (void) m.log_uarch_step(log_type); }, restart_if_halted);
+    restart_if_halted();
+    const auto log = m.log_uarch_step(log_type);
+    run_benchmark("uarch/verify_step_log", 1000, [&] { machine::verify_uarch_step_log(log); });
+    run_benchmark("uarch/log_reset_with_proofs", 20, [&] { (void) m.log_uarch_reset(log_type); });
+}
+
+void benchmark_verify_uarch_state_transitions() {
+    constexpr uint64_t steps = 10000;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    const auto image = std::filesystem::temp_directory_path() / "benchmark-uarch-registers.bin";
+    std::ofstream(image, std::ios::binary)
+        .write(reinterpret_cast<const char *>(uarch_register_program), sizeof(uarch_register_program));
+    config.uarch.ram.image_filename = image.string();
+    machine m(config);
+    std::filesystem::remove(image);
+    const access_log::type log_type(true, false);
+    uarch_state_transitions transitions;
+    transitions.reserve(steps);
+    machine::hash_type root_hash;
+    m.get_root_hash(root_hash);
+    for (uint64_t i = 0; i < steps; ++i) {
+        uarch_state_transition t;
+        t.root_hash_before = root_hash;
+        t.log = m.log_uarch_step(log_type);
+        m.get_root_hash(root_hash);
+        t.root_hash_after = root_hash;
+        transitions.push_back(std::move(t));
+    }
+    // Verifying the transitions one at a time is the baseline for the batch verification
+    run_benchmark("verify_uarch_state_transitions/10k_steps/one_at_a_time", 1, [&] {
+        for (const auto &t : transitions) {
+            machine::verify_uarch_step_state_transition(t.root_hash_before, t.log, t.root_hash_after);
+        }
+    });
+    std::vector<uint64_t> thread_counts{1};
+    if (os_get_concurrency() > 1) {
+        thread_counts.push_back(os_get_concurrency());
+    }
+    for (const uint64_t threads : thread_counts) {
+        machine_runtime_config runtime;
+        runtime.concurrency.verify_uarch_state_transitions = threads;
+        run_benchmark("verify_uarch_state_transitions/10k_steps/batch/" + std::to_string(threads) + "_threads", 1,
+            [&] { machine::verify_uarch_state_transitions(transitions, runtime); });
+    }
+}
+
+void benchmark_find_pma_entry() {
+    constexpr uint64_t lookups = 1000;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    const machine m(config);
+    const std::vector<std::pair<std::string, uint64_t>> addresses{
+        {"ram", PMA_RAM_START + config.ram.length / 2},
+        {"shadow_state", PMA_SHADOW_STATE_START},
+        {"clint", PMA_CLINT_START},
+        {"htif", PMA_HTIF_START},
+        {"unmapped", UINT64_C(1) << 50},
+    };
+    for (const auto &[range, address] : addresses) {
+        run_benchmark("find_pma_entry/" + range + "/" + std::to_string(lookups) + "_lookups", 10000, [&] {
+            for (uint64_t i = 0; i < lookups; ++i) {
+                (void) m.find_pma_entry<uint64_t>(address + (i & 7) * sizeof(uint64_t));
+            }
+        });
+    }
+}
+
+void benchmark_page_hashing() {
+    using hash_type = machine_merkle_tree::hash_type;
+    std::vector<unsigned char> page(machine_merkle_tree::get_page_size());
+    for (size_t i = 0; i < page.size(); ++i) {
+        page[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    const machine_merkle_tree t;
+    machine_merkle_tree::hasher_type h;
+    hash_type hash;
+    run_benchmark("page_hashing/page", 10000, [&] {
+        ++page[0];
+        t.get_page_node_hash(h, page.data(), hash);
+    });
+    std::fill(page.begin(), page.end(), 0);
+    run_benchmark("page_hashing/pristine_page", 10000, [&] { t.get_page_node_hash(h, page.data(), hash); });
+}
+
+void benchmark_update_merkle_tree() {
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 23;
+    machine m(config);
+    const uint64_t pages = config.ram.length >> LOG2_PAGE_SIZE;
+    (void) m.update_merkle_tree();
+    unsigned char value = 0;
+    // One in every stride pages of RAM is written before each update
+    for (const uint64_t stride : {UINT64_C(256), UINT64_C(16), UINT64_C(1)}) {
+        const std::string suffix = "/" + std::to_string(pages / stride) + "_of_" + std::to_string(pages) + "_pages";
+        run_benchmark(
+            "update_merkle_tree" + suffix, 5, [&] { (void) m.update_merkle_tree(); },
+            [&] {
+                ++value;
+                for (uint64_t page = 0; page < pages; page += stride) {
+                    m.write_memory(PMA_RAM_START + (page << LOG2_PAGE_SIZE), &value, sizeof(value));
+                }
+            });
+    }
+}
+
+void benchmark_get_proof() {
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 24;
+    machine m(config);
+    std::vector<unsigned char> data(config.ram.length);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    m.write_memory(PMA_RAM_START, data.data(), data.size());
+    (void) m.update_merkle_tree();
+    uint64_t word = 0;
+    for (const int log2_size : {machine_merkle_tree::get_log2_word_size(), machine_merkle_tree::get_log2_page_size(),
+             machine_merkle_tree::get_log2_root_size()}) {
+        run_benchmark("get_proof/log2_size_" + std::to_string(log2_size), 1000, [&] {
+            word = (word + 4099) % (config.ram.length / sizeof(uint64_t));
+            const uint64_t address = log2_size == machine_merkle_tree::get_log2_root_size() ?
+                0 :
+                (PMA_RAM_START + word * sizeof(uint64_t)) & ~((UINT64_C(1) << log2_size) - 1);
+            (void) m.get_proof(address, log2_size, skip_merkle_tree_update);
+        });
+    }
+}
+
+void benchmark_access_log_json() {
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    machine m(config);
+    // Resetting the microarchitecture logs a write with its proof
+    const auto log = m.log_uarch_reset(access_log::type(true, true));
+    std::string serialized;
+    run_benchmark("access_log_json/serialize", 100, [&] {
+        nlohmann::json j;
+        to_json(j, log);
+        serialized = j.dump();
+    });
+    print_metric("access_log_json/size", serialized.size(), "bytes");
+    run_benchmark("access_log_json/parse", 100, [&] {
+        const auto j = nlohmann::json{{"log", nlohmann::json::parse(serialized)}};
+        not_default_constructible<access_log> parsed;
+        ju_get_opt_field(j, "log"s, parsed);
+    });
+}
+
+/// \brief Throws if a C API call failed
+void check_c_api(int error_code, char **err_msg) {
+    if (error_code != CM_ERROR_OK) {
+        const std::string what = *err_msg != nullptr ? *err_msg : "unknown error";
+        cm_delete_cstring(*err_msg);
+        throw std::runtime_error(what);
+    }
+}
+
+void benchmark_c_api_accessors() {
+    char *err_msg{};
+    const cm_machine_config *default_config{};
+    check_c_api(cm_get_default_config(&default_config, &err_msg), &err_msg);
+    cm_machine_config config = *default_config;
+    config.ram.length = UINT64_C(1) << 22;
+    const auto image = std::filesystem::temp_directory_path() / "benchmark-uarch-registers.bin";
+    std::ofstream(image, std::ios::binary)
+        .write(reinterpret_cast<const char *>(uarch_register_program), sizeof(uarch_register_program));
+    const std::string image_filename = image.string();
+    config.uarch.ram.image_filename = image_filename.c_str();
+    cm_machine_runtime_config runtime{};
+    cm_machine *m{};
+    check_c_api(cm_create_machine(&config, &runtime, &m, &err_msg), &err_msg);
+    cm_delete_machine_config(default_config);
+    std::filesystem::remove(image);
+    // Polling loop of an orchestrator that watches a few CSRs
+    constexpr std::array<CM_PROC_CSR, 4> csrs{CM_PROC_MCYCLE, CM_PROC_IFLAGS, CM_PROC_HTIF_TOHOST,
+        CM_PROC_HTIF_FROMHOST};
+    std::array<uint64_t, csrs.size()> vals{};
+    run_benchmark("c_api/read_csr_x4", 10000, [&] {
+        for (size_t i = 0; i < csrs.size(); ++i) {
+            check_c_api(cm_read_csr(m, csrs[i], &vals[i], &err_msg), &err_msg);
+        }
+    });
+    run_benchmark("c_api/read_csrs_x4", 10000,
+        [&] { check_c_api(cm_read_csrs(m, csrs.data(), vals.data(), csrs.size(), &err_msg), &err_msg); });
+    cm_processor_config state{};
+    run_benchmark("c_api/read_processor_state", 10000,
+        [&] { check_c_api(cm_read_processor_state(m, &state, &err_msg), &err_msg); });
+    run_benchmark("c_api/get_proof", 100, [&] {
+        cm_merkle_tree_proof *proof{};
+        check_c_api(cm_get_proof(m, PMA_RAM_START, 3, &proof, &err_msg), &err_msg);
+        cm_delete_merkle_tree_proof(proof);
+    });
+    std::array<cm_hash, 64> siblings{};
+    run_benchmark("c_api/get_proof_into", 100, [&] {
+        cm_merkle_tree_proof proof{};
+        proof.sibling_hashes.entry = siblings.data();
+        proof.sibling_hashes.count = siblings.size();
+        check_c_api(cm_get_proof_into(m, PMA_RAM_START, 3, &proof, &err_msg), &err_msg);
+    });
+    const cm_access_log_type log_type{true, false, false};
+    const auto restart_if_halted = [&] {
+        bool halted{};
+        check_c_api(cm_read_uarch_halt_flag(m, &halted, &err_msg), &err_msg);
+        if (halted) {
+            check_c_api(cm_reset_uarch(m, &err_msg), &err_msg);
+        }
+    };
+    run_benchmark(
+        "c_api/log_uarch_step", 100,
+        [&] {
+            cm_access_log *log{};
+            check_c_api(cm_log_uarch_step(m, log_type, false, &log, &err_msg), &err_msg);
+            cm_delete_access_log(log);
+        },
+        restart_if_halted);
+    cm_access_log_buffer *buffer{};
+    check_c_api(cm_new_access_log_buffer(&buffer, &err_msg), &err_msg);
+    run_benchmark(
+        "c_api/log_uarch_step_into", 100,
+        [&] {
+            const cm_access_log *log{};
+            check_c_api(cm_log_uarch_step_into(m, log_type, false, buffer, &log, &err_msg), &err_msg);
+        },
+        restart_if_halted);
+    cm_delete_access_log_buffer(buffer);
+    cm_delete_machine(m);
+}
+
+void benchmark_memory_ranges() {
+    char *err_msg{};
+    const cm_machine_config *default_config{};
+    check_c_api(cm_get_default_config(&default_config, &err_msg), &err_msg);
+    cm_machine_config config = *default_config;
+    config.ram.length = UINT64_C(1) << 22;
+    cm_machine_runtime_config runtime{};
+    cm_machine *m{};
+    check_c_api(cm_create_machine(&config, &runtime, &m, &err_msg), &err_msg);
+    cm_delete_machine_config(default_config);
+    // A monitor collecting 1000 hash-sized chunks scattered across RAM
+    constexpr size_t count = 1000;
+    constexpr uint64_t length = 32;
+    std::vector<unsigned char> data(count * length);
+    std::vector<cm_memory_range_read> ranges(count);
+    memory_range_reads cpp_ranges(count);
+    for (size_t i = 0; i < count; ++i) {
+        ranges[i] = {PMA_RAM_START + i * 4096 + (i % 64) * length, data.data() + i * length, length};
+        cpp_ranges[i] = {ranges[i].address, ranges[i].data, ranges[i].length};
+    }
+    run_benchmark("memory_ranges/read_memory_x1000", 100, [&] {
+        for (const auto &r : ranges) {
+            check_c_api(cm_read_memory(m, r.address, r.data, r.length, &err_msg), &err_msg);
+        }
+    });
+    run_benchmark("memory_ranges/read_memory_ranges_1000", 100,
+        [&] { check_c_api(cm_read_memory_ranges(m, ranges.data(), ranges.size(), &err_msg), &err_msg); });
+    cm_delete_machine(m);
+    // Messages a remote machine exchanges for the same reads, encoded and decoded on both ends.
+    // Each message also costs a network round trip, which is not measured here.
+    run_benchmark("memory_ranges/jsonrpc_read_memory_x1000", 10, [&] {
+        for (const auto &r : cpp_ranges) {
+            const auto request = nlohmann::json{{"address", r.address}, {"length", r.length}}.dump();
+            const auto params = nlohmann::json::parse(request);
+            uint64_t address{};
+            uint64_t request_length{};
+            ju_get_field(params, "address"s, address);
+            ju_get_field(params, "length"s, request_length);
+            const auto response = nlohmann::json{{"result", encode_base64(r.data, request_length)}}.dump();
+            const auto bin = decode_base64(nlohmann::json::parse(response)["result"].get<std::string>());
+            memcpy(r.data, bin.data(), bin.size());
+        }
+    });
+    run_benchmark("memory_ranges/jsonrpc_read_memory_ranges_1000", 10, [&] {
+        nlohmann::json jrequest;
+        to_json(jrequest, cpp_ranges);
+        const auto request = nlohmann::json{{"ranges", jrequest}}.dump();
+        std::vector<memory_range_data> requested;
+        ju_get_field(nlohmann::json::parse(request), "ranges"s, requested);
+        memory_range_writes read(requested.size());
+        for (size_t i = 0; i < requested.size(); ++i) {
+            read[i] = {requested[i].address, cpp_ranges[i].data, requested[i].length};
+        }
+        nlohmann::json jresponse;
+        to_json(jresponse, read);
+        const auto response = nlohmann::json{{"result", jresponse}}.dump();
+        std::vector<memory_range_data> chunks;
+        ju_get_field(nlohmann::json::parse(response), "result"s, chunks);
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            memcpy(cpp_ranges[i].data, chunks[i].data.data(), chunks[i].data.size());
+        }
+    });
+}
+
+void benchmark_bisector() {
+    constexpr uint64_t mcycle_end = 1000000;
+    auto config = machine::get_default_config();
+    config.ram.length = UINT64_C(1) << 22;
+    config.processor.pc = PMA_RAM_START;
+    const auto root = std::filesystem::temp_directory_path() / "benchmark-bisector";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "checkpoints");
+    const auto stored = (root / "machine").string();
+    {
+        machine m(config);
+        m.write_memory(PMA_RAM_START, reinterpret_cast<const unsigned char *>(page_writer_program),
+            sizeof(page_writer_program));
+        m.store(stored);
+    }
+    // Each checkpoint is a machine stored to disk and loaded back when a query falls after it
+    const auto checkpoint = (root / "checkpoint").string();
+    std::unique_ptr<machine> m = std::make_unique<machine>(stored);
+    m->run(mcycle_end / 2);
+    run_benchmark("bisector/store_checkpoint", 10, [&] { m->store(checkpoint); },
+        [&] { std::filesystem::remove_all(checkpoint); });
+    run_benchmark("bisector/load_checkpoint", 10, [&] { m = std::make_unique<machine>(checkpoint); });
+    run_benchmark("bisector/replay_1000000_cycles", 5, [&] { m->run(m->read_mcycle() + mcycle_end); });
+    m.reset();
+    // A dispute over mcycle_end cycles, where every other query moves the interval left
+    const auto bisect = [&](uint64_t max_checkpoints, uint64_t min_checkpoint_distance) {
+        machine_bisector b(stored, (root / "checkpoints").string(), {}, max_checkpoints, min_checkpoint_distance);
+        uint64_t left = 0;
+        uint64_t right = mcycle_end;
+        for (uint64_t i = 0; right - left > 1; ++i) {
+            const uint64_t mid = left + (right - left) / 2;
+            (void) b.get_root_hash(mid);
+            if (i % 2 == 0) {
+                right = mid;
+            } else {
+                left = mid;
+            }
+        }
+    };
+    run_benchmark("bisector/bisect_1000000_cycles/no_checkpoints", 3, [&] { bisect(0, 0); });
+    // Checkpointing at every query, which costs more than it saves in a dispute this short
+    run_benchmark("bisector/bisect_1000000_cycles/every_query", 3, [&] { bisect(16, 1); });
+    run_benchmark("bisector/bisect_1000000_cycles/default", 3, [&] { bisect(16, 0); });
+    std::filesystem::remove_all(root);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) try {
+    const char *filter = "";
+    const char *json_output = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--json=", strlen("--json=")) == 0) {
+            json_output = argv[i] + strlen("--json=");
+        } else if (strcmp(argv[i], "--help") == 0) {
+            (void) fprintf(stderr, "Usage: %s [--json=<filename>] [<filter>]\n", argv[0]);
+            return 0;
+        } else {
+            filter = argv[i];
+        }
+    }
+    const std::vector<std::pair<const char *, std::function<void()>>> benchmarks{
+        {"parallel_for", benchmark_parallel_for},
+        {"merkle_tree_zeroing", benchmark_merkle_tree_zeroing},
+        {"page_proofs", benchmark_page_proofs},
+        {"multi_proofs", benchmark_multi_proofs},
+        {"periodic_hashes", benchmark_periodic_hashes},
+        {"profile", benchmark_profile},
+        {"insn_fusion", benchmark_insn_fusion},
+        {"interpret", benchmark_interpret},
+        {"uarch", benchmark_uarch},
+        {"verify_uarch_state_transitions", benchmark_verify_uarch_state_transitions},
+        {"find_pma_entry", benchmark_find_pma_entry},
+        {"page_hashing", benchmark_page_hashing},
+        {"update_merkle_tree", benchmark_update_merkle_tree},
+        {"get_proof", benchmark_get_proof},
+        {"access_log_json", benchmark_access_log_json},
+        {"c_api", benchmark_c_api_accessors},
+        {"memory_ranges", benchmark_memory_ranges},
+        {"bisector", benchmark_bisector},
+    };
+    for (const auto &[name, run] : benchmarks) {
+        if (strstr(name, filter) != nullptr) {
+            run();
+        }
+    }
+    if (json_output != nullptr) {
+        write_results(json_output);
+    }
+    return 0;
+} catch (std::exception &e) {
+    (void) fprintf(stderr, "Caught exception: %s\n", e.what());
+    return 1;
+} catch (...) {
+    (void) fprintf(stderr, "Caught unknown exception\n");
+    return 1;
+}
@@ -0,0 +1,229 @@
+// Copyright Cartesi and individual authors (see AUTHORS)
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program (see COPYING). If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Differential fuzz test checking that the host FPU fast path and soft-float agree bit for bit,
+// both on results and on exception flags
+
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <random>
+#include <string>
+
+#include <host-float.h>
+#include <soft-float.h>
+
+using namespace cartesi;
+
+namespace {
+
+/// \brief Checks if string matches prefix and captures uint64_t that follows
+/// \param pre Prefix to match in str.
+/// \param str Input string
+/// \param val If string matches prefix and conversion to uint64_t succeeds, points to converted value
+/// \returns True if string matches prefix and conversion succeeds, false otherwise
+bool uint64val(const char *pre, const char *str, uint64_t *val) {
+    const size_t len = strlen(pre);
+    if (strncmp(pre, str, len) == 0) {
+        str += len;
+        int end = 0;
+        // NOLINTNEXTLINE(cert-err34-c): %n is used to verify conversion errors
+        return sscanf(str, "%" SCNu64 "%n", val, &end) == 1 && !str[end];
+    }
+    return false;
+}
+
+/// \brief Prints help message
+void help(const char *name) {
+    (void) fprintf(stderr,
+        "Usage:\n\n  %s [options]\n\n"
+        "Compares the host FPU fast path against soft-float on random operands.\n\n"
+        "where options are\n\n"
+        "  --iterations=<n>\n"
+        "    number of random operand sets per operation (default: 1000000)\n\n"
+        "  --seed=<n>\n"
+        "    seed of the random operand generator (default: 0)\n\n",
+        name);
+    exit(0);
+}
+
+/// \brief Generates random operands biased towards the interesting corners of the format
+template <typename SFLOAT>
+class operand_generator {
+    using F_UINT = typename SFLOAT::F_UINT;
+    std::mt19937_64 m_gen;
+
+    F_UINT pack(uint64_t sign, uint64_t exp, uint64_t mant) {
+        return SFLOAT::pack(static_cast<uint32_t>(sign), static_cast<uint32_t>(exp),
+            static_cast<F_UINT>(mant) & SFLOAT::MANT_MASK);
+    }
+
+public:
+    explicit operand_generator(uint64_t seed) : m_gen(seed) {}
+
+    F_UINT operator()() {
+        const uint64_t r = m_gen();
+        const uint64_t sign = r & 1;
+        const uint64_t mant = m_gen();
+        const uint64_t bias = SFLOAT::EXP_MASK / 2;
+        switch ((r >> 1) % 8) {
+            case 0: // Any bit pattern, including NaNs and infinities
+                return static_cast<F_UINT>(mant);
+            case 1: // Zeros, subnormals, and numbers around the underflow threshold
+                return pack(sign, (r >> 8) % 4, (r >> 16) % 4 == 0 ? 0 : mant);
+            case 2: // Numbers around the overflow threshold, and infinities or NaNs
+                return pack(sign, SFLOAT::EXP_MASK - (r >> 8) % 4, mant);
+            case 3: // Numbers with few significant bits, so results are often exact
+                return pack(sign, bias + (r >> 8) % 16 - 8, mant & ~(SFLOAT::MANT_MASK >> 4));
+            default: // Numbers of moderate magnitude, so operations often combine operands of similar exponents
+                return pack(sign, bias + (r >> 8) % 64 - 32, mant);
+        }
+    }
+
+    FRM_modes rounding_mode() {
+        // Mostly round to nearest even, the only mode with a fast path
+        const uint64_t r = m_gen() % 8;
+        return static_cast<FRM_modes>(r <= FRM_RMM ? (r < 3 ? FRM_RNE : r) : FRM_RNE);
+    }
+
+    uint32_t fflags() {
+        // The fast path behaves differently depending on the inexact flag being already set
+        return static_cast<uint32_t>(m_gen() & FFLAGS_RW_MASK);
+    }
+};
+
+/// \brief Counters for the results of one operation
+struct op_stats {
+    uint64_t host = 0;
+    uint64_t mismatches = 0;
+};
+
+/// \brief Compares both implementations of an operation on a single operand set
+template <typename F_UINT, typename HOST, typename SOFT>
+void compare(const char *name, op_stats &stats, FRM_modes rm, uint32_t fflags, const std::array<F_UINT, 3> &args,
+    const HOST &host, const SOFT &soft) {
+    uint32_t host_fflags = fflags;
+    F_UINT host_r = 0;
+    const bool taken = host(rm, &host_fflags, &host_r);
+    uint32_t soft_fflags = fflags;
+    const F_UINT soft_r = soft(rm, &soft_fflags);
+    if (!taken) {
+        // Declined operations must leave the flags alone, so the soft-float fallback sees the original ones
+        if (host_fflags != fflags) {
+            ++stats.mismatches;
+            (void) fprintf(stderr, "%s: declined operation changed fflags\n", name);
+        }
+        return;
+    }
+    ++stats.host;
+    if (host_r != soft_r || host_fflags != soft_fflags) {
+        if (++stats.mismatches <= 10) {
+            (void) fprintf(stderr,
+                "%s(0x%" PRIx64 ", 0x%" PRIx64 ", 0x%" PRIx64 ") rm=%u fflags=0x%x: host 0x%" PRIx64
+                " fflags=0x%x, soft 0x%" PRIx64 " fflags=0x%x\n",
+                name, static_cast<uint64_t>(args[0]), static_cast<uint64_t>(args[1]), static_cast<uint64_t>(args[2]),
+                static_cast<unsigned>(rm), fflags, static_cast<uint64_t>(host_r), host_fflags,
+                static_cast<uint64_t>(soft_r), soft_fflags);
+        }
+    }
+}
+
+/// \brief Fuzzes all operations with a fast path for one precision
+/// \returns True if both implementations agreed on all operand sets
+template <typename HFLOAT, typename SFLOAT>
+bool fuzz(const char *suffix, uint64_t iterations, uint64_t seed) {
+    using F_UINT = typename SFLOAT::F_UINT;
+    operand_generator<SFLOAT> gen(seed);
+    std::array<op_stats, 5> stats{};
+    for (uint64_t i = 0; i < iterations; ++i) {
+        const std::array<F_UINT, 3> v{gen(), gen(), gen()};
+        const FRM_modes rm = gen.rounding_mode();
+        const uint32_t fflags = gen.fflags();
+        compare<F_UINT>(
+            "add", stats[0], rm, fflags, v,
+            [&](FRM_modes m, uint32_t *f, F_UINT *r) { return HFLOAT::host_add(v[0], v[1], m, f, r); },
+            [&](FRM_modes m, uint32_t *f) { return SFLOAT::add(v[0], v[1], m, f); });
+        compare<F_UINT>(
+            "mul", stats[1], rm, fflags, v,
+            [&](FRM_modes m, uint32_t *f, F_UINT *r) { return HFLOAT::host_mul(v[0], v[1], m, f, r); },
+            [&](FRM_modes m, uint32_t *f) { return SFLOAT::mul(v[0], v[1], m, f); });
+        compare<F_UINT>(
+            "div", stats[2], rm, fflags, v,
+            [&](FRM_modes m, uint32_t *f, F_UINT *r) { return HFLOAT::host_div(v[0], v[1], m, f, r); },
+            [&](FRM_modes m, uint32_t *f) { return SFLOAT::div(v[0], v[1], m, f); });
+        compare<F_UINT>(
+            "sqrt", stats[3], rm, fflags, v,
+            [&](FRM_modes m, uint32_t *f, F_UINT *r) { return HFLOAT::host_sqrt(v[0], m, f, r); },
+            [&](FRM_modes m, uint32_t *f) { return SFLOAT::sqrt(v[0], m, f); });
+        compare<F_UINT>(
+            "fma", stats[4], rm, fflags, v,
+            [&](FRM_modes m, uint32_t *f, F_UINT *r) { return HFLOAT::host_fma(v[0], v[1], v[2], m, f, r); },
+            [&](FRM_modes m, uint32_t *f) { return SFLOAT::fma(v[0], v[1], v[2], m, f); });
+    }
+    const std::array<const char *, 5> names{"add", "mul", "div", "sqrt", "fma"};
+    bool succeeded = true;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        (void) fprintf(stderr, "%s%s: %" PRIu64 " of %" PRIu64 " on host, %" PRIu64 " mismatches\n", names[i],
+            suffix, stats[i].host, iterations, stats[i].mismatches);
+        succeeded = succeeded && stats[i].mismatches == 0;
+        // Make sure the fast path was actually exercised, unless the host has no fused multiply-add
+        if (stats[i].host == 0 && (i != 4 || HFLOAT::has_host_fma()) && iterations >= 1000) {
+            (void) fprintf(stderr, "%s%s: fast path was never taken\n", names[i], suffix);
+            succeeded = false;
+        }
+    }
+    return succeeded;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) try {
+    uint64_t iterations = 1000000;
+    uint64_t seed = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--help") == 0) {
+            help(argv[0]);
+        } else if (uint64val("--iterations=", argv[i], &iterations)) {
+            ;
+        } else if (uint64val("--seed=", argv[i], &seed)) {
+            ;
+        } else {
+            (void) fprintf(stderr, "invalid option '%s'\n", argv[i]);
+            exit(1);
+        }
+    }
+#ifdef HOST_FLOAT_ENABLED
+    const bool succeeded = fuzz<i_hfloat32, i_sfloat32>(".s", iterations, seed) &&
+        fuzz<i_hfloat64, i_sfloat64>(".d", iterations, seed);
+    if (!succeeded) {
+        (void) fprintf(stderr, "host FPU fast path and soft-float disagree\n");
+        return 1;
+    }
+#else
+    (void) fprintf(stderr, "host FPU fast path is disabled\n");
+#endif
+    return 0;
+} catch (std::exception &e) {
+    (void) fprintf(stderr, "Caught exception: %s\n", e.what());
+    return 1;
+} catch (...) {
+    (void) fprintf(stderr, "Caught unknown exception\n");
+    return 1;
+}
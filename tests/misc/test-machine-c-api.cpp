@@ -40,9 +40,11 @@
 #include <fstream>
 #include <iostream>
 #include <thread>
+#include <utility>
 
 #include <machine-c-api.h>
 #include <riscv-constants.h>
+#include <rtc.h>
 #include <uarch-constants.h>
 #include <uarch-solidity-compat.h>
 
@@ -646,6 +648,9 @@ BOOST_AUTO_TEST_CASE_NOLINT(delete_null_test) {
     cm_delete_machine(nullptr);
     cm_delete_access_log(nullptr);
     cm_delete_merkle_tree_proof(nullptr);
+    cm_delete_merkle_tree_multi_proof(nullptr);
+    cm_delete_periodic_root_hash_array(nullptr);
+    cm_delete_machine_profile(nullptr);
 }
 
 BOOST_FIXTURE_TEST_CASE_NOLINT(get_root_hash_null_hash_test, ordinary_machine_fixture) {
@@ -759,6 +764,130 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(get_proof_machine_hash_test, ordinary_machine_fix
     cm_delete_merkle_tree_proof(p);
 }
 
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_proof_into_null_proof_test, ordinary_machine_fixture) {
+    int error_code = cm_get_proof_into(_machine, 0, 12, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_proof_into_small_buffer_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    std::array<cm_hash, 51> siblings{};
+    cm_merkle_tree_proof p{};
+    p.sibling_hashes.entry = siblings.data();
+    p.sibling_hashes.count = siblings.size();
+    int error_code = cm_get_proof_into(_machine, 0, 12, &p, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_LENGTH_ERROR);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("proof sibling hashes buffer is too small"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_proof_into_machine_hash_test, ordinary_machine_fixture) {
+    char *err_msg{};
+
+    cm_merkle_tree_proof *expected{};
+    int error_code = cm_get_proof(_machine, 0, 12, &expected, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    std::array<cm_hash, 61> siblings{};
+    cm_merkle_tree_proof p{};
+    for (int log2_size : {12, 3}) {
+        p.sibling_hashes.entry = siblings.data();
+        p.sibling_hashes.count = siblings.size();
+        error_code = cm_get_proof_into(_machine, 0, log2_size, &p, &err_msg);
+        BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(err_msg, nullptr);
+        BOOST_CHECK_EQUAL(p.log2_target_size, static_cast<size_t>(log2_size));
+        BOOST_CHECK_EQUAL(p.sibling_hashes.count, static_cast<size_t>(64 - log2_size));
+        auto verification = calculate_proof_root_hash(&p);
+        BOOST_CHECK_EQUAL_COLLECTIONS(verification.begin(), verification.end(), p.root_hash,
+            p.root_hash + sizeof(cm_hash));
+    }
+
+    p.sibling_hashes.entry = siblings.data();
+    p.sibling_hashes.count = siblings.size();
+    error_code = cm_get_proof_into(_machine, 0, 12, &p, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(p.target_address, expected->target_address);
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.target_hash, p.target_hash + sizeof(cm_hash), expected->target_hash,
+        expected->target_hash + sizeof(cm_hash));
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.root_hash, p.root_hash + sizeof(cm_hash), expected->root_hash,
+        expected->root_hash + sizeof(cm_hash));
+    BOOST_REQUIRE_EQUAL(p.sibling_hashes.count, expected->sibling_hashes.count);
+    BOOST_CHECK(memcmp(p.sibling_hashes.entry, expected->sibling_hashes.entry,
+                    p.sibling_hashes.count * sizeof(cm_hash)) == 0);
+
+    cm_delete_merkle_tree_proof(expected);
+}
+
+BOOST_AUTO_TEST_CASE_NOLINT(get_multi_proof_null_machine_test) {
+    cm_merkle_tree_multi_proof_target target{0, 12, {}};
+    cm_merkle_tree_multi_proof_target_array targets{&target, 1};
+    cm_merkle_tree_multi_proof *proof{};
+    int error_code = cm_get_multi_proof(nullptr, &targets, &proof, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_multi_proof_null_proof_test, ordinary_machine_fixture) {
+    cm_merkle_tree_multi_proof_target target{0, 12, {}};
+    cm_merkle_tree_multi_proof_target_array targets{&target, 1};
+    int error_code = cm_get_multi_proof(_machine, &targets, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    error_code = cm_get_multi_proof(_machine, nullptr, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_multi_proof_overlapping_targets_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    std::array<cm_merkle_tree_multi_proof_target, 2> target{{{0, 12, {}}, {8, 3, {}}}};
+    cm_merkle_tree_multi_proof_target_array targets{target.data(), target.size()};
+    cm_merkle_tree_multi_proof *proof{};
+    int error_code = cm_get_multi_proof(_machine, &targets, &proof, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+
+    std::string result = err_msg;
+    std::string origin("targets overlap");
+    BOOST_CHECK_EQUAL(origin, result);
+
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_multi_proof_machine_hash_test, ordinary_machine_fixture) {
+    char *err_msg{};
+
+    std::array<cm_merkle_tree_multi_proof_target, 4> target{
+        {{0x80001000, 12, {}}, {0x80000000, 3, {}}, {0x80000008, 3, {}}, {0x200, 3, {}}}};
+    cm_merkle_tree_multi_proof_target_array targets{target.data(), target.size()};
+    cm_merkle_tree_multi_proof *p{};
+    int error_code = cm_get_multi_proof(_machine, &targets, &p, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(err_msg, nullptr);
+
+    auto verification = calculate_emulator_hash(_machine);
+    BOOST_CHECK_EQUAL_COLLECTIONS(verification.begin(), verification.end(), p->root_hash,
+        p->root_hash + sizeof(cm_hash));
+    BOOST_CHECK_EQUAL(p->log2_root_size, static_cast<size_t>(64));
+    BOOST_REQUIRE_EQUAL(p->targets.count, target.size());
+
+    // Targets come sorted by address, with the same hashes as individual proofs
+    size_t total_siblings = 0;
+    for (size_t i = 0; i < p->targets.count; ++i) {
+        const auto &t = p->targets.entry[i];
+        if (i > 0) {
+            BOOST_CHECK_LT(p->targets.entry[i - 1].address, t.address);
+        }
+        cm_merkle_tree_proof *single{};
+        error_code = cm_get_proof(_machine, t.address, t.log2_size, &single, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL_COLLECTIONS(t.hash, t.hash + sizeof(cm_hash), single->target_hash,
+            single->target_hash + sizeof(cm_hash));
+        total_siblings += single->sibling_hashes.count;
+        cm_delete_merkle_tree_proof(single);
+    }
+    BOOST_CHECK_LT(p->sibling_hashes.count, total_siblings);
+
+    cm_delete_merkle_tree_multi_proof(p);
+}
+
 BOOST_AUTO_TEST_CASE_NOLINT(read_word_null_machine_test) {
     uint64_t word_value = 0;
     int error_code = cm_read_word(nullptr, 0x100, &word_value, nullptr);
@@ -947,6 +1076,31 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_memory_scattered_data, ordinary_machin
     BOOST_CHECK_EQUAL(read_value, write_value);
 }
 
+BOOST_FIXTURE_TEST_CASE_NOLINT(write_memory_page_junction_root_hash_test, ordinary_machine_fixture) {
+    // A single write across a page junction must update the hashes of both pages
+    const std::array<uint8_t, 2> write_data{0xde, 0xad};
+    const uint64_t address = 0x80004000 - 1;
+    cm_hash junction_hash{};
+    BOOST_REQUIRE_EQUAL(cm_get_root_hash(_machine, &junction_hash, nullptr), CM_ERROR_OK);
+    int error_code = cm_write_memory(_machine, address, write_data.data(), write_data.size(), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(cm_get_root_hash(_machine, &junction_hash, nullptr), CM_ERROR_OK);
+
+    cm_machine *machine{};
+    error_code = cm_create_machine(&_machine_config, &_runtime_config, &machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_memory(machine, address, write_data.data(), 1, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_memory(machine, address + 1, write_data.data() + 1, 1, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash split_hash{};
+    BOOST_REQUIRE_EQUAL(cm_get_root_hash(machine, &split_hash, nullptr), CM_ERROR_OK);
+    cm_delete_machine(machine);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(junction_hash, junction_hash + sizeof(cm_hash), split_hash,
+        split_hash + sizeof(cm_hash));
+}
+
 BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_memory_massive_test, ordinary_machine_fixture) {
     // writing somewhere in the middle of a page
     uint64_t address = 0x8000000F;
@@ -1050,6 +1204,119 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_virtual_memory_massive_test, ordinary_
     BOOST_CHECK_EQUAL_COLLECTIONS(write_data.begin(), write_data.end(), read_data.begin(), read_data.end());
 }
 
+BOOST_AUTO_TEST_CASE_NOLINT(memory_ranges_null_machine_test) {
+    std::array<uint8_t, sizeof(uint64_t)> data{};
+    const cm_memory_range_read read_range{0x80000000, data.data(), data.size()};
+    const cm_memory_range_write write_range{0x80000000, data.data(), data.size()};
+    BOOST_CHECK_EQUAL(cm_read_memory_ranges(nullptr, &read_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_write_memory_ranges(nullptr, &write_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_read_virtual_memory_ranges(nullptr, &read_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_write_virtual_memory_ranges(nullptr, &write_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(memory_ranges_null_ranges_test, ordinary_machine_fixture) {
+    BOOST_CHECK_EQUAL(cm_read_memory_ranges(_machine, nullptr, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_write_memory_ranges(_machine, nullptr, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_read_memory_ranges(_machine, nullptr, 0, nullptr), CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(cm_write_memory_ranges(_machine, nullptr, 0, nullptr), CM_ERROR_OK);
+    const cm_memory_range_read read_range{0x80000000, nullptr, 1};
+    BOOST_CHECK_EQUAL(cm_read_memory_ranges(_machine, &read_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    const cm_memory_range_write write_range{0x80000000, nullptr, 1};
+    BOOST_CHECK_EQUAL(cm_write_memory_ranges(_machine, &write_range, 1, nullptr), CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_memory_ranges_basic_test, ordinary_machine_fixture) {
+    std::array<uint8_t, 16> first{};
+    std::array<uint8_t, 8> second{};
+    std::array<uint8_t, 4096 + 2> third{};
+    memset(first.data(), 0x11, first.size());
+    memset(second.data(), 0x22, second.size());
+    memset(third.data(), 0x33, third.size());
+    // the second range straddles the end of the DTB and the start of RAM,
+    // and the third one the junction between two RAM pages
+    const std::array<cm_memory_range_write, 3> write_ranges{{
+        {0x80000100, first.data(), first.size()},
+        {0x80000000 - second.size() / 2, second.data(), second.size()},
+        {0x80004000 - 1, third.data(), third.size()},
+    }};
+    char *err_msg{};
+    int error_code = cm_write_memory_ranges(_machine, write_ranges.data(), write_ranges.size(), &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    std::array<uint8_t, 16> read_first{};
+    std::array<uint8_t, 8> read_second{};
+    std::array<uint8_t, 4096 + 2> read_third{};
+    const std::array<cm_memory_range_read, 3> read_ranges{{
+        {write_ranges[0].address, read_first.data(), read_first.size()},
+        {write_ranges[1].address, read_second.data(), read_second.size()},
+        {write_ranges[2].address, read_third.data(), read_third.size()},
+    }};
+    error_code = cm_read_memory_ranges(_machine, read_ranges.data(), read_ranges.size(), &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL_COLLECTIONS(first.begin(), first.end(), read_first.begin(), read_first.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(second.begin(), second.end(), read_second.begin(), read_second.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(third.begin(), third.end(), read_third.begin(), read_third.end());
+
+    // each half of the second range can still be read on its own
+    std::array<uint8_t, 4> half{};
+    error_code = cm_read_memory(_machine, 0x80000000, half.data(), half.size(), &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(half.begin(), half.end(), second.begin(), second.begin() + half.size());
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(memory_ranges_outside_pmas_test, ordinary_machine_fixture) {
+    // the range starts at the end of RAM and continues where there is no PMA
+    const uint64_t address = 0x80000000 + (1 << 20) - 4;
+    std::array<uint8_t, 8> data{};
+    memset(data.data(), 0x44, data.size());
+    const cm_memory_range_write write_range{address, data.data(), data.size()};
+    char *err_msg{};
+    int error_code = cm_write_memory_ranges(_machine, &write_range, 1, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("address range not entirely in memory PMA"));
+    cm_delete_cstring(err_msg);
+
+    std::array<uint8_t, 8> read_data{};
+    const cm_memory_range_read read_range{address, read_data.data(), read_data.size()};
+    error_code = cm_read_memory_ranges(_machine, &read_range, 1, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("address range not entirely in PMAs"));
+    cm_delete_cstring(err_msg);
+
+    const cm_memory_range_read wrapping_range{UINT64_MAX, read_data.data(), read_data.size()};
+    error_code = cm_read_memory_ranges(_machine, &wrapping_range, 1, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("memory range wraps around address space"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_virtual_memory_ranges_basic_test, ordinary_machine_fixture) {
+    std::array<uint8_t, 12404> write_data{};
+    memset(write_data.data(), 0xda, write_data.size());
+    const std::array<cm_memory_range_write, 2> write_ranges{{
+        {0x8000000F, write_data.data(), write_data.size()},
+        {0x80010000, write_data.data(), 8},
+    }};
+    char *err_msg{};
+    int error_code = cm_write_virtual_memory_ranges(_machine, write_ranges.data(), write_ranges.size(), &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    std::array<uint8_t, 12404> read_data{};
+    std::array<uint8_t, 8> read_small{};
+    const std::array<cm_memory_range_read, 2> read_ranges{{
+        {0x8000000F, read_data.data(), read_data.size()},
+        {0x80010000, read_small.data(), read_small.size()},
+    }};
+    error_code = cm_read_virtual_memory_ranges(_machine, read_ranges.data(), read_ranges.size(), &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL_COLLECTIONS(write_data.begin(), write_data.end(), read_data.begin(), read_data.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(write_data.begin(), write_data.begin() + 8, read_small.begin(), read_small.end());
+}
+
 // NOLINTNEXTLINE
 #define CHECK_READER_FAILS_ON_nullptr_MACHINE(T, reader_f)                                                             \
     BOOST_FIXTURE_TEST_CASE_NOLINT(read_##reader_f##_null_machine_test, ordinary_machine_fixture) {                    \
@@ -1569,6 +1836,304 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(replace_memory_range_basic_test, flash_drive_mach
     BOOST_CHECK_EQUAL(_flash_data, read_string);
 }
 
+BOOST_AUTO_TEST_CASE_NOLINT(clear_memory_range_null_machine_test) {
+    int error_code = cm_clear_memory_range(nullptr, 0x80000000000000, 0x3c00000, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(clear_memory_range_inexistent_range_test, flash_drive_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_clear_memory_range(_machine, _flash_config.start, 4096, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("attempt to clear inexistent memory range"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(clear_memory_range_protected_range_test, flash_drive_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_clear_memory_range(_machine, 0x80000000, _machine_config.ram.length, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("attempt to clear a protected range RAM"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(clear_memory_range_basic_test, flash_drive_machine_fixture) {
+    // The first page of the flash drive is already in the Merkle tree and the last one is only marked dirty
+    cm_hash hash{};
+    int error_code = cm_get_root_hash(_machine, &hash, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    const uint64_t last_page = _flash_config.start + _flash_config.length - 4096;
+    error_code = cm_write_memory(_machine, last_page, reinterpret_cast<const unsigned char *>(_flash_data.data()),
+        _flash_data.size(), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    char *err_msg{};
+    error_code = cm_clear_memory_range(_machine, _flash_config.start, _flash_config.length, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    std::vector<unsigned char> flash(_flash_config.length, 0xff);
+    error_code = cm_read_memory(_machine, _flash_config.start, flash.data(), flash.size(), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK(std::all_of(flash.begin(), flash.end(), [](unsigned char c) { return c == 0; }));
+
+    bool result{};
+    error_code = cm_verify_merkle_tree(_machine, &result, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK(result);
+    error_code = cm_verify_dirty_page_maps(_machine, &result, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK(result);
+
+    // Clearing the range must produce the same state as writing zeros over it
+    cm_hash cleared_hash{};
+    error_code = cm_get_root_hash(_machine, &cleared_hash, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_memory(_machine, _flash_config.start, flash.data(), flash.size(), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_get_root_hash(_machine, &hash, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), cleared_hash, cleared_hash + sizeof(cm_hash));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+class rollup_machine_fixture : public incomplete_machine_fixture {
+public:
+    rollup_machine_fixture() {
+        _machine_config.htif.yield_manual = true;
+        _machine_config.htif.yield_automatic = true;
+        _machine_config.rollup.has_value = true;
+        _machine_config.rollup.rx_buffer = {0x60000000, 2 << 20, false, nullptr};
+        _machine_config.rollup.tx_buffer = {0x60200000, 2 << 20, false, nullptr};
+        _machine_config.rollup.input_metadata = {0x60400000, 4096, false, nullptr};
+        _machine_config.rollup.voucher_hashes = {0x60600000, 2 << 20, false, nullptr};
+        _machine_config.rollup.notice_hashes = {0x60800000, 2 << 20, false, nullptr};
+        _machine = _create_echo_machine();
+    }
+
+    ~rollup_machine_fixture() {
+        cm_delete_machine(_machine);
+    }
+
+    rollup_machine_fixture(const rollup_machine_fixture &other) = delete;
+    rollup_machine_fixture(rollup_machine_fixture &&other) noexcept = delete;
+    rollup_machine_fixture &operator=(const rollup_machine_fixture &other) = delete;
+    rollup_machine_fixture &operator=(rollup_machine_fixture &&other) noexcept = delete;
+
+protected:
+    // Accepts each input whose first 8 bytes are not zero, after emitting them as a notice, and rejects the others
+    cm_machine *_create_echo_machine() {
+        cm_machine *machine{};
+        int error_code = cm_create_machine(&_machine_config, &_runtime_config, &machine, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        std::array<uint32_t, 26> program{
+            0x400082b7, // lui t0, 0x40008
+            0x600004b7, // lui s1, 0x60000
+            0x60200937, // lui s2, 0x60200
+            0x608009b7, // lui s3, 0x60800
+            0x00100a13, // li s4, 1
+            0x20100313, // li t1, 0x201
+            0x03031313, // slli t1, t1, 48
+            0x020a1393, // slli t2, s4, 32
+            0x00736333, // or t1, t1, t2
+            0x0062b023, // sd t1, 0(t0)
+            0x0004b503, // ld a0, 0(s1)
+            0x00200a13, // li s4, 2
+            0xfe0502e3, // beqz a0, loop
+            0x00100a13, // li s4, 1
+            0x04a93023, // sd a0, 64(s2)
+            0x00800e13, // li t3, 8
+            0x038e1e13, // slli t3, t3, 56
+            0x03c93c23, // sd t3, 56(s2)
+            0x20000313, // li t1, 0x200
+            0x03031313, // slli t1, t1, 48
+            0x00400393, // li t2, 4
+            0x02039393, // slli t2, t2, 32
+            0x00736333, // or t1, t1, t2
+            0x0062b023, // sd t1, 0(t0)
+            0x00a9b023, // sd a0, 0(s3)
+            0xfb1ff06f, // j loop
+        };
+        error_code = cm_write_memory(machine, 0x80000000, reinterpret_cast<unsigned char *>(program.data()),
+            program.size() * sizeof(uint32_t), nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        error_code = cm_write_pc(machine, 0x80000000, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        return machine;
+    }
+};
+
+BOOST_AUTO_TEST_CASE_NOLINT(advance_rollup_null_machine_test) {
+    const cm_rollup_input_array inputs{};
+    cm_rollup_input_result_array *results{};
+    int error_code = cm_advance_rollup(nullptr, &inputs, UINT64_MAX, &results, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(advance_rollup_no_rollup_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    const cm_rollup_input_array inputs{};
+    cm_rollup_input_result_array *results{};
+    int error_code = cm_advance_rollup(_machine, &inputs, UINT64_MAX, &results, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    std::string result = err_msg;
+    std::string origin("rollup device is not present");
+    BOOST_CHECK_EQUAL(origin, result);
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(advance_rollup_basic_test, rollup_machine_fixture) {
+    const std::array<uint64_t, 4> payloads{0x1111, 0x2222, 0, 0x3333};
+    const std::string metadata(128, 'm');
+    std::array<cm_rollup_input, 4> input_entries{};
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        input_entries[i].metadata = reinterpret_cast<const uint8_t *>(metadata.data());
+        input_entries[i].metadata_length = metadata.size();
+        input_entries[i].payload = reinterpret_cast<const uint8_t *>(&payloads[i]);
+        input_entries[i].payload_length = sizeof(uint64_t);
+    }
+    const cm_rollup_input_array inputs{input_entries.data(), input_entries.size()};
+    char *err_msg{};
+    cm_rollup_input_result_array *results{};
+    int error_code = cm_advance_rollup(_machine, &inputs, UINT64_MAX, &results, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    // A leading entry for the run up to the first input, then processing stops at the first rejected input
+    BOOST_REQUIRE_EQUAL(results->count, static_cast<size_t>(4));
+    BOOST_CHECK_EQUAL(results->entry[0].status, CM_ROLLUP_INPUT_ACCEPTED);
+    BOOST_CHECK_EQUAL(results->entry[0].notices.count, static_cast<size_t>(0));
+    BOOST_CHECK_EQUAL(results->entry[1].status, CM_ROLLUP_INPUT_ACCEPTED);
+    BOOST_CHECK_EQUAL(results->entry[2].status, CM_ROLLUP_INPUT_ACCEPTED);
+    BOOST_CHECK_EQUAL(results->entry[3].status, CM_ROLLUP_INPUT_REJECTED);
+
+    // Drive an identical machine by hand and compare root hashes after each input
+    cm_machine *machine = _create_echo_machine();
+    CM_BREAK_REASON break_reason{};
+    error_code = cm_machine_run(machine, UINT64_MAX, &break_reason, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(break_reason, CM_BREAK_REASON_YIELDED_MANUALLY);
+    cm_hash initial_hash{};
+    error_code = cm_get_root_hash(machine, &initial_hash, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(initial_hash, initial_hash + sizeof(cm_hash), results->entry[0].root_hash,
+        results->entry[0].root_hash + sizeof(cm_hash));
+    const auto &r = _machine_config.rollup;
+    for (size_t i = 0; i + 1 < results->count; ++i) {
+        const auto &result = results->entry[i + 1];
+        BOOST_CHECK_EQUAL(result.vouchers.count, static_cast<size_t>(0));
+        BOOST_CHECK_EQUAL(result.reports.count, static_cast<size_t>(0));
+        BOOST_CHECK_EQUAL(result.voucher_hashes.count, static_cast<size_t>(0));
+        if (result.status == CM_ROLLUP_INPUT_ACCEPTED) {
+            BOOST_REQUIRE_EQUAL(result.notices.count, static_cast<size_t>(1));
+            BOOST_REQUIRE_EQUAL(result.notices.entry[0].length, static_cast<size_t>(64 + sizeof(uint64_t)));
+            uint64_t notice = 0;
+            memcpy(&notice, result.notices.entry[0].data + 64, sizeof(notice));
+            BOOST_CHECK_EQUAL(notice, payloads[i]);
+            BOOST_REQUIRE_EQUAL(result.notice_hashes.count, static_cast<size_t>(1));
+            memcpy(&notice, result.notice_hashes.entry[0], sizeof(notice));
+            BOOST_CHECK_EQUAL(notice, payloads[i]);
+        } else {
+            BOOST_CHECK_EQUAL(result.notices.count, static_cast<size_t>(0));
+            BOOST_CHECK_EQUAL(result.notice_hashes.count, static_cast<size_t>(0));
+        }
+
+        BOOST_REQUIRE_EQUAL(cm_clear_memory_range(machine, r.input_metadata.start, r.input_metadata.length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_write_memory(machine, r.input_metadata.start, input_entries[i].metadata,
+                                input_entries[i].metadata_length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_clear_memory_range(machine, r.voucher_hashes.start, r.voucher_hashes.length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_clear_memory_range(machine, r.notice_hashes.start, r.notice_hashes.length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_clear_memory_range(machine, r.rx_buffer.start, r.rx_buffer.length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_write_memory(machine, r.rx_buffer.start, input_entries[i].payload,
+                                input_entries[i].payload_length, nullptr),
+            CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_reset_iflags_Y(machine, nullptr), CM_ERROR_OK);
+        BOOST_REQUIRE_EQUAL(cm_write_htif_fromhost_data(machine, 0, nullptr), CM_ERROR_OK);
+        do {
+            error_code = cm_machine_run(machine, UINT64_MAX, &break_reason, nullptr);
+            BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        } while (break_reason == CM_BREAK_REASON_YIELDED_AUTOMATICALLY);
+        BOOST_REQUIRE_EQUAL(break_reason, CM_BREAK_REASON_YIELDED_MANUALLY);
+
+        cm_hash hash{};
+        error_code = cm_get_root_hash(machine, &hash, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), result.root_hash,
+            result.root_hash + sizeof(cm_hash));
+    }
+    cm_delete_machine(machine);
+    cm_delete_rollup_input_result_array(results);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(advance_rollup_reached_target_mcycle_test, rollup_machine_fixture) {
+    const uint64_t payload = 0x1111;
+    const cm_rollup_input input{nullptr, 0, reinterpret_cast<const uint8_t *>(&payload), sizeof(payload)};
+    const cm_rollup_input_array inputs{&input, 1};
+    cm_rollup_input_result_array *results{};
+    int error_code = cm_advance_rollup(_machine, &inputs, 2, &results, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // The machine never asks for the input, which the leading entry reports
+    BOOST_REQUIRE_EQUAL(results->count, static_cast<size_t>(1));
+    BOOST_CHECK_EQUAL(results->entry[0].status, CM_ROLLUP_INPUT_REACHED_TARGET_MCYCLE);
+    cm_delete_rollup_input_result_array(results);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(advance_rollup_before_first_input_test, rollup_machine_fixture) {
+    // Enter the echo loop right after its manual yield, with a request already in the rx buffer, so the machine
+    // emits a notice before it asks for the first input
+    const uint64_t payload = 0x5555;
+    const auto &r = _machine_config.rollup;
+    int error_code = cm_write_memory(_machine, r.rx_buffer.start, reinterpret_cast<const unsigned char *>(&payload),
+        sizeof(payload), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    const std::array<std::pair<int, uint64_t>, 5> regs{{
+        {5, 0x40008000},             // t0
+        {9, r.rx_buffer.start},      // s1
+        {18, r.tx_buffer.start},     // s2
+        {19, r.notice_hashes.start}, // s3
+        {20, 1},                     // s4
+    }};
+    for (const auto &[i, val] : regs) {
+        BOOST_REQUIRE_EQUAL(cm_write_x(_machine, i, val, nullptr), CM_ERROR_OK);
+    }
+    BOOST_REQUIRE_EQUAL(cm_write_pc(_machine, 0x80000028, nullptr), CM_ERROR_OK);
+
+    // Even with no inputs, the outputs and the status of the first manual yield are returned
+    const cm_rollup_input_array inputs{};
+    cm_rollup_input_result_array *results{};
+    error_code = cm_advance_rollup(_machine, &inputs, UINT64_MAX, &results, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(results->count, static_cast<size_t>(1));
+    const auto &initial = results->entry[0];
+    BOOST_CHECK_EQUAL(initial.status, CM_ROLLUP_INPUT_ACCEPTED);
+    BOOST_REQUIRE_EQUAL(initial.notices.count, static_cast<size_t>(1));
+    uint64_t notice = 0;
+    memcpy(&notice, initial.notices.entry[0].data + 64, sizeof(notice));
+    BOOST_CHECK_EQUAL(notice, payload);
+    cm_delete_rollup_input_result_array(results);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(inspect_rollup_basic_test, rollup_machine_fixture) {
+    const uint64_t query = 0x4444;
+    cm_rollup_input_result *result{};
+    char *err_msg{};
+    int error_code = cm_inspect_rollup(_machine, reinterpret_cast<const uint8_t *>(&query), sizeof(query), UINT64_MAX,
+        &result, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL(result->status, CM_ROLLUP_INPUT_ACCEPTED);
+    BOOST_REQUIRE_EQUAL(result->notices.count, static_cast<size_t>(1));
+    uint64_t notice = 0;
+    memcpy(&notice, result->notices.entry[0].data + 64, sizeof(notice));
+    BOOST_CHECK_EQUAL(notice, query);
+    cm_delete_rollup_input_result(result);
+}
+
 BOOST_AUTO_TEST_CASE_NOLINT(destroy_null_machine_test) {
     int error_code = cm_destroy(nullptr, nullptr);
     BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
@@ -1793,6 +2358,82 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(read_write_csr_basic_test, ordinary_machine_fixtu
     BOOST_CHECK_EQUAL(static_cast<uint64_t>(0x200), cm_get_csr_address(CM_PROC_PC));
 }
 
+BOOST_AUTO_TEST_CASE_NOLINT(read_csrs_null_machine_test) {
+    const std::array<CM_PROC_CSR, 1> csrs{CM_PROC_MCYCLE};
+    std::array<uint64_t, 1> vals{};
+    int error_code = cm_read_csrs(nullptr, csrs.data(), vals.data(), csrs.size(), nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_csrs_null_output_test, ordinary_machine_fixture) {
+    const std::array<CM_PROC_CSR, 1> csrs{CM_PROC_MCYCLE};
+    std::array<uint64_t, 1> vals{};
+    int error_code = cm_read_csrs(_machine, nullptr, vals.data(), csrs.size(), nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    error_code = cm_read_csrs(_machine, csrs.data(), nullptr, csrs.size(), nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    error_code = cm_read_csrs(_machine, nullptr, nullptr, 0, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_csrs_basic_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_write_csr(_machine, CM_PROC_MCYCLE, 42, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    const std::array<CM_PROC_CSR, 4> csrs{CM_PROC_MCYCLE, CM_PROC_IFLAGS, CM_PROC_PC, CM_PROC_UARCH_CYCLE};
+    std::array<uint64_t, 4> vals{};
+    error_code = cm_read_csrs(_machine, csrs.data(), vals.data(), csrs.size(), &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL(vals[0], static_cast<uint64_t>(42));
+    for (size_t i = 0; i < csrs.size(); ++i) {
+        uint64_t val{};
+        BOOST_REQUIRE_EQUAL(cm_read_csr(_machine, csrs[i], &val, nullptr), CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(vals[i], val);
+    }
+
+    const std::array<CM_PROC_CSR, 2> bad_csrs{CM_PROC_MCYCLE, CM_PROC_UNKNOWN};
+    error_code = cm_read_csrs(_machine, bad_csrs.data(), vals.data(), bad_csrs.size(), &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("unknown CSR"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_processor_state_null_output_test, ordinary_machine_fixture) {
+    int error_code = cm_read_processor_state(_machine, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(read_processor_state_basic_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    BOOST_REQUIRE_EQUAL(cm_write_x(_machine, 5, 0xdeadbeef, nullptr), CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(cm_write_f(_machine, 7, 0xfeedbeef, nullptr), CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(cm_write_csr(_machine, CM_PROC_IUNREP, 1, nullptr), CM_ERROR_OK);
+
+    cm_processor_config state{};
+    int error_code = cm_read_processor_state(_machine, &state, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(err_msg, nullptr);
+
+    uint64_t val{};
+    for (int i = 0; i < 32; ++i) {
+        BOOST_REQUIRE_EQUAL(cm_read_x(_machine, i, &val, nullptr), CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(state.x[i], val);
+        BOOST_REQUIRE_EQUAL(cm_read_f(_machine, i, &val, nullptr), CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(state.f[i], val);
+    }
+    BOOST_CHECK_EQUAL(state.x[5], static_cast<uint64_t>(0xdeadbeef));
+    BOOST_CHECK_EQUAL(state.f[7], static_cast<uint64_t>(0xfeedbeef));
+    // CSRs in the processor state follow the order of CM_PROC_CSR, from pc to iunrep
+    const uint64_t *csrs = &state.pc;
+    for (int r = CM_PROC_PC; r <= CM_PROC_IUNREP; ++r) {
+        BOOST_REQUIRE_EQUAL(cm_read_csr(_machine, static_cast<CM_PROC_CSR>(r), &val, nullptr), CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(csrs[r - CM_PROC_PC], val);
+    }
+    BOOST_CHECK_EQUAL(state.iunrep, static_cast<uint64_t>(1));
+}
+
 BOOST_AUTO_TEST_CASE_NOLINT(verify_merkle_tree_null_machine_test) {
     bool ret{};
     int error_code = cm_verify_merkle_tree(nullptr, &ret, nullptr);
@@ -1998,6 +2639,47 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(log_uarch_step_complex_test_null_error_placeholde
     cm_delete_access_log(_access_log);
 }
 
+BOOST_FIXTURE_TEST_CASE_NOLINT(log_uarch_step_into_null_buffer_test, access_log_machine_fixture) {
+    const cm_access_log *log{};
+    int error_code = cm_log_uarch_step_into(_machine, _log_type, false, nullptr, &log, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(cm_new_access_log_buffer(nullptr, nullptr), CM_ERROR_INVALID_ARGUMENT);
+    cm_delete_access_log_buffer(nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(log_uarch_step_into_test, access_log_machine_fixture) {
+    char *err_msg{};
+    cm_access_log_buffer *buffer{};
+    int error_code = cm_new_access_log_buffer(&buffer, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    error_code = cm_log_uarch_step_into(_machine, _log_type, false, buffer, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("invalid access log output"));
+    cm_delete_cstring(err_msg);
+    err_msg = nullptr;
+
+    // Reuse the same buffer for several steps
+    for (int i = 0; i < 3; ++i) {
+        cm_hash hash0;
+        cm_hash hash1;
+        BOOST_REQUIRE_EQUAL(cm_get_root_hash(_machine, &hash0, nullptr), CM_ERROR_OK);
+        const cm_access_log *log{};
+        error_code = cm_log_uarch_step_into(_machine, _log_type, false, buffer, &log, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(err_msg, nullptr);
+        BOOST_REQUIRE_EQUAL(cm_get_root_hash(_machine, &hash1, nullptr), CM_ERROR_OK);
+        BOOST_CHECK(log->accesses.count > 0);
+        BOOST_CHECK(log->log_type.proofs);
+        BOOST_CHECK(log->log_type.annotations);
+        error_code = cm_verify_uarch_step_state_transition(&hash0, log, &hash1, &_runtime_config, false, &err_msg);
+        BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL(err_msg, nullptr);
+    }
+
+    cm_delete_access_log_buffer(buffer);
+}
+
 // sunda
 BOOST_FIXTURE_TEST_CASE_NOLINT(log_uarch_step_until_halt, access_log_machine_fixture) {
     cm_hash hash0{};
@@ -2132,6 +2814,74 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(step_hash_test, access_log_machine_fixture) {
     cm_delete_access_log(_access_log);
 }
 
+BOOST_AUTO_TEST_CASE_NOLINT(verify_uarch_state_transitions_null_transitions_test) {
+    char *err_msg{};
+    cm_machine_runtime_config runtime_config{};
+    int error_code = cm_verify_uarch_state_transitions(nullptr, &runtime_config, false, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    std::string result = err_msg;
+    std::string origin("invalid uarch state transitions");
+    BOOST_CHECK_EQUAL(origin, result);
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(verify_uarch_state_transitions_test, access_log_machine_fixture) {
+    // log every step until the uarch halts
+    std::vector<cm_uarch_state_transition> transitions(3);
+    int error_code = cm_get_root_hash(_machine, &transitions[0].root_hash_before, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        auto &t = transitions[i];
+        if (i > 0) {
+            std::copy(std::begin(transitions[i - 1].root_hash_after), std::end(transitions[i - 1].root_hash_after),
+                std::begin(t.root_hash_before));
+        }
+        cm_access_log *log{};
+        error_code = cm_log_uarch_step(_machine, _log_type, false, &log, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        t.type = CM_UARCH_STATE_TRANSITION_STEP;
+        t.log = log;
+        error_code = cm_get_root_hash(_machine, &t.root_hash_after, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    const cm_uarch_state_transition_array array{transitions.data(), transitions.size()};
+
+    char *err_msg{};
+    error_code = cm_verify_uarch_state_transitions(&array, &_runtime_config, false, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(err_msg, nullptr);
+
+    // transitions must form a chain
+    std::swap(transitions[1], transitions[2]);
+    error_code = cm_verify_uarch_state_transitions(&array, &_runtime_config, false, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg),
+        "root hash before transition 1 does not match root hash after transition 0");
+    cm_delete_cstring(err_msg);
+    std::swap(transitions[1], transitions[2]);
+
+    // the first invalid transition is reported even when later ones are invalid too
+    transitions[1].root_hash_after[0] ^= 1;
+    transitions[2].root_hash_before[0] ^= 1;
+    error_code = cm_verify_uarch_state_transitions(&array, &_runtime_config, true, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), "transition 2: mismatch in root hash after replay");
+    cm_delete_cstring(err_msg);
+    transitions[1].root_hash_after[0] ^= 1;
+    transitions[2].root_hash_before[0] ^= 1;
+
+    // step logs do not replay as resets
+    transitions[0].type = CM_UARCH_STATE_TRANSITION_RESET;
+    error_code = cm_verify_uarch_state_transitions(&array, &_runtime_config, false, &err_msg);
+    BOOST_CHECK_NE(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(std::string(err_msg).rfind("transition 0: ", 0), 0);
+    cm_delete_cstring(err_msg);
+
+    for (auto &t : transitions) {
+        cm_delete_access_log(const_cast<cm_access_log *>(t.log)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+}
+
 BOOST_AUTO_TEST_CASE_NOLINT(machine_run_null_machine_test) {
     CM_BREAK_REASON break_reason{};
     int error_code = cm_machine_run(nullptr, 1000, &break_reason, nullptr);
@@ -2213,6 +2963,720 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_long_cycle_test, ordinary_machine_fix
     BOOST_CHECK_EQUAL_COLLECTIONS(verification.begin(), verification.end(), hash_end, hash_end + sizeof(cm_hash));
 }
 
+BOOST_AUTO_TEST_CASE_NOLINT(get_periodic_root_hashes_null_machine_test) {
+    cm_periodic_root_hash_array *hashes{};
+    int error_code = cm_get_periodic_root_hashes(nullptr, &hashes, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_periodic_root_hashes_null_output_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_get_periodic_root_hashes(_machine, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+
+    std::string result = err_msg;
+    std::string origin("invalid periodic root hashes output");
+    BOOST_CHECK_EQUAL(origin, result);
+
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_periodic_root_hashes_disabled_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_machine_run(_machine, 1000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    cm_periodic_root_hash_array *hashes{};
+    error_code = cm_get_periodic_root_hashes(_machine, &hashes, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL(hashes->count, static_cast<size_t>(0));
+
+    cm_delete_periodic_root_hash_array(hashes);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_periodic_root_hashes_machine_hash_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    cm_machine_runtime_config runtime_config{};
+    runtime_config.periodic_hashes.period = 1000;
+    runtime_config.periodic_hashes.start = 500;
+    cm_machine *periodic_machine{};
+    int error_code = cm_create_machine(&_machine_config, &runtime_config, &periodic_machine, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    // Periods crossing run boundaries, and a run ending exactly at a period boundary
+    for (const uint64_t mcycle_end : {1200, 1500, 3600}) {
+        error_code = cm_machine_run(periodic_machine, mcycle_end, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    cm_periodic_root_hash_array *hashes{};
+    error_code = cm_get_periodic_root_hashes(periodic_machine, &hashes, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_REQUIRE_EQUAL(hashes->count, static_cast<size_t>(4));
+
+    // Each hash must match the one obtained by stopping the machine at that mcycle
+    for (size_t i = 0; i < hashes->count; ++i) {
+        const uint64_t mcycle = 500 + i * 1000;
+        BOOST_CHECK_EQUAL(hashes->entry[i].mcycle, mcycle);
+        error_code = cm_machine_run(_machine, mcycle, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        cm_hash hash{};
+        error_code = cm_get_root_hash(_machine, &hash, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), hashes->entry[i].hash,
+            hashes->entry[i].hash + sizeof(cm_hash));
+    }
+    cm_delete_periodic_root_hash_array(hashes);
+
+    // Hashes are only returned once
+    error_code = cm_get_periodic_root_hashes(periodic_machine, &hashes, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(hashes->count, static_cast<size_t>(0));
+    cm_delete_periodic_root_hash_array(hashes);
+
+    // The Merkle tree left behind by the background hashing must still be correct
+    cm_hash hash{};
+    error_code = cm_get_root_hash(periodic_machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    auto verification = calculate_emulator_hash(periodic_machine);
+    BOOST_CHECK_EQUAL_COLLECTIONS(verification.begin(), verification.end(), hash, hash + sizeof(cm_hash));
+
+    cm_delete_machine(periodic_machine);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_periodic_root_hashes_boundary_start_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    cm_machine_runtime_config runtime_config{};
+    runtime_config.periodic_hashes.period = 1000;
+    runtime_config.periodic_hashes.start = 0;
+    cm_machine *periodic_machine{};
+    int error_code = cm_create_machine(&_machine_config, &runtime_config, &periodic_machine, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    // Without a start, the first hash is one period in, and a run resuming on a boundary
+    // whose hash was already taken does not take it again
+    for (const uint64_t mcycle_end : {1000, 1000, 1500}) {
+        error_code = cm_machine_run(periodic_machine, mcycle_end, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    cm_periodic_root_hash_array *hashes{};
+    error_code = cm_get_periodic_root_hashes(periodic_machine, &hashes, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(hashes->count, static_cast<size_t>(1));
+    BOOST_CHECK_EQUAL(hashes->entry[0].mcycle, static_cast<uint64_t>(1000));
+    cm_delete_periodic_root_hash_array(hashes);
+
+    // A run resuming on a boundary that was reached some other way records its hash
+    error_code = cm_write_csr(periodic_machine, CM_PROC_MCYCLE, 3000, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash resumed_hash{};
+    error_code = cm_get_root_hash(periodic_machine, &resumed_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_machine_run(periodic_machine, 3500, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_get_periodic_root_hashes(periodic_machine, &hashes, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(hashes->count, static_cast<size_t>(1));
+    BOOST_CHECK_EQUAL(hashes->entry[0].mcycle, static_cast<uint64_t>(3000));
+    BOOST_CHECK_EQUAL_COLLECTIONS(resumed_hash, resumed_hash + sizeof(cm_hash), hashes->entry[0].hash,
+        hashes->entry[0].hash + sizeof(cm_hash));
+    cm_delete_periodic_root_hash_array(hashes);
+
+    cm_delete_machine(periodic_machine);
+}
+
+BOOST_AUTO_TEST_CASE_NOLINT(get_profile_null_machine_test) {
+    cm_machine_profile *profile{};
+    int error_code = cm_get_profile(nullptr, &profile, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_profile_null_output_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_get_profile(_machine, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+
+    std::string result = err_msg;
+    std::string origin("invalid profile output");
+    BOOST_CHECK_EQUAL(origin, result);
+
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_profile_disabled_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    int error_code = cm_machine_run(_machine, 1000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    cm_machine_profile *profile{};
+    error_code = cm_get_profile(_machine, &profile, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL(profile->insn_counts.count, static_cast<size_t>(0));
+    BOOST_CHECK_EQUAL(profile->insn_pair_counts.count, static_cast<size_t>(0));
+    BOOST_CHECK_EQUAL(profile->pc_samples.count, static_cast<size_t>(0));
+
+    cm_delete_machine_profile(profile);
+}
+
+static cm_machine *create_fusion_machine(const cm_machine_config &config,
+    const cm_machine_runtime_config &runtime_config) {
+    cm_machine *machine{};
+    int error_code = cm_create_machine(&config, &runtime_config, &machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // A loop over the idioms the interpreter fuses, after a trap handler that skips faulting instructions
+    std::array<uint32_t, 27> program{
+        0x34102ff3, // csrr t6, mepc
+        0x004f8f93, // addi t6, t6, 4
+        0x341f9073, // csrw mepc, t6
+        0x30200073, // mret
+        0x00000297, // auipc t0, 0
+        0x10028293, // addi t0, t0, 256
+        0x00001337, // lui t1, 1
+        0xffd3031b, // addiw t1, t1, -3
+        0x00000397, // auipc t2, 0
+        0x2003be03, // ld t3, 512(t2)
+        0x001e0e13, // addi t3, t3, 1
+        0x00000397, // auipc t2, 0
+        0x1fc3ba23, // sd t3, 500(t2)
+        0x005e3e93, // sltiu t4, t3, 5
+        0x000e9463, // bnez t4, 8
+        0x00150513, // addi a0, a0, 1
+        0x00652f33, // slt t5, a0, t1
+        0x01e00463, // beqz t5, 8
+        0x00768693, // addi a3, a3, 7
+        0x15fd4595, // c.li a1, 5; c.addi a1, -1
+        0x4401fdfd, // c.bnez a1, -2; c.li s0, 0
+        0x0625c011, // c.beqz s0, 4; c.addi a2, 9
+        0x00000297, // auipc t0, 0
+        0x00828067, // jr 8(t0)
+        0xfff00fb7, // lui t6, 0xfff00
+        0x000fbf83, // ld t6, 0(t6)
+        0xfa9ff06f, // j start
+    };
+    error_code = cm_write_memory(machine, 0x80000000, reinterpret_cast<unsigned char *>(program.data()),
+        program.size() * sizeof(uint32_t), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_csr(machine, CM_PROC_MTVEC, 0x80000000, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_pc(machine, 0x80000010, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    return machine;
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(get_profile_machine_hash_test, ordinary_machine_fixture) {
+    char *err_msg{};
+    cm_machine_runtime_config runtime_config{};
+    runtime_config.profile.enabled = true;
+    runtime_config.profile.pc_sample_period = 100;
+    cm_machine *profiled_machine = create_fusion_machine(_machine_config, runtime_config);
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+
+    const uint64_t mcycle_end = 10000;
+    int error_code = cm_machine_run(profiled_machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_machine_run(machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    cm_machine_profile *profile{};
+    error_code = cm_get_profile(profiled_machine, &profile, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    // Every cycle executes an instruction, including the ones that trap, and counts come in decreasing order
+    uint64_t insn_total = 0;
+    for (size_t i = 0; i < profile->insn_counts.count; ++i) {
+        insn_total += profile->insn_counts.entry[i].count;
+        if (i > 0) {
+            BOOST_CHECK_GE(profile->insn_counts.entry[i - 1].count, profile->insn_counts.entry[i].count);
+        }
+    }
+    BOOST_CHECK_EQUAL(insn_total, mcycle_end);
+
+    // Every instruction but the first follows another one
+    uint64_t pair_total = 0;
+    for (size_t i = 0; i < profile->insn_pair_counts.count; ++i) {
+        pair_total += profile->insn_pair_counts.entry[i].count;
+        if (i > 0) {
+            BOOST_CHECK_GE(profile->insn_pair_counts.entry[i - 1].count, profile->insn_pair_counts.entry[i].count);
+        }
+    }
+    BOOST_CHECK_EQUAL(pair_total, insn_total - 1);
+
+    // One pc sample for each multiple of the sample period, including mcycle 0
+    uint64_t sample_total = 0;
+    for (size_t i = 0; i < profile->pc_samples.count; ++i) {
+        sample_total += profile->pc_samples.entry[i].count;
+    }
+    BOOST_CHECK_EQUAL(sample_total, mcycle_end / 100);
+    cm_delete_machine_profile(profile);
+
+    // Profiling must not change the machine state
+    cm_hash profiled_hash{};
+    error_code = cm_get_root_hash(profiled_machine, &profiled_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), profiled_hash, profiled_hash + sizeof(cm_hash));
+
+    cm_delete_machine(machine);
+    cm_delete_machine(profiled_machine);
+}
+
+BOOST_AUTO_TEST_CASE_NOLINT(create_bisector_null_output_test) {
+    char *err_msg{};
+    const cm_machine_runtime_config runtime_config{};
+    int error_code = cm_create_bisector("/unknown_dir", "/tmp", &runtime_config, 4, 0, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("invalid new bisector output"));
+    cm_delete_cstring(err_msg);
+}
+
+BOOST_AUTO_TEST_CASE_NOLINT(bisector_get_root_hash_null_bisector_test) {
+    cm_hash hash{};
+    int error_code = cm_bisector_get_root_hash(nullptr, 0, &hash, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(bisector_find_first_divergence_test, ordinary_machine_fixture) {
+    const uint64_t mcycle_end = 1000;
+    const uint64_t mcycle_divergence = 613;
+    const uint64_t max_checkpoints = 3;
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    int error_code = cm_store(machine, _machine_dir_path.c_str(), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // Root hashes at every mcycle, from the counterparty's point of view
+    std::vector<std::array<uint8_t, sizeof(cm_hash)>> claims(mcycle_end + 1);
+    for (uint64_t mcycle = 0; mcycle <= mcycle_end; ++mcycle) {
+        error_code = cm_machine_run(machine, mcycle, nullptr, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        error_code = cm_get_root_hash(machine, reinterpret_cast<cm_hash *>(claims[mcycle].data()), nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    cm_delete_machine(machine);
+    // The counterparty claims a wrong state from mcycle_divergence on
+    for (uint64_t mcycle = mcycle_divergence; mcycle <= mcycle_end; ++mcycle) {
+        claims[mcycle][0] ^= 1;
+    }
+
+    const auto checkpoints_dir = std::filesystem::temp_directory_path() / "bisector-checkpoints";
+    std::filesystem::create_directory(checkpoints_dir);
+    cm_bisector *bisector{};
+    char *err_msg{};
+    // Checkpoints at every query, so the test exercises them
+    error_code = cm_create_bisector(_machine_dir_path.c_str(), checkpoints_dir.c_str(), &_runtime_config,
+        max_checkpoints, 1, &bisector, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+
+    // Hashes agree at the start and disagree at the end
+    uint64_t mcycle_begin = 0;
+    uint64_t mcycle_last = mcycle_end;
+    while (mcycle_last - mcycle_begin > 1) {
+        const uint64_t mcycle = mcycle_begin + (mcycle_last - mcycle_begin) / 2;
+        cm_hash hash{};
+        error_code = cm_bisector_get_root_hash(bisector, mcycle, &hash, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        if (memcmp(hash, claims[mcycle].data(), sizeof(cm_hash)) == 0) {
+            mcycle_begin = mcycle;
+        } else {
+            mcycle_last = mcycle;
+        }
+        uint64_t count = 0;
+        error_code = cm_bisector_get_checkpoint_count(bisector, &count, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        BOOST_CHECK_LE(count, max_checkpoints);
+    }
+    BOOST_CHECK_EQUAL(mcycle_last, mcycle_divergence);
+
+    // Queries in any order match the hashes obtained by running the machine straight through
+    for (const uint64_t mcycle : {uint64_t{999}, uint64_t{1}, uint64_t{500}, uint64_t{0}, uint64_t{750}}) {
+        cm_hash hash{};
+        error_code = cm_bisector_get_root_hash(bisector, mcycle, &hash, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        claims[mcycle][0] ^= mcycle >= mcycle_divergence ? 1 : 0;
+        BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), claims[mcycle].begin(), claims[mcycle].end());
+    }
+
+    uint64_t count = 0;
+    error_code = cm_bisector_get_checkpoint_count(bisector, &count, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_GT(count, static_cast<uint64_t>(0));
+
+    // Checkpoints are removed with the bisector
+    cm_delete_bisector(bisector);
+    BOOST_CHECK(std::filesystem::is_empty(checkpoints_dir));
+
+    // With the default distance, a dispute this short is cheaper to replay than to checkpoint
+    error_code = cm_create_bisector(_machine_dir_path.c_str(), checkpoints_dir.c_str(), &_runtime_config,
+        max_checkpoints, 0, &bisector, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (const uint64_t mcycle : {uint64_t{500}, uint64_t{250}, uint64_t{375}}) {
+        cm_hash hash{};
+        error_code = cm_bisector_get_root_hash(bisector, mcycle, &hash, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    error_code = cm_bisector_get_checkpoint_count(bisector, &count, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(count, static_cast<uint64_t>(0));
+    cm_delete_bisector(bisector);
+    std::filesystem::remove_all(checkpoints_dir);
+}
+
+BOOST_AUTO_TEST_CASE_NOLINT(machine_run_lockstep_null_machine_test) {
+    auto break_reason{CM_BREAK_REASON_REACHED_TARGET_MCYCLE};
+    int error_code = cm_machine_run_lockstep(nullptr, nullptr, 1000, 100, &break_reason, nullptr);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(break_reason, CM_BREAK_REASON_FAILED);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_lockstep_invalid_period_test, ordinary_machine_fixture) {
+    cm_machine *reference = create_fusion_machine(_machine_config, _runtime_config);
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    char *err_msg{};
+    int error_code = cm_machine_run_lockstep(machine, reference, 1000, 0, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_INVALID_ARGUMENT);
+    BOOST_CHECK_EQUAL(std::string(err_msg), std::string("lockstep period cannot be 0"));
+    cm_delete_cstring(err_msg);
+    cm_delete_machine(machine);
+    cm_delete_machine(reference);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_lockstep_divergent_reference_test, ordinary_machine_fixture) {
+    cm_machine *reference = create_fusion_machine(_machine_config, _runtime_config);
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    int error_code = cm_write_x(reference, 10, 1, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    char *err_msg{};
+    error_code = cm_machine_run_lockstep(machine, reference, 1000, 100, nullptr, &err_msg);
+    BOOST_CHECK_EQUAL(error_code, CM_ERROR_RUNTIME_ERROR);
+    BOOST_CHECK_EQUAL(std::string(err_msg),
+        std::string("machine diverged from reference at mcycle 0 (reference at mcycle 0)"));
+    cm_delete_cstring(err_msg);
+    cm_delete_machine(machine);
+    cm_delete_machine(reference);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_lockstep_test, ordinary_machine_fixture) {
+    cm_machine *reference = create_fusion_machine(_machine_config, _runtime_config);
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    // The program goes through every fused idiom and trap path, checked against the microarchitecture
+    const uint64_t mcycle_end = 500;
+    auto break_reason{CM_BREAK_REASON_FAILED};
+    char *err_msg{};
+    int error_code = cm_machine_run_lockstep(machine, reference, mcycle_end, 37, &break_reason, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(err_msg, nullptr);
+    BOOST_CHECK_EQUAL(break_reason, CM_BREAK_REASON_REACHED_TARGET_MCYCLE);
+
+    uint64_t mcycle{};
+    error_code = cm_read_mcycle(machine, &mcycle, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(mcycle, mcycle_end);
+    error_code = cm_read_mcycle(reference, &mcycle, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(mcycle, mcycle_end);
+
+    cm_delete_machine(machine);
+    cm_delete_machine(reference);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(rtc_interrupt_event_horizon_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    cm_machine *chunked_machine = create_fusion_machine(_machine_config, _runtime_config);
+    // The timer interrupt becomes pending at mcycle 81920, with all interrupts disabled
+    int error_code = cm_write_csr(machine, CM_PROC_CLINT_MTIMECMP, 10, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_csr(chunked_machine, CM_PROC_CLINT_MTIMECMP, 10, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    // The RTC tick at mcycle 81920 is processed only once the machine runs past it
+    char *err_msg{};
+    error_code = cm_machine_run(machine, 81920, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    uint64_t mip{};
+    error_code = cm_read_csr(machine, CM_PROC_MIP, &mip, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL((mip & cartesi::MIP_MTIP_MASK), static_cast<uint64_t>(0));
+    error_code = cm_machine_run(machine, 100000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_read_csr(machine, CM_PROC_MIP, &mip, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL((mip & cartesi::MIP_MTIP_MASK), cartesi::MIP_MTIP_MASK);
+
+    // Skipping RTC ticks must not change the machine state, compared to stopping at every tick
+    for (uint64_t mcycle_end = 0; mcycle_end < 100000;) {
+        mcycle_end = std::min(mcycle_end + cartesi::RTC_FREQ_DIV, static_cast<uint64_t>(100000));
+        error_code = cm_machine_run(chunked_machine, mcycle_end, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    cm_hash chunked_hash{};
+    error_code = cm_get_root_hash(chunked_machine, &chunked_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), chunked_hash, chunked_hash + sizeof(cm_hash));
+
+    cm_delete_machine(machine);
+    cm_delete_machine(chunked_machine);
+}
+
+static cm_machine *create_interrupt_toggling_machine(const cm_machine_config &config,
+    const cm_machine_runtime_config &runtime_config) {
+    cm_machine *machine{};
+    int error_code = cm_create_machine(&config, &runtime_config, &machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // A loop that toggles interrupt enables with and without a pending software interrupt,
+    // after a handler that counts the interrupts it takes
+    std::array<uint32_t, 12> program{
+        0x34417073, // csrci mip, 2
+        0x00148493, // addi s1, s1, 1
+        0x30200073, // mret
+        0x00000013, // nop
+        0x30416073, // csrsi mie, 2
+        0x30046073, // csrsi mstatus, 8
+        0x30047073, // csrci mstatus, 8
+        0x34416073, // csrsi mip, 2
+        0x30046073, // csrsi mstatus, 8
+        0x30047073, // csrci mstatus, 8
+        0x30417073, // csrci mie, 2
+        0xfe5ff06f, // j start
+    };
+    error_code = cm_write_memory(machine, 0x80000000, reinterpret_cast<unsigned char *>(program.data()),
+        program.size() * sizeof(uint32_t), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_csr(machine, CM_PROC_MTVEC, 0x80000000, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_pc(machine, 0x80000010, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    return machine;
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(interrupt_csr_writes_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_interrupt_toggling_machine(_machine_config, _runtime_config);
+    cm_machine *stepped_machine = create_interrupt_toggling_machine(_machine_config, _runtime_config);
+
+    // Writes that leave no interrupt ready do not break the inner loop, which must not change the machine state,
+    // compared to serving interrupts after every instruction
+    const uint64_t mcycle_end = 10000;
+    char *err_msg{};
+    int error_code = cm_machine_run(machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (uint64_t mcycle = 1; mcycle <= mcycle_end; ++mcycle) {
+        error_code = cm_machine_run(stepped_machine, mcycle, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    uint64_t interrupts{};
+    error_code = cm_read_x(machine, 9, &interrupts, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_GT(interrupts, static_cast<uint64_t>(0));
+    cm_hash stepped_hash{};
+    error_code = cm_get_root_hash(stepped_machine, &stepped_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), stepped_hash, stepped_hash + sizeof(cm_hash));
+
+    cm_delete_machine(machine);
+    cm_delete_machine(stepped_machine);
+}
+
+static cm_machine *create_idle_machine(cm_machine_config config, const cm_machine_runtime_config &runtime_config) {
+    config.processor.iflags |= cartesi::IFLAGS_I_MASK;
+    cm_machine *machine{};
+    int error_code = cm_create_machine(&config, &runtime_config, &machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // wfi; j -4
+    std::array<uint32_t, 2> program{0x10500073, 0xffdff06f};
+    error_code = cm_write_memory(machine, 0x80000000, reinterpret_cast<unsigned char *>(program.data()),
+        program.size() * sizeof(uint32_t), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // The timer interrupt becomes pending at mcycle 81920
+    error_code = cm_write_csr(machine, CM_PROC_CLINT_MTIMECMP, 10, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    return machine;
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(wfi_idle_fast_forward_stall_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_idle_machine(_machine_config, _runtime_config);
+    char *err_msg{};
+    int error_code = cm_machine_run(machine, 50000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    // The hart is still stalled at the WFI, and no instructions were retired
+    uint64_t pc{};
+    error_code = cm_read_pc(machine, &pc, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(pc, static_cast<uint64_t>(0x80000000));
+    uint64_t icycleinstret{};
+    error_code = cm_read_csr(machine, CM_PROC_ICYCLEINSTRET, &icycleinstret, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(icycleinstret, static_cast<uint64_t>(50000));
+
+    // The WFI retires in the last mcycle before the timer interrupt becomes pending
+    error_code = cm_machine_run(machine, 81920, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_read_pc(machine, &pc, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(pc, static_cast<uint64_t>(0x80000004));
+    error_code = cm_read_csr(machine, CM_PROC_ICYCLEINSTRET, &icycleinstret, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(icycleinstret, static_cast<uint64_t>(81919));
+
+    cm_delete_machine(machine);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(wfi_idle_fast_forward_reproducible_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_idle_machine(_machine_config, _runtime_config);
+    cm_machine *stepped_machine = create_idle_machine(_machine_config, _runtime_config);
+    char *err_msg{};
+
+    // Skipping idle mcycles at once must give the same state as running a few mcycles at a time
+    int error_code = cm_machine_run(machine, 100000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (uint64_t mcycle_end = 999; mcycle_end < 100000; mcycle_end += 999) {
+        error_code = cm_machine_run(stepped_machine, mcycle_end, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    error_code = cm_machine_run(stepped_machine, 100000, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash stepped_hash{};
+    error_code = cm_get_root_hash(stepped_machine, &stepped_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), stepped_hash, stepped_hash + sizeof(cm_hash));
+
+    // The WFI retires in the last mcycle before the timer interrupt becomes pending
+    uint64_t icycleinstret{};
+    error_code = cm_read_csr(machine, CM_PROC_ICYCLEINSTRET, &icycleinstret, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(icycleinstret, static_cast<uint64_t>(81919));
+
+    cm_delete_machine(stepped_machine);
+    cm_delete_machine(machine);
+}
+
+static cm_machine *create_timer_machine(cm_machine_config config, const cm_machine_runtime_config &runtime_config) {
+    config.processor.iflags |= cartesi::IFLAGS_I_MASK;
+    cm_machine *machine{};
+    int error_code = cm_create_machine(&config, &runtime_config, &machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // A loop that counts wakeups from WFI, after a timer interrupt handler that counts interrupts and rearms
+    // mtimecmp 10 ticks later
+    std::array<uint32_t, 14> program{
+        0x00148493, // addi s1, s1, 1
+        0x020042b7, // lui t0, 0x2004
+        0x0002b303, // ld t1, 0(t0)
+        0x00a30313, // addi t1, t1, 10
+        0x0062b023, // sd t1, 0(t0)
+        0x30200073, // mret
+        0x00000013, // nop
+        0x00000013, // nop
+        0x08000293, // li t0, 0x80
+        0x3042a073, // csrs mie, t0
+        0x30046073, // csrsi mstatus, 8
+        0x10500073, // loop: wfi
+        0x00190913, // addi s2, s2, 1
+        0xff9ff06f, // j loop
+    };
+    error_code = cm_write_memory(machine, 0x80000000, reinterpret_cast<unsigned char *>(program.data()),
+        program.size() * sizeof(uint32_t), nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_csr(machine, CM_PROC_MTVEC, 0x80000000, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    error_code = cm_write_pc(machine, 0x80000020, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    // The timer interrupt becomes pending at mcycle 81920
+    error_code = cm_write_csr(machine, CM_PROC_CLINT_MTIMECMP, 10, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    return machine;
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(wfi_idle_fast_forward_wakeup_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_timer_machine(_machine_config, _runtime_config);
+    cm_machine *stepped_machine = create_timer_machine(_machine_config, _runtime_config);
+    char *err_msg{};
+
+    // Timer interrupts become pending at mcycles 81920, 163840 and 245760
+    const uint64_t mcycle_end = 300000;
+    int error_code = cm_machine_run(machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (uint64_t mcycle = 999; mcycle < mcycle_end; mcycle += 999) {
+        error_code = cm_machine_run(stepped_machine, mcycle, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+    error_code = cm_machine_run(stepped_machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+
+    // Each interrupt is taken after the WFI retired, so the handler returns to the instruction that follows it
+    uint64_t interrupts{};
+    error_code = cm_read_x(machine, 9, &interrupts, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(interrupts, static_cast<uint64_t>(3));
+    uint64_t wakeups{};
+    error_code = cm_read_x(machine, 18, &wakeups, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(wakeups, static_cast<uint64_t>(3));
+    uint64_t mepc{};
+    error_code = cm_read_csr(machine, CM_PROC_MEPC, &mepc, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(mepc, static_cast<uint64_t>(0x80000030));
+
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash stepped_hash{};
+    error_code = cm_get_root_hash(stepped_machine, &stepped_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), stepped_hash, stepped_hash + sizeof(cm_hash));
+
+    cm_delete_machine(stepped_machine);
+    cm_delete_machine(machine);
+}
+
+BOOST_FIXTURE_TEST_CASE_NOLINT(fused_idioms_reproducible_test, ordinary_machine_fixture) {
+    cm_machine *machine = create_fusion_machine(_machine_config, _runtime_config);
+    cm_machine *stepped_machine = create_fusion_machine(_machine_config, _runtime_config);
+    char *err_msg{};
+
+    // Instructions are never fused when running a single mcycle at a time
+    const uint64_t mcycle_end = 20000;
+    int error_code = cm_machine_run(machine, mcycle_end, nullptr, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    for (uint64_t mcycle = 1; mcycle <= mcycle_end; ++mcycle) {
+        error_code = cm_machine_run(stepped_machine, mcycle, nullptr, &err_msg);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+
+    cm_hash hash{};
+    error_code = cm_get_root_hash(machine, &hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_hash stepped_hash{};
+    error_code = cm_get_root_hash(stepped_machine, &stepped_hash, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(hash, hash + sizeof(cm_hash), stepped_hash, stepped_hash + sizeof(cm_hash));
+
+    // The loop went around, trapping on the faulting load every time
+    uint64_t a0{};
+    error_code = cm_read_x(machine, 10, &a0, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_GT(a0, static_cast<uint64_t>(0));
+    uint64_t mcause{};
+    error_code = cm_read_csr(machine, CM_PROC_MCAUSE, &mcause, &err_msg);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(mcause, static_cast<uint64_t>(cartesi::MCAUSE_LOAD_ACCESS_FAULT));
+
+    cm_delete_machine(stepped_machine);
+    cm_delete_machine(machine);
+}
+
 BOOST_AUTO_TEST_CASE_NOLINT(machine_run_uarch_null_machine_test) {
     auto status{CM_UARCH_BREAK_REASON_REACHED_TARGET_CYCLE};
     int error_code = cm_machine_run_uarch(nullptr, 1000, &status, nullptr);
@@ -2301,6 +3765,66 @@ BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_uarch_advance_until_halt, access_log_
     BOOST_REQUIRE_EQUAL(halt, 1);
 }
 
+BOOST_FIXTURE_TEST_CASE_NOLINT(machine_run_uarch_self_modifying_code_test, incomplete_machine_fixture) {
+    // Overwrites addi a0, a0, 1 with slli a0, a0, 4 after executing it, so a stale decoded instruction gives a0 = 3
+    uint32_t test_uarch_ram[] = {
+        0x00000497,                                                            // auipc s1, 0
+        0x00300413,                                                            // li s0, 3
+        0x004512b7,                                                            // lui t0, 0x451
+        0x51328293,                                                            // addi t0, t0, 0x513
+        0x00150513,                                                            // loop: addi a0, a0, 1
+        0x0054a823,                                                            // sw t0, 16(s1) overwrites loop
+        0xfff40413,                                                            // addi s0, s0, -1
+        0xfe041ae3,                                                            // bnez s0, loop
+        (cartesi::uarch_ecall_functions::UARCH_ECALL_FN_HALT << 20) | 0x00893, // li a7, halt
+        0x00000073,                                                            // ecall
+    };
+    const auto uarch_ram_path = (std::filesystem::temp_directory_path() / "test-uarch-smc-ram.bin").string();
+    std::ofstream of(uarch_ram_path, std::ios::binary);
+    of.write(static_cast<char *>(static_cast<void *>(&test_uarch_ram)), sizeof(test_uarch_ram));
+    of.close();
+    delete[] _machine_config.uarch.ram.image_filename;
+    _machine_config.uarch.ram.image_filename = new_cstr(uarch_ram_path.c_str());
+
+    cm_machine *run_machine{};
+    int error_code = cm_create_machine(&_machine_config, &_runtime_config, &run_machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    cm_machine *step_machine{};
+    error_code = cm_create_machine(&_machine_config, &_runtime_config, &step_machine, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    std::filesystem::remove(uarch_ram_path);
+
+    auto status{CM_UARCH_BREAK_REASON_REACHED_TARGET_CYCLE};
+    error_code = cm_machine_run_uarch(run_machine, UINT64_MAX, &status, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_REQUIRE_EQUAL(status, CM_UARCH_BREAK_REASON_UARCH_HALTED);
+
+    // Logged steps never use the decoded instruction cache
+    bool halted = false;
+    while (!halted) {
+        cm_access_log *access_log{};
+        error_code = cm_log_uarch_step(step_machine, cm_access_log_type{false, false, false}, false, &access_log,
+            nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+        cm_delete_access_log(access_log);
+        error_code = cm_read_uarch_halt_flag(step_machine, &halted, nullptr);
+        BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    }
+
+    uint64_t a0{};
+    error_code = cm_read_uarch_x(run_machine, 10, &a0, nullptr);
+    BOOST_REQUIRE_EQUAL(error_code, CM_ERROR_OK);
+    BOOST_CHECK_EQUAL(a0, 256);
+    cm_hash run_hash{};
+    BOOST_REQUIRE_EQUAL(cm_get_root_hash(run_machine, &run_hash, nullptr), CM_ERROR_OK);
+    cm_hash step_hash{};
+    BOOST_REQUIRE_EQUAL(cm_get_root_hash(step_machine, &step_hash, nullptr), CM_ERROR_OK);
+    BOOST_CHECK_EQUAL_COLLECTIONS(run_hash, run_hash + sizeof(cm_hash), step_hash, step_hash + sizeof(cm_hash));
+
+    cm_delete_machine(step_machine);
+    cm_delete_machine(run_machine);
+}
+
 BOOST_FIXTURE_TEST_CASE_NOLINT(machine_reset_uarch, ordinary_machine_fixture) {
     char *err_msg{};
     // ensure that uarch cycle is 0
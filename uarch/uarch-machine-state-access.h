@@ -458,6 +458,11 @@ private:
         return (iflags & IFLAGS_Y_MASK) != 0;
     }
 
+    bool do_read_iflags_I(void) {
+        auto iflags = read_iflags();
+        return (iflags & IFLAGS_I_MASK) != 0;
+    }
+
     uint8_t do_read_iflags_PRV(void) {
         auto iflags = read_iflags();
         return (iflags & IFLAGS_PRV_MASK) >> IFLAGS_PRV_SHIFT;
@@ -766,6 +771,21 @@ private:
         // Soft yield is meaningless in microarchitecture
         return false;
     }
+
+    void do_count_insn(insn_id id) {
+        (void) id;
+        // Profiling is meaningless in microarchitecture
+    }
+
+    uint64_t do_get_pc_sample_period() {
+        // Profiling is meaningless in microarchitecture
+        return 0;
+    }
+
+    void do_sample_pc(uint64_t pc) {
+        (void) pc;
+        // Profiling is meaningless in microarchitecture
+    }
 };
 
 } // namespace cartesi